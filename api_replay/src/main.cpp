@@ -0,0 +1,416 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "modules/args_parser/include/args_parser.h"
+
+#include "api_call_record.h"
+#include "dynamic_lib_load.h"
+
+using hebench::APIBridge::APICallRecord;
+using hebench::APIBridge::DynamicLibLoad;
+using hebench::APIBridge::ErrorCode;
+using hebench::APIBridge::Handle;
+
+/**
+ * @brief Packed data read from a recording, laid out ready to be passed to the backend.
+ */
+struct ReplayPackedData
+{
+    std::vector<std::vector<std::uint8_t>> storage;
+    std::vector<hebench::APIBridge::NativeDataBuffer> buffers;
+    std::vector<hebench::APIBridge::DataPack> packs;
+    hebench::APIBridge::PackedData packed_data;
+};
+
+struct ReplayCall
+{
+    APICallRecord::Call call;
+    std::uint64_t bench_id;
+    std::vector<std::uint64_t> in_ids;
+    std::vector<std::uint64_t> out_ids;
+    std::vector<hebench::APIBridge::ParameterIndexer> indexers;
+    std::shared_ptr<ReplayPackedData> p_data;
+};
+
+struct Replay
+{
+    std::uint64_t bench_desc_index;
+    std::vector<hebench::APIBridge::WorkloadParam> w_params;
+    std::uint64_t bench_id;
+    std::uint64_t max_id;
+    std::vector<ReplayCall> calls; // all calls after benchmark initialization
+};
+
+struct CallStats
+{
+    std::uint64_t count = 0;
+    double total_ms     = 0.0;
+};
+
+const char *getCallName(APICallRecord::Call call)
+{
+    switch (call)
+    {
+    case APICallRecord::Call::InitBenchmark:
+        return "initBenchmark";
+    case APICallRecord::Call::Encode:
+        return "encode";
+    case APICallRecord::Call::Decode:
+        return "decode";
+    case APICallRecord::Call::Encrypt:
+        return "encrypt";
+    case APICallRecord::Call::Decrypt:
+        return "decrypt";
+    case APICallRecord::Call::Load:
+        return "load";
+    case APICallRecord::Call::Store:
+        return "store";
+    case APICallRecord::Call::Operate:
+        return "operate";
+    case APICallRecord::Call::DestroyHandle:
+        return "destroyHandle";
+    default:
+        return "unknown";
+    } // end switch
+}
+
+std::shared_ptr<ReplayPackedData> readPackedData(hebench::APIBridge::APICallReader &reader, bool b_contents)
+{
+    std::shared_ptr<ReplayPackedData> retval = std::make_shared<ReplayPackedData>();
+
+    std::uint64_t pack_count = reader.readU64();
+    std::vector<std::uint64_t> buffer_counts(pack_count);
+    retval->packs.resize(pack_count);
+    for (std::uint64_t pack_i = 0; pack_i < pack_count; ++pack_i)
+    {
+        retval->packs[pack_i].param_position = reader.readU64();
+        buffer_counts[pack_i]                = reader.readU64();
+        for (std::uint64_t buffer_i = 0; buffer_i < buffer_counts[pack_i]; ++buffer_i)
+        {
+            hebench::APIBridge::NativeDataBuffer buffer;
+            buffer.tag  = static_cast<std::int64_t>(reader.readU64());
+            buffer.size = reader.readU64();
+            retval->storage.emplace_back(buffer.size);
+            if (b_contents)
+                reader.readBytes(retval->storage.back().data(), buffer.size);
+            retval->buffers.push_back(buffer);
+        } // end for
+    } // end for
+
+    // point descriptors to their storage now that all vectors are final
+    std::size_t buffer_offset = 0;
+    for (std::uint64_t pack_i = 0; pack_i < pack_count; ++pack_i)
+    {
+        retval->packs[pack_i].buffer_count = buffer_counts[pack_i];
+        retval->packs[pack_i].p_buffers    = retval->buffers.data() + buffer_offset;
+        buffer_offset += buffer_counts[pack_i];
+    } // end for
+    for (std::size_t buffer_i = 0; buffer_i < retval->buffers.size(); ++buffer_i)
+        retval->buffers[buffer_i].p = retval->storage[buffer_i].data();
+    retval->packed_data.p_data_packs = retval->packs.data();
+    retval->packed_data.pack_count   = pack_count;
+
+    return retval;
+}
+
+Replay readRecording(const std::string &filename)
+{
+    Replay retval;
+    hebench::APIBridge::APICallReader reader(filename);
+    APICallRecord::Call call;
+
+    if (!reader.readCall(call) || call != APICallRecord::Call::InitBenchmark)
+        throw std::runtime_error("Recording does not start with benchmark initialization.");
+    retval.bench_desc_index = reader.readU64();
+    retval.w_params.resize(reader.readU64());
+    reader.readBytes(retval.w_params.data(), retval.w_params.size() * sizeof(hebench::APIBridge::WorkloadParam));
+    retval.bench_id = reader.readU64();
+    retval.max_id   = retval.bench_id;
+
+    while (reader.readCall(call))
+    {
+        ReplayCall replay_call;
+        replay_call.call     = call;
+        replay_call.bench_id = APICallRecord::UnknownId;
+        switch (call)
+        {
+        case APICallRecord::Call::Encode:
+            replay_call.bench_id = reader.readU64();
+            replay_call.p_data   = readPackedData(reader, true);
+            replay_call.out_ids.push_back(reader.readU64());
+            break;
+
+        case APICallRecord::Call::Decode:
+            replay_call.bench_id = reader.readU64();
+            replay_call.in_ids.push_back(reader.readU64());
+            replay_call.p_data = readPackedData(reader, false);
+            break;
+
+        case APICallRecord::Call::Encrypt:
+        case APICallRecord::Call::Decrypt:
+            replay_call.bench_id = reader.readU64();
+            replay_call.in_ids.push_back(reader.readU64());
+            replay_call.out_ids.push_back(reader.readU64());
+            break;
+
+        case APICallRecord::Call::Load:
+            replay_call.bench_id = reader.readU64();
+            replay_call.in_ids.resize(reader.readU64());
+            for (std::uint64_t &id : replay_call.in_ids)
+                id = reader.readU64();
+            replay_call.out_ids.push_back(reader.readU64());
+            break;
+
+        case APICallRecord::Call::Store:
+            replay_call.bench_id = reader.readU64();
+            replay_call.in_ids.push_back(reader.readU64());
+            replay_call.out_ids.resize(reader.readU64());
+            for (std::uint64_t &id : replay_call.out_ids)
+                id = reader.readU64();
+            break;
+
+        case APICallRecord::Call::Operate:
+            replay_call.bench_id = reader.readU64();
+            replay_call.in_ids.push_back(reader.readU64());
+            replay_call.indexers.resize(reader.readU64());
+            reader.readBytes(replay_call.indexers.data(), replay_call.indexers.size() * sizeof(hebench::APIBridge::ParameterIndexer));
+            replay_call.out_ids.push_back(reader.readU64());
+            break;
+
+        case APICallRecord::Call::DestroyHandle:
+            replay_call.in_ids.push_back(reader.readU64());
+            break;
+
+        default:
+            throw std::runtime_error("Invalid call found in recording.");
+        } // end switch
+
+        if (replay_call.bench_id != APICallRecord::UnknownId && replay_call.bench_id != retval.bench_id)
+            throw std::runtime_error("Recording contains calls on more than one benchmark.");
+        for (std::uint64_t id : replay_call.in_ids)
+            if (id == APICallRecord::UnknownId || id > retval.max_id)
+                throw std::runtime_error(std::string("Recorded call to ") + getCallName(call) + " uses a handle that was not recorded.");
+        for (std::uint64_t id : replay_call.out_ids)
+            if (id > retval.max_id)
+                retval.max_id = id;
+
+        // the benchmark is destroyed once, after all loops
+        if (call != APICallRecord::Call::DestroyHandle || replay_call.in_ids.front() != retval.bench_id)
+            retval.calls.emplace_back(std::move(replay_call));
+    } // end while
+
+    return retval;
+}
+
+void validateRetCode(const Handle *p_h_engine, ErrorCode err_code, const std::string &call_name)
+{
+    if (err_code != HEBENCH_ECODE_SUCCESS)
+    {
+        std::vector<char> description(DynamicLibLoad::getErrorDescription(err_code, nullptr, 0) + 1, 0);
+        DynamicLibLoad::getErrorDescription(err_code, description.data(), description.size());
+        std::string s_message = description.data();
+        if (p_h_engine)
+        {
+            description.assign(DynamicLibLoad::getLastErrorDescription(*p_h_engine, nullptr, 0) + 1, 0);
+            DynamicLibLoad::getLastErrorDescription(*p_h_engine, description.data(), description.size());
+            if (description.front() != '\0')
+                s_message += std::string("\n") + description.data();
+        } // end if
+        throw std::runtime_error("Backend call to " + call_name + " failed with message:\n" + s_message);
+    } // end if
+}
+
+int main(int argc, char **argv)
+{
+    int retval = 0;
+
+    try
+    {
+        hebench::ArgsParser args_parser;
+        args_parser.addArgument("--backend_lib_path", "--backend", "-b", 1, "<path_to_shared_lib>",
+                                "   [REQUIRED] Path to backend shared library to replay the calls on.");
+        args_parser.addArgument("--record_file", "-r", 1, "<path_to_file>",
+                                "   [REQUIRED] API Bridge call recording to replay, as generated by\n"
+                                "   Test Harness with \"--record_api_calls\".");
+        args_parser.addArgument("--loops", "-n", 1, "<uint64>",
+                                "   [OPTIONAL] Number of times to replay the recorded calls on the same\n"
+                                "   initialized benchmark. Defaults to 1.");
+        args_parser.addArgument("--operation_loops", 1, "<uint64>",
+                                "   [OPTIONAL] Number of times every recorded operation is issued in a row.\n"
+                                "   Only the last result is kept. Defaults to 1.");
+        args_parser.parse(argc, argv);
+
+        std::string backend_lib_path;
+        std::string record_file;
+        std::uint64_t loops;
+        std::uint64_t operation_loops;
+        args_parser.getValue<decltype(backend_lib_path)>(backend_lib_path, "--backend_lib_path");
+        args_parser.getValue<decltype(record_file)>(record_file, "--record_file");
+        args_parser.getValue<decltype(loops)>(loops, "--loops", 1);
+        args_parser.getValue<decltype(operation_loops)>(operation_loops, "--operation_loops", 1);
+        if (loops < 1 || operation_loops < 1)
+            throw std::runtime_error("Loop counts must be greater than 0.");
+
+        std::cout << "[ Info    ] Reading recording: " << record_file << std::endl;
+        Replay replay = readRecording(record_file);
+        std::cout << "[      OK ] Calls recorded: " << replay.calls.size() + 1 << std::endl;
+
+        DynamicLibLoad::loadLibrary(backend_lib_path);
+
+        Handle h_engine;
+        std::uint64_t bench_desc_count = 0;
+        validateRetCode(nullptr, DynamicLibLoad::initEngine(&h_engine), "initEngine");
+        validateRetCode(&h_engine, DynamicLibLoad::subscribeBenchmarksCount(h_engine, &bench_desc_count), "subscribeBenchmarksCount");
+        std::vector<Handle> h_bench_descs(bench_desc_count);
+        validateRetCode(&h_engine, DynamicLibLoad::subscribeBenchmarks(h_engine, h_bench_descs.data()), "subscribeBenchmarks");
+        if (replay.bench_desc_index >= h_bench_descs.size())
+            throw std::runtime_error("Recorded benchmark is not offered by backend.");
+
+        // handles by recorded id
+        std::vector<Handle> handles(replay.max_id + 1);
+        std::vector<bool> alive(replay.max_id + 1, false);
+        std::vector<CallStats> stats(static_cast<std::size_t>(APICallRecord::Call::DestroyHandle) + 1);
+
+        hebench::APIBridge::WorkloadParams w_params;
+        w_params.params = replay.w_params.data();
+        w_params.count  = replay.w_params.size();
+        auto start_time = std::chrono::steady_clock::now();
+        validateRetCode(&h_engine,
+                        DynamicLibLoad::initBenchmark(h_engine, h_bench_descs[replay.bench_desc_index],
+                                                      w_params.count > 0 ? &w_params : nullptr,
+                                                      &handles[replay.bench_id]),
+                        getCallName(APICallRecord::Call::InitBenchmark));
+        stats[static_cast<std::size_t>(APICallRecord::Call::InitBenchmark)].count    = 1;
+        stats[static_cast<std::size_t>(APICallRecord::Call::InitBenchmark)].total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+        alive[replay.bench_id] = true;
+        Handle h_bench         = handles[replay.bench_id];
+
+        std::cout << "[ Info    ] Replaying..." << std::endl;
+        for (std::uint64_t loop_i = 0; loop_i < loops; ++loop_i)
+        {
+            for (ReplayCall &replay_call : replay.calls)
+            {
+                ErrorCode err_code = HEBENCH_ECODE_SUCCESS;
+                std::vector<Handle> in_handles(replay_call.in_ids.size());
+                for (std::size_t i = 0; i < in_handles.size(); ++i)
+                    in_handles[i] = handles[replay_call.in_ids[i]];
+                std::vector<Handle> out_handles(replay_call.out_ids.size());
+
+                start_time = std::chrono::steady_clock::now();
+                switch (replay_call.call)
+                {
+                case APICallRecord::Call::Encode:
+                    err_code = DynamicLibLoad::encode(h_bench, &replay_call.p_data->packed_data, &out_handles.front());
+                    break;
+
+                case APICallRecord::Call::Decode:
+                    err_code = DynamicLibLoad::decode(h_bench, in_handles.front(), &replay_call.p_data->packed_data);
+                    break;
+
+                case APICallRecord::Call::Encrypt:
+                    err_code = DynamicLibLoad::encrypt(h_bench, in_handles.front(), &out_handles.front());
+                    break;
+
+                case APICallRecord::Call::Decrypt:
+                    err_code = DynamicLibLoad::decrypt(h_bench, in_handles.front(), &out_handles.front());
+                    break;
+
+                case APICallRecord::Call::Load:
+                    err_code = DynamicLibLoad::load(h_bench, in_handles.data(), in_handles.size(), &out_handles.front());
+                    break;
+
+                case APICallRecord::Call::Store:
+                    err_code = DynamicLibLoad::store(h_bench, in_handles.front(), out_handles.data(), out_handles.size());
+                    break;
+
+                case APICallRecord::Call::Operate:
+                    for (std::uint64_t op_i = 0; err_code == HEBENCH_ECODE_SUCCESS && op_i < operation_loops; ++op_i)
+                    {
+                        if (op_i > 0)
+                            DynamicLibLoad::destroyHandle(out_handles.front());
+                        err_code = DynamicLibLoad::operate(h_bench, in_handles.front(), replay_call.indexers.data(), &out_handles.front());
+                    } // end for
+                    break;
+
+                case APICallRecord::Call::DestroyHandle:
+                    err_code                          = DynamicLibLoad::destroyHandle(in_handles.front());
+                    alive[replay_call.in_ids.front()] = false;
+                    break;
+
+                default:
+                    break;
+                } // end switch
+                double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+                validateRetCode(&h_engine, err_code, getCallName(replay_call.call));
+
+                CallStats &call_stats = stats[static_cast<std::size_t>(replay_call.call)];
+                call_stats.count += (replay_call.call == APICallRecord::Call::Operate ? operation_loops : 1);
+                call_stats.total_ms += elapsed_ms;
+
+                for (std::size_t i = 0; i < out_handles.size(); ++i)
+                {
+                    std::uint64_t id = replay_call.out_ids[i];
+                    if (id != APICallRecord::UnknownId)
+                    {
+                        handles[id] = out_handles[i];
+                        alive[id]   = true;
+                    } // end if
+                } // end for
+            } // end for
+
+            // release handles the recording did not destroy before looping again
+            for (std::size_t id = 0; id < handles.size(); ++id)
+                if (alive[id] && id != replay.bench_id)
+                {
+                    DynamicLibLoad::destroyHandle(handles[id]);
+                    alive[id] = false;
+                } // end if
+        } // end for
+
+        DynamicLibLoad::destroyHandle(h_bench);
+        for (Handle h : h_bench_descs)
+            DynamicLibLoad::destroyHandle(h);
+        DynamicLibLoad::destroyHandle(h_engine);
+        DynamicLibLoad::unloadLibrary();
+
+        std::cout << "[    DONE ] " << std::endl
+                  << std::endl
+                  << std::setw(16) << std::left << "Call"
+                  << std::setw(12) << std::right << "Count"
+                  << std::setw(18) << "Total (ms)"
+                  << std::setw(18) << "Average (ms)" << std::endl;
+        for (std::size_t call_i = 0; call_i < stats.size(); ++call_i)
+            if (stats[call_i].count > 0)
+                std::cout << std::setw(16) << std::left << getCallName(static_cast<APICallRecord::Call>(call_i))
+                          << std::setw(12) << std::right << stats[call_i].count
+                          << std::setw(18) << std::fixed << std::setprecision(3) << stats[call_i].total_ms
+                          << std::setw(18) << stats[call_i].total_ms / stats[call_i].count << std::endl;
+    }
+    catch (hebench::ArgsParser::HelpShown &)
+    {
+        // do nothing
+    }
+    catch (std::exception &ex)
+    {
+        std::cout << "Error occurred with message: " << std::endl
+                  << ex.what() << std::endl;
+        retval = -1;
+    }
+    catch (...)
+    {
+        std::cout << "Unexpected error occurred!" << std::endl;
+        retval = -1;
+    }
+
+    return retval;
+}
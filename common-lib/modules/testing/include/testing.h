@@ -0,0 +1,101 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _COMMON_Testing_H_7e5fa8c2415240ea93eff148ed73539b
+#define _COMMON_Testing_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace hebench {
+namespace Testing {
+
+/**
+ * @brief Thrown by the check macros when a condition does not hold.
+ */
+class CheckFailed : public std::runtime_error
+{
+public:
+    CheckFailed(const char *file, int line, const std::string &condition) :
+        std::runtime_error(std::string(file) + ":" + std::to_string(line) + ": check failed: " + condition)
+    {
+    }
+};
+
+/**
+ * @brief Named test function run by runTests().
+ */
+struct TestCase
+{
+    const char *name;
+    void (*run)();
+};
+
+/**
+ * @brief Runs every test case and reports the result of each in standard
+ * output.
+ * @details A test case fails if it throws. Remaining test cases run after a
+ * failure.
+ * @returns `EXIT_SUCCESS` if all test cases passed, `EXIT_FAILURE` otherwise,
+ * to be returned from `main()` and picked up by CTest.
+ */
+inline int runTests(const std::vector<TestCase> &test_cases)
+{
+    std::size_t failed_count = 0;
+    for (const TestCase &test_case : test_cases)
+    {
+        try
+        {
+            test_case.run();
+            std::cout << "[ PASSED ] " << test_case.name << std::endl;
+        }
+        catch (std::exception &ex)
+        {
+            ++failed_count;
+            std::cout << "[ FAILED ] " << test_case.name << std::endl
+                      << "           " << ex.what() << std::endl;
+        }
+        catch (...)
+        {
+            ++failed_count;
+            std::cout << "[ FAILED ] " << test_case.name << std::endl
+                      << "           Unknown exception." << std::endl;
+        }
+    } // end for
+    std::cout << test_cases.size() - failed_count << "/" << test_cases.size() << " test cases passed." << std::endl;
+    return failed_count > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+} // namespace Testing
+} // namespace hebench
+
+// fails the current test case if `condition` is false
+#define HEBENCH_CHECK(condition)                                                 \
+    do                                                                           \
+    {                                                                            \
+        if (!(condition))                                                        \
+            throw hebench::Testing::CheckFailed(__FILE__, __LINE__, #condition); \
+    } while (false)
+
+// fails the current test case unless `statement` throws `exception_type`
+#define HEBENCH_CHECK_THROWS(statement, exception_type)                                                     \
+    do                                                                                                      \
+    {                                                                                                       \
+        bool b_thrown = false;                                                                              \
+        try                                                                                                 \
+        {                                                                                                   \
+            statement;                                                                                      \
+        }                                                                                                   \
+        catch (exception_type &)                                                                            \
+        {                                                                                                   \
+            b_thrown = true;                                                                                \
+        }                                                                                                   \
+        if (!b_thrown)                                                                                      \
+            throw hebench::Testing::CheckFailed(__FILE__, __LINE__, #statement " throws " #exception_type); \
+    } while (false)
+
+#endif // defined _COMMON_Testing_H_7e5fa8c2415240ea93eff148ed73539b
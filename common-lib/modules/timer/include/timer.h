@@ -4,11 +4,14 @@
 #ifndef _COMMON_Timer_H_7e5fa8c2415240ea93eff148ed73539b
 #define _COMMON_Timer_H_7e5fa8c2415240ea93eff148ed73539b
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <ctime>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace hebench {
 namespace Common {
@@ -171,6 +174,9 @@ public:
     TimingReportEvent(std::uint32_t _id = 0, const std::string &_description = std::string()) :
         id(_id),
         description(_description),
+        span_id(0),
+        parent_span_id(0),
+        depth(0),
         m_cpu_time_start(0.0),
         m_cpu_time_end(0.0),
         m_wall_time_start(0.0),
@@ -200,6 +206,34 @@ public:
      * @brief Description of this event.
      */
     std::string description;
+    /**
+     * @brief ID of the span measured by this event, unique in the process.
+     * @details Events returned by an EventTimer are always assigned a span ID,
+     * so that other events can be nested inside them. `0` means no span.
+     * @sa nextSpanID()
+     */
+    std::uint64_t span_id;
+    /**
+     * @brief ID of the span that encloses this event, or `0` if this event
+     * is not nested inside another.
+     */
+    std::uint64_t parent_span_id;
+    /**
+     * @brief Nesting depth of this event: `0` for top level events, and the
+     * depth of the parent plus 1 for nested events.
+     */
+    std::uint32_t depth;
+
+    /**
+     * @brief Generates a new span ID, unique in the process.
+     * @details Use to nest events measured elsewhere, such as timings reported
+     * by a backend, inside an event returned by an EventTimer.
+     */
+    static std::uint64_t nextSpanID()
+    {
+        static std::atomic<std::uint64_t> next_id(1);
+        return next_id.fetch_add(1, std::memory_order_relaxed);
+    }
 
     template <class TimeInterval = DefaultTimeInterval> // TimeInterval = std::nano, std::micro, std::milli, std::ratio<1, 1>, etc.
     /**
@@ -365,6 +399,22 @@ template <bool high_precision = false>
  *
  * To measure execution time of a portion of code, sandwich the code between
  * calls to `start()` and `stop()`.
+ *
+ * Measurements can be nested by sandwiching the enclosing code between calls
+ * to `startSpan()` and `stopSpan()`. Events stopped while spans are open are
+ * children of the innermost open span. For example, a decoding phase that
+ * contains a decode per result:
+ *
+ * @code
+ * timer.startSpan();
+ * for (...)
+ * {
+ *     timer.start();
+ *     decode(...);
+ *     events.push_back(timer.stop(decode_id, 1, nullptr)); // child of the span
+ * }
+ * events.push_back(timer.stopSpan(decoding_id, 1, nullptr));
+ * @endcode
  */
 class EventTimer
 {
@@ -437,9 +487,63 @@ public:
             getCPUElapsedTime<TimeInterval>(m_cpu_start_time), cpu_end_time,
             getWallElapsedTime<TimeInterval>(m_start_time), wall_end_time,
             iterations);
+        retval->span_id = TimingReportEvent::nextSpanID();
+        setParentSpan(*retval);
+
+        return retval;
+    }
+
+    /**
+     * @brief Opens a new span, nested inside the innermost open span, if any.
+     * @details The span measures time from this call until the matching call
+     * to `stopSpan()`. Events stopped in between are its children.
+     */
+    void startSpan()
+    {
+        Span span;
+        span.span_id        = TimingReportEvent::nextSpanID();
+        span.cpu_start_time = std::clock();
+        span.start_time     = ClockType::now();
+        m_spans.push_back(span);
+    }
+    template <class TimeInterval = TimingReportEvent::DefaultTimeInterval> // TimeInterval = std::nano, std::micro, std::milli, std::ratio<1, 1>, etc.
+    /**
+     * @brief Closes the innermost open span.
+     * @param[in] id Optional ID to associate with this event.
+     * @param[in] iterations Number of iterations measured in this event.
+     * @param[in] description Optional text description to add to this event.
+     * @return A TimingReportEvent with the measurement details of the span.
+     * @throws std::logic_error if there is no open span.
+     * @details The returned event report will reflect the timings between the
+     * matching call to `startSpan()` and this call. This does not affect
+     * measurements started with `start()`.
+     */
+    TimingReportEvent::Ptr stopSpan(std::uint32_t id,
+                                    std::uint64_t iterations,
+                                    const char *description)
+    {
+        double cpu_end_time  = getCPUElapsedTime<TimeInterval>();
+        double wall_end_time = getWallElapsedTime<TimeInterval>();
+        if (m_spans.empty())
+            throw std::logic_error("EventTimer::stopSpan(): no open span.");
+        Span span = m_spans.back();
+        m_spans.pop_back();
+
+        TimingReportEvent::Ptr retval = TimingReportEvent::create(id,
+                                                                  description ? std::string(description) : std::string());
+        retval->setTimings<TimeInterval>(
+            getCPUElapsedTime<TimeInterval>(span.cpu_start_time), cpu_end_time,
+            getWallElapsedTime<TimeInterval>(span.start_time), wall_end_time,
+            iterations);
+        retval->span_id = span.span_id;
+        setParentSpan(*retval);
 
         return retval;
     }
+    /**
+     * @brief Number of spans opened with `startSpan()` and not yet closed.
+     */
+    std::size_t getOpenSpanCount() const { return m_spans.size(); }
 
     /**
      * @brief Retrieves whether the timer is active.
@@ -454,6 +558,19 @@ private:
                                       std::chrono::high_resolution_clock,
                                       std::chrono::system_clock>::type ClockType;
 
+    struct Span
+    {
+        std::uint64_t span_id;
+        std::chrono::time_point<ClockType> start_time;
+        std::clock_t cpu_start_time;
+    };
+
+    void setParentSpan(TimingReportEvent &event) const
+    {
+        event.parent_span_id = m_spans.empty() ? 0 : m_spans.back().span_id;
+        event.depth          = static_cast<std::uint32_t>(m_spans.size());
+    }
+
     template <class TimeInterval>
     double getCPUElapsedTime() const
     {
@@ -479,6 +596,7 @@ private:
     std::clock_t m_cpu_init_time;
     std::chrono::time_point<ClockType> m_start_time;
     std::clock_t m_cpu_start_time;
+    std::vector<Span> m_spans; // open spans, innermost last
 
     bool m_active;
 };
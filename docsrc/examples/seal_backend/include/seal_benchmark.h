@@ -0,0 +1,156 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hebench/api_bridge/cpp/hebench.hpp"
+#include <seal/seal.h>
+
+#include "seal_context.h"
+
+class SEALEngine;
+
+/**
+ * @brief Encoded or encrypted sample of an operation parameter or result.
+ * @details A sample may span several plaintexts or ciphertexts, depending on
+ * the workload. Only one of the collections is filled.
+ */
+struct SEALSample
+{
+    std::vector<seal::Plaintext> plain;
+    std::vector<seal::Ciphertext> cipher;
+};
+
+/**
+ * @brief Common description of all benchmarks in the SEAL example backend.
+ * @details Fills in the descriptor for the category and adds the encryption
+ * parameters and thread count to the benchmark description.
+ */
+class SEALBenchmarkDescription : public hebench::cpp::BenchmarkDescription
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALBenchmarkDescription)
+
+public:
+    ~SEALBenchmarkDescription() override;
+
+    std::string getBenchmarkDescription(const hebench::APIBridge::WorkloadParams *p_w_params) const override;
+
+    void destroyBenchmark(hebench::cpp::BaseBenchmark *p_bench) override;
+
+    std::size_t polyModulusDegree() const { return m_poly_modulus_degree; }
+    const std::vector<int> &coeffModulusBits() const { return m_coeff_modulus_bits; }
+    int scaleExponent() const { return m_scale_exponent; }
+
+protected:
+    /**
+     * @param[in] cipher_param_mask Operation parameters that are encrypted.
+     * @param[in] thread_count Threads used by the engine, for reporting.
+     */
+    SEALBenchmarkDescription(hebench::APIBridge::Workload workload,
+                             hebench::APIBridge::Category category,
+                             std::uint32_t cipher_param_mask,
+                             std::size_t poly_modulus_degree,
+                             const std::vector<int> &coeff_modulus_bits,
+                             int scale_exponent,
+                             std::size_t thread_count);
+
+private:
+    std::size_t m_poly_modulus_degree;
+    std::vector<int> m_coeff_modulus_bits;
+    int m_scale_exponent;
+    std::size_t m_thread_count;
+};
+
+/**
+ * @brief Common pipeline of all benchmarks in the SEAL example backend.
+ * @details Implements the API Bridge pipeline on top of the per sample
+ * operations of each workload. Encoding, encryption, decryption and decoding
+ * process every sample of a batch in parallel, and operation computes every
+ * result of a batch in parallel, using the engine threads. Samples spanning
+ * several plaintexts or ciphertexts are also processed in parallel when the
+ * batch holds a single sample.
+ *
+ * Results are ordered as in the tutorial: the result for the samples
+ * (i_0, i_1, ..., i_n-1) of the operation parameters is at index
+ * `(...(i_0 * batch_1 + i_1) * batch_2 + ...) + i_n-1`.
+ */
+class SEALBenchmark : public hebench::cpp::BaseBenchmark
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALBenchmark)
+
+public:
+    ~SEALBenchmark() override;
+
+    hebench::APIBridge::Handle encode(const hebench::APIBridge::PackedData *p_parameters) override;
+    void decode(hebench::APIBridge::Handle encoded_data, hebench::APIBridge::PackedData *p_native) override;
+    hebench::APIBridge::Handle encrypt(hebench::APIBridge::Handle encoded_data) override;
+    hebench::APIBridge::Handle decrypt(hebench::APIBridge::Handle encrypted_data) override;
+
+    hebench::APIBridge::Handle load(const hebench::APIBridge::Handle *p_local_data, std::uint64_t count) override;
+    void store(hebench::APIBridge::Handle remote_data,
+               hebench::APIBridge::Handle *p_local_data, std::uint64_t count) override;
+
+    hebench::APIBridge::Handle operate(hebench::APIBridge::Handle h_remote_packed,
+                                       const hebench::APIBridge::ParameterIndexer *p_param_indexers) override;
+
+protected:
+    /**
+     * @param[in] params_count Number of parameters for the operation.
+     */
+    SEALBenchmark(SEALEngine &engine,
+                  const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                  const hebench::APIBridge::WorkloadParams &bench_params,
+                  std::uint64_t params_count);
+
+    SEALEngine &engine() const { return m_engine; }
+    const SEALContextWrapper &context() const { return *m_context; }
+    /**
+     * @brief Creates the HE context for the benchmark. Must be called by the
+     * constructor of derived classes.
+     */
+    void initContext(const SEALBenchmarkDescription &description, const std::vector<int> &rotation_steps);
+
+    /**
+     * @brief Encodes a sample of an operation parameter.
+     * @param[in] param_position Operation parameter of the sample.
+     * @param[in] values Native values of the sample.
+     */
+    virtual SEALSample encodeSample(std::uint64_t param_position, const std::vector<double> &values) const = 0;
+    /**
+     * @brief Decodes a decrypted result sample into \p values.
+     */
+    virtual void decodeResult(const SEALSample &result, std::vector<double> &values) const = 0;
+    /**
+     * @brief Computes the operation on one sample per operation parameter.
+     * @param[in] args Sample for each operation parameter, in order.
+     * @returns Encrypted result sample.
+     */
+    virtual SEALSample operateSample(const std::vector<const SEALSample *> &args) const = 0;
+
+private:
+    // used to bundle a collection of operation parameters
+    struct InternalParams
+    {
+    public:
+        static constexpr std::int64_t tagPlaintext  = 0x10;
+        static constexpr std::int64_t tagCiphertext = 0x20;
+        static constexpr std::int64_t tagResult     = 0x40;
+
+        std::vector<std::shared_ptr<SEALSample>> samples;
+        std::int64_t tag;
+        std::uint64_t param_position;
+    };
+
+    SEALEngine &m_engine;
+    std::unique_ptr<SEALContextWrapper> m_context;
+    std::uint64_t m_params_count;
+    std::uint32_t m_cipher_param_mask;
+};
@@ -0,0 +1,96 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "hebench/api_bridge/cpp/hebench.hpp"
+#include <seal/seal.h>
+
+/**
+ * @brief CKKS context, keys and SEAL objects used by a benchmark.
+ * @details Encoder, encryptor, evaluator and decryptor are used concurrently
+ * from the engine threads: SEAL allows this as long as the keys are not
+ * modified and each thread writes to its own ciphertexts.
+ *
+ * Every rescale sets the scale of the result back to the initial scale. The
+ * error introduced is negligible because coefficient moduli are chosen close
+ * to the scale, and it keeps all ciphertexts at the same scale, so operands
+ * only need their levels matched.
+ */
+class SEALContextWrapper
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALContextWrapper)
+
+public:
+    /**
+     * @param[in] poly_modulus_degree Polynomial modulus degree.
+     * @param[in] coeff_modulus_bits Bit sizes of the coefficient moduli.
+     * @param[in] scale_exponent Scale is 2^scale_exponent.
+     * @param[in] rotation_steps Steps for which to generate Galois keys. No
+     * Galois keys are generated if empty.
+     */
+    SEALContextWrapper(std::size_t poly_modulus_degree,
+                       const std::vector<int> &coeff_modulus_bits,
+                       int scale_exponent,
+                       const std::vector<int> &rotation_steps);
+
+    const std::shared_ptr<seal::SEALContext> &context() const { return m_context; }
+    seal::CKKSEncoder &encoder() const { return *m_ckks_encoder; }
+    seal::Encryptor &encryptor() const { return *m_encryptor; }
+    seal::Evaluator &evaluator() const { return *m_evaluator; }
+    seal::Decryptor &decryptor() const { return *m_decryptor; }
+    double scale() const { return m_scale; }
+    std::size_t slotCount() const { return m_ckks_encoder->slot_count(); }
+
+    seal::Plaintext encodeVector(const std::vector<double> &values) const;
+    /**
+     * @brief Encodes \p value in all slots, at the level of \p ct.
+     */
+    seal::Plaintext encodeConstant(double value, const seal::Ciphertext &ct) const;
+    /**
+     * @brief Lowers the operand with the most levels left to the level of the other.
+     */
+    void matchLevels(seal::Ciphertext &a, seal::Ciphertext &b) const;
+    /**
+     * @brief a = a * b, relinearized and rescaled.
+     */
+    void multiplyRescale(seal::Ciphertext &a, seal::Ciphertext b) const;
+    /**
+     * @brief ct = ct * plain, rescaled. \p plain must be at the level of \p ct.
+     */
+    void multiplyPlainRescale(seal::Ciphertext &ct, const seal::Plaintext &plain) const;
+    /**
+     * @brief a = a + b.
+     */
+    void add(seal::Ciphertext &a, seal::Ciphertext b) const;
+    /**
+     * @brief Adds every block of \p block_size slots into the first slot of the block.
+     * @details \p block_size must be a power of 2 with rotation keys for all
+     * powers of 2 below it. Other slots are left with partial sums.
+     */
+    void sumBlocks(seal::Ciphertext &ct, std::size_t block_size) const;
+
+    /**
+     * @brief Rotation steps needed to sum blocks of \p block_size slots.
+     */
+    static std::vector<int> getSumBlocksSteps(std::size_t block_size);
+    static std::size_t nextPowerOf2(std::size_t value);
+
+private:
+    std::shared_ptr<seal::SEALContext> m_context;
+    std::unique_ptr<seal::KeyGenerator> m_keygen;
+    std::unique_ptr<seal::PublicKey> m_public_key;
+    std::unique_ptr<seal::SecretKey> m_secret_key;
+    std::unique_ptr<seal::RelinKeys> m_relin_keys;
+    std::unique_ptr<seal::GaloisKeys> m_galois_keys;
+    std::unique_ptr<seal::Encryptor> m_encryptor;
+    std::unique_ptr<seal::Evaluator> m_evaluator;
+    std::unique_ptr<seal::Decryptor> m_decryptor;
+    std::unique_ptr<seal::CKKSEncoder> m_ckks_encoder;
+    double m_scale;
+};
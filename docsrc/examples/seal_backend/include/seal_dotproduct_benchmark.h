@@ -0,0 +1,57 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "seal_benchmark.h"
+
+/**
+ * @brief DotProduct with both operands encrypted.
+ * @details Each vector is encoded in the slots of a single plaintext. The
+ * element-wise product is added into the first slot with log2(n) rotations.
+ */
+class SEALDotProductBenchmarkDescription : public SEALBenchmarkDescription
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALDotProductBenchmarkDescription)
+
+public:
+    static constexpr std::uint64_t NumWorkloadParams = 1;
+
+    // HE specific parameters: a single multiplicative level
+    static constexpr std::size_t PolyModulusDegree = 8192;
+    static constexpr int ScaleExponent             = 40;
+
+    SEALDotProductBenchmarkDescription(hebench::APIBridge::Category category, std::size_t thread_count);
+    ~SEALDotProductBenchmarkDescription() override;
+
+    hebench::cpp::BaseBenchmark *createBenchmark(hebench::cpp::BaseEngine &engine,
+                                                 const hebench::APIBridge::WorkloadParams *p_params) override;
+};
+
+class SEALDotProductBenchmark : public SEALBenchmark
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALDotProductBenchmark)
+
+public:
+    static constexpr std::int64_t tag = 0x2;
+
+    SEALDotProductBenchmark(SEALEngine &engine,
+                            const SEALDotProductBenchmarkDescription &description,
+                            const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                            const hebench::APIBridge::WorkloadParams &bench_params);
+    ~SEALDotProductBenchmark() override;
+
+    std::int64_t classTag() const override { return BaseBenchmark::classTag() | SEALDotProductBenchmark::tag; }
+
+protected:
+    SEALSample encodeSample(std::uint64_t param_position, const std::vector<double> &values) const override;
+    void decodeResult(const SEALSample &result, std::vector<double> &values) const override;
+    SEALSample operateSample(const std::vector<const SEALSample *> &args) const override;
+
+private:
+    static constexpr std::uint64_t ParametersCount = 2; // number of parameters for this operation
+
+    std::size_t m_block_size; // n rounded up to a power of 2
+};
@@ -0,0 +1,62 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "seal_benchmark.h"
+
+/**
+ * @brief EltwiseAdd and EltwiseMultiply with both operands encrypted.
+ * @details Each vector is encoded in the slots of a single plaintext.
+ */
+class SEALEltwiseBenchmarkDescription : public SEALBenchmarkDescription
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALEltwiseBenchmarkDescription)
+
+public:
+    static constexpr std::uint64_t NumWorkloadParams = 1;
+
+    // HE specific parameters: a single multiplicative level
+    static constexpr std::size_t PolyModulusDegree = 8192;
+    static constexpr int ScaleExponent             = 40;
+
+    /**
+     * @param[in] workload EltwiseAdd or EltwiseMultiply.
+     */
+    SEALEltwiseBenchmarkDescription(hebench::APIBridge::Workload workload,
+                                    hebench::APIBridge::Category category,
+                                    std::size_t thread_count);
+    ~SEALEltwiseBenchmarkDescription() override;
+
+    hebench::cpp::BaseBenchmark *createBenchmark(hebench::cpp::BaseEngine &engine,
+                                                 const hebench::APIBridge::WorkloadParams *p_params) override;
+};
+
+class SEALEltwiseBenchmark : public SEALBenchmark
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALEltwiseBenchmark)
+
+public:
+    static constexpr std::int64_t tag = 0x1;
+
+    SEALEltwiseBenchmark(SEALEngine &engine,
+                         const SEALEltwiseBenchmarkDescription &description,
+                         const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                         const hebench::APIBridge::WorkloadParams &bench_params);
+    ~SEALEltwiseBenchmark() override;
+
+    std::int64_t classTag() const override { return BaseBenchmark::classTag() | SEALEltwiseBenchmark::tag; }
+
+protected:
+    SEALSample encodeSample(std::uint64_t param_position, const std::vector<double> &values) const override;
+    void decodeResult(const SEALSample &result, std::vector<double> &values) const override;
+    SEALSample operateSample(const std::vector<const SEALSample *> &args) const override;
+
+private:
+    static constexpr std::uint64_t ParametersCount = 2; // number of parameters for this operation
+
+    bool m_b_multiply;
+    std::uint64_t m_n;
+};
@@ -0,0 +1,62 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "hebench/api_bridge/cpp/hebench.hpp"
+
+#define SEAL_BACKEND_HE_SECURITY_128 1
+
+/**
+ * @brief Engine of the multithreaded SEAL example backend.
+ * @details Registers all workloads in both Latency and Offline categories. HE
+ * contexts are owned by each benchmark because encryption parameters and
+ * rotation keys depend on the workload parameters.
+ *
+ * The number of threads used to encode, encrypt, decrypt, decode and operate
+ * on batches is read from the environment variable named by `ThreadCountEnvVar`
+ * during engine initialization. If not set, or set to 0, all hardware threads
+ * are used. Worker threads are started once during initialization and wait
+ * for work between calls.
+ */
+class SEALEngine : public hebench::cpp::BaseEngine
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALEngine)
+
+public:
+    static constexpr const char *ThreadCountEnvVar = "HEBENCH_SEAL_THREADS";
+
+    static SEALEngine *create();
+    static void destroy(SEALEngine *p);
+
+    ~SEALEngine() override;
+
+    std::size_t threadCount() const { return m_thread_count; }
+    /**
+     * @brief Calls `func(i)` for every `i` in range [0, count), distributing
+     * the calls among the engine threads.
+     * @details The calling thread participates. If any call throws, the first
+     * exception caught is rethrown once all threads are done. Calls nested
+     * inside another parallelFor() run sequentially in the calling thread, so
+     * a batch is split among threads, and a single sample uses all threads.
+     * A call made while the engine threads are busy with a call from another
+     * thread also runs sequentially.
+     */
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)> &func) const;
+
+protected:
+    SEALEngine();
+
+    void init() override;
+
+private:
+    class WorkerPool;
+
+    std::size_t m_thread_count;
+    std::unique_ptr<WorkerPool> m_p_pool; // engine threads other than the caller
+};
@@ -0,0 +1,6 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#define SEAL_BACKEND_ECODE_SEAL_ERROR 2
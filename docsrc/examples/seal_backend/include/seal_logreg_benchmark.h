@@ -0,0 +1,85 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include "seal_benchmark.h"
+
+/**
+ * @brief LogisticRegression inference with polynomial sigmoid approximations
+ * of degree 3, 5 and 7, with plaintext model and encrypted input.
+ * @details Weights W are encoded in the slots of a plaintext. The linear
+ * regression is the product of W and the input, added into the first slot with
+ * log2(n) rotations, plus the bias. The odd terms of the sigmoid polynomial
+ * are computed independently, in parallel when there is a single result, as
+ * `c_k * x * (x^2)^((k - 1) / 2)`, using at most 5 multiplicative levels for
+ * degree 7.
+ */
+class SEALLogRegBenchmarkDescription : public SEALBenchmarkDescription
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALLogRegBenchmarkDescription)
+
+public:
+    static constexpr std::uint64_t NumWorkloadParams = 1;
+
+    // HE specific parameters: 6 multiplicative levels
+    static constexpr std::size_t PolyModulusDegree   = 16384;
+    static constexpr std::size_t MultiplicativeDepth = 6;
+    static constexpr int ScaleExponent               = 40;
+
+    /**
+     * @param[in] workload LogisticRegression_PolyD3, LogisticRegression_PolyD5
+     * or LogisticRegression_PolyD7.
+     */
+    SEALLogRegBenchmarkDescription(hebench::APIBridge::Workload workload,
+                                   hebench::APIBridge::Category category,
+                                   std::size_t thread_count);
+    ~SEALLogRegBenchmarkDescription() override;
+
+    hebench::cpp::BaseBenchmark *createBenchmark(hebench::cpp::BaseEngine &engine,
+                                                 const hebench::APIBridge::WorkloadParams *p_params) override;
+
+    /**
+     * @brief Coefficients of the sigmoid approximation for the workload, from
+     * degree 0 upwards, as used by the test harness.
+     */
+    static std::vector<double> getSigmoidCoefficients(hebench::APIBridge::Workload workload);
+
+private:
+    static std::vector<int> getCoeffModulusBits();
+};
+
+class SEALLogRegBenchmark : public SEALBenchmark
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALLogRegBenchmark)
+
+public:
+    static constexpr std::int64_t tag = 0x8;
+
+    SEALLogRegBenchmark(SEALEngine &engine,
+                        const SEALLogRegBenchmarkDescription &description,
+                        const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                        const hebench::APIBridge::WorkloadParams &bench_params);
+    ~SEALLogRegBenchmark() override;
+
+    std::int64_t classTag() const override { return BaseBenchmark::classTag() | SEALLogRegBenchmark::tag; }
+
+protected:
+    SEALSample encodeSample(std::uint64_t param_position, const std::vector<double> &values) const override;
+    void decodeResult(const SEALSample &result, std::vector<double> &values) const override;
+    SEALSample operateSample(const std::vector<const SEALSample *> &args) const override;
+
+private:
+    static constexpr std::uint64_t ParametersCount = 3; // number of parameters for this operation
+    // positions of the operation parameters
+    static constexpr std::uint64_t Index_W = 0;
+    static constexpr std::uint64_t Index_b = 1;
+    static constexpr std::uint64_t Index_X = 2;
+
+    std::vector<double> m_coefficients;
+    std::size_t m_block_size; // n rounded up to a power of 2
+};
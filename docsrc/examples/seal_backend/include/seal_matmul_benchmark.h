@@ -0,0 +1,66 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "seal_benchmark.h"
+
+/**
+ * @brief MatrixMultiply with both operands encrypted.
+ * @details With `M = M0 x M1`, M0 `m x n` and M1 `n x p`, slots are split into
+ * `p` blocks of `s` slots, where `s` is `n` rounded up to a power of 2:
+ * - M1 is encoded in a single plaintext: block `j` holds column `j`.
+ * - Each row of M0 is encoded in a plaintext, replicated in all `p` blocks.
+ *
+ * Row `i` of the result is the product of row `i` of M0 and M1, with every
+ * block added into its first slot with log2(s) rotations: slot `j * s` holds
+ * `M[i][j]`. Rows are computed in parallel when there is a single result.
+ */
+class SEALMatMulBenchmarkDescription : public SEALBenchmarkDescription
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALMatMulBenchmarkDescription)
+
+public:
+    static constexpr std::uint64_t NumWorkloadParams = 3;
+
+    // HE specific parameters: a single multiplicative level
+    static constexpr std::size_t PolyModulusDegree = 8192;
+    static constexpr int ScaleExponent             = 40;
+
+    SEALMatMulBenchmarkDescription(hebench::APIBridge::Category category, std::size_t thread_count);
+    ~SEALMatMulBenchmarkDescription() override;
+
+    hebench::cpp::BaseBenchmark *createBenchmark(hebench::cpp::BaseEngine &engine,
+                                                 const hebench::APIBridge::WorkloadParams *p_params) override;
+};
+
+class SEALMatMulBenchmark : public SEALBenchmark
+{
+public:
+    HEBERROR_DECLARE_CLASS_NAME(SEALMatMulBenchmark)
+
+public:
+    static constexpr std::int64_t tag = 0x4;
+
+    SEALMatMulBenchmark(SEALEngine &engine,
+                        const SEALMatMulBenchmarkDescription &description,
+                        const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                        const hebench::APIBridge::WorkloadParams &bench_params);
+    ~SEALMatMulBenchmark() override;
+
+    std::int64_t classTag() const override { return BaseBenchmark::classTag() | SEALMatMulBenchmark::tag; }
+
+protected:
+    SEALSample encodeSample(std::uint64_t param_position, const std::vector<double> &values) const override;
+    void decodeResult(const SEALSample &result, std::vector<double> &values) const override;
+    SEALSample operateSample(const std::vector<const SEALSample *> &args) const override;
+
+private:
+    static constexpr std::uint64_t ParametersCount = 2; // number of parameters for this operation
+
+    std::uint64_t m_rows_m0;
+    std::uint64_t m_cols_m0;
+    std::uint64_t m_cols_m1;
+    std::size_t m_block_size; // cols_m0 rounded up to a power of 2
+};
@@ -0,0 +1,414 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#include "seal_benchmark.h"
+#include "seal_engine.h"
+#include "seal_error.h"
+
+//--------------------------------
+// class SEALBenchmarkDescription
+//--------------------------------
+
+SEALBenchmarkDescription::SEALBenchmarkDescription(hebench::APIBridge::Workload workload,
+                                                   hebench::APIBridge::Category category,
+                                                   std::uint32_t cipher_param_mask,
+                                                   std::size_t poly_modulus_degree,
+                                                   const std::vector<int> &coeff_modulus_bits,
+                                                   int scale_exponent,
+                                                   std::size_t thread_count) :
+    m_poly_modulus_degree(poly_modulus_degree),
+    m_coeff_modulus_bits(coeff_modulus_bits),
+    m_scale_exponent(scale_exponent),
+    m_thread_count(thread_count)
+{
+    std::memset(&m_descriptor, 0, sizeof(hebench::APIBridge::BenchmarkDescriptor));
+    m_descriptor.workload  = workload;
+    m_descriptor.data_type = hebench::APIBridge::DataType::Float64;
+    m_descriptor.category  = category;
+    if (category == hebench::APIBridge::Category::Latency)
+    {
+        m_descriptor.cat_params.latency.min_test_time_ms        = 0; // use harness default
+        m_descriptor.cat_params.latency.warmup_iterations_count = 1;
+    } // end if
+    // else, offline: all data_count = 0 to accept the batch sizes from the harness
+    m_descriptor.cipher_param_mask = cipher_param_mask;
+    m_descriptor.scheme            = HEBENCH_HE_SCHEME_CKKS;
+    m_descriptor.security          = SEAL_BACKEND_HE_SECURITY_128;
+    m_descriptor.other             = 0;
+}
+
+SEALBenchmarkDescription::~SEALBenchmarkDescription()
+{
+}
+
+std::string SEALBenchmarkDescription::getBenchmarkDescription(const hebench::APIBridge::WorkloadParams *p_w_params) const
+{
+    std::stringstream ss;
+    ss << BenchmarkDescription::getBenchmarkDescription(p_w_params);
+    ss << ", Encryption parameters" << std::endl
+       << ", , HE Library, Microsoft SEAL 3.5" << std::endl
+       << ", , Poly modulus degree, " << m_poly_modulus_degree << std::endl
+       << ", , Coefficient Moduli";
+    for (int bits : m_coeff_modulus_bits)
+        ss << ", " << bits;
+    ss << std::endl
+       << ", , Scale, 2^" << m_scale_exponent << std::endl
+       << ", Threads, " << m_thread_count;
+    if (p_w_params)
+    {
+        ss << std::endl
+           << ", Workload parameters";
+        for (std::uint64_t param_i = 0; param_i < p_w_params->count; ++param_i)
+            ss << std::endl
+               << ", , " << p_w_params->params[param_i].name << ", " << p_w_params->params[param_i].u_param;
+    } // end if
+    return ss.str();
+}
+
+void SEALBenchmarkDescription::destroyBenchmark(hebench::cpp::BaseBenchmark *p_bench)
+{
+    if (p_bench)
+    {
+        SEALBenchmark *p_tmp = dynamic_cast<SEALBenchmark *>(p_bench);
+        delete p_tmp;
+    } // end if
+}
+
+//---------------------
+// class SEALBenchmark
+//---------------------
+
+SEALBenchmark::SEALBenchmark(SEALEngine &engine,
+                             const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                             const hebench::APIBridge::WorkloadParams &bench_params,
+                             std::uint64_t params_count) :
+    hebench::cpp::BaseBenchmark(engine, bench_desc, bench_params),
+    m_engine(engine),
+    m_params_count(params_count),
+    m_cipher_param_mask(bench_desc.cipher_param_mask)
+{
+}
+
+SEALBenchmark::~SEALBenchmark()
+{
+}
+
+void SEALBenchmark::initContext(const SEALBenchmarkDescription &description, const std::vector<int> &rotation_steps)
+{
+    m_context = std::make_unique<SEALContextWrapper>(description.polyModulusDegree(),
+                                                     description.coeffModulusBits(),
+                                                     description.scaleExponent(),
+                                                     rotation_steps);
+}
+
+hebench::APIBridge::Handle SEALBenchmark::encode(const hebench::APIBridge::PackedData *p_parameters)
+{
+    assert(p_parameters && p_parameters->pack_count > 0 && p_parameters->p_data_packs);
+
+    std::vector<InternalParams> params(p_parameters->pack_count);
+    // (datapack, sample) of every sample to encode
+    std::vector<std::pair<std::size_t, std::uint64_t>> samples;
+    for (std::size_t datapack_i = 0; datapack_i < p_parameters->pack_count; ++datapack_i)
+    {
+        const hebench::APIBridge::DataPack &datapack = p_parameters->p_data_packs[datapack_i];
+        assert(datapack.buffer_count > 0 && datapack.p_buffers);
+        if (datapack.param_position >= m_params_count)
+            throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid operation parameter position: "
+                                                                + std::to_string(datapack.param_position) + "."),
+                                             HEBENCH_ECODE_INVALID_ARGS);
+
+        params[datapack_i].samples.resize(datapack.buffer_count);
+        params[datapack_i].param_position = datapack.param_position;
+        params[datapack_i].tag            = InternalParams::tagPlaintext;
+        for (std::uint64_t sample_i = 0; sample_i < datapack.buffer_count; ++sample_i)
+            samples.emplace_back(datapack_i, sample_i);
+    } // end for
+
+    m_engine.parallelFor(samples.size(), [&](std::size_t i) {
+        const hebench::APIBridge::DataPack &datapack              = p_parameters->p_data_packs[samples[i].first];
+        const hebench::APIBridge::NativeDataBuffer &sample_buffer = datapack.p_buffers[samples[i].second];
+        assert(sample_buffer.p && sample_buffer.size / sizeof(double) > 0);
+        const double *p_values = reinterpret_cast<const double *>(sample_buffer.p);
+        std::vector<double> values(p_values, p_values + sample_buffer.size / sizeof(double));
+        params[samples[i].first].samples[samples[i].second] =
+            std::make_shared<SEALSample>(encodeSample(datapack.param_position, values));
+    });
+
+    return m_engine.template createHandle<decltype(params)>(sizeof(seal::Plaintext) * samples.size(),
+                                                           InternalParams::tagPlaintext,
+                                                           std::move(params));
+}
+
+void SEALBenchmark::decode(hebench::APIBridge::Handle h_encoded_data, hebench::APIBridge::PackedData *p_native)
+{
+    assert(p_native && p_native->p_data_packs && p_native->pack_count > 0);
+
+    const std::vector<InternalParams> &encoded =
+        m_engine.template retrieveFromHandle<std::vector<InternalParams>>(h_encoded_data);
+
+    // (native datapack, encoded datapack, sample) of every sample to decode
+    std::vector<std::tuple<hebench::APIBridge::DataPack *, const InternalParams *, std::uint64_t>> samples;
+    for (std::size_t datapack_i = 0; datapack_i < p_native->pack_count; ++datapack_i)
+    {
+        hebench::APIBridge::DataPack *p_native_datapack = &p_native->p_data_packs[datapack_i];
+
+        const InternalParams *p_encoded_datapack = nullptr;
+        for (std::size_t encoded_i = 0; !p_encoded_datapack && encoded_i < encoded.size(); ++encoded_i)
+            if (encoded[encoded_i].param_position == p_native_datapack->param_position)
+                p_encoded_datapack = &encoded[encoded_i];
+
+        if (p_encoded_datapack)
+        {
+            // only results are ever decoded: operation parameters may not be decodable
+            // back into their native layout
+            if ((p_encoded_datapack->tag & (InternalParams::tagPlaintext | InternalParams::tagResult))
+                != (InternalParams::tagPlaintext | InternalParams::tagResult))
+                throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected for handle 'h_encoded_data'. Only decrypted results can be decoded."),
+                                                 HEBENCH_ECODE_INVALID_ARGS);
+
+            std::uint64_t min_sample_count = std::min(p_native_datapack->buffer_count, p_encoded_datapack->samples.size());
+            for (std::uint64_t sample_i = 0; sample_i < min_sample_count; ++sample_i)
+                samples.emplace_back(p_native_datapack, p_encoded_datapack, sample_i);
+        } // end if
+    } // end for
+
+    m_engine.parallelFor(samples.size(), [&](std::size_t i) {
+        hebench::APIBridge::DataPack *p_native_datapack     = std::get<0>(samples[i]);
+        const InternalParams *p_encoded_datapack            = std::get<1>(samples[i]);
+        std::uint64_t sample_i                              = std::get<2>(samples[i]);
+        hebench::APIBridge::NativeDataBuffer &native_sample = p_native_datapack->p_buffers[sample_i];
+
+        std::vector<double> decoded;
+        decodeResult(*p_encoded_datapack->samples[sample_i], decoded);
+        std::copy_n(decoded.begin(),
+                    std::min(decoded.size(), native_sample.size / sizeof(double)),
+                    reinterpret_cast<double *>(native_sample.p));
+    });
+}
+
+hebench::APIBridge::Handle SEALBenchmark::encrypt(hebench::APIBridge::Handle h_encoded_parameters)
+{
+    if ((h_encoded_parameters.tag & InternalParams::tagPlaintext) != InternalParams::tagPlaintext)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected for handle 'h_encoded_parameters'."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+
+    const std::vector<InternalParams> &encoded_parameters =
+        m_engine.template retrieveFromHandle<std::vector<InternalParams>>(h_encoded_parameters);
+
+    std::vector<InternalParams> encrypted_parameters(encoded_parameters.size());
+    std::vector<std::pair<std::size_t, std::size_t>> samples;
+    for (std::size_t datapack_i = 0; datapack_i < encoded_parameters.size(); ++datapack_i)
+    {
+        if ((encoded_parameters[datapack_i].tag & InternalParams::tagPlaintext) != InternalParams::tagPlaintext)
+            throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected in data pack."),
+                                             HEBENCH_ECODE_INVALID_ARGS);
+
+        encrypted_parameters[datapack_i].param_position = encoded_parameters[datapack_i].param_position;
+        encrypted_parameters[datapack_i].tag            = InternalParams::tagCiphertext;
+        encrypted_parameters[datapack_i].samples.resize(encoded_parameters[datapack_i].samples.size());
+        for (std::size_t sample_i = 0; sample_i < encoded_parameters[datapack_i].samples.size(); ++sample_i)
+            samples.emplace_back(datapack_i, sample_i);
+    } // end for
+
+    m_engine.parallelFor(samples.size(), [&](std::size_t i) {
+        const SEALSample &encoded_sample               = *encoded_parameters[samples[i].first].samples[samples[i].second];
+        std::shared_ptr<SEALSample> p_encrypted_sample = std::make_shared<SEALSample>();
+        p_encrypted_sample->cipher.resize(encoded_sample.plain.size());
+        m_engine.parallelFor(encoded_sample.plain.size(), [&](std::size_t plain_i) {
+            m_context->encryptor().encrypt(encoded_sample.plain[plain_i], p_encrypted_sample->cipher[plain_i]);
+        });
+        encrypted_parameters[samples[i].first].samples[samples[i].second] = std::move(p_encrypted_sample);
+    });
+
+    return m_engine.template createHandle<decltype(encrypted_parameters)>(encrypted_parameters.size(),
+                                                                          InternalParams::tagCiphertext,
+                                                                          std::move(encrypted_parameters));
+}
+
+hebench::APIBridge::Handle SEALBenchmark::decrypt(hebench::APIBridge::Handle h_encrypted_data)
+{
+    if ((h_encrypted_data.tag & InternalParams::tagCiphertext) != InternalParams::tagCiphertext)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected for handle 'h_encrypted_data'."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+
+    const std::vector<InternalParams> &encrypted_data =
+        m_engine.template retrieveFromHandle<std::vector<InternalParams>>(h_encrypted_data);
+
+    std::vector<InternalParams> plaintext_data(encrypted_data.size());
+    std::vector<std::pair<std::size_t, std::size_t>> samples;
+    for (std::size_t datapack_i = 0; datapack_i < encrypted_data.size(); ++datapack_i)
+    {
+        if ((encrypted_data[datapack_i].tag & InternalParams::tagCiphertext) != InternalParams::tagCiphertext)
+            throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected in data pack."),
+                                             HEBENCH_ECODE_INVALID_ARGS);
+
+        plaintext_data[datapack_i].param_position = encrypted_data[datapack_i].param_position;
+        plaintext_data[datapack_i].tag            = InternalParams::tagPlaintext
+                                         | (encrypted_data[datapack_i].tag & InternalParams::tagResult);
+        plaintext_data[datapack_i].samples.resize(encrypted_data[datapack_i].samples.size());
+        for (std::size_t sample_i = 0; sample_i < encrypted_data[datapack_i].samples.size(); ++sample_i)
+            samples.emplace_back(datapack_i, sample_i);
+    } // end for
+
+    m_engine.parallelFor(samples.size(), [&](std::size_t i) {
+        const SEALSample &encrypted_sample             = *encrypted_data[samples[i].first].samples[samples[i].second];
+        std::shared_ptr<SEALSample> p_decrypted_sample = std::make_shared<SEALSample>();
+        p_decrypted_sample->plain.resize(encrypted_sample.cipher.size());
+        m_engine.parallelFor(encrypted_sample.cipher.size(), [&](std::size_t cipher_i) {
+            m_context->decryptor().decrypt(encrypted_sample.cipher[cipher_i], p_decrypted_sample->plain[cipher_i]);
+        });
+        plaintext_data[samples[i].first].samples[samples[i].second] = std::move(p_decrypted_sample);
+    });
+
+    return m_engine.template createHandle<decltype(plaintext_data)>(plaintext_data.size(),
+                                                                    InternalParams::tagPlaintext,
+                                                                    std::move(plaintext_data));
+}
+
+hebench::APIBridge::Handle SEALBenchmark::load(const hebench::APIBridge::Handle *p_local_data, uint64_t count)
+{
+    std::vector<InternalParams> loaded_data;
+
+    for (std::size_t handle_i = 0; handle_i < count; ++handle_i)
+    {
+        const hebench::APIBridge::Handle &handle = p_local_data[handle_i];
+        const std::vector<InternalParams> &params =
+            m_engine.template retrieveFromHandle<std::vector<InternalParams>>(handle);
+        loaded_data.insert(loaded_data.end(), params.begin(), params.end());
+    } // end for
+
+    return m_engine.template createHandle<decltype(loaded_data)>(loaded_data.size(),
+                                                                InternalParams::tagCiphertext | InternalParams::tagPlaintext,
+                                                                std::move(loaded_data));
+}
+
+void SEALBenchmark::store(hebench::APIBridge::Handle h_remote_data,
+                          hebench::APIBridge::Handle *p_local_data, std::uint64_t count)
+{
+    if (count > 0 && !p_local_data)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid null array of handles: \"p_local_data\""),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+
+    if (count > 0)
+    {
+        std::vector<InternalParams> plain_data;
+        std::vector<InternalParams> encrypted_data;
+        const std::vector<InternalParams> &remote_data =
+            m_engine.template retrieveFromHandle<std::vector<InternalParams>>(h_remote_data);
+
+        for (const auto &internal_params : remote_data)
+        {
+            if ((internal_params.tag & InternalParams::tagCiphertext) == InternalParams::tagCiphertext)
+                encrypted_data.push_back(internal_params);
+            else if ((internal_params.tag & InternalParams::tagPlaintext) == InternalParams::tagPlaintext)
+                plain_data.push_back(internal_params);
+            else
+                throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Unknown tag detected in data pack"),
+                                                 HEBENCH_ECODE_INVALID_ARGS);
+        } // end for
+
+        // first handle holds ciphertexts, second handle holds plaintexts
+        if (!encrypted_data.empty())
+            p_local_data[0] = m_engine.template createHandle<decltype(encrypted_data)>(encrypted_data.size(),
+                                                                                      InternalParams::tagCiphertext,
+                                                                                      std::move(encrypted_data));
+        if (!plain_data.empty())
+        {
+            hebench::APIBridge::Handle *p_h_plain = nullptr;
+            if (encrypted_data.empty())
+                p_h_plain = &p_local_data[0];
+            else if (count > 1)
+                p_h_plain = &p_local_data[1];
+
+            if (p_h_plain)
+                *p_h_plain = m_engine.template createHandle<decltype(plain_data)>(plain_data.size(),
+                                                                                 InternalParams::tagPlaintext,
+                                                                                 std::move(plain_data));
+        } // end if
+    } // end if
+
+    // pad any extra local handles
+    for (std::uint64_t i = 2; i < count; ++i)
+        std::memset(p_local_data + i, 0, sizeof(hebench::APIBridge::Handle));
+}
+
+hebench::APIBridge::Handle SEALBenchmark::operate(hebench::APIBridge::Handle h_remote_packed,
+                                                  const hebench::APIBridge::ParameterIndexer *p_param_indexers)
+{
+    if ((h_remote_packed.tag & (InternalParams::tagCiphertext | InternalParams::tagPlaintext)) != (InternalParams::tagCiphertext | InternalParams::tagPlaintext))
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected for handle 'h_remote_packed'."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+    const std::vector<InternalParams> &loaded_data =
+        m_engine.template retrieveFromHandle<std::vector<InternalParams>>(h_remote_packed);
+
+    // find the samples of each operation parameter, encrypted as the descriptor specifies
+    std::vector<const std::vector<std::shared_ptr<SEALSample>> *> p_params(m_params_count, nullptr);
+    for (std::size_t i = 0; i < loaded_data.size(); ++i)
+    {
+        std::uint64_t param_position = loaded_data[i].param_position;
+        std::int64_t expected_tag    = ((m_cipher_param_mask >> param_position) & 1) != 0 ?
+                                           InternalParams::tagCiphertext :
+                                           InternalParams::tagPlaintext;
+        if (param_position < m_params_count
+            && (loaded_data[i].tag & expected_tag) == expected_tag)
+            p_params[param_position] = &loaded_data[i].samples;
+    } // end for
+
+    std::uint64_t results_count = 1;
+    for (std::size_t param_i = 0; param_i < m_params_count; ++param_i)
+    {
+        if (!p_params[param_i])
+        {
+            std::stringstream ss;
+            ss << "Unable to find operation parameter " << param_i << " loaded.";
+            throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS(ss.str()),
+                                             HEBENCH_ECODE_INVALID_ARGS);
+        } // end if
+        if (p_param_indexers[param_i].value_index >= p_params[param_i]->size())
+        {
+            std::stringstream ss;
+            ss << "Invalid parameter indexer for operation parameter " << param_i << ". Expected index in range [0, "
+               << p_params[param_i]->size() << "), but " << p_param_indexers[param_i].value_index << " received.";
+            throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS(ss.str()),
+                                             HEBENCH_ECODE_INVALID_ARGS);
+        } // end if
+        else if (p_param_indexers[param_i].value_index + p_param_indexers[param_i].batch_size > p_params[param_i]->size())
+        {
+            std::stringstream ss;
+            ss << "Invalid parameter indexer for operation parameter " << param_i << ". Expected batch size in range [1, "
+               << p_params[param_i]->size() - p_param_indexers[param_i].value_index << "], but " << p_param_indexers[param_i].batch_size << " received.";
+            throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS(ss.str()),
+                                             HEBENCH_ECODE_INVALID_ARGS);
+        } // end else if
+        results_count *= p_param_indexers[param_i].batch_size; // count the number of results expected
+    } // end for
+
+    std::vector<InternalParams> results(1); // all workloads have a single result component
+    results.front().samples.resize(results_count);
+    results.front().param_position = 0; // result component
+    results.front().tag            = InternalParams::tagCiphertext | InternalParams::tagResult;
+
+    m_engine.parallelFor(results_count, [&](std::size_t result_i) {
+        // last operation parameter moves fastest
+        std::vector<const SEALSample *> args(m_params_count);
+        std::uint64_t remainder = result_i;
+        for (std::size_t param_i = m_params_count; param_i > 0; --param_i)
+        {
+            const hebench::APIBridge::ParameterIndexer &indexer = p_param_indexers[param_i - 1];
+            args[param_i - 1] = p_params[param_i - 1]->at(indexer.value_index + remainder % indexer.batch_size).get();
+            remainder /= indexer.batch_size;
+        } // end for
+        results.front().samples[result_i] = std::make_shared<SEALSample>(operateSample(args));
+    });
+
+    return m_engine.template createHandle<decltype(results)>(sizeof(seal::Ciphertext) * results_count,
+                                                            InternalParams::tagCiphertext | InternalParams::tagResult,
+                                                            std::move(results));
+}
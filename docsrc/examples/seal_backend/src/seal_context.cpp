@@ -0,0 +1,111 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <utility>
+
+#include "seal_context.h"
+
+SEALContextWrapper::SEALContextWrapper(std::size_t poly_modulus_degree,
+                                       const std::vector<int> &coeff_modulus_bits,
+                                       int scale_exponent,
+                                       const std::vector<int> &rotation_steps)
+{
+    if (coeff_modulus_bits.size() < 2)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid CKKS initialization parameters. There must be, at least, 2 coefficient moduli."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+
+    seal::EncryptionParameters parameters(seal::scheme_type::CKKS);
+    parameters.set_poly_modulus_degree(poly_modulus_degree);
+    parameters.set_coeff_modulus(seal::CoeffModulus::Create(poly_modulus_degree, coeff_modulus_bits));
+    m_context = seal::SEALContext::Create(parameters);
+    m_scale   = std::pow(2.0, scale_exponent);
+
+    m_keygen     = std::unique_ptr<seal::KeyGenerator>(new seal::KeyGenerator(m_context));
+    m_public_key = std::unique_ptr<seal::PublicKey>(new seal::PublicKey(m_keygen->public_key()));
+    m_secret_key = std::unique_ptr<seal::SecretKey>(new seal::SecretKey(m_keygen->secret_key()));
+    m_relin_keys = std::unique_ptr<seal::RelinKeys>(new seal::RelinKeys(m_keygen->relin_keys_local()));
+    // generate only the rotation keys needed: they are the largest keys
+    if (!rotation_steps.empty())
+        m_galois_keys = std::unique_ptr<seal::GaloisKeys>(new seal::GaloisKeys(m_keygen->galois_keys_local(rotation_steps)));
+    m_encryptor    = std::unique_ptr<seal::Encryptor>(new seal::Encryptor(m_context, *m_public_key));
+    m_evaluator    = std::unique_ptr<seal::Evaluator>(new seal::Evaluator(m_context));
+    m_decryptor    = std::unique_ptr<seal::Decryptor>(new seal::Decryptor(m_context, *m_secret_key));
+    m_ckks_encoder = std::unique_ptr<seal::CKKSEncoder>(new seal::CKKSEncoder(m_context));
+}
+
+std::size_t SEALContextWrapper::nextPowerOf2(std::size_t value)
+{
+    std::size_t retval = 1;
+    while (retval < value)
+        retval <<= 1;
+    return retval;
+}
+
+std::vector<int> SEALContextWrapper::getSumBlocksSteps(std::size_t block_size)
+{
+    std::vector<int> retval;
+    for (std::size_t step = 1; step < block_size; step <<= 1)
+        retval.push_back(static_cast<int>(step));
+    return retval;
+}
+
+seal::Plaintext SEALContextWrapper::encodeVector(const std::vector<double> &values) const
+{
+    seal::Plaintext retval;
+    m_ckks_encoder->encode(values, m_scale, retval);
+    return retval;
+}
+
+seal::Plaintext SEALContextWrapper::encodeConstant(double value, const seal::Ciphertext &ct) const
+{
+    seal::Plaintext retval;
+    m_ckks_encoder->encode(value, ct.parms_id(), m_scale, retval);
+    return retval;
+}
+
+void SEALContextWrapper::matchLevels(seal::Ciphertext &a, seal::Ciphertext &b) const
+{
+    std::size_t a_level = m_context->get_context_data(a.parms_id())->chain_index();
+    std::size_t b_level = m_context->get_context_data(b.parms_id())->chain_index();
+    if (a_level > b_level)
+        m_evaluator->mod_switch_to_inplace(a, b.parms_id());
+    else if (b_level > a_level)
+        m_evaluator->mod_switch_to_inplace(b, a.parms_id());
+}
+
+void SEALContextWrapper::multiplyRescale(seal::Ciphertext &a, seal::Ciphertext b) const
+{
+    matchLevels(a, b);
+    m_evaluator->multiply_inplace(a, b);
+    m_evaluator->relinearize_inplace(a, *m_relin_keys);
+    m_evaluator->rescale_to_next_inplace(a);
+    a.scale() = m_scale;
+}
+
+void SEALContextWrapper::multiplyPlainRescale(seal::Ciphertext &ct, const seal::Plaintext &plain) const
+{
+    m_evaluator->multiply_plain_inplace(ct, plain);
+    m_evaluator->rescale_to_next_inplace(ct);
+    ct.scale() = m_scale;
+}
+
+void SEALContextWrapper::add(seal::Ciphertext &a, seal::Ciphertext b) const
+{
+    matchLevels(a, b);
+    m_evaluator->add_inplace(a, b);
+}
+
+void SEALContextWrapper::sumBlocks(seal::Ciphertext &ct, std::size_t block_size) const
+{
+    if (block_size > 1 && !m_galois_keys)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("No rotation keys generated for this context."),
+                                         HEBENCH_ECODE_CRITICAL_ERROR);
+    // after the rotation by step, slot i holds the sum of slots [i, i + 2 * step)
+    for (std::size_t step = 1; step < block_size; step <<= 1)
+    {
+        seal::Ciphertext rotated;
+        m_evaluator->rotate_vector(ct, static_cast<int>(step), *m_galois_keys, rotated);
+        m_evaluator->add_inplace(ct, rotated);
+    } // end for
+}
@@ -0,0 +1,91 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "seal_dotproduct_benchmark.h"
+#include "seal_engine.h"
+#include "seal_error.h"
+
+//------------------------------------------
+// class SEALDotProductBenchmarkDescription
+//------------------------------------------
+
+SEALDotProductBenchmarkDescription::SEALDotProductBenchmarkDescription(hebench::APIBridge::Category category,
+                                                                       std::size_t thread_count) :
+    SEALBenchmarkDescription(hebench::APIBridge::Workload::DotProduct, category,
+                             (1 << 0) | (1 << 1), // all parameters encrypted
+                             PolyModulusDegree, { 60, ScaleExponent, 60 }, ScaleExponent,
+                             thread_count)
+{
+    hebench::cpp::WorkloadParams::DotProduct default_workload_params;
+    default_workload_params.n = 1000;
+    this->addDefaultParameters(default_workload_params);
+}
+
+SEALDotProductBenchmarkDescription::~SEALDotProductBenchmarkDescription()
+{
+}
+
+hebench::cpp::BaseBenchmark *SEALDotProductBenchmarkDescription::createBenchmark(hebench::cpp::BaseEngine &engine,
+                                                                                 const hebench::APIBridge::WorkloadParams *p_params)
+{
+    if (!p_params)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid empty workload parameters. This workload requires flexible parameters."),
+                                         HEBENCH_ECODE_CRITICAL_ERROR);
+
+    SEALEngine &seal_engine = dynamic_cast<SEALEngine &>(engine);
+    return new SEALDotProductBenchmark(seal_engine, *this, m_descriptor, *p_params);
+}
+
+//-------------------------------
+// class SEALDotProductBenchmark
+//-------------------------------
+
+SEALDotProductBenchmark::SEALDotProductBenchmark(SEALEngine &engine,
+                                                 const SEALDotProductBenchmarkDescription &description,
+                                                 const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                                                 const hebench::APIBridge::WorkloadParams &bench_params) :
+    SEALBenchmark(engine, bench_desc, bench_params, ParametersCount)
+{
+    if (bench_params.count < SEALDotProductBenchmarkDescription::NumWorkloadParams)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload parameters. This workload requires "
+                                                            + std::to_string(SEALDotProductBenchmarkDescription::NumWorkloadParams)
+                                                            + " parameters."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+
+    hebench::cpp::WorkloadParams::DotProduct w_params(bench_params);
+    if (w_params.n <= 0 || w_params.n > SEALDotProductBenchmarkDescription::PolyModulusDegree / 2)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload parameters. This workload only supports vectors of size up to "
+                                                            + std::to_string(SEALDotProductBenchmarkDescription::PolyModulusDegree / 2) + "."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+    m_block_size = SEALContextWrapper::nextPowerOf2(w_params.n);
+
+    initContext(description, SEALContextWrapper::getSumBlocksSteps(m_block_size));
+}
+
+SEALDotProductBenchmark::~SEALDotProductBenchmark()
+{
+}
+
+SEALSample SEALDotProductBenchmark::encodeSample(std::uint64_t param_position, const std::vector<double> &values) const
+{
+    (void)param_position;
+    // unused slots are 0, so they do not contribute to the sum
+    SEALSample retval;
+    retval.plain.push_back(context().encodeVector(values));
+    return retval;
+}
+
+void SEALDotProductBenchmark::decodeResult(const SEALSample &result, std::vector<double> &values) const
+{
+    context().encoder().decode(result.plain.front(), values);
+    values.resize(1);
+}
+
+SEALSample SEALDotProductBenchmark::operateSample(const std::vector<const SEALSample *> &args) const
+{
+    SEALSample retval;
+    retval.cipher.push_back(args[0]->cipher.front());
+    context().multiplyRescale(retval.cipher.front(), args[1]->cipher.front());
+    context().sumBlocks(retval.cipher.front(), m_block_size);
+    return retval;
+}
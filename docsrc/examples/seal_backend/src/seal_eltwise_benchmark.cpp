@@ -0,0 +1,107 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "seal_eltwise_benchmark.h"
+#include "seal_engine.h"
+#include "seal_error.h"
+
+//---------------------------------------
+// class SEALEltwiseBenchmarkDescription
+//---------------------------------------
+
+SEALEltwiseBenchmarkDescription::SEALEltwiseBenchmarkDescription(hebench::APIBridge::Workload workload,
+                                                                 hebench::APIBridge::Category category,
+                                                                 std::size_t thread_count) :
+    SEALBenchmarkDescription(workload, category,
+                             (1 << 0) | (1 << 1), // all parameters encrypted
+                             PolyModulusDegree, { 60, ScaleExponent, 60 }, ScaleExponent,
+                             thread_count)
+{
+    if (workload == hebench::APIBridge::Workload::EltwiseAdd)
+    {
+        hebench::cpp::WorkloadParams::EltwiseAdd default_workload_params;
+        default_workload_params.n = 1000;
+        this->addDefaultParameters(default_workload_params);
+    } // end if
+    else if (workload == hebench::APIBridge::Workload::EltwiseMultiply)
+    {
+        hebench::cpp::WorkloadParams::EltwiseMultiply default_workload_params;
+        default_workload_params.n = 1000;
+        this->addDefaultParameters(default_workload_params);
+    } // end else if
+    else
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload. Expected EltwiseAdd or EltwiseMultiply."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+}
+
+SEALEltwiseBenchmarkDescription::~SEALEltwiseBenchmarkDescription()
+{
+}
+
+hebench::cpp::BaseBenchmark *SEALEltwiseBenchmarkDescription::createBenchmark(hebench::cpp::BaseEngine &engine,
+                                                                              const hebench::APIBridge::WorkloadParams *p_params)
+{
+    if (!p_params)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid empty workload parameters. This workload requires flexible parameters."),
+                                         HEBENCH_ECODE_CRITICAL_ERROR);
+
+    SEALEngine &seal_engine = dynamic_cast<SEALEngine &>(engine);
+    return new SEALEltwiseBenchmark(seal_engine, *this, m_descriptor, *p_params);
+}
+
+//----------------------------
+// class SEALEltwiseBenchmark
+//----------------------------
+
+SEALEltwiseBenchmark::SEALEltwiseBenchmark(SEALEngine &engine,
+                                           const SEALEltwiseBenchmarkDescription &description,
+                                           const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                                           const hebench::APIBridge::WorkloadParams &bench_params) :
+    SEALBenchmark(engine, bench_desc, bench_params, ParametersCount),
+    m_b_multiply(bench_desc.workload == hebench::APIBridge::Workload::EltwiseMultiply)
+{
+    if (bench_params.count < SEALEltwiseBenchmarkDescription::NumWorkloadParams)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload parameters. This workload requires "
+                                                            + std::to_string(SEALEltwiseBenchmarkDescription::NumWorkloadParams)
+                                                            + " parameters."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+
+    // EltwiseAdd and EltwiseMultiply share the layout of their workload parameters
+    hebench::cpp::WorkloadParams::EltwiseAdd w_params(bench_params);
+    m_n = w_params.n;
+    if (m_n <= 0 || m_n > SEALEltwiseBenchmarkDescription::PolyModulusDegree / 2)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload parameters. This workload only supports vectors of size up to "
+                                                            + std::to_string(SEALEltwiseBenchmarkDescription::PolyModulusDegree / 2) + "."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+
+    initContext(description, std::vector<int>());
+}
+
+SEALEltwiseBenchmark::~SEALEltwiseBenchmark()
+{
+}
+
+SEALSample SEALEltwiseBenchmark::encodeSample(std::uint64_t param_position, const std::vector<double> &values) const
+{
+    (void)param_position;
+    SEALSample retval;
+    retval.plain.push_back(context().encodeVector(values));
+    return retval;
+}
+
+void SEALEltwiseBenchmark::decodeResult(const SEALSample &result, std::vector<double> &values) const
+{
+    context().encoder().decode(result.plain.front(), values);
+    values.resize(m_n);
+}
+
+SEALSample SEALEltwiseBenchmark::operateSample(const std::vector<const SEALSample *> &args) const
+{
+    SEALSample retval;
+    retval.cipher.push_back(args[0]->cipher.front());
+    if (m_b_multiply)
+        context().multiplyRescale(retval.cipher.front(), args[1]->cipher.front());
+    else
+        context().add(retval.cipher.front(), args[1]->cipher.front());
+    return retval;
+}
@@ -0,0 +1,276 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "seal_engine.h"
+#include "seal_error.h"
+
+// include all benchmarks
+#include "seal_dotproduct_benchmark.h"
+#include "seal_eltwise_benchmark.h"
+#include "seal_logreg_benchmark.h"
+#include "seal_matmul_benchmark.h"
+
+//-----------------
+// Engine creation
+//-----------------
+
+namespace hebench {
+namespace cpp {
+
+BaseEngine *createEngine()
+{
+    return SEALEngine::create();
+}
+
+void destroyEngine(BaseEngine *p)
+{
+    SEALEngine *_p = dynamic_cast<SEALEngine *>(p);
+    SEALEngine::destroy(_p);
+}
+
+} // namespace cpp
+} // namespace hebench
+
+namespace {
+// true while a thread runs calls from parallelFor()
+thread_local bool b_in_parallel_for = false;
+} // namespace
+
+//------------------------------
+// class SEALEngine::WorkerPool
+//------------------------------
+
+/**
+ * @brief Threads that run the calls of parallelFor() alongside the caller.
+ * @details Threads are started on construction and wait for the next call
+ * until the pool is destroyed. The pool runs one call at a time.
+ */
+class SEALEngine::WorkerPool
+{
+public:
+    WorkerPool(std::size_t worker_count);
+    ~WorkerPool();
+
+    /**
+     * @brief Calls `func(i)` for every `i` in range [0, count) from the pool
+     * threads and the calling thread.
+     * @returns `false`, without calling \p func, if the pool is running a call
+     * from another thread.
+     */
+    bool run(std::size_t count, const std::function<void(std::size_t)> &func);
+
+private:
+    void workerLoop();
+    // picks indices of the current call until none are left
+    void process();
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_run_mutex; // held by the thread whose call is running
+    std::mutex m_mutex; // protects call state below
+    std::condition_variable m_cv_start;
+    std::condition_variable m_cv_done;
+    std::uint64_t m_generation; // incremented on every call
+    bool m_b_stop;
+    const std::function<void(std::size_t)> *m_p_func;
+    std::size_t m_count;
+    std::atomic<std::size_t> m_next;
+    std::size_t m_busy_count; // workers that have not finished the current call
+    std::exception_ptr m_p_ex;
+};
+
+SEALEngine::WorkerPool::WorkerPool(std::size_t worker_count) :
+    m_generation(0),
+    m_b_stop(false),
+    m_p_func(nullptr),
+    m_count(0),
+    m_next(0),
+    m_busy_count(0)
+{
+    for (std::size_t worker_i = 0; worker_i < worker_count; ++worker_i)
+        m_workers.emplace_back(&WorkerPool::workerLoop, this);
+}
+
+SEALEngine::WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_b_stop = true;
+    }
+    m_cv_start.notify_all();
+    for (std::thread &worker : m_workers)
+        worker.join();
+}
+
+bool SEALEngine::WorkerPool::run(std::size_t count, const std::function<void(std::size_t)> &func)
+{
+    std::unique_lock<std::mutex> run_lock(m_run_mutex, std::try_to_lock);
+    if (!run_lock.owns_lock())
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_p_func     = &func;
+        m_count      = count;
+        m_next       = 0;
+        m_busy_count = m_workers.size();
+        m_p_ex       = nullptr;
+        ++m_generation;
+    }
+    m_cv_start.notify_all();
+    process();
+
+    std::exception_ptr p_ex;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv_done.wait(lock, [this]() { return m_busy_count <= 0; });
+        m_p_func = nullptr;
+        p_ex     = m_p_ex;
+    }
+    if (p_ex)
+        std::rethrow_exception(p_ex);
+    return true;
+}
+
+void SEALEngine::WorkerPool::workerLoop()
+{
+    std::uint64_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv_start.wait(lock, [this, generation]() { return m_b_stop || m_generation != generation; });
+            if (m_b_stop)
+                break;
+            generation = m_generation;
+        }
+        process();
+        bool b_last;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            b_last = (--m_busy_count <= 0);
+        }
+        if (b_last)
+            m_cv_done.notify_one();
+    } // end while
+}
+
+void SEALEngine::WorkerPool::process()
+{
+    b_in_parallel_for = true;
+    try
+    {
+        for (std::size_t i = m_next++; i < m_count; i = m_next++)
+            (*m_p_func)(i);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_p_ex)
+            m_p_ex = std::current_exception();
+        m_next = m_count; // stop everyone else
+    }
+    b_in_parallel_for = false;
+}
+
+//------------------
+// class SEALEngine
+//------------------
+
+SEALEngine *SEALEngine::create()
+{
+    SEALEngine *p_retval = new SEALEngine();
+    p_retval->init();
+    return p_retval;
+}
+
+void SEALEngine::destroy(SEALEngine *p)
+{
+    if (p)
+        delete p;
+}
+
+SEALEngine::SEALEngine() :
+    m_thread_count(1)
+{
+}
+
+SEALEngine::~SEALEngine()
+{
+}
+
+void SEALEngine::parallelFor(std::size_t count, const std::function<void(std::size_t)> &func) const
+{
+    std::size_t thread_count = std::min(m_thread_count, count);
+    // nested calls run in the calling thread: all engine threads are busy already
+    if (thread_count <= 1 || b_in_parallel_for || !m_p_pool || !m_p_pool->run(count, func))
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            func(i);
+    } // end if
+}
+
+void SEALEngine::init()
+{
+    // threads to use on batches
+    m_thread_count      = 0;
+    const char *s_value = std::getenv(ThreadCountEnvVar);
+    if (s_value && *s_value)
+    {
+        try
+        {
+            m_thread_count = std::stoull(s_value);
+        }
+        catch (...)
+        {
+            throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS(std::string("Invalid thread count in environment variable ")
+                                                                + ThreadCountEnvVar + ": \"" + s_value + "\"."),
+                                             HEBENCH_ECODE_INVALID_ARGS);
+        }
+    } // end if
+    if (m_thread_count <= 0)
+        m_thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    // the thread calling parallelFor() is one of the engine threads
+    m_p_pool.reset(new WorkerPool(m_thread_count - 1));
+
+    // add any new error codes
+
+    addErrorCode(SEAL_BACKEND_ECODE_SEAL_ERROR, "SEAL error.");
+
+    // add supported schemes
+
+    addSchemeName(HEBENCH_HE_SCHEME_CKKS, "CKKS");
+
+    // add supported security
+
+    addSecurityName(SEAL_BACKEND_HE_SECURITY_128, "128 bits");
+
+    // add the all benchmark descriptors
+    const hebench::APIBridge::Category categories[] = { hebench::APIBridge::Category::Latency,
+                                                        hebench::APIBridge::Category::Offline };
+    const hebench::APIBridge::Workload logreg_workloads[] = { hebench::APIBridge::Workload::LogisticRegression_PolyD3,
+                                                              hebench::APIBridge::Workload::LogisticRegression_PolyD5,
+                                                              hebench::APIBridge::Workload::LogisticRegression_PolyD7 };
+    for (hebench::APIBridge::Category category : categories)
+    {
+        addBenchmarkDescription(std::make_shared<SEALEltwiseBenchmarkDescription>(hebench::APIBridge::Workload::EltwiseAdd,
+                                                                                  category, m_thread_count));
+        addBenchmarkDescription(std::make_shared<SEALEltwiseBenchmarkDescription>(hebench::APIBridge::Workload::EltwiseMultiply,
+                                                                                  category, m_thread_count));
+        addBenchmarkDescription(std::make_shared<SEALDotProductBenchmarkDescription>(category, m_thread_count));
+        addBenchmarkDescription(std::make_shared<SEALMatMulBenchmarkDescription>(category, m_thread_count));
+        for (hebench::APIBridge::Workload workload : logreg_workloads)
+            addBenchmarkDescription(std::make_shared<SEALLogRegBenchmarkDescription>(workload, category, m_thread_count));
+    } // end for
+}
@@ -0,0 +1,157 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "seal_engine.h"
+#include "seal_error.h"
+#include "seal_logreg_benchmark.h"
+
+//--------------------------------------
+// class SEALLogRegBenchmarkDescription
+//--------------------------------------
+
+SEALLogRegBenchmarkDescription::SEALLogRegBenchmarkDescription(hebench::APIBridge::Workload workload,
+                                                               hebench::APIBridge::Category category,
+                                                               std::size_t thread_count) :
+    SEALBenchmarkDescription(workload, category,
+                             1 << 2, // only input X is encrypted
+                             PolyModulusDegree, getCoeffModulusBits(), ScaleExponent,
+                             thread_count)
+{
+    if (category == hebench::APIBridge::Category::Offline)
+    {
+        // a single model per operation
+        m_descriptor.cat_params.offline.data_count[0] = 1; // W
+        m_descriptor.cat_params.offline.data_count[1] = 1; // b
+    } // end if
+
+    // validate workload
+    getSigmoidCoefficients(workload);
+
+    hebench::cpp::WorkloadParams::LogisticRegression default_workload_params;
+    default_workload_params.n = 16;
+    this->addDefaultParameters(default_workload_params);
+}
+
+SEALLogRegBenchmarkDescription::~SEALLogRegBenchmarkDescription()
+{
+}
+
+std::vector<int> SEALLogRegBenchmarkDescription::getCoeffModulusBits()
+{
+    std::vector<int> retval(MultiplicativeDepth + 2, ScaleExponent);
+    retval.front() = 60;
+    retval.back()  = 60;
+    return retval;
+}
+
+std::vector<double> SEALLogRegBenchmarkDescription::getSigmoidCoefficients(hebench::APIBridge::Workload workload)
+{
+    switch (workload)
+    {
+    case hebench::APIBridge::Workload::LogisticRegression_PolyD3:
+        return { 0.5, 0.15012, 0.0, -0.0015930078125 };
+    case hebench::APIBridge::Workload::LogisticRegression_PolyD5:
+        return { 0.5, 0.19131, 0.0, -0.0045963, 0.0, 0.0000412332000732421875 };
+    case hebench::APIBridge::Workload::LogisticRegression_PolyD7:
+        return { 0.5, 0.21687, 0.0, -0.00819154296875, 0.0, 0.0001658331298828125, 0.0, -0.00000119561672210693359375 };
+    default:
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload. Expected LogisticRegression_PolyD3, LogisticRegression_PolyD5 or LogisticRegression_PolyD7."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+    } // end switch
+}
+
+hebench::cpp::BaseBenchmark *SEALLogRegBenchmarkDescription::createBenchmark(hebench::cpp::BaseEngine &engine,
+                                                                             const hebench::APIBridge::WorkloadParams *p_params)
+{
+    if (!p_params)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid empty workload parameters. This workload requires flexible parameters."),
+                                         HEBENCH_ECODE_CRITICAL_ERROR);
+
+    SEALEngine &seal_engine = dynamic_cast<SEALEngine &>(engine);
+    return new SEALLogRegBenchmark(seal_engine, *this, m_descriptor, *p_params);
+}
+
+//---------------------------
+// class SEALLogRegBenchmark
+//---------------------------
+
+SEALLogRegBenchmark::SEALLogRegBenchmark(SEALEngine &engine,
+                                         const SEALLogRegBenchmarkDescription &description,
+                                         const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                                         const hebench::APIBridge::WorkloadParams &bench_params) :
+    SEALBenchmark(engine, bench_desc, bench_params, ParametersCount),
+    m_coefficients(SEALLogRegBenchmarkDescription::getSigmoidCoefficients(bench_desc.workload))
+{
+    if (bench_params.count < SEALLogRegBenchmarkDescription::NumWorkloadParams)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload parameters. This workload requires "
+                                                            + std::to_string(SEALLogRegBenchmarkDescription::NumWorkloadParams)
+                                                            + " parameters."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+
+    hebench::cpp::WorkloadParams::LogisticRegression w_params(bench_params);
+    if (w_params.n <= 0 || w_params.n > SEALLogRegBenchmarkDescription::PolyModulusDegree / 2)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload parameters. This workload only supports feature vectors of size up to "
+                                                            + std::to_string(SEALLogRegBenchmarkDescription::PolyModulusDegree / 2) + "."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+    m_block_size = SEALContextWrapper::nextPowerOf2(w_params.n);
+
+    initContext(description, SEALContextWrapper::getSumBlocksSteps(m_block_size));
+}
+
+SEALLogRegBenchmark::~SEALLogRegBenchmark()
+{
+}
+
+SEALSample SEALLogRegBenchmark::encodeSample(std::uint64_t param_position, const std::vector<double> &values) const
+{
+    SEALSample retval;
+    if (param_position == Index_b)
+    {
+        // bias is added after the product W * X is rescaled: encode it at that level
+        seal::parms_id_type parms_id = context().context()->first_context_data()->next_context_data()->parms_id();
+        retval.plain.emplace_back();
+        context().encoder().encode(values.front(), parms_id, context().scale(), retval.plain.back());
+    } // end if
+    else
+        retval.plain.push_back(context().encodeVector(values));
+    return retval;
+}
+
+void SEALLogRegBenchmark::decodeResult(const SEALSample &result, std::vector<double> &values) const
+{
+    context().encoder().decode(result.plain.front(), values);
+    values.resize(1);
+}
+
+SEALSample SEALLogRegBenchmark::operateSample(const std::vector<const SEALSample *> &args) const
+{
+    // linear regression: x = W . X + b
+    seal::Ciphertext x = args[Index_X]->cipher.front();
+    context().multiplyPlainRescale(x, args[Index_W]->plain.front());
+    context().sumBlocks(x, m_block_size);
+    context().evaluator().add_plain_inplace(x, args[Index_b]->plain.front());
+
+    // sigmoid: c_0 + c_1 * x + c_3 * x^3 + ...
+    seal::Ciphertext x2 = x;
+    context().multiplyRescale(x2, x);
+    std::vector<std::size_t> degrees; // degrees of the terms to compute
+    for (std::size_t degree = 1; degree < m_coefficients.size(); degree += 2)
+        if (m_coefficients[degree] != 0.0)
+            degrees.push_back(degree);
+    std::vector<seal::Ciphertext> terms(degrees.size());
+    engine().parallelFor(degrees.size(), [&](std::size_t term_i) {
+        seal::Ciphertext &term = terms[term_i];
+        term                   = x;
+        context().multiplyPlainRescale(term, context().encodeConstant(m_coefficients[degrees[term_i]], term));
+        for (std::size_t degree = 1; degree < degrees[term_i]; degree += 2)
+            context().multiplyRescale(term, x2);
+    });
+
+    SEALSample retval;
+    retval.cipher.push_back(std::move(terms.front()));
+    seal::Ciphertext &result = retval.cipher.front();
+    for (std::size_t term_i = 1; term_i < terms.size(); ++term_i)
+        context().add(result, std::move(terms[term_i]));
+    context().evaluator().add_plain_inplace(result, context().encodeConstant(m_coefficients.front(), result));
+    return retval;
+}
@@ -0,0 +1,126 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "seal_engine.h"
+#include "seal_error.h"
+#include "seal_matmul_benchmark.h"
+
+//--------------------------------------
+// class SEALMatMulBenchmarkDescription
+//--------------------------------------
+
+SEALMatMulBenchmarkDescription::SEALMatMulBenchmarkDescription(hebench::APIBridge::Category category,
+                                                               std::size_t thread_count) :
+    SEALBenchmarkDescription(hebench::APIBridge::Workload::MatrixMultiply, category,
+                             (1 << 0) | (1 << 1), // all parameters encrypted
+                             PolyModulusDegree, { 60, ScaleExponent, 60 }, ScaleExponent,
+                             thread_count)
+{
+    hebench::cpp::WorkloadParams::MatrixMultiply default_workload_params;
+    default_workload_params.rows_M0 = 10;
+    default_workload_params.cols_M0 = 9;
+    default_workload_params.cols_M1 = 8;
+    this->addDefaultParameters(default_workload_params);
+}
+
+SEALMatMulBenchmarkDescription::~SEALMatMulBenchmarkDescription()
+{
+}
+
+hebench::cpp::BaseBenchmark *SEALMatMulBenchmarkDescription::createBenchmark(hebench::cpp::BaseEngine &engine,
+                                                                             const hebench::APIBridge::WorkloadParams *p_params)
+{
+    if (!p_params)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid empty workload parameters. This workload requires flexible parameters."),
+                                         HEBENCH_ECODE_CRITICAL_ERROR);
+
+    SEALEngine &seal_engine = dynamic_cast<SEALEngine &>(engine);
+    return new SEALMatMulBenchmark(seal_engine, *this, m_descriptor, *p_params);
+}
+
+//---------------------------
+// class SEALMatMulBenchmark
+//---------------------------
+
+SEALMatMulBenchmark::SEALMatMulBenchmark(SEALEngine &engine,
+                                         const SEALMatMulBenchmarkDescription &description,
+                                         const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                                         const hebench::APIBridge::WorkloadParams &bench_params) :
+    SEALBenchmark(engine, bench_desc, bench_params, ParametersCount)
+{
+    if (bench_params.count < SEALMatMulBenchmarkDescription::NumWorkloadParams)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload parameters. This workload requires "
+                                                            + std::to_string(SEALMatMulBenchmarkDescription::NumWorkloadParams)
+                                                            + " parameters."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+
+    hebench::cpp::WorkloadParams::MatrixMultiply w_params(bench_params);
+    m_rows_m0    = w_params.rows_M0;
+    m_cols_m0    = w_params.cols_M0;
+    m_cols_m1    = w_params.cols_M1;
+    m_block_size = SEALContextWrapper::nextPowerOf2(m_cols_m0);
+    if (m_rows_m0 <= 0 || m_cols_m0 <= 0 || m_cols_m1 <= 0
+        || m_cols_m1 * m_block_size > SEALMatMulBenchmarkDescription::PolyModulusDegree / 2)
+        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload parameters. This workload only supports matrices where "
+                                                            "cols_M1 * cols_M0, with cols_M0 rounded up to a power of 2, is at most "
+                                                            + std::to_string(SEALMatMulBenchmarkDescription::PolyModulusDegree / 2) + "."),
+                                         HEBENCH_ECODE_INVALID_ARGS);
+
+    initContext(description, SEALContextWrapper::getSumBlocksSteps(m_block_size));
+}
+
+SEALMatMulBenchmark::~SEALMatMulBenchmark()
+{
+}
+
+SEALSample SEALMatMulBenchmark::encodeSample(std::uint64_t param_position, const std::vector<double> &values) const
+{
+    SEALSample retval;
+    if (param_position == 0)
+    {
+        // M0: one plaintext per row, replicated in every block
+        retval.plain.resize(m_rows_m0);
+        engine().parallelFor(m_rows_m0, [&](std::size_t row_i) {
+            std::vector<double> slots(m_cols_m1 * m_block_size, 0.0);
+            for (std::uint64_t block_i = 0; block_i < m_cols_m1; ++block_i)
+                for (std::uint64_t col_i = 0; col_i < m_cols_m0; ++col_i)
+                    slots[block_i * m_block_size + col_i] = values.at(row_i * m_cols_m0 + col_i);
+            retval.plain[row_i] = context().encodeVector(slots);
+        });
+    } // end if
+    else
+    {
+        // M1: column j in block j
+        std::vector<double> slots(m_cols_m1 * m_block_size, 0.0);
+        for (std::uint64_t col_i = 0; col_i < m_cols_m1; ++col_i)
+            for (std::uint64_t row_i = 0; row_i < m_cols_m0; ++row_i)
+                slots[col_i * m_block_size + row_i] = values.at(row_i * m_cols_m1 + col_i);
+        retval.plain.push_back(context().encodeVector(slots));
+    } // end else
+    return retval;
+}
+
+void SEALMatMulBenchmark::decodeResult(const SEALSample &result, std::vector<double> &values) const
+{
+    values.resize(m_rows_m0 * m_cols_m1);
+    std::vector<double> slots;
+    for (std::uint64_t row_i = 0; row_i < m_rows_m0; ++row_i)
+    {
+        context().encoder().decode(result.plain.at(row_i), slots);
+        for (std::uint64_t col_i = 0; col_i < m_cols_m1; ++col_i)
+            values[row_i * m_cols_m1 + col_i] = slots[col_i * m_block_size];
+    } // end for
+}
+
+SEALSample SEALMatMulBenchmark::operateSample(const std::vector<const SEALSample *> &args) const
+{
+    SEALSample retval;
+    retval.cipher.resize(m_rows_m0);
+    engine().parallelFor(m_rows_m0, [&](std::size_t row_i) {
+        seal::Ciphertext &row = retval.cipher[row_i];
+        row                   = args[0]->cipher.at(row_i);
+        context().multiplyRescale(row, args[1]->cipher.front());
+        context().sumBlocks(row, m_block_size);
+    });
+    return retval;
+}
@@ -0,0 +1,144 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Call_Record_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Call_Record_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hebench/api_bridge/api.h"
+
+namespace hebench {
+namespace APIBridge {
+
+/**
+ * @brief Format of API Bridge call stream recordings.
+ * @details A recording is a binary file in native byte order that starts with
+ * `FileMagic` and `FileVersion` (`uint64_t`, `uint32_t`), followed by one
+ * entry per successful API Bridge call issued on a benchmark. Each entry
+ * starts with its `Call` identifier (`uint32_t`) followed by its arguments:
+ *
+ * | Call | Arguments |
+ * |------|-----------|
+ * | InitBenchmark | index of benchmark description among subscribed, parameter count, `WorkloadParam` array, out id |
+ * | Encode | benchmark id, packed data with contents, out id |
+ * | Decode | benchmark id, in id, packed data layout (no contents) |
+ * | Encrypt, Decrypt | benchmark id, in id, out id |
+ * | Load | benchmark id, count, in ids, out id |
+ * | Store | benchmark id, in id, count, out ids |
+ * | Operate | benchmark id, in id, indexer count, `ParameterIndexer` array, out id |
+ * | DestroyHandle | id |
+ *
+ * Handles are replaced by sequential ids starting at 1 in order of creation.
+ * Id 0 identifies a handle unknown to the recording. Packed data is stored
+ * as pack count followed, for each pack, by parameter position, buffer count
+ * and, for each buffer, tag, size and, if contents are included, size bytes.
+ * All counts, sizes, indices and ids are `uint64_t`. Tags are `int64_t`.
+ */
+struct APICallRecord
+{
+    enum class Call : std::uint32_t
+    {
+        InitBenchmark = 1,
+        Encode,
+        Decode,
+        Encrypt,
+        Decrypt,
+        Load,
+        Store,
+        Operate,
+        DestroyHandle
+    };
+
+    static constexpr std::uint64_t FileMagic   = 0x3143455242454828; // "(HEBREC1"
+    static constexpr std::uint32_t FileVersion = 1;
+    static constexpr std::uint64_t UnknownId   = 0;
+};
+
+/**
+ * @brief Writes the stream of API Bridge calls issued on a benchmark.
+ * @details Keeps track of the handles created by recorded calls to replace
+ * them by ids. Handles not created by recorded calls (engine, benchmark
+ * descriptions) are not tracked and their destruction is not recorded.
+ */
+class APICallRecorder
+{
+public:
+    /**
+     * @brief Creates the recording file.
+     * @param[in] filename File to write. Overwritten if it exists.
+     * @param[in] bench_descs Benchmark description handles as subscribed from
+     * the backend, used to locate the description initialized.
+     * @exception std::runtime_error if the file cannot be created.
+     */
+    APICallRecorder(const std::string &filename, const std::vector<Handle> &bench_descs);
+
+    void recordInitBenchmark(Handle h_bench_desc, const WorkloadParams *p_params, Handle h_benchmark);
+    void recordEncode(Handle h_benchmark, const PackedData *p_parameters, Handle h_plaintext);
+    void recordDecode(Handle h_benchmark, Handle h_plaintext, const PackedData *p_native);
+    void recordEncrypt(Handle h_benchmark, Handle h_plaintext, Handle h_ciphertext);
+    void recordDecrypt(Handle h_benchmark, Handle h_ciphertext, Handle h_plaintext);
+    void recordLoad(Handle h_benchmark, const Handle *h_local_packed_params, std::uint64_t local_count, Handle h_remote);
+    void recordStore(Handle h_benchmark, Handle h_remote, const Handle *h_local_packed_params, std::uint64_t local_count);
+    void recordOperate(Handle h_benchmark, Handle h_remote_packed_params, const ParameterIndexer *p_param_indexers, Handle h_remote_output);
+    void recordDestroyHandle(Handle h);
+
+private:
+    struct HandleInfo
+    {
+        std::uint64_t id;
+        /**
+         * @brief Number of operation parameters represented by the handle.
+         * @details Needed to know how many parameter indexers are passed to
+         * operate(). 0 if unknown.
+         */
+        std::uint64_t param_count;
+    };
+
+    std::uint64_t addHandle(Handle h, std::uint64_t param_count);
+    const HandleInfo &findHandle(Handle h) const;
+    void writeCall(APICallRecord::Call call);
+    void writeU64(std::uint64_t value);
+    void writeBytes(const void *p_data, std::uint64_t size);
+    void writePackedData(const PackedData *p_packed_data, bool b_contents);
+
+    std::ofstream m_fnum;
+    std::vector<Handle> m_bench_descs;
+    std::unordered_map<const void *, HandleInfo> m_handles;
+    std::uint64_t m_next_id;
+};
+
+/**
+ * @brief Reads API Bridge call stream recordings written by APICallRecorder.
+ */
+class APICallReader
+{
+public:
+    /**
+     * @brief Opens a recording file.
+     * @exception std::runtime_error if the file cannot be opened or is not a
+     * supported recording.
+     */
+    APICallReader(const std::string &filename);
+
+    /**
+     * @brief Reads the identifier of the next call.
+     * @returns `false` if the end of the recording was reached.
+     */
+    bool readCall(APICallRecord::Call &call);
+    std::uint64_t readU64();
+    void readBytes(void *p_data, std::uint64_t size);
+
+private:
+    std::ifstream m_fnum;
+};
+
+} // namespace APIBridge
+} // namespace hebench
+
+#endif // defined _HEBench_API_Call_Record_H_7e5fa8c2415240ea93eff148ed73539b
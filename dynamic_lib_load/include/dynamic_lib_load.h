@@ -8,6 +8,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "hebench/api_bridge/api.h"
 
@@ -16,6 +17,7 @@ namespace APIBridge {
 
 struct ExternFunctions;
 struct DynamicLib;
+class APICallRecorder;
 
 /**
  * @brief "Static class" re-implementing API Bridge methods to direct calls to correct backend
@@ -28,6 +30,22 @@ struct DynamicLib;
 class DynamicLibLoad
 {
 public:
+    /**
+     * @brief Makes a loaded backend library active for the lifetime of this
+     * object and restores the previously active one on destruction.
+     */
+    class ActiveLibraryScope
+    {
+    public:
+        ActiveLibraryScope(DynamicLib *p_lib);
+        ~ActiveLibraryScope();
+        ActiveLibraryScope(const ActiveLibraryScope &) = delete;
+        ActiveLibraryScope &operator=(const ActiveLibraryScope &) = delete;
+
+    private:
+        DynamicLib *m_p_previous_lib;
+    };
+
     /**
      * @brief Loads the pre-built backend library at the specified path
      * @param[in] path The filepath to the pre-built backend library
@@ -39,9 +57,53 @@ public:
      * @details If no exceptions were thrown, the backend loading was a success.
      * The test harness may then simply continue execution utilizing the API Bridge
      * methods freely. The calls will divert to the specified loaded backend library.
+     *
+     * Several libraries can be loaded at the same time. API Bridge calls are
+     * diverted to the active library, which is the last one loaded until
+     * changed with setActiveLibrary(). Handles must only be passed to the
+     * library that created them.
+     * @return The library loaded, now active.
+     */
+    static DynamicLib *loadLibrary(const std::string &path);
+    /**
+     * @brief Unloads all loaded backend libraries.
      */
-    static void loadLibrary(const std::string &path);
     static void unloadLibrary();
+    /**
+     * @brief Diverts subsequent API Bridge calls to a loaded backend library.
+     * @exception std::invalid_argument if \p p_lib is not loaded.
+     * @details Changing the active library ends any active recording.
+     */
+    static void setActiveLibrary(DynamicLib *p_lib);
+    static DynamicLib *getActiveLibrary() { return m_lib; }
+
+    /**
+     * @brief Starts recording the API Bridge calls issued on the next benchmark.
+     * @param[in] filename File where to write the recording (see APICallRecord).
+     * @exception std::runtime_error if no backend library is loaded or the
+     * file cannot be created.
+     * @details Every successful call from initBenchmark() onwards, including
+     * the plaintext contents passed to encode(), is recorded until
+     * endRecording() is called. Recording happens after each call returns,
+     * thus, it does not affect the time spent in the backend, but timings
+     * measured around the calls while recording should be disregarded.
+     *
+     * Recordings can be replayed against a backend with the API replayer tool.
+     */
+    static void beginRecording(const std::string &filename);
+    /**
+     * @brief Stops the active recording, if any, and closes its file.
+     */
+    static void endRecording();
+    static bool isRecording() { return m_p_recorder != nullptr; }
+
+    /**
+     * @brief Whether the loaded backend exports the sub-phase timing extension.
+     * @details If so, sub-phase timings pushed by the backend during API Bridge
+     * calls are collected with SubPhaseTimings::drain().
+     * @sa hebench_api_bridge_ext.h
+     */
+    static bool hasSubPhaseTimings();
 
     static ErrorCode destroyHandle(Handle h);
     static ErrorCode initEngine(Handle *h_engine);
@@ -102,8 +164,10 @@ private:
      * @brief Object allowing calling of dynamically loaded backends through form
      * m_functions.API_Bridge_Function(params)
      */
-    static ExternFunctions m_functions;
-    static DynamicLib *m_lib;
+    static ExternFunctions m_functions; // functions of active library
+    static DynamicLib *m_lib; // active library
+    static std::vector<DynamicLib *> m_loaded_libs;
+    static APICallRecorder *m_p_recorder;
 
     /**
      * @brief Constructor made private to avoid any unnecessary instance creation
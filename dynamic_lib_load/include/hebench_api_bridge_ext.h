@@ -0,0 +1,65 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_Ext_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_Ext_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <stdint.h>
+
+/**
+ * @file
+ * @brief Optional Test Harness extensions to the API Bridge.
+ * @details Extensions are functions that backends may export, with C linkage,
+ * alongside the API Bridge functions. Test Harness looks them up when loading
+ * the backend library and only uses the ones found, so backends that do not
+ * export them are unaffected.
+ *
+ * Backends using an extension should include this header.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Name of the symbol for the sub-phase timing extension.
+ * @sa hebenchExtSetSubPhaseSink()
+ */
+#define HEBENCH_EXT_SUBPHASE_SINK_SYMBOL "hebenchExtSetSubPhaseSink"
+
+/**
+ * @brief Maximum length, including null terminator, of a sub-phase name.
+ * @details Longer names are truncated.
+ */
+#define HEBENCH_EXT_SUBPHASE_NAME_SIZE 64
+
+/**
+ * @brief Pushes the timing of a sub-phase of the API Bridge call in progress.
+ * @param[in] name Null-terminated name of the sub-phase, such as
+ * "relinearize" or "host to device". Sub-phases with the same name are
+ * grouped together in the report.
+ * @param[in] wall_time_ns Elapsed wall time of the sub-phase, in nanoseconds.
+ * @param[in] cpu_time_ns Elapsed CPU time of the sub-phase, in nanoseconds,
+ * or 0 if not measured.
+ * @details This function is lock-free and can be called from any thread,
+ * but only while the API Bridge call that contains the sub-phase is running.
+ * Sub-phases are attributed to that call when it returns.
+ */
+typedef void (*HEBenchExtSubPhasePush)(const char *name, uint64_t wall_time_ns, uint64_t cpu_time_ns);
+
+/**
+ * @brief Sub-phase timing extension.
+ * @param[in] push Function that the backend uses to push sub-phase timings,
+ * or null when Test Harness stops listening, before unloading the backend.
+ * @details Exported by the backend with name HEBENCH_EXT_SUBPHASE_SINK_SYMBOL.
+ * Called by Test Harness once after loading the backend library, before
+ * `initEngine()`.
+ */
+void hebenchExtSetSubPhaseSink(HEBenchExtSubPhasePush push);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // defined _HEBench_API_Bridge_Ext_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,78 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_SubPhase_Timings_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_SubPhase_Timings_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "hebench_api_bridge_ext.h"
+
+namespace hebench {
+namespace APIBridge {
+
+/**
+ * @brief Sub-phase timing pushed by a backend through the sub-phase timing
+ * extension.
+ */
+struct SubPhaseTiming
+{
+    char name[HEBENCH_EXT_SUBPHASE_NAME_SIZE];
+    std::uint64_t wall_time_ns;
+    std::uint64_t cpu_time_ns;
+};
+
+/**
+ * @brief "Static class" holding the lock-free buffer that receives the
+ * sub-phase timings pushed by the backend during an API Bridge call.
+ * @details Backends push timings from any of their threads while a call is in
+ * progress. After the call returns, the caller collects them with drain().
+ * Timings pushed when the buffer is full are dropped and counted.
+ */
+class SubPhaseTimings
+{
+public:
+    /**
+     * @brief Maximum number of sub-phase timings held between two drains.
+     */
+    static constexpr std::size_t Capacity = 4096;
+
+    /**
+     * @brief Function passed to the backend to push sub-phase timings.
+     * @sa HEBenchExtSubPhasePush
+     */
+    static void push(const char *name, std::uint64_t wall_time_ns, std::uint64_t cpu_time_ns);
+    /**
+     * @brief Moves the timings pushed since the last drain into \p out_timings.
+     * @param[out] out_timings Receives the timings in the order they were
+     * pushed. Previous contents are cleared.
+     * @details Must not be called while an API Bridge call is in progress.
+     * Waits for pushes that already claimed a slot to complete.
+     */
+    static void drain(std::vector<SubPhaseTiming> &out_timings);
+    /**
+     * @brief Number of timings dropped because the buffer was full.
+     */
+    static std::uint64_t getDroppedCount() { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot
+    {
+        SubPhaseTiming timing;
+        std::atomic<bool> ready;
+    };
+
+    static Slot m_slots[Capacity];
+    static std::atomic<std::uint64_t> m_next;
+    static std::atomic<std::uint64_t> m_dropped;
+
+    SubPhaseTimings() {}
+};
+
+} // namespace APIBridge
+} // namespace hebench
+
+#endif // defined _HEBench_SubPhase_Timings_H_7e5fa8c2415240ea93eff148ed73539b
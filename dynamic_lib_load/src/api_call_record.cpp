@@ -0,0 +1,229 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdexcept>
+
+#include "api_call_record.h"
+
+namespace hebench {
+namespace APIBridge {
+
+//-----------------------
+// class APICallRecorder
+//-----------------------
+
+APICallRecorder::APICallRecorder(const std::string &filename, const std::vector<Handle> &bench_descs) :
+    m_bench_descs(bench_descs),
+    m_next_id(1)
+{
+    m_fnum.open(filename, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    if (!m_fnum.is_open())
+        throw std::runtime_error("Failed to open API call recording file \"" + filename + "\" for writing.");
+    writeU64(APICallRecord::FileMagic);
+    std::uint32_t version = APICallRecord::FileVersion;
+    writeBytes(&version, sizeof(version));
+}
+
+std::uint64_t APICallRecorder::addHandle(Handle h, std::uint64_t param_count)
+{
+    HandleInfo info;
+    info.id          = m_next_id++;
+    info.param_count = param_count;
+    m_handles[h.p]   = info;
+    return info.id;
+}
+
+const APICallRecorder::HandleInfo &APICallRecorder::findHandle(Handle h) const
+{
+    static const HandleInfo unknown = { APICallRecord::UnknownId, 0 };
+    auto it                         = m_handles.find(h.p);
+    return it == m_handles.end() ? unknown : it->second;
+}
+
+void APICallRecorder::writeCall(APICallRecord::Call call)
+{
+    std::uint32_t value = static_cast<std::uint32_t>(call);
+    writeBytes(&value, sizeof(value));
+}
+
+void APICallRecorder::writeU64(std::uint64_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void APICallRecorder::writeBytes(const void *p_data, std::uint64_t size)
+{
+    if (size > 0)
+    {
+        m_fnum.write(reinterpret_cast<const char *>(p_data), size);
+        if (!m_fnum)
+            throw std::runtime_error("Error writing to API call recording file.");
+    } // end if
+}
+
+void APICallRecorder::writePackedData(const PackedData *p_packed_data, bool b_contents)
+{
+    writeU64(p_packed_data->pack_count);
+    for (std::uint64_t pack_i = 0; pack_i < p_packed_data->pack_count; ++pack_i)
+    {
+        const DataPack &data_pack = p_packed_data->p_data_packs[pack_i];
+        writeU64(data_pack.param_position);
+        writeU64(data_pack.buffer_count);
+        for (std::uint64_t buffer_i = 0; buffer_i < data_pack.buffer_count; ++buffer_i)
+        {
+            const NativeDataBuffer &buffer = data_pack.p_buffers[buffer_i];
+            writeU64(static_cast<std::uint64_t>(buffer.tag));
+            writeU64(buffer.size);
+            if (b_contents)
+                writeBytes(buffer.p, buffer.size);
+        } // end for
+    } // end for
+}
+
+void APICallRecorder::recordInitBenchmark(Handle h_bench_desc, const WorkloadParams *p_params, Handle h_benchmark)
+{
+    std::uint64_t desc_index = 0;
+    while (desc_index < m_bench_descs.size() && m_bench_descs[desc_index].p != h_bench_desc.p)
+        ++desc_index;
+    if (desc_index >= m_bench_descs.size())
+        throw std::runtime_error("Benchmark description to record was not subscribed from backend.");
+
+    writeCall(APICallRecord::Call::InitBenchmark);
+    writeU64(desc_index);
+    std::uint64_t param_count = p_params ? p_params->count : 0;
+    writeU64(param_count);
+    if (param_count > 0)
+        writeBytes(p_params->params, param_count * sizeof(WorkloadParam));
+    writeU64(addHandle(h_benchmark, 0));
+}
+
+void APICallRecorder::recordEncode(Handle h_benchmark, const PackedData *p_parameters, Handle h_plaintext)
+{
+    writeCall(APICallRecord::Call::Encode);
+    writeU64(findHandle(h_benchmark).id);
+    writePackedData(p_parameters, true);
+    writeU64(addHandle(h_plaintext, p_parameters->pack_count));
+}
+
+void APICallRecorder::recordDecode(Handle h_benchmark, Handle h_plaintext, const PackedData *p_native)
+{
+    writeCall(APICallRecord::Call::Decode);
+    writeU64(findHandle(h_benchmark).id);
+    writeU64(findHandle(h_plaintext).id);
+    writePackedData(p_native, false);
+}
+
+void APICallRecorder::recordEncrypt(Handle h_benchmark, Handle h_plaintext, Handle h_ciphertext)
+{
+    const HandleInfo &plaintext = findHandle(h_plaintext);
+    writeCall(APICallRecord::Call::Encrypt);
+    writeU64(findHandle(h_benchmark).id);
+    writeU64(plaintext.id);
+    writeU64(addHandle(h_ciphertext, plaintext.param_count));
+}
+
+void APICallRecorder::recordDecrypt(Handle h_benchmark, Handle h_ciphertext, Handle h_plaintext)
+{
+    const HandleInfo &ciphertext = findHandle(h_ciphertext);
+    writeCall(APICallRecord::Call::Decrypt);
+    writeU64(findHandle(h_benchmark).id);
+    writeU64(ciphertext.id);
+    writeU64(addHandle(h_plaintext, ciphertext.param_count));
+}
+
+void APICallRecorder::recordLoad(Handle h_benchmark, const Handle *h_local_packed_params, std::uint64_t local_count, Handle h_remote)
+{
+    std::uint64_t param_count = 0;
+    writeCall(APICallRecord::Call::Load);
+    writeU64(findHandle(h_benchmark).id);
+    writeU64(local_count);
+    for (std::uint64_t i = 0; i < local_count; ++i)
+    {
+        const HandleInfo &local = findHandle(h_local_packed_params[i]);
+        param_count += local.param_count;
+        writeU64(local.id);
+    } // end for
+    writeU64(addHandle(h_remote, param_count));
+}
+
+void APICallRecorder::recordStore(Handle h_benchmark, Handle h_remote, const Handle *h_local_packed_params, std::uint64_t local_count)
+{
+    writeCall(APICallRecord::Call::Store);
+    writeU64(findHandle(h_benchmark).id);
+    writeU64(findHandle(h_remote).id);
+    writeU64(local_count);
+    for (std::uint64_t i = 0; i < local_count; ++i)
+        writeU64(h_local_packed_params[i].p ? addHandle(h_local_packed_params[i], 0) : APICallRecord::UnknownId);
+}
+
+void APICallRecorder::recordOperate(Handle h_benchmark, Handle h_remote_packed_params, const ParameterIndexer *p_param_indexers, Handle h_remote_output)
+{
+    const HandleInfo &remote = findHandle(h_remote_packed_params);
+    writeCall(APICallRecord::Call::Operate);
+    writeU64(findHandle(h_benchmark).id);
+    writeU64(remote.id);
+    writeU64(remote.param_count);
+    writeBytes(p_param_indexers, remote.param_count * sizeof(ParameterIndexer));
+    writeU64(addHandle(h_remote_output, 0));
+}
+
+void APICallRecorder::recordDestroyHandle(Handle h)
+{
+    auto it = m_handles.find(h.p);
+    if (it != m_handles.end())
+    {
+        writeCall(APICallRecord::Call::DestroyHandle);
+        writeU64(it->second.id);
+        m_handles.erase(it);
+    } // end if
+}
+
+//---------------------
+// class APICallReader
+//---------------------
+
+APICallReader::APICallReader(const std::string &filename)
+{
+    m_fnum.open(filename, std::ios_base::in | std::ios_base::binary);
+    if (!m_fnum.is_open())
+        throw std::runtime_error("Failed to open API call recording file \"" + filename + "\" for reading.");
+    std::uint32_t version = 0;
+    if (readU64() != APICallRecord::FileMagic)
+        throw std::runtime_error("File \"" + filename + "\" is not an API call recording.");
+    readBytes(&version, sizeof(version));
+    if (version != APICallRecord::FileVersion)
+        throw std::runtime_error("Unsupported API call recording version " + std::to_string(version) + ".");
+}
+
+bool APICallReader::readCall(APICallRecord::Call &call)
+{
+    std::uint32_t value;
+    m_fnum.read(reinterpret_cast<char *>(&value), sizeof(value));
+    if (m_fnum.gcount() == 0 && m_fnum.eof())
+        return false;
+    if (!m_fnum)
+        throw std::runtime_error("Unexpected end of API call recording.");
+    call = static_cast<APICallRecord::Call>(value);
+    return true;
+}
+
+std::uint64_t APICallReader::readU64()
+{
+    std::uint64_t retval;
+    readBytes(&retval, sizeof(retval));
+    return retval;
+}
+
+void APICallReader::readBytes(void *p_data, std::uint64_t size)
+{
+    if (size > 0)
+    {
+        m_fnum.read(reinterpret_cast<char *>(p_data), size);
+        if (!m_fnum)
+            throw std::runtime_error("Unexpected end of API call recording.");
+    } // end if
+}
+
+} // namespace APIBridge
+} // namespace hebench
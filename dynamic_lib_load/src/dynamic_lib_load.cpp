@@ -7,7 +7,13 @@
 #error("Source file only supported in LINUX!")
 #endif
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "api_call_record.h"
 #include "dynamic_lib_load.h"
+#include "subphase_timings.h"
 
 namespace hebench {
 namespace APIBridge {
@@ -79,6 +85,8 @@ typedef std::uint64_t (*GetErrorDescription)(ErrorCode code, char *p_description
 
 typedef std::uint64_t (*GetLastErrorDescription)(Handle h_engine, char *p_description, std::uint64_t size);
 
+typedef void (*SetSubPhaseSink)(HEBenchExtSubPhasePush push);
+
 /**
  * @brief Holds function pointers to each method in the API Bridge with external linkage
  * @details Each data member contains the function pointer that one would expect based on
@@ -106,15 +114,20 @@ struct ExternFunctions
     GetBenchmarkDescriptionEx getBenchmarkDescriptionEx;
     GetErrorDescription getErrorDescription;
     GetLastErrorDescription getLastErrorDescription;
+    // optional extensions: null if not exported by the backend
+    SetSubPhaseSink setSubPhaseSink;
 };
 
 struct DynamicLib
 {
     std::string path;
     void *handle;
+    ExternFunctions functions;
+    std::uint64_t bench_desc_count;
+    std::vector<Handle> bench_descs; // as subscribed, to identify benchmarks in recordings
 
     DynamicLib(std::string p) :
-        path(p), handle(nullptr)
+        path(p), handle(nullptr), bench_desc_count(0)
     {
         handle = dlopen(path.c_str(), RTLD_NOW);
         if (!handle)
@@ -130,45 +143,111 @@ struct DynamicLib
 };
 
 ExternFunctions DynamicLibLoad::m_functions;
-DynamicLib *DynamicLibLoad::m_lib = nullptr;
+DynamicLib *DynamicLibLoad::m_lib             = nullptr;
+std::vector<DynamicLib *> DynamicLibLoad::m_loaded_libs;
+APICallRecorder *DynamicLibLoad::m_p_recorder = nullptr;
 
-void DynamicLibLoad::loadLibrary(const std::string &path)
+DynamicLibLoad::ActiveLibraryScope::ActiveLibraryScope(DynamicLib *p_lib) :
+    m_p_previous_lib(DynamicLibLoad::getActiveLibrary())
+{
+    DynamicLibLoad::setActiveLibrary(p_lib);
+}
+
+DynamicLibLoad::ActiveLibraryScope::~ActiveLibraryScope()
+{
+    if (m_p_previous_lib)
+        DynamicLibLoad::setActiveLibrary(m_p_previous_lib);
+}
+
+DynamicLib *DynamicLibLoad::loadLibrary(const std::string &path)
 {
     std::cout << "[ Info    ] Loading Backend Library..." << std::endl;
-    m_lib = new DynamicLib(path);
+    std::unique_ptr<DynamicLib> p_lib = std::make_unique<DynamicLib>(path);
+    ExternFunctions &functions        = p_lib->functions;
 
     std::cout << "[ Info    ] Finding Backend Symbols in Memory..." << std::endl;
-    m_functions.destroyHandle             = (DestroyHandle)loadSymbol(m_lib->handle, "destroyHandle");
-    m_functions.initEngine                = (InitEngine)loadSymbol(m_lib->handle, "initEngine");
-    m_functions.subscribeBenchmarksCount  = (SubscribeBenchmarksCount)loadSymbol(m_lib->handle, "subscribeBenchmarksCount");
-    m_functions.subscribeBenchmarks       = (SubscribeBenchmarks)loadSymbol(m_lib->handle, "subscribeBenchmarks");
-    m_functions.getWorkloadParamsDetails  = (GetWorkloadParamsDetails)loadSymbol(m_lib->handle, "getWorkloadParamsDetails");
-    m_functions.describeBenchmark         = (DescribeBenchmark)loadSymbol(m_lib->handle, "describeBenchmark");
-    m_functions.initBenchmark             = (InitBenchmark)loadSymbol(m_lib->handle, "initBenchmark");
-    m_functions.encode                    = (Encode)loadSymbol(m_lib->handle, "encode");
-    m_functions.decode                    = (Decode)loadSymbol(m_lib->handle, "decode");
-    m_functions.encrypt                   = (Encrypt)loadSymbol(m_lib->handle, "encrypt");
-    m_functions.decrypt                   = (Decrypt)loadSymbol(m_lib->handle, "decrypt");
-    m_functions.load                      = (Load)loadSymbol(m_lib->handle, "load");
-    m_functions.store                     = (Store)loadSymbol(m_lib->handle, "store");
-    m_functions.operate                   = (Operate)loadSymbol(m_lib->handle, "operate");
-    m_functions.getSchemeName             = (GetSchemeName)loadSymbol(m_lib->handle, "getSchemeName");
-    m_functions.getSchemeSecurityName     = (GetSchemeSecurityName)loadSymbol(m_lib->handle, "getSchemeSecurityName");
-    m_functions.getBenchmarkDescriptionEx = (GetBenchmarkDescriptionEx)loadSymbol(m_lib->handle, "getBenchmarkDescriptionEx");
-    m_functions.getErrorDescription       = (GetErrorDescription)loadSymbol(m_lib->handle, "getErrorDescription");
-    m_functions.getLastErrorDescription   = (GetLastErrorDescription)loadSymbol(m_lib->handle, "getLastErrorDescription");
+    functions.destroyHandle               = (DestroyHandle)loadSymbol(p_lib->handle, "destroyHandle");
+    functions.initEngine                  = (InitEngine)loadSymbol(p_lib->handle, "initEngine");
+    functions.subscribeBenchmarksCount    = (SubscribeBenchmarksCount)loadSymbol(p_lib->handle, "subscribeBenchmarksCount");
+    functions.subscribeBenchmarks         = (SubscribeBenchmarks)loadSymbol(p_lib->handle, "subscribeBenchmarks");
+    functions.getWorkloadParamsDetails    = (GetWorkloadParamsDetails)loadSymbol(p_lib->handle, "getWorkloadParamsDetails");
+    functions.describeBenchmark           = (DescribeBenchmark)loadSymbol(p_lib->handle, "describeBenchmark");
+    functions.initBenchmark               = (InitBenchmark)loadSymbol(p_lib->handle, "initBenchmark");
+    functions.encode                      = (Encode)loadSymbol(p_lib->handle, "encode");
+    functions.decode                      = (Decode)loadSymbol(p_lib->handle, "decode");
+    functions.encrypt                     = (Encrypt)loadSymbol(p_lib->handle, "encrypt");
+    functions.decrypt                     = (Decrypt)loadSymbol(p_lib->handle, "decrypt");
+    functions.load                        = (Load)loadSymbol(p_lib->handle, "load");
+    functions.store                       = (Store)loadSymbol(p_lib->handle, "store");
+    functions.operate                     = (Operate)loadSymbol(p_lib->handle, "operate");
+    functions.getSchemeName               = (GetSchemeName)loadSymbol(p_lib->handle, "getSchemeName");
+    functions.getSchemeSecurityName       = (GetSchemeSecurityName)loadSymbol(p_lib->handle, "getSchemeSecurityName");
+    functions.getBenchmarkDescriptionEx   = (GetBenchmarkDescriptionEx)loadSymbol(p_lib->handle, "getBenchmarkDescriptionEx");
+    functions.getErrorDescription         = (GetErrorDescription)loadSymbol(p_lib->handle, "getErrorDescription");
+    functions.getLastErrorDescription     = (GetLastErrorDescription)loadSymbol(p_lib->handle, "getLastErrorDescription");
+    functions.setSubPhaseSink             = (SetSubPhaseSink)dlsym(p_lib->handle, HEBENCH_EXT_SUBPHASE_SINK_SYMBOL);
+    dlerror(); // reset: extensions are optional
+    if (functions.setSubPhaseSink)
+    {
+        std::cout << "[ Info    ] Backend exports sub-phase timing extension." << std::endl;
+        functions.setSubPhaseSink(&SubPhaseTimings::push);
+    } // end if
     std::cout << "[    DONE ] " << std::endl;
+
+    m_loaded_libs.push_back(p_lib.release());
+    setActiveLibrary(m_loaded_libs.back());
+    return m_loaded_libs.back();
+}
+
+void DynamicLibLoad::setActiveLibrary(DynamicLib *p_lib)
+{
+    if (std::find(m_loaded_libs.begin(), m_loaded_libs.end(), p_lib) == m_loaded_libs.end())
+        throw std::invalid_argument("Backend library to activate is not loaded.");
+    if (p_lib != m_lib)
+    {
+        // recordings follow a single backend
+        endRecording();
+        m_lib       = p_lib;
+        m_functions = p_lib->functions;
+    } // end if
 }
 
 void DynamicLibLoad::unloadLibrary()
 {
-    if (m_lib)
+    endRecording();
+    for (DynamicLib *p_lib : m_loaded_libs)
     {
-        delete m_lib;
-        m_lib = nullptr;
+        if (p_lib->functions.setSubPhaseSink)
+            p_lib->functions.setSubPhaseSink(nullptr);
+        delete p_lib;
+    } // end for
+    m_loaded_libs.clear();
+    m_lib       = nullptr;
+    m_functions = ExternFunctions();
+}
+
+void DynamicLibLoad::beginRecording(const std::string &filename)
+{
+    if (!m_lib)
+        throw std::runtime_error("Cannot record API Bridge calls: no backend library loaded.");
+    endRecording();
+    m_p_recorder = new APICallRecorder(filename, m_lib->bench_descs);
+}
+
+void DynamicLibLoad::endRecording()
+{
+    if (m_p_recorder)
+    {
+        delete m_p_recorder;
+        m_p_recorder = nullptr;
     } // end if
 }
 
+bool DynamicLibLoad::hasSubPhaseTimings()
+{
+    return m_lib && m_functions.setSubPhaseSink;
+}
+
 void *DynamicLibLoad::loadSymbol(void *handle, const std::string &name)
 {
     void *fptr = dlsym(handle, name.c_str());
@@ -180,7 +259,10 @@ void *DynamicLibLoad::loadSymbol(void *handle, const std::string &name)
 
 ErrorCode DynamicLibLoad::destroyHandle(Handle h)
 {
-    return m_functions.destroyHandle(h);
+    ErrorCode retval = m_functions.destroyHandle(h);
+    if (m_p_recorder && retval == HEBENCH_ECODE_SUCCESS)
+        m_p_recorder->recordDestroyHandle(h);
+    return retval;
 }
 
 ErrorCode DynamicLibLoad::initEngine(Handle *h_engine)
@@ -190,12 +272,18 @@ ErrorCode DynamicLibLoad::initEngine(Handle *h_engine)
 
 ErrorCode DynamicLibLoad::subscribeBenchmarksCount(Handle h_engine, std::uint64_t *p_count)
 {
-    return m_functions.subscribeBenchmarksCount(h_engine, p_count);
+    ErrorCode retval = m_functions.subscribeBenchmarksCount(h_engine, p_count);
+    if (retval == HEBENCH_ECODE_SUCCESS && p_count)
+        m_lib->bench_desc_count = *p_count;
+    return retval;
 }
 
 ErrorCode DynamicLibLoad::subscribeBenchmarks(Handle h_engine, Handle *p_h_bench_descs)
 {
-    return m_functions.subscribeBenchmarks(h_engine, p_h_bench_descs);
+    ErrorCode retval = m_functions.subscribeBenchmarks(h_engine, p_h_bench_descs);
+    if (retval == HEBENCH_ECODE_SUCCESS && p_h_bench_descs)
+        m_lib->bench_descs.assign(p_h_bench_descs, p_h_bench_descs + m_lib->bench_desc_count);
+    return retval;
 }
 
 ErrorCode DynamicLibLoad::getWorkloadParamsDetails(Handle h_engine, Handle h_bench_desc, std::uint64_t *p_param_count, std::uint64_t *p_default_count)
@@ -210,41 +298,62 @@ ErrorCode DynamicLibLoad::describeBenchmark(Handle h_engine, Handle h_bench_desc
 
 ErrorCode DynamicLibLoad::initBenchmark(Handle h_engine, Handle h_bench_desc, const WorkloadParams *p_params, Handle *h_benchmark)
 {
-    return m_functions.initBenchmark(h_engine, h_bench_desc, p_params, h_benchmark);
+    ErrorCode retval = m_functions.initBenchmark(h_engine, h_bench_desc, p_params, h_benchmark);
+    if (m_p_recorder && retval == HEBENCH_ECODE_SUCCESS)
+        m_p_recorder->recordInitBenchmark(h_bench_desc, p_params, *h_benchmark);
+    return retval;
 }
 
 ErrorCode DynamicLibLoad::encode(Handle h_benchmark, const PackedData *p_parameters, Handle *h_plaintext)
 {
-    return m_functions.encode(h_benchmark, p_parameters, h_plaintext);
+    ErrorCode retval = m_functions.encode(h_benchmark, p_parameters, h_plaintext);
+    if (m_p_recorder && retval == HEBENCH_ECODE_SUCCESS)
+        m_p_recorder->recordEncode(h_benchmark, p_parameters, *h_plaintext);
+    return retval;
 }
 
 ErrorCode DynamicLibLoad::decode(Handle h_benchmark, Handle h_plaintext, PackedData *p_native)
 {
-    return m_functions.decode(h_benchmark, h_plaintext, p_native);
+    ErrorCode retval = m_functions.decode(h_benchmark, h_plaintext, p_native);
+    if (m_p_recorder && retval == HEBENCH_ECODE_SUCCESS)
+        m_p_recorder->recordDecode(h_benchmark, h_plaintext, p_native);
+    return retval;
 }
 
 ErrorCode DynamicLibLoad::encrypt(Handle h_benchmark, Handle h_plaintext, Handle *h_ciphertext)
 {
-    return m_functions.encrypt(h_benchmark, h_plaintext, h_ciphertext);
+    ErrorCode retval = m_functions.encrypt(h_benchmark, h_plaintext, h_ciphertext);
+    if (m_p_recorder && retval == HEBENCH_ECODE_SUCCESS)
+        m_p_recorder->recordEncrypt(h_benchmark, h_plaintext, *h_ciphertext);
+    return retval;
 }
 
 ErrorCode DynamicLibLoad::decrypt(Handle h_benchmark, Handle h_ciphertext, Handle *h_plaintext)
 {
-    return m_functions.decrypt(h_benchmark, h_ciphertext, h_plaintext);
+    ErrorCode retval = m_functions.decrypt(h_benchmark, h_ciphertext, h_plaintext);
+    if (m_p_recorder && retval == HEBENCH_ECODE_SUCCESS)
+        m_p_recorder->recordDecrypt(h_benchmark, h_ciphertext, *h_plaintext);
+    return retval;
 }
 
 ErrorCode DynamicLibLoad::load(Handle h_benchmark,
                                const Handle *h_local_packed_params, std::uint64_t local_count,
                                Handle *h_remote_packed_params)
 {
-    return m_functions.load(h_benchmark, h_local_packed_params, local_count, h_remote_packed_params);
+    ErrorCode retval = m_functions.load(h_benchmark, h_local_packed_params, local_count, h_remote_packed_params);
+    if (m_p_recorder && retval == HEBENCH_ECODE_SUCCESS)
+        m_p_recorder->recordLoad(h_benchmark, h_local_packed_params, local_count, *h_remote_packed_params);
+    return retval;
 }
 
 ErrorCode DynamicLibLoad::store(Handle h_benchmark,
                                 Handle h_remote,
                                 Handle *h_local_packed_params, std::uint64_t local_count)
 {
-    return m_functions.store(h_benchmark, h_remote, h_local_packed_params, local_count);
+    ErrorCode retval = m_functions.store(h_benchmark, h_remote, h_local_packed_params, local_count);
+    if (m_p_recorder && retval == HEBENCH_ECODE_SUCCESS)
+        m_p_recorder->recordStore(h_benchmark, h_remote, h_local_packed_params, local_count);
+    return retval;
 }
 
 ErrorCode DynamicLibLoad::operate(Handle h_benchmark,
@@ -252,7 +361,10 @@ ErrorCode DynamicLibLoad::operate(Handle h_benchmark,
                                   const ParameterIndexer *p_param_indexers,
                                   Handle *h_remote_output)
 {
-    return m_functions.operate(h_benchmark, h_remote_packed_params, p_param_indexers, h_remote_output);
+    ErrorCode retval = m_functions.operate(h_benchmark, h_remote_packed_params, p_param_indexers, h_remote_output);
+    if (m_p_recorder && retval == HEBENCH_ECODE_SUCCESS)
+        m_p_recorder->recordOperate(h_benchmark, h_remote_packed_params, p_param_indexers, *h_remote_output);
+    return retval;
 }
 
 std::uint64_t DynamicLibLoad::getSchemeName(Handle h_engine, Scheme s, char *p_name, std::uint64_t size)
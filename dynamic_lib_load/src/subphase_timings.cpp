@@ -0,0 +1,60 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#include "subphase_timings.h"
+
+namespace hebench {
+namespace APIBridge {
+
+SubPhaseTimings::Slot SubPhaseTimings::m_slots[SubPhaseTimings::Capacity];
+std::atomic<std::uint64_t> SubPhaseTimings::m_next(0);
+std::atomic<std::uint64_t> SubPhaseTimings::m_dropped(0);
+
+void SubPhaseTimings::push(const char *name, std::uint64_t wall_time_ns, std::uint64_t cpu_time_ns)
+{
+    // claim a slot: no two threads get the same one
+    std::uint64_t slot_i = m_next.fetch_add(1, std::memory_order_relaxed);
+    if (slot_i >= Capacity)
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    } // end if
+
+    Slot &slot = m_slots[slot_i];
+    std::strncpy(slot.timing.name, name ? name : "", HEBENCH_EXT_SUBPHASE_NAME_SIZE - 1);
+    slot.timing.name[HEBENCH_EXT_SUBPHASE_NAME_SIZE - 1] = '\0';
+    slot.timing.wall_time_ns                             = wall_time_ns;
+    slot.timing.cpu_time_ns                              = cpu_time_ns;
+    // publish the slot contents to drain()
+    slot.ready.store(true, std::memory_order_release);
+}
+
+void SubPhaseTimings::drain(std::vector<SubPhaseTiming> &out_timings)
+{
+    out_timings.clear();
+    std::uint64_t claimed = m_next.load(std::memory_order_acquire);
+    std::uint64_t slot_i  = 0;
+    do
+    {
+        std::uint64_t count = std::min<std::uint64_t>(claimed, Capacity);
+        for (; slot_i < count; ++slot_i)
+        {
+            Slot &slot = m_slots[slot_i];
+            // a claimed slot is reused after the reset below, so wait for its
+            // push to complete instead of leaving it behind
+            while (!slot.ready.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            out_timings.push_back(slot.timing);
+            slot.ready.store(false, std::memory_order_relaxed);
+        } // end for
+        // reset only if no slot was claimed meanwhile; otherwise collect it too
+    } while (!m_next.compare_exchange_weak(claimed, 0, std::memory_order_acq_rel, std::memory_order_acquire));
+}
+
+} // namespace APIBridge
+} // namespace hebench
@@ -6,6 +6,7 @@
 #define _HEBench_Harness_Report_H_0596d40a3cce4b108a81595c50eb286d
 
 #include <stdint.h>
+#include <stdio.h>
 
 #include "hebench_report_types.h"
 
@@ -114,6 +115,41 @@ extern "C"
      * @returns `true` on success.
      */
     int32_t getEvent(void *p_report, TimingReportEventC *p_event, uint64_t index);
+    /**
+     * @brief Copies a range of events from the report.
+     * @param p_report
+     * @param[out] p_events Buffer with room for, at least, \p count events
+     * where to store the copies.
+     * @param[in] start_index Index of the first event to copy.
+     * @param[in] count Maximum number of events to copy.
+     * @returns Number of events copied. This is less than \p count if the
+     * range goes past the last event in the report. Returns 0 on error.
+     */
+    uint64_t getEvents(void *p_report, TimingReportEventC *p_events, uint64_t start_index, uint64_t count);
+    /**
+     * @brief Retrieves a read-only pointer to the events in the report.
+     * @param p_report
+     * @param[out] p_count If not null, receives the number of events pointed
+     * to by the returned pointer.
+     * @returns Pointer to a contiguous array with all the events in the
+     * report, in order, or null on error or if the report has no events.
+     * @details The returned array is owned by the report and no copies are
+     * made. The pointer remains valid until the events of the report are
+     * modified by `addEvent()`, `setEventCapacity()`, `clearEvents()` or by
+     * merging writer thread shards, or until the report is freed.
+     */
+    const TimingReportEventC *getEventsData(void *p_report, uint64_t *p_count);
+    /**
+     * @brief Retrieves a read-only, column-wise view of the events in the report.
+     * @param p_report
+     * @param[out] p_columns Structure where to store the pointers to each column.
+     * @returns `true` on success.
+     * @details The columns are owned by the report. They are built on first
+     * request and remain valid until the events of the report are modified,
+     * or until the report is freed. Subsequent requests without modifications
+     * in between do not copy the events again.
+     */
+    int32_t getEventColumns(void *p_report, TimingReportEventColumnsC *p_columns);
     uint64_t getEventCount(void *p_report);
     uint64_t getEventCapacity(void *p_report);
     /**
@@ -125,6 +161,43 @@ extern "C"
     int32_t setEventCapacity(void *p_report, uint64_t new_capacity);
     int32_t clearEvents(void *p_report);
 
+    // multi-threaded event recording
+
+    /**
+     * @brief Registers the calling thread as an event writer for the report.
+     * @param p_report
+     * @returns `true` on success.
+     * @details Each registered writer thread records its events into its own
+     * shard of the report. Calls to `addEvent()` from a registered thread append
+     * to the thread shard without locking, so several threads can add events to
+     * the same report concurrently. Calls from threads not registered keep the
+     * single-writer behavior.
+     *
+     * Shards are merged into the report deterministically by `mergeEventShards()`
+     * and automatically by `save2CSV()`, `convert2CSV()` and `generateSummaryCSV()`:
+     * shard events are inserted by event wall start time, while events added by
+     * threads not registered keep their order. Events in shards are not
+     * visible through `getEvent()` or `getEventCount()` until merged. Event types
+     * of shard events must be added with a non-empty header before merging.
+     *
+     * Merging must not occur while registered threads are still adding events.
+     */
+    int32_t registerEventWriterThread(void *p_report);
+    /**
+     * @brief Unregisters the calling thread as an event writer for the report.
+     * @param p_report
+     * @returns `true` on success.
+     * @details Events already recorded by the thread are kept until next merge.
+     */
+    int32_t unregisterEventWriterThread(void *p_report);
+    /**
+     * @brief Merges the events recorded by writer threads into the report.
+     * @param p_report
+     * @returns `true` on success.
+     * @sa registerEventWriterThread()
+     */
+    int32_t mergeEventShards(void *p_report);
+
     // CSV
     int32_t save2CSV(void *p_report, const char *filename);
     /**
@@ -153,6 +226,63 @@ extern "C"
      */
     void freeCSVContent(char *p_csv_content);
 
+    // streamed CSV
+
+    /**
+     * @brief Writes the report in CSV format through the specified callback.
+     * @param p_report
+     * @param[in] write_callback Function called for every chunk of CSV content,
+     * in order. Cannot be null.
+     * @param[in] p_user_data Passed as is to every call to \p write_callback.
+     * @returns `true` on success.
+     * @details Content is produced in chunks of bounded size and handed directly
+     * to \p write_callback without building the full CSV in memory. Content
+     * is the same as that produced by `convert2CSV()`.
+     */
+    int32_t convert2CSVCallback(void *p_report, ReportWriteCallback write_callback, void *p_user_data);
+    /**
+     * @brief Writes the report in CSV format to an open file descriptor.
+     * @param p_report
+     * @param[in] fd File descriptor open for writing. It is not closed.
+     * @returns `true` on success.
+     * @sa convert2CSVCallback()
+     */
+    int32_t convert2CSVFD(void *p_report, int32_t fd);
+    /**
+     * @brief Writes the report in CSV format to an open `FILE` stream.
+     * @param p_report
+     * @param[in] p_file Stream open for writing. It is not closed nor flushed.
+     * @returns `true` on success.
+     * @sa convert2CSVCallback()
+     */
+    int32_t convert2CSVFile(void *p_report, FILE *p_file);
+    /**
+     * @brief Writes the summary of the report in CSV format through the
+     * specified callback.
+     * @param p_report
+     * @param[out] p_main_event_summary TimingReportEventC struct where to store the
+     * summary of the main event.
+     * @param[in] write_callback Function called for every chunk of CSV content,
+     * in order. Cannot be null.
+     * @param[in] p_user_data Passed as is to every call to \p write_callback.
+     * @returns `true` on success.
+     * @details Content is the same as that produced by `generateSummaryCSV()`.
+     */
+    int32_t generateSummaryCSVCallback(void *p_report, TimingReportEventC *p_main_event_summary,
+                                       ReportWriteCallback write_callback, void *p_user_data);
+    /**
+     * @brief Writes the summary of the report in CSV format to an open file
+     * descriptor.
+     * @sa generateSummaryCSVCallback()
+     */
+    int32_t generateSummaryCSVFD(void *p_report, TimingReportEventC *p_main_event_summary, int32_t fd);
+    /**
+     * @brief Writes the summary of the report in CSV format to an open `FILE`
+     * stream.
+     * @sa generateSummaryCSVCallback()
+     */
+    int32_t generateSummaryCSVFile(void *p_report, TimingReportEventC *p_main_event_summary, FILE *p_file);
+
     void *loadReportFromCSV(const char *p_csv_content, char error_description[MAX_DESCRIPTION_BUFFER_SIZE]);
     void *loadReportFromCSVFile(const char *filename, char error_description[MAX_DESCRIPTION_BUFFER_SIZE]);
 
@@ -5,6 +5,7 @@
 #ifndef _HEBench_Harness_Report_CPP_H_0596d40a3cce4b108a81595c50eb286d
 #define _HEBench_Harness_Report_CPP_H_0596d40a3cce4b108a81595c50eb286d
 
+#include <ostream>
 #include <string>
 
 #include "hebench_report_types.h"
@@ -63,17 +64,62 @@ public:
 
     void addEvent(const TimingReportEventC &p_event);
     void getEvent(TimingReportEventC &p_event, uint64_t index) const;
+    /**
+     * @brief Copies a range of events from this report.
+     * @param[out] p_events Buffer with room for, at least, \p count events.
+     * @param[in] start_index Index of the first event to copy.
+     * @param[in] count Maximum number of events to copy.
+     * @return Number of events copied.
+     */
+    uint64_t getEvents(TimingReportEventC *p_events, uint64_t start_index, uint64_t count) const;
+    /**
+     * @brief Read-only pointer to the contiguous array of events in this report,
+     * or null if there are no events.
+     * @details Number of events is given by getEventCount(). No copies are
+     * made. The pointer remains valid until the events of this report are
+     * modified.
+     */
+    const TimingReportEventC *getEventsData() const;
+    /**
+     * @brief Read-only column-wise view of the events in this report.
+     * @details The columns remain valid until the events of this report are
+     * modified.
+     */
+    TimingReportEventColumnsC getEventColumns() const;
     uint64_t getEventCount() const;
     uint64_t getEventCapacity() const;
     void setEventCapacity(uint64_t new_capacity);
     void clear();
 
+    /**
+     * @brief Registers the calling thread as an event writer for this report.
+     * @details Events added by registered writer threads are recorded without
+     * locking into per-thread shards and merged by start time on save or when
+     * calling mergeEventShards().
+     * @sa hebench::TestHarness::Report::registerEventWriterThread()
+     */
+    void registerWriterThread();
+    void unregisterWriterThread();
+    void mergeEventShards();
+
     // CSV
 
     void save2CSV(const std::string &filename);
     std::string convert2CSV();
+    /**
+     * @brief Writes this report in CSV format to the specified stream.
+     * @details Content is streamed in bounded chunks without building the
+     * whole CSV in memory.
+     */
+    void convert2CSV(std::ostream &os);
 
     std::string generateSummaryCSV(TimingReportEventC &main_event_summary);
+    /**
+     * @brief Writes the summary of this report in CSV format to the specified stream.
+     * @details Content is streamed in bounded chunks without building the
+     * whole CSV in memory.
+     */
+    void generateSummaryCSV(TimingReportEventC &main_event_summary, std::ostream &os);
 
     static TimingReport loadReportFromCSV(const std::string &s_csv_content);
     static TimingReport loadReportFromCSVFile(const std::string &filename);
@@ -0,0 +1,119 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Report_Fingerprint_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Report_Fingerprint_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hebench {
+namespace TestHarness {
+namespace Report {
+namespace cpp {
+
+/**
+ * @brief Description of the machine, build and backend that produced a report.
+ * @details A fingerprint is a list of key-value entries organized in groups:
+ *
+ * - GroupMachine: hardware and operating system configuration (CPU model,
+ * cores, caches, memory, kernel, frequency governor, SMT, turbo...).
+ * - GroupBuild: compiler and flags used to build the test harness.
+ * - GroupBackend: backend library file and its content hash.
+ * - GroupEnvironment: runtime environment knobs applied to the run, if any
+ * (see Test Harness environment sweeps).
+ *
+ * Fingerprints are stored in the report header as a section of the form:
+ * @code
+ * Fingerprint,
+ * , Machine,
+ * , , CPU model, "..."
+ * , Build,
+ * , , Compiler, "..."
+ * @endcode
+ *
+ * Reports whose machine or backend fingerprints differ are not comparable:
+ * timings from different hardware or a different backend library must not
+ * be aggregated. Differences in the build or environment only warrant a
+ * warning.
+ */
+class Fingerprint
+{
+public:
+    static constexpr const char *SectionTitle     = "Fingerprint";
+    static constexpr const char *GroupMachine     = "Machine";
+    static constexpr const char *GroupBuild       = "Build";
+    static constexpr const char *GroupBackend     = "Backend";
+    static constexpr const char *GroupEnvironment = "Environment";
+    static constexpr const char *Unknown          = "Unknown";
+
+    struct Entry
+    {
+        std::string group;
+        std::string key;
+        std::string value;
+    };
+
+    struct Difference
+    {
+        std::string group;
+        std::string key;
+        std::string lhs_value; // Unknown if missing in the first fingerprint
+        std::string rhs_value; // Unknown if missing in the second fingerprint
+    };
+
+    /**
+     * @brief Sets the value of an entry.
+     * @details Entries keep the order in which they were first set.
+     */
+    void set(const std::string &group, const std::string &key, const std::string &value);
+    /**
+     * @brief Retrieves the value of an entry.
+     * @returns The value of the entry or Unknown if the entry does not exist.
+     */
+    std::string get(const std::string &group, const std::string &key) const;
+    const std::vector<Entry> &getEntries() const { return m_entries; }
+    bool empty() const { return m_entries.empty(); }
+
+    /**
+     * @brief Generates the report header section for this fingerprint.
+     * @returns The section, ending in a new line, or an empty string if this
+     * fingerprint is empty.
+     */
+    std::string toHeader() const;
+    /**
+     * @brief Extracts the fingerprint from a report header.
+     * @returns The fingerprint found in \p header. The result is empty if
+     * \p header has no fingerprint section, as is the case for reports
+     * generated before fingerprints were collected.
+     */
+    static Fingerprint fromHeader(const std::string &header);
+
+    /**
+     * @brief Lists the entries that differ between two fingerprints.
+     * @details If either fingerprint is empty, nothing is known about it, so,
+     * no differences are listed.
+     */
+    static std::vector<Difference> compare(const Fingerprint &lhs, const Fingerprint &rhs);
+    /**
+     * @brief Determines whether a difference makes reports incomparable.
+     * @returns `true` if \p diff is in the machine or backend groups.
+     */
+    static bool isIncompatible(const Difference &diff);
+    /**
+     * @brief Describes a list of differences, one per line.
+     */
+    static std::string toString(const std::vector<Difference> &diffs);
+
+private:
+    std::vector<Entry> m_entries;
+};
+
+} // namespace cpp
+} // namespace Report
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Report_Fingerprint_H_0596d40a3cce4b108a81595c50eb286d
@@ -54,9 +54,68 @@ extern "C"
          * @details Set to empty string if no description.
          */
         char description[MAX_TIME_REPORT_EVENT_DESCRIPTION_SIZE];
+        /**
+         * @brief ID of the span measured by this event.
+         * @details Unique among the events of a report. Events measured by
+         * Test Harness always have a span ID, whether other events are nested
+         * inside them or not. `0` for events loaded from reports that predate
+         * spans.
+         */
+        uint64_t span_id;
+        /**
+         * @brief ID of the span that encloses this event.
+         * @details Set to `0` for top level events.
+         */
+        uint64_t parent_span_id;
+        /**
+         * @brief Nesting depth of this event.
+         * @details `0` for top level events, and the depth of the parent plus
+         * `1` for nested events.
+         */
+        uint32_t depth;
     };
     typedef struct _TimingReportEventC TimingReportEventC;
 
+    /**
+     * @brief Read-only, column-wise view of the events in a report.
+     * @details Each array has `count` elements, where element `i` of each array
+     * corresponds to the field of the same name in the event at index `i` of
+     * the report. See TimingReportEventC for the meaning of each field.
+     *
+     * Arrays are owned by the report. They remain valid until the events of the
+     * report are modified or the report is freed.
+     */
+    struct _TimingReportEventColumnsC
+    {
+        uint64_t count;
+        const uint32_t *event_type_id;
+        const double *cpu_time_start;
+        const double *cpu_time_end;
+        const double *wall_time_start;
+        const double *wall_time_end;
+        const int64_t *time_interval_ratio_num;
+        const int64_t *time_interval_ratio_den;
+        const uint64_t *iterations;
+        const uint64_t *span_id;
+        const uint64_t *parent_span_id;
+        const uint32_t *depth;
+    };
+    typedef struct _TimingReportEventColumnsC TimingReportEventColumnsC;
+
+    /**
+     * @brief Callback used to stream generated report content.
+     * @param[in] p_data Pointer to the chunk of content to write. This is not
+     * null-terminated.
+     * @param[in] size Number of bytes in the chunk.
+     * @param[in] p_user_data User data passed to the function that generates
+     * the content.
+     * @returns Non-zero if the whole chunk was written successfully, 0 to signal
+     * an error and stop generating content.
+     * @details Content is generated in chunks of bounded size, so memory used
+     * does not depend on size of the report.
+     */
+    typedef int32_t (*ReportWriteCallback)(const char *p_data, uint64_t size, void *p_user_data);
+
 #define MAX_SYMBOL_BUFFER_SIZE 4
     struct _UnitPrefix
     {
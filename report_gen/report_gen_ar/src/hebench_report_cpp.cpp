@@ -181,7 +181,7 @@ std::string TimingReport::getEventTypeHeader(uint32_t event_type_id) const
     if (n <= 0)
         throw std::runtime_error(INTERNAL_LOG_MSG("Unexpected error retrieving event type header."));
     ch_retval.resize(n);
-    if (hebench::TestHarness::Report::getEventTypeHeader(m_lib_handle, event_type_id, ch_retval.data(), ch_retval.size() <= 0))
+    if (hebench::TestHarness::Report::getEventTypeHeader(m_lib_handle, event_type_id, ch_retval.data(), ch_retval.size()) <= 0)
         throw std::runtime_error(INTERNAL_LOG_MSG("Unexpected error retrieving event type header."));
     return ch_retval.data();
 }
@@ -213,6 +213,27 @@ void TimingReport::getEvent(hebench::TestHarness::Report::TimingReportEventC &p_
         throw std::runtime_error(INTERNAL_LOG_MSG("Error retrieving event from report."));
 }
 
+uint64_t TimingReport::getEvents(hebench::TestHarness::Report::TimingReportEventC *p_events,
+                                 uint64_t start_index, uint64_t count) const
+{
+    if (!p_events && count > 0)
+        throw std::invalid_argument(INTERNAL_LOG_MSG("Invalid null \"p_events\"."));
+    return hebench::TestHarness::Report::getEvents(m_lib_handle, p_events, start_index, count);
+}
+
+const hebench::TestHarness::Report::TimingReportEventC *TimingReport::getEventsData() const
+{
+    return hebench::TestHarness::Report::getEventsData(m_lib_handle, nullptr);
+}
+
+hebench::TestHarness::Report::TimingReportEventColumnsC TimingReport::getEventColumns() const
+{
+    hebench::TestHarness::Report::TimingReportEventColumnsC retval;
+    if (!hebench::TestHarness::Report::getEventColumns(m_lib_handle, &retval))
+        throw std::runtime_error(INTERNAL_LOG_MSG("Error retrieving event columns from report."));
+    return retval;
+}
+
 uint64_t TimingReport::getEventCount() const
 {
     return hebench::TestHarness::Report::getEventCount(m_lib_handle);
@@ -235,6 +256,24 @@ void TimingReport::clear()
         throw std::runtime_error(INTERNAL_LOG_MSG("Error clearning up events."));
 }
 
+void TimingReport::registerWriterThread()
+{
+    if (!hebench::TestHarness::Report::registerEventWriterThread(m_lib_handle))
+        throw std::runtime_error(INTERNAL_LOG_MSG("Error registering event writer thread."));
+}
+
+void TimingReport::unregisterWriterThread()
+{
+    if (!hebench::TestHarness::Report::unregisterEventWriterThread(m_lib_handle))
+        throw std::runtime_error(INTERNAL_LOG_MSG("Error unregistering event writer thread."));
+}
+
+void TimingReport::mergeEventShards()
+{
+    if (!hebench::TestHarness::Report::mergeEventShards(m_lib_handle))
+        throw std::runtime_error(INTERNAL_LOG_MSG("Error merging event shards."));
+}
+
 void TimingReport::save2CSV(const std::string &filename)
 {
     if (!hebench::TestHarness::Report::save2CSV(m_lib_handle, filename.c_str()))
@@ -269,6 +308,25 @@ std::string TimingReport::generateSummaryCSV(hebench::TestHarness::Report::Timin
     return retval;
 }
 
+static int32_t writeToOStream(const char *p_data, uint64_t size, void *p_user_data)
+{
+    std::ostream *p_os = reinterpret_cast<std::ostream *>(p_user_data);
+    p_os->write(p_data, static_cast<std::streamsize>(size));
+    return (*p_os) ? 1 : 0;
+}
+
+void TimingReport::convert2CSV(std::ostream &os)
+{
+    if (!hebench::TestHarness::Report::convert2CSVCallback(m_lib_handle, &writeToOStream, &os))
+        throw std::runtime_error(INTERNAL_LOG_MSG("Error converting report to CSV format."));
+}
+
+void TimingReport::generateSummaryCSV(hebench::TestHarness::Report::TimingReportEventC &main_event_summary, std::ostream &os)
+{
+    if (!hebench::TestHarness::Report::generateSummaryCSVCallback(m_lib_handle, &main_event_summary, &writeToOStream, &os))
+        throw std::runtime_error(INTERNAL_LOG_MSG("Error generating report summary."));
+}
+
 TimingReport TimingReport::loadReportFromCSV(const std::string &s_csv_content)
 {
     TimingReport retval;
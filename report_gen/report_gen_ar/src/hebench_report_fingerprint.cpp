@@ -0,0 +1,195 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <sstream>
+
+#include "hebench_report_fingerprint.h"
+
+namespace hebench {
+namespace TestHarness {
+namespace Report {
+namespace cpp {
+
+namespace {
+
+std::string trim(const std::string &s)
+{
+    static const char *WhiteSpace = " \t\r\n";
+    std::size_t first             = s.find_first_not_of(WhiteSpace);
+    if (first == std::string::npos)
+        return std::string();
+    return s.substr(first, s.find_last_not_of(WhiteSpace) - first + 1);
+}
+
+std::string quoteCSV(const std::string &s)
+{
+    std::string retval = "\"";
+    for (char ch : s)
+    {
+        if (ch == '"')
+            retval += "\"\"";
+        else if (ch == '\n' || ch == '\r')
+            retval += ' ';
+        else
+            retval += ch;
+    } // end for
+    retval += '"';
+    return retval;
+}
+
+/**
+ * @brief Splits a CSV line into its fields, removing quotes and surrounding
+ * white space.
+ */
+std::vector<std::string> splitCSV(const std::string &line)
+{
+    std::vector<std::string> retval;
+    std::string field;
+    bool b_quoted      = false;
+    bool b_quote_field = false;
+    for (std::size_t i = 0; i < line.size(); ++i)
+    {
+        char ch = line[i];
+        if (b_quoted)
+        {
+            if (ch == '"' && i + 1 < line.size() && line[i + 1] == '"')
+            {
+                field += '"';
+                ++i;
+            } // end if
+            else if (ch == '"')
+                b_quoted = false;
+            else
+                field += ch;
+        } // end if
+        else if (ch == '"')
+        {
+            b_quoted      = true;
+            b_quote_field = true;
+            field.clear(); // drop white space before the opening quote
+        } // end else if
+        else if (ch == ',')
+        {
+            retval.push_back(b_quote_field ? field : trim(field));
+            field.clear();
+            b_quote_field = false;
+        } // end else if
+        else if (!b_quote_field)
+            field += ch;
+    } // end for
+    retval.push_back(b_quote_field ? field : trim(field));
+    return retval;
+}
+
+} // namespace
+
+void Fingerprint::set(const std::string &group, const std::string &key, const std::string &value)
+{
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                           [&group, &key](const Entry &entry) { return entry.group == group && entry.key == key; });
+    if (it == m_entries.end())
+        m_entries.push_back(Entry{ group, key, value });
+    else
+        it->value = value;
+}
+
+std::string Fingerprint::get(const std::string &group, const std::string &key) const
+{
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                           [&group, &key](const Entry &entry) { return entry.group == group && entry.key == key; });
+    return it == m_entries.end() ? std::string(Unknown) : it->value;
+}
+
+std::string Fingerprint::toHeader() const
+{
+    std::stringstream ss;
+    if (!m_entries.empty())
+    {
+        ss << SectionTitle << "," << std::endl;
+        std::string group;
+        for (const Entry &entry : m_entries)
+        {
+            if (entry.group != group || &entry == &m_entries.front())
+            {
+                group = entry.group;
+                ss << ", " << group << "," << std::endl;
+            } // end if
+            ss << ", , " << entry.key << ", " << quoteCSV(entry.value) << std::endl;
+        } // end for
+    } // end if
+    return ss.str();
+}
+
+Fingerprint Fingerprint::fromHeader(const std::string &header)
+{
+    Fingerprint retval;
+
+    std::istringstream is(header);
+    std::string line;
+    bool b_in_section = false;
+    std::string group;
+    while (std::getline(is, line))
+    {
+        if (!b_in_section)
+        {
+            std::vector<std::string> fields = splitCSV(line);
+            b_in_section                    = !fields.empty() && fields.front() == SectionTitle;
+        } // end if
+        else
+        {
+            // section ends at the first line that is not indented
+            if (line.empty() || line.front() != ',')
+                break;
+            std::vector<std::string> fields = splitCSV(line);
+            if (fields.size() >= 2 && !fields[1].empty())
+                group = fields[1];
+            else if (fields.size() >= 4 && !fields[2].empty())
+                retval.set(group, fields[2], fields[3]);
+        } // end else
+    } // end while
+
+    return retval;
+}
+
+std::vector<Fingerprint::Difference> Fingerprint::compare(const Fingerprint &lhs, const Fingerprint &rhs)
+{
+    std::vector<Difference> retval;
+    if (!lhs.empty() && !rhs.empty())
+    {
+        for (const Entry &entry : lhs.m_entries)
+        {
+            std::string rhs_value = rhs.get(entry.group, entry.key);
+            if (rhs_value != entry.value)
+                retval.push_back(Difference{ entry.group, entry.key, entry.value, rhs_value });
+        } // end for
+        // entries missing in the first fingerprint
+        for (const Entry &entry : rhs.m_entries)
+        {
+            bool b_missing = std::none_of(lhs.m_entries.begin(), lhs.m_entries.end(),
+                                          [&entry](const Entry &lhs_entry) { return lhs_entry.group == entry.group && lhs_entry.key == entry.key; });
+            if (b_missing && entry.value != Unknown)
+                retval.push_back(Difference{ entry.group, entry.key, Unknown, entry.value });
+        } // end for
+    } // end if
+    return retval;
+}
+
+bool Fingerprint::isIncompatible(const Difference &diff)
+{
+    return diff.group == GroupMachine || diff.group == GroupBackend;
+}
+
+std::string Fingerprint::toString(const std::vector<Difference> &diffs)
+{
+    std::stringstream ss;
+    for (const Difference &diff : diffs)
+        ss << diff.group << " " << diff.key << ": \"" << diff.lhs_value << "\" vs \"" << diff.rhs_value << "\"" << std::endl;
+    return ss.str();
+}
+
+} // namespace cpp
+} // namespace Report
+} // namespace TestHarness
+} // namespace hebench
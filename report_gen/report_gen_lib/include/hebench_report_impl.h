@@ -6,8 +6,10 @@
 #define _HEBench_TimingReport_H_0596d40a3cce4b108a81595c50eb286d
 
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <ratio>
 #include <string>
 #include <unordered_map>
@@ -24,7 +26,8 @@ class TimingReport
 public:
     // section indicators for parsing generated CSV
 
-    static constexpr const char *TagVersion      = "#v,0,1,1";
+    static constexpr const char *TagVersion      = "#v,0,1,2";
+    static constexpr const char *TagVersionFlat  = "#v,0,1,1"; // previous version, without spans
     static constexpr const char *TagReportHeader = "#0100"; // header at the start of the test
     static constexpr const char *TagFailedTest   = "#XXXX"; // indicates failed test (validation failed)
     static constexpr const char *TagReportData   = "#0200"; // start of the data
@@ -37,17 +40,94 @@ public:
     static double computeElapsedCPUTime(const TimingReportEventC &event);
 
     TimingReport();
+    ~TimingReport();
 
     void newEventType(std::uint32_t set_id, const std::string &set_header, bool is_main_event = false);
     const std::unordered_map<std::uint32_t, std::string> &getEventTypes() const { return m_event_headers; }
 
     std::uint32_t getMainEventID() const { return m_main_event; }
 
-    void newEvent(std::shared_ptr<TimingReportEventC> p_event, const std::string &set_header = std::string());
-    const std::vector<std::shared_ptr<TimingReportEventC>> &getEvents() const { return m_events; }
+    /**
+     * @brief Column-wise view of the events in a report.
+     * @details Each column has as many elements as events in the report.
+     */
+    struct EventColumns
+    {
+        std::vector<std::uint32_t> event_type_id;
+        std::vector<double> cpu_time_start;
+        std::vector<double> cpu_time_end;
+        std::vector<double> wall_time_start;
+        std::vector<double> wall_time_end;
+        std::vector<std::int64_t> time_interval_ratio_num;
+        std::vector<std::int64_t> time_interval_ratio_den;
+        std::vector<std::uint64_t> iterations;
+        std::vector<std::uint64_t> span_id;
+        std::vector<std::uint64_t> parent_span_id;
+        std::vector<std::uint32_t> depth;
+    };
+
+    void newEvent(const TimingReportEventC &event, const std::string &set_header = std::string());
+    /**
+     * @brief Events in this report, stored contiguously in order of insertion.
+     * @details References and pointers into the returned vector remain valid
+     * until the events of this report are modified.
+     */
+    const std::vector<TimingReportEventC> &getEvents() const { return m_events; }
+    /**
+     * @brief Column-wise view of the events in this report.
+     * @details The columns are built on first request and cached until the
+     * events of this report are modified. References and pointers into the
+     * returned columns remain valid until then.
+     */
+    const EventColumns &getEventColumns();
     void reserveCapacityForEvents(std::size_t new_capacity);
     void clear();
 
+    /**
+     * @brief Registers the calling thread as an event writer for this report.
+     * @details A registered writer thread owns an event shard in this report.
+     * Events added by the thread through newWriterThreadEvent() are appended
+     * to its shard without locking. Shards are merged into the main event list
+     * by mergeEventShards().
+     *
+     * Registering an already registered thread has no effect.
+     */
+    void registerWriterThread();
+    /**
+     * @brief Unregisters the calling thread as an event writer for this report.
+     * @details Events already recorded in the thread shard are kept until the
+     * next merge.
+     */
+    void unregisterWriterThread();
+    bool isWriterThreadRegistered() const;
+    /**
+     * @brief Appends an event to the shard of the calling thread.
+     * @param[in] event Event to add.
+     * @return `true` if the calling thread is a registered writer and the event
+     * was added to its shard, `false` if the calling thread is not registered.
+     * @details The event type of the event must be registered with a
+     * non-empty header by the time shards are merged.
+     */
+    bool newWriterThreadEvent(const TimingReportEventC &event);
+    /**
+     * @brief Moves all events recorded in writer thread shards into the main
+     * event list.
+     * @details Events already in the main list keep their order. Shard events
+     * are sorted by wall start time and inserted before the first main list
+     * event that starts later. Ties are broken by the order in which the writer
+     * threads were registered (events already in the main list go first), then
+     * by order of insertion, so the result is deterministic for a given set of
+     * events.
+     *
+     * If no shard contains events, the main event list is not modified.
+     * @throws std::runtime_error if the event type of a shard event is not
+     * registered with a non-empty header. The report is not modified.
+     *
+     * This method must not be called while other threads are still adding
+     * events to this report.
+     */
+    void mergeEventShards();
+
     const std::string &getHeader() const { return m_header; }
     void setHeader(const std::string &header) { m_header = header; }
     void appendHeader(const std::string &header, bool new_line);
@@ -139,15 +219,51 @@ private:
      */
     static std::string readTextBlock(std::istream &is, std::string &s_block,
                                      const std::vector<std::string> tags);
+    /**
+     * @brief Parses a timing event from a line of the report table.
+     * @param[in] b_has_spans Specifies whether the line contains the span
+     * columns. If `false`, the event is parsed as a top level event that is
+     * not a span.
+     */
     static void parseTimingEvent(std::string &s_out_event_header,
                                  std::shared_ptr<TimingReportEventC> &p_out_event,
-                                 const std::string &s_line);
+                                 const std::string &s_line,
+                                 bool b_has_spans);
+
+    struct EventShard
+    {
+        std::vector<TimingReportEventC> events;
+    };
+    struct EventShards
+    {
+        std::mutex mtx; // only taken for registration and merging
+        std::vector<std::unique_ptr<EventShard>> shards; // in order of registration
+    };
+
+    struct WriterShard
+    {
+        std::weak_ptr<EventShards> p_owner; // expires when the report is destroyed
+        EventShard *p_shard;
+    };
+
+    /**
+     * @brief Removes the writer shards of the calling thread that belong to
+     * reports already destroyed.
+     */
+    static void removeExpiredWriterShards();
+
+    // shards owned by the calling thread, keyed by report instance ID
+    static thread_local std::unordered_map<std::uint64_t, WriterShard> m_tl_writer_shards;
 
     std::string m_header;
     std::string m_footer;
     std::uint32_t m_main_event;
     std::unordered_map<std::uint32_t, std::string> m_event_headers; // maps event id to event header
-    std::vector<std::shared_ptr<TimingReportEventC>> m_events;
+    std::vector<TimingReportEventC> m_events;
+    EventColumns m_event_columns;
+    bool m_b_event_columns_valid;
+    std::uint64_t m_instance_id;
+    std::shared_ptr<EventShards> m_p_shards;
 };
 
 template <class TimeInterval>
@@ -172,6 +288,16 @@ public:
     static void generateCSV(std::ostream &os,
                             TimingReportEventC &main_event_summary,
                             const TimingReport &report);
+
+private:
+    /**
+     * @brief Generates the inclusive and exclusive wall time of every event
+     * type nested in, or enclosing, other events.
+     * @details Inclusive time of an event is its elapsed wall time. Exclusive
+     * time is the inclusive time minus the wall time of its direct children,
+     * and never less than 0. Nothing is generated if no events are nested.
+     */
+    static void generateSpansCSV(std::ostream &os, const TimingReport &report);
 };
 
 } // namespace Report
@@ -7,6 +7,9 @@
 
 #include <cmath>
 #include <cstdint>
+#include <functional>
+#include <streambuf>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -15,6 +18,56 @@ namespace Utilities {
 
 uint64_t copyString(char *dst, uint64_t size, const std::string &src);
 
+/**
+ * @brief Output stream buffer that hands its content, in chunks of bounded
+ * size, to a write function.
+ * @details Used to stream generated content directly to its destination
+ * without accumulating it in memory. Memory used is bounded by the chunk size.
+ *
+ * The write function is called only when a chunk is full and on finish(),
+ * so flushing the stream (for example, with `std::endl`) does not write
+ * partial chunks.
+ *
+ * If the write function fails, the buffer enters a failed state and any
+ * stream using it will have its badbit set on next write.
+ */
+class ChunkedOutputBuffer : public std::streambuf
+{
+public:
+    /**
+     * @brief Function that writes a chunk.
+     * @details Receives a pointer to the chunk and its size in bytes. Returns
+     * true on success, false on failure.
+     */
+    typedef std::function<bool(const char *, std::size_t)> WriteFunction;
+
+    static constexpr std::size_t DefaultChunkSize = 64 * 1024;
+
+    ChunkedOutputBuffer(const WriteFunction &write_fn, std::size_t chunk_size = DefaultChunkSize);
+    /**
+     * @brief Writes any content left in the current chunk, ignoring errors.
+     */
+    ~ChunkedOutputBuffer() override;
+
+    /**
+     * @brief Writes the content left in the current chunk.
+     * @returns `true` on success, `false` if the buffer is in failed state.
+     */
+    bool finish();
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char_type *s, std::streamsize count) override;
+    int sync() override;
+
+private:
+    bool flushChunk();
+
+    WriteFunction m_write_fn;
+    std::vector<char> m_chunk;
+    bool m_b_failed;
+};
+
 namespace Math {
 
 template <typename T>
@@ -2,12 +2,17 @@
 // Copyright (C) 2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <cerrno>
 #include <cstring>
 #include <fstream>
 #include <new>
+#include <ostream>
 #include <sstream>
 #include <string>
 
+#include <unistd.h>
+
 #include "hebench_report.h"
 #include "hebench_report_impl.h"
 #include "hebench_report_utils.h"
@@ -16,6 +21,61 @@ namespace hebench {
 namespace TestHarness {
 namespace Report {
 
+static bool writeChunkToFD(int fd, const char *p_data, std::size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = ::write(fd, p_data, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        } // end if
+        p_data += written;
+        size -= static_cast<std::size_t>(written);
+    } // end while
+    return true;
+}
+
+static bool writeChunkToFile(FILE *p_file, const char *p_data, std::size_t size)
+{
+    return std::fwrite(p_data, 1, size, p_file) == size;
+}
+
+static bool writeChunkToCallback(ReportWriteCallback write_callback, void *p_user_data,
+                                 const char *p_data, std::size_t size)
+{
+    return write_callback(p_data, size, p_user_data) != 0;
+}
+
+/**
+ * @brief Streams the CSV report through the specified chunk writer.
+ */
+static void streamCSV(TimingReport &report, const hebench::Utilities::ChunkedOutputBuffer::WriteFunction &write_fn)
+{
+    hebench::Utilities::ChunkedOutputBuffer buffer(write_fn);
+    std::ostream os(&buffer);
+    report.mergeEventShards();
+    report.convert2CSV(os);
+    if (!os || !buffer.finish())
+        throw std::ios_base::failure("Error writing CSV report.");
+}
+
+/**
+ * @brief Streams the CSV summary through the specified chunk writer.
+ */
+static void streamSummaryCSV(TimingReport &report, TimingReportEventC &main_event_summary,
+                             const hebench::Utilities::ChunkedOutputBuffer::WriteFunction &write_fn)
+{
+    hebench::Utilities::ChunkedOutputBuffer buffer(write_fn);
+    std::ostream os(&buffer);
+    report.mergeEventShards();
+    ReportSummary::generateCSV(os, main_event_summary, report);
+    if (!os || !buffer.finish())
+        throw std::ios_base::failure("Error writing CSV summary.");
+}
+
 extern "C"
 {
 
@@ -352,11 +412,9 @@ extern "C"
             if (!p || !p_event)
                 throw std::invalid_argument("");
 
-            std::shared_ptr<TimingReportEventC> sp_event = std::make_shared<TimingReportEventC>();
-            if (!sp_event)
-                throw std::bad_alloc();
-            *sp_event = *p_event;
-            p->newEvent(sp_event);
+            if (!p->newWriterThreadEvent(*p_event))
+                // calling thread is not a registered writer
+                p->newEvent(*p_event);
 
             retval = 1;
         }
@@ -377,7 +435,91 @@ extern "C"
             if (!p || !p_event || index >= p->getEvents().size())
                 throw std::invalid_argument("");
 
-            *p_event = *p->getEvents()[index];
+            *p_event = p->getEvents()[index];
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
+    uint64_t getEvents(void *p_report, TimingReportEventC *p_events, uint64_t start_index, uint64_t count)
+    {
+        uint64_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p || (!p_events && count > 0))
+                throw std::invalid_argument("");
+
+            const std::vector<TimingReportEventC> &events = p->getEvents();
+            if (start_index < events.size())
+            {
+                retval = std::min<uint64_t>(count, events.size() - start_index);
+                std::copy_n(events.data() + start_index, retval, p_events);
+            } // end if
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
+    const TimingReportEventC *getEventsData(void *p_report, uint64_t *p_count)
+    {
+        const TimingReportEventC *retval = nullptr;
+        uint64_t count                   = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p)
+                throw std::invalid_argument("");
+
+            if (!p->getEvents().empty())
+            {
+                retval = p->getEvents().data();
+                count  = p->getEvents().size();
+            } // end if
+        }
+        catch (...)
+        {
+            retval = nullptr;
+            count  = 0;
+        }
+
+        if (p_count)
+            *p_count = count;
+        return retval;
+    }
+
+    int32_t getEventColumns(void *p_report, TimingReportEventColumnsC *p_columns)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p || !p_columns)
+                throw std::invalid_argument("");
+
+            const TimingReport::EventColumns &columns = p->getEventColumns();
+            p_columns->count                          = columns.event_type_id.size();
+            p_columns->event_type_id                  = columns.event_type_id.data();
+            p_columns->cpu_time_start                 = columns.cpu_time_start.data();
+            p_columns->cpu_time_end                   = columns.cpu_time_end.data();
+            p_columns->wall_time_start                = columns.wall_time_start.data();
+            p_columns->wall_time_end                  = columns.wall_time_end.data();
+            p_columns->time_interval_ratio_num        = columns.time_interval_ratio_num.data();
+            p_columns->time_interval_ratio_den        = columns.time_interval_ratio_den.data();
+            p_columns->iterations                     = columns.iterations.data();
+            p_columns->span_id                        = columns.span_id.data();
+            p_columns->parent_span_id                 = columns.parent_span_id.data();
+            p_columns->depth                          = columns.depth.data();
 
             retval = 1;
         }
@@ -469,6 +611,69 @@ extern "C"
         return retval;
     }
 
+    int32_t registerEventWriterThread(void *p_report)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p)
+                throw std::invalid_argument("");
+
+            p->registerWriterThread();
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
+    int32_t unregisterEventWriterThread(void *p_report)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p)
+                throw std::invalid_argument("");
+
+            p->unregisterWriterThread();
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
+    int32_t mergeEventShards(void *p_report)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p)
+                throw std::invalid_argument("");
+
+            p->mergeEventShards();
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
     int32_t save2CSV(void *p_report, const char *filename)
     {
         int32_t retval = 0;
@@ -483,6 +688,7 @@ extern "C"
             if (!fnum.is_open())
                 throw std::ios_base::failure("Error opening file");
 
+            p->mergeEventShards();
             p->convert2CSV(fnum);
 
             retval = 1;
@@ -508,6 +714,7 @@ extern "C"
             std::stringstream ss;
             std::string s_csv_content;
 
+            p->mergeEventShards();
             p->convert2CSV(ss);
             s_csv_content = ss.str();
             ss            = std::stringstream();
@@ -543,6 +750,7 @@ extern "C"
             std::stringstream ss;
             std::string s_csv_content;
 
+            p->mergeEventShards();
             ReportSummary::generateCSV(ss, *p_main_event_summary, *p);
             s_csv_content = ss.str();
             ss            = std::stringstream();
@@ -571,6 +779,148 @@ extern "C"
             delete[] p_csv_content;
     }
 
+    int32_t convert2CSVCallback(void *p_report, ReportWriteCallback write_callback, void *p_user_data)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p || !write_callback)
+                throw std::invalid_argument("");
+
+            streamCSV(*p, [write_callback, p_user_data](const char *p_data, std::size_t size) {
+                return writeChunkToCallback(write_callback, p_user_data, p_data, size);
+            });
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
+    int32_t convert2CSVFD(void *p_report, int32_t fd)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p || fd < 0)
+                throw std::invalid_argument("");
+
+            streamCSV(*p, [fd](const char *p_data, std::size_t size) {
+                return writeChunkToFD(fd, p_data, size);
+            });
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
+    int32_t convert2CSVFile(void *p_report, FILE *p_file)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p || !p_file)
+                throw std::invalid_argument("");
+
+            streamCSV(*p, [p_file](const char *p_data, std::size_t size) {
+                return writeChunkToFile(p_file, p_data, size);
+            });
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
+    int32_t generateSummaryCSVCallback(void *p_report, TimingReportEventC *p_main_event_summary,
+                                       ReportWriteCallback write_callback, void *p_user_data)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p || !p_main_event_summary || !write_callback)
+                throw std::invalid_argument("");
+
+            streamSummaryCSV(*p, *p_main_event_summary,
+                             [write_callback, p_user_data](const char *p_data, std::size_t size) {
+                                 return writeChunkToCallback(write_callback, p_user_data, p_data, size);
+                             });
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
+    int32_t generateSummaryCSVFD(void *p_report, TimingReportEventC *p_main_event_summary, int32_t fd)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p || !p_main_event_summary || fd < 0)
+                throw std::invalid_argument("");
+
+            streamSummaryCSV(*p, *p_main_event_summary,
+                             [fd](const char *p_data, std::size_t size) {
+                                 return writeChunkToFD(fd, p_data, size);
+                             });
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
+    int32_t generateSummaryCSVFile(void *p_report, TimingReportEventC *p_main_event_summary, FILE *p_file)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReport *p = reinterpret_cast<TimingReport *>(p_report);
+            if (!p || !p_main_event_summary || !p_file)
+                throw std::invalid_argument("");
+
+            streamSummaryCSV(*p, *p_main_event_summary,
+                             [p_file](const char *p_data, std::size_t size) {
+                                 return writeChunkToFile(p_file, p_data, size);
+                             });
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
     void *loadReportFromCSV(const char *p_csv_content, char error_description[MAX_DESCRIPTION_BUFFER_SIZE])
     {
         TimingReport *p_retval = nullptr;
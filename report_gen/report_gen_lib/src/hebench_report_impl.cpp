@@ -2,6 +2,8 @@
 // Copyright (C) 2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <limits>
@@ -19,9 +21,37 @@ std::string to_string(const std::string_view &s)
     return std::string(s.begin(), s.end());
 }
 
+thread_local std::unordered_map<std::uint64_t, TimingReport::WriterShard> TimingReport::m_tl_writer_shards;
+
 TimingReport::TimingReport() :
-    m_main_event(std::numeric_limits<decltype(m_main_event)>::max())
+    m_main_event(std::numeric_limits<decltype(m_main_event)>::max()),
+    m_b_event_columns_valid(false),
+    m_p_shards(new EventShards())
+{
+    // unique ID per report instance to identify writer thread shards
+    // (addresses may be reused by new reports after a report is destroyed)
+    static std::atomic<std::uint64_t> next_instance_id(0);
+    m_instance_id = next_instance_id++;
+}
+
+TimingReport::~TimingReport()
+{
+    // entries of other writer threads expire with the shards and are removed
+    // the next time those threads register or merge
+    m_tl_writer_shards.erase(m_instance_id);
+    m_p_shards.reset();
+    removeExpiredWriterShards();
+}
+
+void TimingReport::removeExpiredWriterShards()
 {
+    for (auto it = m_tl_writer_shards.begin(); it != m_tl_writer_shards.end();)
+    {
+        if (it->second.p_owner.expired())
+            it = m_tl_writer_shards.erase(it);
+        else
+            ++it;
+    } // end for
 }
 
 void TimingReport::newEventType(std::uint32_t set_id, const std::string &set_header, bool is_main_event)
@@ -31,14 +61,46 @@ void TimingReport::newEventType(std::uint32_t set_id, const std::string &set_hea
         m_main_event = set_id;
 }
 
-void TimingReport::newEvent(std::shared_ptr<TimingReportEventC> p_event, const std::string &set_header)
+void TimingReport::newEvent(const TimingReportEventC &event, const std::string &set_header)
 {
-    if (p_event)
+    if (m_event_headers.count(event.event_type_id) <= 0 || !set_header.empty())
+        newEventType(event.event_type_id, set_header);
+    m_events.push_back(event);
+    m_b_event_columns_valid = false;
+}
+
+const TimingReport::EventColumns &TimingReport::getEventColumns()
+{
+    if (!m_b_event_columns_valid)
     {
-        if (m_event_headers.count(p_event->event_type_id) <= 0 || !set_header.empty())
-            newEventType(p_event->event_type_id, set_header);
-        m_events.push_back(p_event);
+        m_event_columns.event_type_id.resize(m_events.size());
+        m_event_columns.cpu_time_start.resize(m_events.size());
+        m_event_columns.cpu_time_end.resize(m_events.size());
+        m_event_columns.wall_time_start.resize(m_events.size());
+        m_event_columns.wall_time_end.resize(m_events.size());
+        m_event_columns.time_interval_ratio_num.resize(m_events.size());
+        m_event_columns.time_interval_ratio_den.resize(m_events.size());
+        m_event_columns.iterations.resize(m_events.size());
+        m_event_columns.span_id.resize(m_events.size());
+        m_event_columns.parent_span_id.resize(m_events.size());
+        m_event_columns.depth.resize(m_events.size());
+        for (std::size_t i = 0; i < m_events.size(); ++i)
+        {
+            m_event_columns.event_type_id[i]           = m_events[i].event_type_id;
+            m_event_columns.cpu_time_start[i]          = m_events[i].cpu_time_start;
+            m_event_columns.cpu_time_end[i]            = m_events[i].cpu_time_end;
+            m_event_columns.wall_time_start[i]         = m_events[i].wall_time_start;
+            m_event_columns.wall_time_end[i]           = m_events[i].wall_time_end;
+            m_event_columns.time_interval_ratio_num[i] = m_events[i].time_interval_ratio_num;
+            m_event_columns.time_interval_ratio_den[i] = m_events[i].time_interval_ratio_den;
+            m_event_columns.iterations[i]              = m_events[i].iterations;
+            m_event_columns.span_id[i]                 = m_events[i].span_id;
+            m_event_columns.parent_span_id[i]          = m_events[i].parent_span_id;
+            m_event_columns.depth[i]                   = m_events[i].depth;
+        } // end for
+        m_b_event_columns_valid = true;
     } // end if
+    return m_event_columns;
 }
 
 void TimingReport::reserveCapacityForEvents(std::size_t new_capacity)
@@ -49,6 +111,99 @@ void TimingReport::reserveCapacityForEvents(std::size_t new_capacity)
 void TimingReport::clear()
 {
     m_events.clear();
+    m_event_columns         = EventColumns();
+    m_b_event_columns_valid = false;
+    std::lock_guard<std::mutex> lock(m_p_shards->mtx);
+    for (auto &p_shard : m_p_shards->shards)
+        p_shard->events.clear();
+}
+
+void TimingReport::registerWriterThread()
+{
+    if (m_tl_writer_shards.count(m_instance_id) <= 0)
+    {
+        removeExpiredWriterShards();
+        std::lock_guard<std::mutex> lock(m_p_shards->mtx);
+        m_p_shards->shards.emplace_back(new EventShard());
+        m_tl_writer_shards[m_instance_id] = { m_p_shards, m_p_shards->shards.back().get() };
+    } // end if
+}
+
+void TimingReport::unregisterWriterThread()
+{
+    // shard remains owned by the report until destroyed, so that its
+    // events are still merged
+    m_tl_writer_shards.erase(m_instance_id);
+}
+
+bool TimingReport::isWriterThreadRegistered() const
+{
+    return m_tl_writer_shards.count(m_instance_id) > 0;
+}
+
+bool TimingReport::newWriterThreadEvent(const TimingReportEventC &event)
+{
+    auto it = m_tl_writer_shards.find(m_instance_id);
+    if (it == m_tl_writer_shards.end())
+        return false;
+    it->second.p_shard->events.push_back(event);
+    return true;
+}
+
+void TimingReport::mergeEventShards()
+{
+    removeExpiredWriterShards();
+    std::lock_guard<std::mutex> lock(m_p_shards->mtx);
+
+    // shard events in order of registration of their writer threads, then insertion
+    std::vector<TimingReportEventC> shard_events;
+    std::size_t shard_events_count = 0;
+    for (const auto &p_shard : m_p_shards->shards)
+        shard_events_count += p_shard->events.size();
+
+    if (shard_events_count > 0)
+    {
+        // validate before modifying the report
+        for (const auto &p_shard : m_p_shards->shards)
+            for (const TimingReportEventC &event : p_shard->events)
+            {
+                auto it = m_event_headers.find(event.event_type_id);
+                if (it == m_event_headers.end() || it->second.empty())
+                    throw std::runtime_error("Event type " + std::to_string(event.event_type_id)
+                                             + " recorded by a writer thread must be registered with a header before merging.");
+            } // end for
+
+        shard_events.reserve(shard_events_count);
+        for (auto &p_shard : m_p_shards->shards)
+        {
+            shard_events.insert(shard_events.end(), p_shard->events.begin(), p_shard->events.end());
+            p_shard->events.clear();
+        } // end for
+
+        // events from different threads may have been recorded using different time units
+        auto start_time = [](const TimingReportEventC &event) {
+            return event.wall_time_start * event.time_interval_ratio_num / event.time_interval_ratio_den;
+        };
+        std::stable_sort(shard_events.begin(), shard_events.end(),
+                         [&start_time](const TimingReportEventC &a, const TimingReportEventC &b) {
+                             return start_time(a) < start_time(b);
+                         });
+
+        // merge shard events into position: events in the main list keep their
+        // relative order and go first on ties
+        std::vector<TimingReportEventC> events;
+        events.reserve(m_events.size() + shard_events.size());
+        auto shard_it = shard_events.begin();
+        for (const TimingReportEventC &event : m_events)
+        {
+            while (shard_it != shard_events.end() && start_time(*shard_it) < start_time(event))
+                events.push_back(*shard_it++);
+            events.push_back(event);
+        } // end for
+        events.insert(events.end(), shard_it, shard_events.end());
+        m_events.swap(events);
+        m_b_event_columns_valid = false;
+    } // end if
 }
 
 void TimingReport::appendHeader(const std::string &header, bool new_line)
@@ -113,14 +268,15 @@ std::ostream &TimingReport::convert2CSV(std::ostream &os) const
         os << TagReportData << std::endl // start of the report table
            << ",idx,ID,Event,Description,Time ratio num,Time ratio den,"
            << "Wall time start,Wall time end,Elapsed wall time,"
-           << "CPU time start,CPU time end,Elapsed CPU time,Iterations"
+           << "CPU time start,CPU time end,Elapsed CPU time,Iterations,"
+           << "Span,Parent span,Depth"
            << std::endl;
         if (!os)
             throw std::ios_base::failure("Error writing table header to stream.");
 
         for (std::size_t i = 0; i < m_events.size(); ++i)
         {
-            const TimingReportEventC &timing_event = *m_events[i];
+            const TimingReportEventC &timing_event = m_events[i];
             os << "," << i << "," << timing_event.event_type_id << ",";
             if (m_event_headers.count(timing_event.event_type_id) > 0)
                 os << m_event_headers.at(timing_event.event_type_id);
@@ -130,7 +286,9 @@ std::ostream &TimingReport::convert2CSV(std::ostream &os) const
                << timing_event.wall_time_end - timing_event.wall_time_start << ","
                << timing_event.cpu_time_start << "," << timing_event.cpu_time_end << ","
                << timing_event.cpu_time_end - timing_event.cpu_time_start << ","
-               << timing_event.iterations;
+               << timing_event.iterations << ","
+               << timing_event.span_id << "," << timing_event.parent_span_id << ","
+               << timing_event.depth;
 
             os << std::endl;
 
@@ -234,7 +392,8 @@ void TimingReport::parseHeadingValue(std::string &s_out_heading, double &out_val
 
 void TimingReport::parseTimingEvent(std::string &s_out_event_header,
                                     std::shared_ptr<TimingReportEventC> &p_out_event,
-                                    const std::string &s_line)
+                                    const std::string &s_line,
+                                    bool b_has_spans)
 {
     std::stringstream ss;
     std::size_t value_start, value_length;
@@ -250,11 +409,14 @@ void TimingReport::parseTimingEvent(std::string &s_out_event_header,
         double cpu_start_time, cpu_end_time, wall_start_time, wall_end_time;
         int64_t time_interval_num, time_interval_den;
         std::uint64_t iterations;
+        std::uint64_t span_id        = 0;
+        std::uint64_t parent_span_id = 0;
+        std::uint32_t depth          = 0;
 
         s_line_view = std::string_view(s_line.c_str());
 
         // parse order:
-        // ,idx,ID,Event,Description,Time ratio num, Time ratio den,Wall time start,Wall time end,Elapsed wall time,CPU time start,CPU time end,Elapsed CPU time,Iterations"
+        // ,idx,ID,Event,Description,Time ratio num, Time ratio den,Wall time start,Wall time end,Elapsed wall time,CPU time start,CPU time end,Elapsed CPU time,Iterations[,Span,Parent span,Depth]"
 
         // skip any empty columns at the start
         std::string_view sv_tmp;
@@ -403,6 +565,48 @@ void TimingReport::parseTimingEvent(std::string &s_out_event_header,
             throw std::runtime_error(ss.str());
         } // end if
 
+        if (b_has_spans)
+        {
+            // Span
+            s_value = to_string(findNextValueCSV(value_start, value_length, s_line_view.data()));
+            if (value_start + value_length < s_line_view.length())
+                ++value_length;
+            s_line_view.remove_prefix(value_start + value_length);
+            ss = std::stringstream(s_value);
+            if (s_value.empty() || !(ss >> span_id))
+            {
+                ss = std::stringstream();
+                ss << "Invalid timing event format. Expected type uint64_t for Span, but read value \"" << s_value << "\".";
+                throw std::runtime_error(ss.str());
+            } // end if
+
+            // Parent span
+            s_value = to_string(findNextValueCSV(value_start, value_length, s_line_view.data()));
+            if (value_start + value_length < s_line_view.length())
+                ++value_length;
+            s_line_view.remove_prefix(value_start + value_length);
+            ss = std::stringstream(s_value);
+            if (s_value.empty() || !(ss >> parent_span_id))
+            {
+                ss = std::stringstream();
+                ss << "Invalid timing event format. Expected type uint64_t for Parent span, but read value \"" << s_value << "\".";
+                throw std::runtime_error(ss.str());
+            } // end if
+
+            // Depth
+            s_value = to_string(findNextValueCSV(value_start, value_length, s_line_view.data()));
+            if (value_start + value_length < s_line_view.length())
+                ++value_length;
+            s_line_view.remove_prefix(value_start + value_length);
+            ss = std::stringstream(s_value);
+            if (s_value.empty() || !(ss >> depth))
+            {
+                ss = std::stringstream();
+                ss << "Invalid timing event format. Expected type uint32_t for Depth, but read value \"" << s_value << "\".";
+                throw std::runtime_error(ss.str());
+            } // end if
+        } // end if
+
         retval                = std::make_shared<TimingReportEventC>();
         retval->event_type_id = id;
         hebench::Utilities::copyString(retval->description, MAX_TIME_REPORT_EVENT_DESCRIPTION_SIZE, event_description);
@@ -413,6 +617,9 @@ void TimingReport::parseTimingEvent(std::string &s_out_event_header,
         retval->iterations              = iterations;
         retval->time_interval_ratio_num = time_interval_num;
         retval->time_interval_ratio_den = time_interval_den;
+        retval->span_id                 = span_id;
+        retval->parent_span_id          = parent_span_id;
+        retval->depth                   = depth;
 
     } // end if
 
@@ -488,12 +695,14 @@ TimingReport TimingReport::loadCSV(std::istream &is)
 
     // version
     getTrimmedLine(is, s_line, ",");
-    if (s_line != TagVersion)
+    if (s_line != TagVersion && s_line != TagVersionFlat)
     {
         std::stringstream ss;
         ss << "Invalid CSV report version found. Expected \"" << TagVersion << "\", but read \"" << s_line << "\".";
         throw std::runtime_error(ss.str());
     } // end if
+    // reports from previous version have no span columns
+    bool b_has_spans = (s_line == TagVersion);
 
     // read events recorded
     getTrimmedLine(is, s_line, ",");
@@ -535,8 +744,9 @@ TimingReport TimingReport::loadCSV(std::istream &is)
             {
                 std::string s_event_header;
                 std::shared_ptr<TimingReportEventC> p_event;
-                parseTimingEvent(s_event_header, p_event, s_line);
-                retval.newEvent(p_event, s_event_header);
+                parseTimingEvent(s_event_header, p_event, s_line, b_has_spans);
+                if (p_event)
+                    retval.newEvent(*p_event, s_event_header);
             } // end if
         } // end while
 
@@ -618,20 +828,20 @@ void ReportSummary::generateCSV(std::ostream &os, TimingReportEventC &main_event
     std::vector<decltype(TimingReportEventC::event_type_id)> event_order;
 
     // compute the stats on the events
-    for (std::shared_ptr<TimingReportEventC> p_event : report.getEvents())
+    for (const TimingReportEventC &event : report.getEvents())
     {
-        if (stats.count(p_event->event_type_id) <= 0)
+        if (stats.count(event.event_type_id) <= 0)
         {
-            stats[p_event->event_type_id] = LocalStats();
-            event_order.push_back(p_event->event_type_id);
+            stats[event.event_type_id] = LocalStats();
+            event_order.push_back(event.event_type_id);
         } // end if
 
-        double wall_time = TimingReport::computeElapsedWallTime(*p_event) / p_event->iterations;
-        double cpu_time  = TimingReport::computeElapsedCPUTime(*p_event) / p_event->iterations;
-        for (std::uint64_t i = 0; i < p_event->iterations; ++i)
+        double wall_time = TimingReport::computeElapsedWallTime(event) / event.iterations;
+        double cpu_time  = TimingReport::computeElapsedCPUTime(event) / event.iterations;
+        for (std::uint64_t i = 0; i < event.iterations; ++i)
         {
-            stats[p_event->event_type_id].ave_wall.newEvent(wall_time);
-            stats[p_event->event_type_id].ave_cpu.newEvent(cpu_time);
+            stats[event.event_type_id].ave_wall.newEvent(wall_time);
+            stats[event.event_type_id].ave_cpu.newEvent(cpu_time);
         } // end for
     } // end for
 
@@ -677,6 +887,75 @@ void ReportSummary::generateCSV(std::ostream &os, TimingReportEventC &main_event
                                            report.getEventTypes().at(id));
         } // end if
     } // end for
+
+    generateSpansCSV(os, report);
+}
+
+void ReportSummary::generateSpansCSV(std::ostream &os, const TimingReport &report)
+{
+    struct SpanStats
+    {
+        std::uint32_t min_depth;
+        hebench::Utilities::Math::EventStats inclusive_wall;
+        hebench::Utilities::Math::EventStats exclusive_wall;
+    };
+
+    // wall time of the direct children of each span
+    std::unordered_map<std::uint64_t, double> children_wall; // span ID -> seconds
+    for (const TimingReportEventC &event : report.getEvents())
+        if (event.parent_span_id != 0)
+            children_wall[event.parent_span_id] += TimingReport::computeElapsedWallTime(event);
+    if (children_wall.empty())
+        return; // no nested events: inclusive and exclusive times are the same
+
+    std::unordered_map<decltype(TimingReportEventC::event_type_id), SpanStats> stats; // std::uint32_t
+    std::vector<decltype(TimingReportEventC::event_type_id)> event_order;
+    for (const TimingReportEventC &event : report.getEvents())
+    {
+        auto it_children = event.span_id != 0 ? children_wall.find(event.span_id) : children_wall.end();
+        // only events in a hierarchy are listed
+        if (event.parent_span_id != 0 || it_children != children_wall.end())
+        {
+            if (stats.count(event.event_type_id) <= 0)
+            {
+                stats[event.event_type_id].min_depth = event.depth;
+                event_order.push_back(event.event_type_id);
+            } // end if
+            SpanStats &span_stats = stats.at(event.event_type_id);
+            double inclusive_time = TimingReport::computeElapsedWallTime(event);
+            // children running concurrently may add up to more than their parent
+            double exclusive_time = inclusive_time;
+            if (it_children != children_wall.end())
+                exclusive_time = std::max(0.0, inclusive_time - it_children->second);
+            span_stats.min_depth = std::min(span_stats.min_depth, event.depth);
+            span_stats.inclusive_wall.newEvent(inclusive_time);
+            span_stats.exclusive_wall.newEvent(exclusive_time);
+        } // end if
+    } // end for
+
+    os << std::endl
+       << "Spans" << std::endl
+       << "ID,Event,Depth,Average inclusive Wall time,Unit,Average exclusive Wall time,Unit,Exclusive share,Spans" << std::endl;
+    if (!os)
+        throw std::ios_base::failure("Error writing summary spans header to stream.");
+    for (auto id : event_order)
+    {
+        const SpanStats &span_stats = stats.at(id);
+        hebench::TestHarness::Report::TimingPrefixedSeconds prefix_inclusive;
+        hebench::TestHarness::Report::TimingPrefixedSeconds prefix_exclusive;
+        hebench::TestHarness::Report::TimingReport::computeTimingPrefix(prefix_inclusive, span_stats.inclusive_wall.getMean());
+        hebench::TestHarness::Report::TimingReport::computeTimingPrefix(prefix_exclusive, span_stats.exclusive_wall.getMean());
+        double exclusive_share = span_stats.inclusive_wall.getMean() > 0.0 ?
+                                     span_stats.exclusive_wall.getMean() / span_stats.inclusive_wall.getMean() :
+                                     1.0;
+        os << id << "," << report.getEventTypes().at(id) << "," << span_stats.min_depth << ","
+           << span_stats.inclusive_wall.getMean() * prefix_inclusive.time_interval_ratio_den << "," << prefix_inclusive.symbol << "s,"
+           << span_stats.exclusive_wall.getMean() * prefix_exclusive.time_interval_ratio_den << "," << prefix_exclusive.symbol << "s,"
+           << exclusive_share << ","
+           << span_stats.inclusive_wall.getCount() << std::endl;
+        if (!os)
+            throw std::ios_base::failure("Error writing summary spans row to stream.");
+    } // end for
 }
 
 } // namespace Report
@@ -26,6 +26,75 @@ uint64_t copyString(char *dst, uint64_t size, const std::string &src)
     return retval;
 }
 
+//---------------------------
+// class ChunkedOutputBuffer
+//---------------------------
+
+ChunkedOutputBuffer::ChunkedOutputBuffer(const WriteFunction &write_fn, std::size_t chunk_size) :
+    m_write_fn(write_fn), m_chunk(chunk_size > 0 ? chunk_size : DefaultChunkSize), m_b_failed(false)
+{
+    if (!m_write_fn)
+        throw std::invalid_argument("Invalid null write function.");
+    setp(m_chunk.data(), m_chunk.data() + m_chunk.size());
+}
+
+ChunkedOutputBuffer::~ChunkedOutputBuffer()
+{
+    flushChunk();
+}
+
+bool ChunkedOutputBuffer::finish()
+{
+    return flushChunk();
+}
+
+bool ChunkedOutputBuffer::flushChunk()
+{
+    std::size_t count = static_cast<std::size_t>(pptr() - pbase());
+    if (count > 0 && !m_b_failed)
+        m_b_failed = !m_write_fn(pbase(), count);
+    setp(m_chunk.data(), m_chunk.data() + m_chunk.size());
+    return !m_b_failed;
+}
+
+ChunkedOutputBuffer::int_type ChunkedOutputBuffer::overflow(int_type ch)
+{
+    if (!flushChunk())
+        return traits_type::eof();
+    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    } // end if
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize ChunkedOutputBuffer::xsputn(const char_type *s, std::streamsize count)
+{
+    std::streamsize retval = 0;
+    while (retval < count && !m_b_failed)
+    {
+        std::streamsize available = epptr() - pptr();
+        if (available <= 0)
+        {
+            if (!flushChunk())
+                break;
+            available = epptr() - pptr();
+        } // end if
+        std::streamsize n = std::min(available, count - retval);
+        std::copy_n(s + retval, n, pptr());
+        pbump(static_cast<int>(n));
+        retval += n;
+    } // end while
+    return retval;
+}
+
+int ChunkedOutputBuffer::sync()
+{
+    // partial chunks are written on finish(), not on every stream flush
+    return m_b_failed ? -1 : 0;
+}
+
 namespace Math {
 
 ComponentCounter::ComponentCounter(std::vector<std::size_t> component_sizes) :
@@ -0,0 +1,105 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Report_Batch_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Report_Batch_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "hebench_report_fingerprint.h"
+
+namespace hebench {
+namespace TestHarness {
+namespace Report {
+namespace cpp {
+
+/**
+ * @brief Processes every report under a directory tree in parallel.
+ * @details Every file named ReportFileName found under the root path is
+ * loaded, its header validated and its main event summarized. Optionally,
+ * the summary file of each report is regenerated next to it. Results of all
+ * reports are collected in an index.
+ *
+ * Reports are compared against the reference report, the first successful
+ * report with a fingerprint in path order: reports whose machine or backend
+ * fingerprint differs are flagged as not comparable.
+ */
+class ReportBatch
+{
+public:
+    static constexpr const char *ReportFileName  = "report.csv";
+    static constexpr const char *SummaryFileName = "summary.csv";
+    static constexpr const char *IndexFileName   = "report_index.csv";
+
+    enum class Status
+    {
+        OK,
+        Failed, // report of a failed benchmark: no events
+        Invalid // report could not be loaded or its header is invalid
+    };
+
+    struct Config
+    {
+        std::filesystem::path root_path;
+        std::size_t thread_count = 0; // 0 to use all hardware threads
+        bool b_write_summaries   = false;
+    };
+
+    struct Entry
+    {
+        std::filesystem::path report_path; // relative to root path
+        std::string main_event_name;
+        std::string comparability; // against the reference report: Yes, No, Build differs or Unknown
+        std::string message;
+        Fingerprint fingerprint;
+        Status status             = Status::Invalid;
+        std::uint64_t event_count = 0;
+        double ave_wall_time_s    = 0.0;
+        double ave_cpu_time_s     = 0.0;
+    };
+
+    /**
+     * @brief Processes every report under the configured root path.
+     * @returns One entry per report found, sorted by path.
+     * @throws std::invalid_argument if the root path is not a directory.
+     * @details Errors processing a report are recorded in its entry.
+     */
+    static std::vector<Entry> run(const Config &config);
+    /**
+     * @brief Saves the index of processed reports in CSV format.
+     */
+    static void saveIndex(const std::filesystem::path &filename, const std::vector<Entry> &entries);
+    /**
+     * @brief Prints the count of reports by status and comparability.
+     */
+    static std::ostream &showTotals(std::ostream &os, const std::vector<Entry> &entries);
+
+    /**
+     * @brief Checks that a report header describes a benchmark.
+     * @returns An empty string if \p header is valid, or the reason why it
+     * is not.
+     */
+    static std::string validateHeader(const std::string &header);
+    static const char *getStatusName(Status status);
+
+private:
+    static std::vector<std::filesystem::path> findReports(const std::filesystem::path &root_path);
+    static Entry processReport(const std::filesystem::path &root_path,
+                               const std::filesystem::path &report_path,
+                               bool b_write_summary);
+    static void markComparability(std::vector<Entry> &entries);
+
+    ReportBatch() = default;
+};
+
+} // namespace cpp
+} // namespace Report
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Report_Batch_H_0596d40a3cce4b108a81595c50eb286d
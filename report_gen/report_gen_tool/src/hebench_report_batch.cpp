@@ -0,0 +1,215 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "../include/hebench_report_batch.h"
+#include "hebench_report_cpp.h"
+
+namespace hebench {
+namespace TestHarness {
+namespace Report {
+namespace cpp {
+
+std::string ReportBatch::validateHeader(const std::string &header)
+{
+    // sections every benchmark header starts with
+    static const char *RequiredLines[] = { "Specifications,", ", Category," };
+
+    if (header.empty())
+        return "Empty header.";
+    for (const char *required_line : RequiredLines)
+    {
+        bool b_found = false;
+        std::istringstream is(header);
+        std::string line;
+        while (!b_found && std::getline(is, line))
+            b_found = (line.rfind(required_line, 0) == 0);
+        if (!b_found)
+            return std::string("Header is missing \"") + required_line + "\".";
+    } // end for
+    return std::string();
+}
+
+const char *ReportBatch::getStatusName(Status status)
+{
+    switch (status)
+    {
+    case Status::OK:
+        return "OK";
+    case Status::Failed:
+        return "Failed";
+    default:
+        return "Invalid";
+    } // end switch
+}
+
+std::vector<std::filesystem::path> ReportBatch::findReports(const std::filesystem::path &root_path)
+{
+    std::vector<std::filesystem::path> retval;
+    for (const std::filesystem::directory_entry &dir_entry :
+         std::filesystem::recursive_directory_iterator(root_path, std::filesystem::directory_options::skip_permission_denied))
+    {
+        if (dir_entry.is_regular_file() && dir_entry.path().filename() == ReportFileName)
+            retval.push_back(std::filesystem::relative(dir_entry.path(), root_path));
+    } // end for
+    std::sort(retval.begin(), retval.end());
+    return retval;
+}
+
+ReportBatch::Entry ReportBatch::processReport(const std::filesystem::path &root_path,
+                                              const std::filesystem::path &report_path,
+                                              bool b_write_summary)
+{
+    Entry retval;
+    retval.report_path = report_path;
+    try
+    {
+        TimingReport report = TimingReport::loadReportFromCSVFile((root_path / report_path).string());
+        retval.fingerprint  = Fingerprint::fromHeader(report.getHeader());
+        retval.event_count  = report.getEventCount();
+        retval.message      = validateHeader(report.getHeader());
+        if (!retval.message.empty())
+            retval.status = Status::Invalid;
+        else if (retval.event_count <= 0)
+            retval.status = Status::Failed;
+        else
+        {
+            TimingReportEventC tre;
+            if (b_write_summary)
+            {
+                std::filesystem::path summary_path = root_path / report_path;
+                summary_path.replace_filename(SummaryFileName);
+                std::ofstream fnum(summary_path, std::ios_base::out | std::ios_base::trunc);
+                if (!fnum.is_open())
+                    throw std::runtime_error("Could not open file for writing: " + summary_path.string());
+                report.generateSummaryCSV(tre, fnum);
+            } // end if
+            else
+                report.generateSummaryCSV(tre);
+            retval.main_event_name = report.getEventTypeHeader(tre.event_type_id);
+            retval.ave_wall_time_s = (tre.wall_time_end - tre.wall_time_start) * tre.time_interval_ratio_num / tre.time_interval_ratio_den;
+            retval.ave_cpu_time_s  = (tre.cpu_time_end - tre.cpu_time_start) * tre.time_interval_ratio_num / tre.time_interval_ratio_den;
+            retval.status          = Status::OK;
+        } // end else
+    }
+    catch (std::exception &ex)
+    {
+        retval.status  = Status::Invalid;
+        retval.message = ex.what();
+    }
+    catch (...)
+    {
+        retval.status  = Status::Invalid;
+        retval.message = "Unknown error.";
+    }
+    return retval;
+}
+
+void ReportBatch::markComparability(std::vector<Entry> &entries)
+{
+    auto ref_it = std::find_if(entries.begin(), entries.end(),
+                               [](const Entry &entry) { return entry.status == Status::OK && !entry.fingerprint.empty(); });
+    for (Entry &entry : entries)
+    {
+        if (entry.status == Status::Invalid)
+            continue;
+        if (ref_it == entries.end() || entry.fingerprint.empty())
+            entry.comparability = "Unknown";
+        else
+        {
+            std::vector<Fingerprint::Difference> diffs = Fingerprint::compare(ref_it->fingerprint, entry.fingerprint);
+            if (std::any_of(diffs.begin(), diffs.end(), &Fingerprint::isIncompatible))
+                entry.comparability = "No";
+            else if (!diffs.empty())
+                entry.comparability = "Build differs";
+            else
+                entry.comparability = "Yes";
+        } // end else
+    } // end for
+}
+
+std::vector<ReportBatch::Entry> ReportBatch::run(const Config &config)
+{
+    if (!std::filesystem::is_directory(config.root_path))
+        throw std::invalid_argument("Report root path is not a directory: " + config.root_path.string());
+
+    std::vector<std::filesystem::path> report_paths = findReports(config.root_path);
+    std::vector<Entry> retval(report_paths.size());
+
+    std::size_t thread_count = config.thread_count;
+    if (thread_count <= 0)
+        thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    thread_count = std::min(thread_count, std::max<std::size_t>(report_paths.size(), 1));
+
+    // workers pick the next report until none are left; every entry is written by a single worker
+    std::atomic<std::size_t> next_report(0);
+    auto worker = [&]() {
+        for (std::size_t report_i = next_report++; report_i < report_paths.size(); report_i = next_report++)
+            retval[report_i] = processReport(config.root_path, report_paths[report_i], config.b_write_summaries);
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t thread_i = 1; thread_i < thread_count; ++thread_i)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread &thread : workers)
+        thread.join();
+
+    markComparability(retval);
+    return retval;
+}
+
+void ReportBatch::saveIndex(const std::filesystem::path &filename, const std::vector<Entry> &entries)
+{
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error("Could not open file for writing: " + filename.string());
+
+    fnum << std::setprecision(9)
+         << "Report,Status,Events,Main event,Average wall time (s),Average CPU time (s),Comparable,Message" << std::endl;
+    for (const Entry &entry : entries)
+    {
+        std::string message = entry.message;
+        std::replace(message.begin(), message.end(), '\n', ' ');
+        std::replace(message.begin(), message.end(), '"', '\'');
+        fnum << "\"" << entry.report_path.generic_string() << "\"," << getStatusName(entry.status) << ","
+             << entry.event_count << ",\"" << entry.main_event_name << "\",";
+        if (entry.status == Status::OK)
+            fnum << entry.ave_wall_time_s << "," << entry.ave_cpu_time_s;
+        else
+            fnum << ",";
+        fnum << "," << entry.comparability << ",\"" << message << "\"" << std::endl;
+    } // end for
+}
+
+std::ostream &ReportBatch::showTotals(std::ostream &os, const std::vector<Entry> &entries)
+{
+    std::size_t status_counts[3] = { 0, 0, 0 };
+    std::size_t incomparable     = 0;
+    for (const Entry &entry : entries)
+    {
+        ++status_counts[static_cast<int>(entry.status)];
+        if (entry.comparability == "No")
+            ++incomparable;
+    } // end for
+    os << "Reports found: " << entries.size() << std::endl
+       << "  " << getStatusName(Status::OK) << ": " << status_counts[static_cast<int>(Status::OK)] << std::endl
+       << "  " << getStatusName(Status::Failed) << ": " << status_counts[static_cast<int>(Status::Failed)] << std::endl
+       << "  " << getStatusName(Status::Invalid) << ": " << status_counts[static_cast<int>(Status::Invalid)] << std::endl;
+    if (incomparable > 0)
+        os << "WARNING: " << incomparable << " reports come from a different machine or backend than the reference report"
+           << " and are not comparable." << std::endl;
+    return os;
+}
+
+} // namespace cpp
+} // namespace Report
+} // namespace TestHarness
+} // namespace hebench
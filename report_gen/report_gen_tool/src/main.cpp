@@ -2,13 +2,99 @@
 // Copyright (C) 2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <filesystem>
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "hebench_report_batch.h"
 #include "hebench_report_cpp.h"
 
 using namespace hebench::TestHarness::Report::cpp;
 
+void showUsage(std::ostream &os, const char *program_name)
+{
+    os << "Usage:" << std::endl
+       << "  " << program_name << " <report_file>" << std::endl
+       << "  " << program_name << " --batch <report_root_path> [--threads <count>] [--summaries] [--index <index_file>]" << std::endl
+       << std::endl
+       << "In batch mode, every \"" << ReportBatch::ReportFileName << "\" under the report root path is loaded," << std::endl
+       << "its header validated and its main event summarized, in parallel. Option \"--summaries\"" << std::endl
+       << "regenerates \"" << ReportBatch::SummaryFileName << "\" next to each report. The index of all reports" << std::endl
+       << "is saved to the index file, by default \"" << ReportBatch::IndexFileName << "\" in the report root path." << std::endl;
+}
+
+/**
+ * @brief Runs the batch mode.
+ * @returns 0 if all reports found are valid, -1 otherwise.
+ */
+int runBatch(int argc, char **argv)
+{
+    ReportBatch::Config config;
+    std::filesystem::path index_filename;
+    for (int arg_i = 1; arg_i < argc; ++arg_i)
+    {
+        std::string arg = argv[arg_i];
+        if (arg == "--summaries")
+            config.b_write_summaries = true;
+        else if ((arg == "--batch" || arg == "--threads" || arg == "--index") && arg_i + 1 < argc)
+        {
+            std::string value = argv[++arg_i];
+            if (arg == "--batch")
+                config.root_path = value;
+            else if (arg == "--index")
+                index_filename = value;
+            else if (value.find_first_not_of("0123456789") == std::string::npos && !value.empty())
+                config.thread_count = std::stoull(value);
+            else
+                throw std::invalid_argument("Invalid thread count: " + value);
+        } // end else if
+        else
+            throw std::invalid_argument("Invalid argument: " + arg);
+    } // end for
+    if (index_filename.empty())
+        index_filename = config.root_path / ReportBatch::IndexFileName;
+
+    std::vector<ReportBatch::Entry> entries = ReportBatch::run(config);
+    ReportBatch::saveIndex(index_filename, entries);
+
+    for (const ReportBatch::Entry &entry : entries)
+        if (entry.status == ReportBatch::Status::Invalid)
+            std::cout << "Invalid report " << entry.report_path.generic_string() << ": " << entry.message << std::endl;
+    ReportBatch::showTotals(std::cout, entries);
+    std::cout << "Index saved to: " << index_filename << std::endl;
+
+    return std::any_of(entries.begin(), entries.end(),
+                       [](const ReportBatch::Entry &entry) { return entry.status == ReportBatch::Status::Invalid; }) ?
+               -1 :
+               0;
+}
+
+/**
+ * @brief Loads a single report and prints it along with its summary.
+ */
+void showReport(const std::string &csv_filename)
+{
+    TimingReport report =
+        TimingReport::loadReportFromCSVFile(csv_filename);
+
+    std::cout << report.convert2CSV() << std::endl;
+
+    if (report.getEventCount() <= 0)
+    {
+        std::cout << std::endl
+                  << "The loaded report belongs to a failed task." << std::endl;
+    } // end if
+    else
+    {
+        hebench::TestHarness::Report::TimingReportEventC tre;
+        std::cout << report.generateSummaryCSV(tre) << std::endl;
+        std::cout << "Main event: " << tre.event_type_id << std::endl;
+    } // end else
+}
+
 int main(int argc, char **argv)
 {
     int retval = 0;
@@ -17,26 +103,18 @@ int main(int argc, char **argv)
     {
         std::string csv_filename;
 
-        if (argc > 1)
-            csv_filename = argv[1];
+        if (argc > 1 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h"))
+            showUsage(std::cout, argv[0]);
+        else if (argc > 1 && std::string(argv[1]).rfind("--", 0) == 0)
+            retval = runBatch(argc, argv);
         else
-            csv_filename = "/data/storage/git-repos/hebench/frontend/test_harness/test.tmp/element_wise_addition_1000_3/latency/float32/5001/all_plain/plain/none/0/report.csv";
-
-        TimingReport report =
-            TimingReport::loadReportFromCSVFile(csv_filename);
-
-        std::cout << report.convert2CSV() << std::endl;
-
-        if (report.getEventCount() <= 0)
         {
-            std::cout << std::endl
-                      << "The loaded report belongs to a failed task." << std::endl;
-        } // end if
-        else
-        {
-            hebench::TestHarness::Report::TimingReportEventC tre;
-            std::cout << report.generateSummaryCSV(tre) << std::endl;
-            std::cout << "Main event: " << tre.event_type_id << std::endl;
+            if (argc > 1)
+                csv_filename = argv[1];
+            else
+                csv_filename = "/data/storage/git-repos/hebench/frontend/test_harness/test.tmp/element_wise_addition_1000_3/latency/float32/5001/all_plain/plain/none/0/report.csv";
+
+            showReport(csv_filename);
         } // end else
     }
     catch (std::exception &ex)
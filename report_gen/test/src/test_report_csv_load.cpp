@@ -0,0 +1,192 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "hebench_report.h"
+#include "modules/testing/include/testing.h"
+
+using namespace hebench::TestHarness::Report;
+
+namespace {
+
+// report written before spans were added
+const char *CSVVersion011 = "#v,0,1,1\n"
+                            "Events recorded,2\n"
+                            "Main event,2\n"
+                            "#0100\n"
+                            "Specifications,\n"
+                            "Benchmark,Load test\n"
+                            "#0200\n"
+                            ",idx,ID,Event,Description,Time ratio num,Time ratio den,"
+                            "Wall time start,Wall time end,Elapsed wall time,"
+                            "CPU time start,CPU time end,Elapsed CPU time,Iterations\n"
+                            ",0,2,Operation,first,1,1000,0,4,4,0,3,3,2\n"
+                            ",1,3,Operation: Encode,,1,1000,0,1,1,0,1,1,1\n"
+                            "#8E00\n"
+                            "Footer line\n"
+                            "#8FFF\n";
+
+const char *CSVVersion012 = "#v,0,1,2\n"
+                            "Events recorded,2\n"
+                            "Main event,2\n"
+                            "#0100\n"
+                            "Specifications,\n"
+                            "Benchmark,Load test\n"
+                            "#0200\n"
+                            ",idx,ID,Event,Description,Time ratio num,Time ratio den,"
+                            "Wall time start,Wall time end,Elapsed wall time,"
+                            "CPU time start,CPU time end,Elapsed CPU time,Iterations,"
+                            "Span,Parent span,Depth\n"
+                            ",0,2,Operation,first,1,1000,0,4,4,0,3,3,2,7,0,0\n"
+                            ",1,3,Operation: Encode,,1,1000,0,1,1,0,1,1,1,8,7,1\n"
+                            "#8E00\n"
+                            "Footer line\n"
+                            "#8FFF\n";
+
+void *loadReport(const char *p_csv_content)
+{
+    char error_description[MAX_DESCRIPTION_BUFFER_SIZE];
+    void *p_report = loadReportFromCSV(p_csv_content, error_description);
+    HEBENCH_CHECK(p_report);
+    return p_report;
+}
+
+std::string getEventTypeName(void *p_report, std::uint32_t event_type_id)
+{
+    char header[MAX_DESCRIPTION_BUFFER_SIZE];
+    HEBENCH_CHECK(getEventTypeHeader(p_report, event_type_id, header, sizeof(header)) > 0);
+    return header;
+}
+
+/**
+ * @brief Checks the fields common to both versions of the report.
+ */
+void checkFlatFields(void *p_report)
+{
+    HEBENCH_CHECK(getEventCount(p_report) == 2);
+    std::uint32_t main_event_type_id = 0;
+    HEBENCH_CHECK(getMainEventType(p_report, &main_event_type_id));
+    HEBENCH_CHECK(main_event_type_id == 2);
+    HEBENCH_CHECK(getEventTypeName(p_report, 2) == "Operation");
+    HEBENCH_CHECK(getEventTypeName(p_report, 3) == "Operation: Encode");
+
+    char text[MAX_DESCRIPTION_BUFFER_SIZE];
+    HEBENCH_CHECK(getReportHeader(p_report, text, sizeof(text)) > 0);
+    HEBENCH_CHECK(std::string(text) == "Specifications,\nBenchmark,Load test");
+    HEBENCH_CHECK(getReportFooter(p_report, text, sizeof(text)) > 0);
+    HEBENCH_CHECK(std::string(text) == "Footer line");
+
+    TimingReportEventC event;
+    HEBENCH_CHECK(getEvent(p_report, &event, 0));
+    HEBENCH_CHECK(event.event_type_id == 2);
+    HEBENCH_CHECK(std::string(event.description) == "first");
+    HEBENCH_CHECK(event.time_interval_ratio_num == 1);
+    HEBENCH_CHECK(event.time_interval_ratio_den == 1000);
+    HEBENCH_CHECK(event.wall_time_start == 0.0 && event.wall_time_end == 4.0);
+    HEBENCH_CHECK(event.cpu_time_start == 0.0 && event.cpu_time_end == 3.0);
+    HEBENCH_CHECK(event.iterations == 2);
+
+    HEBENCH_CHECK(getEvent(p_report, &event, 1));
+    HEBENCH_CHECK(event.event_type_id == 3);
+    HEBENCH_CHECK(event.description[0] == '\0');
+    HEBENCH_CHECK(event.wall_time_end == 1.0);
+    HEBENCH_CHECK(event.iterations == 1);
+}
+
+void testEventLayoutPrefix()
+{
+    // fields added after version 0.1.1 go after the description, so that the
+    // layout of the fields that existed before is unchanged
+    HEBENCH_CHECK(offsetof(TimingReportEventC, description) == offsetof(TimingReportEventC, iterations) + sizeof(std::uint64_t));
+    HEBENCH_CHECK(offsetof(TimingReportEventC, span_id) > offsetof(TimingReportEventC, description));
+    HEBENCH_CHECK(offsetof(TimingReportEventC, parent_span_id) > offsetof(TimingReportEventC, span_id));
+    HEBENCH_CHECK(offsetof(TimingReportEventC, depth) > offsetof(TimingReportEventC, parent_span_id));
+}
+
+void testLoadVersion011()
+{
+    void *p_report = loadReport(CSVVersion011);
+    checkFlatFields(p_report);
+
+    // no spans in previous version
+    TimingReportEventColumnsC columns;
+    HEBENCH_CHECK(getEventColumns(p_report, &columns));
+    HEBENCH_CHECK(columns.count == 2);
+    for (std::uint64_t i = 0; i < columns.count; ++i)
+    {
+        HEBENCH_CHECK(columns.span_id[i] == 0);
+        HEBENCH_CHECK(columns.parent_span_id[i] == 0);
+        HEBENCH_CHECK(columns.depth[i] == 0);
+    } // end for
+    freeReport(p_report);
+}
+
+void testLoadVersion012()
+{
+    void *p_report = loadReport(CSVVersion012);
+    checkFlatFields(p_report);
+
+    TimingReportEventC event;
+    HEBENCH_CHECK(getEvent(p_report, &event, 0));
+    HEBENCH_CHECK(event.span_id == 7 && event.parent_span_id == 0 && event.depth == 0);
+    HEBENCH_CHECK(getEvent(p_report, &event, 1));
+    HEBENCH_CHECK(event.span_id == 8 && event.parent_span_id == 7 && event.depth == 1);
+    freeReport(p_report);
+}
+
+void testSaveVersion011AsCurrent()
+{
+    // previous version is saved in current version, with empty spans
+    void *p_report      = loadReport(CSVVersion011);
+    char *p_csv_content = nullptr;
+    HEBENCH_CHECK(convert2CSV(p_report, &p_csv_content));
+    std::string csv_content = p_csv_content;
+    freeCSVContent(p_csv_content);
+    freeReport(p_report);
+
+    HEBENCH_CHECK(csv_content.rfind("#v,0,1,2\n", 0) == 0);
+    HEBENCH_CHECK(csv_content.find(",0,2,Operation,first,1,1000,0,4,4,0,3,3,2,0,0,0\n") != std::string::npos);
+    p_report = loadReport(csv_content.c_str());
+    checkFlatFields(p_report);
+    freeReport(p_report);
+}
+
+void testSaveVersion012RoundTrip()
+{
+    void *p_report      = loadReport(CSVVersion012);
+    char *p_csv_content = nullptr;
+    HEBENCH_CHECK(convert2CSV(p_report, &p_csv_content));
+    std::string csv_content = p_csv_content;
+    freeCSVContent(p_csv_content);
+    freeReport(p_report);
+
+    HEBENCH_CHECK(csv_content == CSVVersion012);
+}
+
+void testLoadUnknownVersion()
+{
+    std::string csv_content = CSVVersion012;
+    csv_content.replace(0, std::strlen("#v,0,1,2"), "#v,0,1,0");
+    char error_description[MAX_DESCRIPTION_BUFFER_SIZE];
+    error_description[0] = '\0';
+    void *p_report       = loadReportFromCSV(csv_content.c_str(), error_description);
+    HEBENCH_CHECK(!p_report);
+    HEBENCH_CHECK(std::string(error_description).find("version") != std::string::npos);
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::Testing::runTests({ { "EventLayoutPrefix", &testEventLayoutPrefix },
+                                        { "LoadVersion011", &testLoadVersion011 },
+                                        { "LoadVersion012", &testLoadVersion012 },
+                                        { "SaveVersion011AsCurrent", &testSaveVersion011AsCurrent },
+                                        { "SaveVersion012RoundTrip", &testSaveVersion012RoundTrip },
+                                        { "LoadUnknownVersion", &testLoadUnknownVersion } });
+}
@@ -0,0 +1,223 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "hebench_report_impl.h"
+#include "modules/testing/include/testing.h"
+
+using namespace hebench::TestHarness::Report;
+
+namespace {
+
+constexpr std::uint32_t EventTypeID = 1;
+
+/**
+ * @brief Event starting at \p wall_time_start, tagged with \p tag in its
+ * iterations to identify it after merging.
+ */
+TimingReportEventC makeEvent(double wall_time_start, std::uint64_t tag)
+{
+    TimingReportEventC event;
+    std::memset(&event, 0, sizeof(event));
+    event.event_type_id           = EventTypeID;
+    event.cpu_time_start          = wall_time_start;
+    event.cpu_time_end            = wall_time_start + 1.0;
+    event.wall_time_start         = wall_time_start;
+    event.wall_time_end           = wall_time_start + 1.0;
+    event.time_interval_ratio_num = 1;
+    event.time_interval_ratio_den = 1000;
+    event.iterations              = tag;
+    return event;
+}
+
+/**
+ * @brief Registers a new writer thread and records the specified events from
+ * it. Returns once the thread is done, so writer threads register in order
+ * of calls.
+ */
+void writeFromThread(TimingReport &report, const std::vector<std::pair<double, std::uint64_t>> &events)
+{
+    // checks fail in the calling thread
+    bool b_added = true;
+    std::thread writer([&report, &events, &b_added]() {
+        report.registerWriterThread();
+        for (const auto &event : events)
+            b_added = report.newWriterThreadEvent(makeEvent(event.first, event.second)) && b_added;
+        report.unregisterWriterThread();
+    });
+    writer.join();
+    HEBENCH_CHECK(b_added);
+}
+
+std::vector<std::uint64_t> getTags(const TimingReport &report)
+{
+    std::vector<std::uint64_t> retval;
+    for (const TimingReportEventC &event : report.getEvents())
+        retval.push_back(event.iterations);
+    return retval;
+}
+
+void testMergeOrderByStartTime()
+{
+    TimingReport report;
+    report.newEventType(EventTypeID, "Operation", true);
+    report.newEvent(makeEvent(0.0, 1));
+    report.newEvent(makeEvent(10.0, 2));
+    report.newEvent(makeEvent(20.0, 3));
+    writeFromThread(report, { { 25.0, 4 }, { 5.0, 5 } });
+    writeFromThread(report, { { 15.0, 6 } });
+
+    report.mergeEventShards();
+    HEBENCH_CHECK((getTags(report) == std::vector<std::uint64_t>{ 1, 5, 2, 6, 3, 4 }));
+}
+
+void testMergeTieBreaking()
+{
+    TimingReport report;
+    report.newEventType(EventTypeID, "Operation", true);
+    report.newEvent(makeEvent(10.0, 1));
+    report.newEvent(makeEvent(10.0, 2));
+    // same start time: main list first, then writer threads in order of
+    // registration, then order of insertion
+    writeFromThread(report, { { 10.0, 3 }, { 10.0, 4 } });
+    writeFromThread(report, { { 10.0, 5 }, { 5.0, 6 } });
+
+    report.mergeEventShards();
+    HEBENCH_CHECK((getTags(report) == std::vector<std::uint64_t>{ 6, 1, 2, 3, 4, 5 }));
+}
+
+void testMergeDeterministic()
+{
+    std::vector<std::uint64_t> first_tags;
+    for (int i = 0; i < 8; ++i)
+    {
+        TimingReport report;
+        report.newEventType(EventTypeID, "Operation", true);
+        report.newEvent(makeEvent(3.0, 1));
+        writeFromThread(report, { { 3.0, 2 }, { 1.0, 3 } });
+        writeFromThread(report, { { 1.0, 4 }, { 3.0, 5 } });
+        report.mergeEventShards();
+        if (i == 0)
+            first_tags = getTags(report);
+        else
+            HEBENCH_CHECK(getTags(report) == first_tags);
+    } // end for
+    HEBENCH_CHECK((first_tags == std::vector<std::uint64_t>{ 3, 4, 1, 2, 5 }));
+}
+
+void testMergeEmptyShards()
+{
+    TimingReport report;
+    report.newEventType(EventTypeID, "Operation", true);
+    report.newEvent(makeEvent(20.0, 1));
+    report.newEvent(makeEvent(10.0, 2));
+    writeFromThread(report, {});
+
+    report.mergeEventShards();
+    HEBENCH_CHECK((getTags(report) == std::vector<std::uint64_t>{ 1, 2 }));
+}
+
+void testMergeUnregisteredEventType()
+{
+    TimingReport report;
+    report.newEventType(EventTypeID, "Operation", true);
+    report.newEvent(makeEvent(0.0, 1));
+    bool b_added = false;
+    std::thread writer([&report, &b_added]() {
+        report.registerWriterThread();
+        TimingReportEventC event = makeEvent(1.0, 2);
+        event.event_type_id      = EventTypeID + 1;
+        b_added                  = report.newWriterThreadEvent(event);
+    });
+    writer.join();
+    HEBENCH_CHECK(b_added);
+
+    HEBENCH_CHECK_THROWS(report.mergeEventShards(), std::runtime_error);
+    HEBENCH_CHECK((getTags(report) == std::vector<std::uint64_t>{ 1 }));
+}
+
+void testUnregisteredWriterThread()
+{
+    TimingReport report;
+    HEBENCH_CHECK(!report.isWriterThreadRegistered());
+    HEBENCH_CHECK(!report.newWriterThreadEvent(makeEvent(0.0, 1)));
+    report.registerWriterThread();
+    HEBENCH_CHECK(report.isWriterThreadRegistered());
+    report.unregisterWriterThread();
+    HEBENCH_CHECK(!report.isWriterThreadRegistered());
+    HEBENCH_CHECK(!report.newWriterThreadEvent(makeEvent(0.0, 1)));
+}
+
+void testWriterThreadOutlivesReport()
+{
+    // a writer thread that never unregisters keeps writing to new reports
+    // after the reports it wrote to are destroyed
+    std::unique_ptr<TimingReport> p_report;
+    bool b_write      = false;
+    bool b_done       = false;
+    bool b_stop       = false;
+    bool b_was_writer = false;
+    bool b_added      = false;
+    std::uint64_t tag = 0;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::thread writer([&]() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true)
+        {
+            cv.wait(lock, [&]() { return b_write || b_stop; });
+            if (b_stop)
+                break;
+            b_was_writer = p_report->isWriterThreadRegistered();
+            p_report->registerWriterThread();
+            b_added = p_report->newWriterThreadEvent(makeEvent(1.0, tag));
+            b_write = false;
+            b_done  = true;
+            cv.notify_all();
+        } // end while
+    });
+    for (tag = 1; tag <= 4; ++tag)
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        p_report.reset(new TimingReport());
+        p_report->newEventType(EventTypeID, "Operation", true);
+        b_write = true;
+        b_done  = false;
+        cv.notify_all();
+        cv.wait(lock, [&]() { return b_done; });
+        HEBENCH_CHECK(!b_was_writer);
+        HEBENCH_CHECK(b_added);
+        p_report->mergeEventShards();
+        HEBENCH_CHECK((getTags(*p_report) == std::vector<std::uint64_t>{ tag }));
+        p_report.reset();
+    } // end for
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        b_stop = true;
+    }
+    cv.notify_all();
+    writer.join();
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::Testing::runTests({ { "MergeOrderByStartTime", &testMergeOrderByStartTime },
+                                        { "MergeTieBreaking", &testMergeTieBreaking },
+                                        { "MergeDeterministic", &testMergeDeterministic },
+                                        { "MergeEmptyShards", &testMergeEmptyShards },
+                                        { "MergeUnregisteredEventType", &testMergeUnregisteredEventType },
+                                        { "UnregisteredWriterThread", &testUnregisteredWriterThread },
+                                        { "WriterThreadOutlivesReport", &testWriterThreadOutlivesReport } });
+}
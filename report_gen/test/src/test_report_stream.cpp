@@ -0,0 +1,144 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "hebench_report.h"
+#include "modules/testing/include/testing.h"
+
+using namespace hebench::TestHarness::Report;
+
+namespace {
+
+constexpr std::uint64_t ChunkSize = 64 * 1024;
+
+/**
+ * @brief Records every call received through a ReportWriteCallback.
+ */
+struct WriteRecorder
+{
+    std::vector<std::uint64_t> chunk_sizes;
+    std::string content;
+    std::size_t fail_on_call = 0; // 1-based; 0 to never fail
+
+    static int32_t write(const char *p_data, uint64_t size, void *p_user_data)
+    {
+        WriteRecorder *p_this = reinterpret_cast<WriteRecorder *>(p_user_data);
+        p_this->chunk_sizes.push_back(size);
+        if (p_this->fail_on_call > 0 && p_this->chunk_sizes.size() >= p_this->fail_on_call)
+            return false;
+        p_this->content.append(p_data, size);
+        return true;
+    }
+};
+
+void *createReport(std::uint64_t events_per_type)
+{
+    void *p_report = allocateReport();
+    HEBENCH_CHECK(p_report);
+    HEBENCH_CHECK(setReportHeader(p_report, "Specifications,\nBenchmark,Stream test"));
+    HEBENCH_CHECK(addEventType(p_report, 1, "Encode"));
+    HEBENCH_CHECK(addMainEventType(p_report, 2, "Operation"));
+    HEBENCH_CHECK(addEventType(p_report, 3, "Decode"));
+    for (std::uint64_t i = 0; i < events_per_type; ++i)
+    {
+        for (std::uint32_t event_type_id = 1; event_type_id <= 3; ++event_type_id)
+        {
+            TimingReportEventC event;
+            std::memset(&event, 0, sizeof(event));
+            event.event_type_id           = event_type_id;
+            event.cpu_time_start          = static_cast<double>(i);
+            event.cpu_time_end            = static_cast<double>(i) + 1.5;
+            event.wall_time_start         = static_cast<double>(i);
+            event.wall_time_end           = static_cast<double>(i) + 2.25;
+            event.time_interval_ratio_num = 1;
+            event.time_interval_ratio_den = 1000;
+            event.iterations              = 1;
+            HEBENCH_CHECK(addEvent(p_report, &event));
+        } // end for
+    } // end for
+    return p_report;
+}
+
+std::string convertInMemory(void *p_report)
+{
+    char *p_csv_content = nullptr;
+    HEBENCH_CHECK(convert2CSV(p_report, &p_csv_content));
+    std::string retval = p_csv_content;
+    freeCSVContent(p_csv_content);
+    return retval;
+}
+
+void checkFullChunks(const WriteRecorder &recorder)
+{
+    HEBENCH_CHECK(recorder.content.size() > 0);
+    std::uint64_t expected_calls = (recorder.content.size() + ChunkSize - 1) / ChunkSize;
+    HEBENCH_CHECK(recorder.chunk_sizes.size() == expected_calls);
+    for (std::size_t i = 0; i + 1 < recorder.chunk_sizes.size(); ++i)
+        HEBENCH_CHECK(recorder.chunk_sizes[i] == ChunkSize);
+}
+
+void testSmallReportSingleCall()
+{
+    void *p_report = createReport(10);
+    WriteRecorder recorder;
+    HEBENCH_CHECK(convert2CSVCallback(p_report, &WriteRecorder::write, &recorder));
+    // multi-line CSV smaller than a chunk must not be written line by line
+    HEBENCH_CHECK(recorder.chunk_sizes.size() == 1);
+    HEBENCH_CHECK(recorder.content == convertInMemory(p_report));
+    freeReport(p_report);
+}
+
+void testLargeReportFullChunks()
+{
+    void *p_report = createReport(20000);
+    WriteRecorder recorder;
+    HEBENCH_CHECK(convert2CSVCallback(p_report, &WriteRecorder::write, &recorder));
+    HEBENCH_CHECK(recorder.content.size() > 2 * ChunkSize);
+    checkFullChunks(recorder);
+    HEBENCH_CHECK(recorder.content == convertInMemory(p_report));
+    freeReport(p_report);
+}
+
+void testSummaryFullChunks()
+{
+    void *p_report = createReport(20000);
+    WriteRecorder recorder;
+    TimingReportEventC main_event_summary;
+    HEBENCH_CHECK(generateSummaryCSVCallback(p_report, &main_event_summary, &WriteRecorder::write, &recorder));
+    checkFullChunks(recorder);
+
+    char *p_csv_content = nullptr;
+    TimingReportEventC expected_summary;
+    HEBENCH_CHECK(generateSummaryCSV(p_report, &expected_summary, &p_csv_content));
+    HEBENCH_CHECK(recorder.content == p_csv_content);
+    HEBENCH_CHECK(main_event_summary.event_type_id == expected_summary.event_type_id);
+    HEBENCH_CHECK(main_event_summary.iterations == expected_summary.iterations);
+    freeCSVContent(p_csv_content);
+    freeReport(p_report);
+}
+
+void testCallbackFailureStops()
+{
+    void *p_report = createReport(20000);
+    WriteRecorder recorder;
+    recorder.fail_on_call = 2;
+    HEBENCH_CHECK(!convert2CSVCallback(p_report, &WriteRecorder::write, &recorder));
+    // no more content is generated after the callback fails
+    HEBENCH_CHECK(recorder.chunk_sizes.size() == 2);
+    HEBENCH_CHECK(recorder.content.size() == ChunkSize);
+    freeReport(p_report);
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::Testing::runTests({ { "SmallReportSingleCall", &testSmallReportSingleCall },
+                                        { "LargeReportFullChunks", &testLargeReportFullChunks },
+                                        { "SummaryFullChunks", &testSummaryFullChunks },
+                                        { "CallbackFailureStops", &testCallbackFailureStops } });
+}
@@ -62,15 +62,24 @@ public:
     static DataGenerator::Ptr create(std::uint64_t vector_size,
                                      std::uint64_t batch_size_a,
                                      std::uint64_t batch_size_b,
-                                     hebench::APIBridge::DataType data_type);
+                                     hebench::APIBridge::DataType data_type,
+                                     RunArena::Ptr p_arena);
 
     ~DataGenerator() override = default;
 
+    bool canComputeResult() const override { return true; }
+    void computeResultUnchecked(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                const std::uint64_t *param_data_pack_indices) override;
+
 private:
     static constexpr std::size_t InputDim0  = BenchmarkDescriptionCategory::OpParameterCount;
     static constexpr std::size_t OutputDim0 = BenchmarkDescriptionCategory::OpResultCount;
 
-    DataGenerator() = default;
+    std::uint64_t m_vector_size;
+    hebench::APIBridge::DataType m_data_type;
+
+    DataGenerator(RunArena::Ptr p_arena) :
+        PartialDataLoader(p_arena) {}
     void init(std::uint64_t vector_size,
               std::uint64_t batch_size_a,
               std::uint64_t batch_size_b,
@@ -142,7 +142,8 @@ void Benchmark::init(const IBenchmarkDescription::Description &description)
     timer.start();
     m_data         = DataGenerator::create(vector_size,
                                    batch_sizes[0], batch_sizes[1],
-                                   m_descriptor.data_type);
+                                   m_descriptor.data_type,
+                                   getRunArena());
     p_timing_event = timer.stop<std::milli>();
 
     ss = std::stringstream();
@@ -71,7 +71,9 @@ void BenchmarkDescription::completeDescription(const Engine &engine,
     std::uint64_t result_batch_size = computeSampleSizes(batch_sizes,
                                                          OpParameterCount,
                                                          default_batch_size,
+                                                         pre_token->getBenchmarkConfiguration(this).operand_sample_sizes,
                                                          pre_token->getDescriptor(this));
+    describeSampleSizes(pre_token->description, batch_sizes, OpParameterCount, pre_token->getDescriptor(this));
     // complete header with workload specifics
     ss << ", , C = V0 + V1" << std::endl
        << ", , , Elements, Batch size" << std::endl;
@@ -139,6 +141,7 @@ void Benchmark::init(const IBenchmarkDescription::Description &description)
     BenchmarkDescription::computeSampleSizes(batch_sizes,
                                              BenchmarkDescription::OpParameterCount,
                                              default_batch_size,
+                                             m_benchmark_configuration.operand_sample_sizes,
                                              m_descriptor);
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Generating workload...") << std::endl;
@@ -148,7 +151,8 @@ void Benchmark::init(const IBenchmarkDescription::Description &description)
     timer.start();
     m_data         = DataGenerator::create(vector_size,
                                    batch_sizes[0], batch_sizes[1],
-                                   m_descriptor.data_type);
+                                   m_descriptor.data_type,
+                                   getRunArena());
     p_timing_event = timer.stop<std::milli>();
 
     ss = std::stringstream();
@@ -7,6 +7,7 @@
 
 #include "../include/hebench_eltwiseadd.h"
 #include "benchmarks/datagen_helper/include/datagen_helper.h"
+#include "include/hebench_overhead.h"
 
 namespace hebench {
 namespace TestHarness {
@@ -155,9 +156,10 @@ void DataGeneratorHelper::vectorEltwiseAdd(hebench::APIBridge::DataType data_typ
 DataGenerator::Ptr DataGenerator::create(std::uint64_t vector_size,
                                          std::uint64_t batch_size_a,
                                          std::uint64_t batch_size_b,
-                                         hebench::APIBridge::DataType data_type)
+                                         hebench::APIBridge::DataType data_type,
+                                         RunArena::Ptr p_arena)
 {
-    DataGenerator::Ptr retval = DataGenerator::Ptr(new DataGenerator());
+    DataGenerator::Ptr retval = DataGenerator::Ptr(new DataGenerator(p_arena));
     retval->init(vector_size, batch_size_a, batch_size_b, data_type);
     return retval;
 }
@@ -176,6 +178,9 @@ void DataGenerator::init(std::uint64_t vector_size,
         batch_size_b,
         batch_size_a * batch_size_b
     };
+    m_vector_size = vector_size;
+    m_data_type   = data_type;
+
     // initialize base data (data packs)
     PartialDataLoader::init(InputDim0, batch_sizes, OutputDim0);
 
@@ -209,6 +214,8 @@ void DataGenerator::init(std::uint64_t vector_size,
     } // end for
 
     // output
+    HarnessOverhead::Scope overhead_scope(HarnessOverhead::GroundTruthPhaseName);
+    std::vector<hebench::APIBridge::NativeDataBuffer *> results(OutputDim0);
     //#pragma omp parallel for collapse(2)
     for (std::uint64_t a_i = 0; a_i < batch_sizes[0]; ++a_i)
     {
@@ -219,17 +226,25 @@ void DataGenerator::init(std::uint64_t vector_size,
             std::uint64_t r_i   = getResultIndex(ppi);
 
             // generate the data
-            DataGeneratorHelper::vectorEltwiseAdd(data_type,
-                                                  getResultData(0).p_buffers[r_i].p, // C
-                                                  getParameterData(0).p_buffers[a_i].p, // A
-                                                  getParameterData(1).p_buffers[b_i].p, // B
-                                                  vector_size);
+            results.front() = &getResultData(0).p_buffers[r_i]; // C
+            computeResult(results, ppi);
         } // end for
     } // end for
 
     // all data has been generated at this point
 }
 
+void DataGenerator::computeResultUnchecked(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                           const std::uint64_t *param_data_pack_indices)
+{
+    // C = A + B
+    DataGeneratorHelper::vectorEltwiseAdd(m_data_type,
+                                          results.front()->p, // C
+                                          getParameterData(0).p_buffers[param_data_pack_indices[0]].p, // A
+                                          getParameterData(1).p_buffers[param_data_pack_indices[1]].p, // B
+                                          m_vector_size);
+}
+
 } // namespace EltwiseAdd
 } // namespace TestHarness
 } // namespace hebench
@@ -14,6 +14,7 @@
 
 #include "include/hebench_benchmark_factory.h"
 #include "include/hebench_idata_loader.h"
+#include "include/hebench_utilities.h"
 
 namespace hebench {
 namespace TestHarness {
@@ -66,18 +67,67 @@ public:
     static constexpr std::size_t Index_b = 1;
     static constexpr std::size_t Index_X = 2;
 
+    /**
+     * @brief Title of the report footer block with the error of the results
+     * against the exact sigmoid.
+     * @details The block is followed by line
+     * "Degree,Results,Max absolute error,Mean absolute error,RMS error" and a
+     * line with the values. See appendActivationError().
+     */
+    static constexpr const char *ActivationErrorFooterTitle = "Activation error";
+
+    /**
+     * @brief Degree of the polynomial that approximates the sigmoid, or 0
+     * for the exact sigmoid.
+     */
+    static unsigned int getDegree(PolynomialDegree polynomial_degree);
+
     static DataGenerator::Ptr create(PolynomialDegree polynomial_degree,
                                      std::uint64_t vector_size,
                                      std::uint64_t batch_size_input,
-                                     hebench::APIBridge::DataType data_type);
+                                     hebench::APIBridge::DataType data_type,
+                                     RunArena::Ptr p_arena);
 
     ~DataGenerator() override = default;
 
+    bool canComputeResult() const override { return true; }
+    void computeResultUnchecked(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                const std::uint64_t *param_data_pack_indices) override;
+
+    /**
+     * @brief Accumulates the error of a result against the exact sigmoid of
+     * the inputs that produced it.
+     * @param[in] result Buffer containing the result to measure.
+     * @param[in] param_data_pack_indices Collection of indices for data sample
+     * to use inside each parameter pack. See IDataLoader::getResultIndex().
+     * @details The exact sigmoid is computed in double precision regardless
+     * of the data type, so the error of the exact sigmoid workload shows the
+     * precision of the backend alone.
+     */
+    void addActivationError(const hebench::APIBridge::NativeDataBuffer &result,
+                            const std::uint64_t *param_data_pack_indices);
+    /**
+     * @brief Appends the error accumulated by addActivationError() to the
+     * report footer and restarts accumulation.
+     * @details Nothing is appended if no error has been accumulated.
+     * @sa ActivationErrorFooterTitle
+     */
+    void appendActivationError(hebench::Utilities::TimingReportEx &out_report);
+
 private:
     static constexpr std::size_t InputDim0  = BenchmarkDescriptionCategory::OpParameterCount;
     static constexpr std::size_t OutputDim0 = BenchmarkDescriptionCategory::OpResultCount;
 
-    DataGenerator() = default;
+    PolynomialDegree m_polynomial_degree;
+    std::uint64_t m_vector_size;
+    hebench::APIBridge::DataType m_data_type;
+    std::uint64_t m_error_count;
+    double m_error_max;
+    double m_error_sum;
+    double m_error_sum_sq;
+
+    DataGenerator(RunArena::Ptr p_arena) :
+        PartialDataLoader(p_arena) {}
     void init(PolynomialDegree polynomial_degree,
               std::uint64_t vector_size,
               std::uint64_t batch_size_input,
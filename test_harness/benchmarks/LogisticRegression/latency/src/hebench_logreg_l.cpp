@@ -171,7 +171,8 @@ void Benchmark::init(const IBenchmarkDescription::Description &description)
     m_data         = DataGenerator::create(pd,
                                    vector_size,
                                    batch_sizes[DataGenerator::Index_X],
-                                   m_descriptor.data_type);
+                                   m_descriptor.data_type,
+                                   getRunArena());
     p_timing_event = timer.stop<std::milli>();
 
     ss = std::stringstream();
@@ -193,7 +194,16 @@ bool Benchmark::validateResult(IDataLoader::Ptr dataset,
     assert(dataset->getParameterCount() == BenchmarkDescriptionCategory::OpParameterCount
            && dataset->getResultCount() == BenchmarkDescriptionCategory::OpResultCount);
 
-    return BenchmarkLatency::validateResult(dataset, param_data_pack_indices, outputs, data_type);
+    bool retval = BenchmarkLatency::validateResult(dataset, param_data_pack_indices, outputs, data_type);
+    if (retval)
+        m_data->addActivationError(*outputs.front(), param_data_pack_indices);
+
+    return retval;
+}
+
+void Benchmark::appendReferenceError(hebench::Utilities::TimingReportEx &out_report)
+{
+    m_data->appendActivationError(out_report);
 }
 
 } // namespace Latency
@@ -69,6 +69,7 @@ protected:
                         const std::uint64_t *param_data_pack_indices,
                         const std::vector<hebench::APIBridge::NativeDataBuffer *> &p_outputs,
                         hebench::APIBridge::DataType data_type) const override;
+    void appendReferenceError(hebench::Utilities::TimingReportEx &out_report) override;
 
 private:
     DataGenerator::Ptr m_data;
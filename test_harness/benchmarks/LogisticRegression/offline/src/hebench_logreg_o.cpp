@@ -73,7 +73,9 @@ void BenchmarkDescription::completeDescription(const Engine &engine,
     std::uint64_t result_batch_size = computeSampleSizes(batch_sizes,
                                                          OpParameterCount,
                                                          default_batch_size,
+                                                         pre_token->getBenchmarkConfiguration(this).operand_sample_sizes,
                                                          bench_desc);
+    describeSampleSizes(pre_token->description, batch_sizes, OpParameterCount, bench_desc);
     if (batch_sizes[DataGenerator::Index_W] != 1)
     {
         ss = std::stringstream();
@@ -178,6 +180,7 @@ void Benchmark::init(const IBenchmarkDescription::Description &description)
     BenchmarkDescription::computeSampleSizes(batch_sizes,
                                              BenchmarkDescription::OpParameterCount,
                                              default_batch_size,
+                                             m_benchmark_configuration.operand_sample_sizes,
                                              bench_desc);
 
     assert(batch_sizes[DataGenerator::Index_W] == 1 && batch_sizes[DataGenerator::Index_b] == 1);
@@ -207,7 +210,8 @@ void Benchmark::init(const IBenchmarkDescription::Description &description)
     m_data         = DataGenerator::create(pd,
                                    vector_size,
                                    batch_sizes[DataGenerator::Index_X],
-                                   m_descriptor.data_type);
+                                   m_descriptor.data_type,
+                                   getRunArena());
     p_timing_event = timer.stop<std::milli>();
 
     ss = std::stringstream();
@@ -229,7 +233,16 @@ bool Benchmark::validateResult(IDataLoader::Ptr dataset,
     assert(dataset->getParameterCount() == BenchmarkDescriptionCategory::OpParameterCount
            && dataset->getResultCount() == BenchmarkDescriptionCategory::OpResultCount);
 
-    return BenchmarkOffline::validateResult(dataset, param_data_pack_indices, outputs, data_type);
+    bool retval = BenchmarkOffline::validateResult(dataset, param_data_pack_indices, outputs, data_type);
+    if (retval)
+        m_data->addActivationError(*outputs.front(), param_data_pack_indices);
+
+    return retval;
+}
+
+void Benchmark::appendReferenceError(hebench::Utilities::TimingReportEx &out_report)
+{
+    m_data->appendActivationError(out_report);
 }
 
 } // namespace Offline
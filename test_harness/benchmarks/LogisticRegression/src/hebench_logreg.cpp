@@ -2,9 +2,11 @@
 // Copyright (C) 2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <iomanip>
 #include <iterator>
 #include <random>
 #include <sstream>
@@ -15,6 +17,7 @@
 #include "../include/hebench_logreg.h"
 #include "benchmarks/datagen_helper/include/datagen_helper.h"
 #include "include/hebench_math_utils.h"
+#include "include/hebench_overhead.h"
 
 namespace hebench {
 namespace TestHarness {
@@ -125,6 +128,13 @@ public:
                                             DataGenerator::PolynomialDegree poly_deg,
                                             void *result, const void *w, const void *b, const void *input,
                                             std::uint64_t feature_count);
+    /**
+     * @brief Computes the exact sigmoid of the linear regression of the inputs
+     * in double precision.
+     */
+    static double logisticRegressionExact(hebench::APIBridge::DataType data_type,
+                                          const void *p_w, const void *p_bias, const void *p_input,
+                                          std::uint64_t feature_count);
 
 protected:
     DataGeneratorHelper() = default;
@@ -140,6 +150,10 @@ private:
     static void logisticRegressionInference(DataGenerator::PolynomialDegree poly_deg,
                                             T &result, const T *p_w, const T &b, const T *p_input,
                                             std::uint64_t feature_count);
+
+    template <class T> // T must always be floating point
+    static double logisticRegressionExact(const T *p_w, const T &b, const T *p_input,
+                                          std::uint64_t feature_count);
 };
 
 template <class T, class Container>
@@ -213,6 +227,15 @@ inline void DataGeneratorHelper::logisticRegressionInference(DataGenerator::Poly
     } // end switch
 }
 
+template <class T>
+inline double DataGeneratorHelper::logisticRegressionExact(const T *p_w, const T &b, const T *p_input,
+                                                           std::uint64_t feature_count)
+{
+    double linear_regression = std::inner_product(p_w, p_w + feature_count, p_input, 0.0)
+                               + static_cast<double>(b);
+    return sigmoid<0>(linear_regression);
+}
+
 void DataGeneratorHelper::logisticRegressionInference(hebench::APIBridge::DataType data_type,
                                                       DataGenerator::PolynomialDegree poly_deg,
                                                       void *p_result, const void *p_w, const void *p_bias, const void *p_input,
@@ -249,16 +272,76 @@ void DataGeneratorHelper::logisticRegressionInference(hebench::APIBridge::DataTy
     } // end switch
 }
 
+double DataGeneratorHelper::logisticRegressionExact(hebench::APIBridge::DataType data_type,
+                                                    const void *p_w, const void *p_bias, const void *p_input,
+                                                    std::uint64_t feature_count)
+{
+    if (!p_bias)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid null 'p_bias'."));
+
+    double retval;
+
+    switch (data_type)
+    {
+    case hebench::APIBridge::DataType::Float32:
+        retval = logisticRegressionExact<float>(reinterpret_cast<const float *>(p_w),
+                                                *reinterpret_cast<const float *>(p_bias),
+                                                reinterpret_cast<const float *>(p_input),
+                                                feature_count);
+        break;
+
+    case hebench::APIBridge::DataType::Float64:
+        retval = logisticRegressionExact<double>(reinterpret_cast<const double *>(p_w),
+                                                 *reinterpret_cast<const double *>(p_bias),
+                                                 reinterpret_cast<const double *>(p_input),
+                                                 feature_count);
+        break;
+
+    default:
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Data type not supported."));
+        break;
+    } // end switch
+
+    return retval;
+}
+
 //---------------------
 // class DataGenerator
 //---------------------
 
+unsigned int DataGenerator::getDegree(PolynomialDegree polynomial_degree)
+{
+    unsigned int retval;
+
+    switch (polynomial_degree)
+    {
+    case PolynomialDegree::PD3:
+        retval = 3;
+        break;
+
+    case PolynomialDegree::PD5:
+        retval = 5;
+        break;
+
+    case PolynomialDegree::PD7:
+        retval = 7;
+        break;
+
+    default:
+        retval = 0;
+        break;
+    } // end switch
+
+    return retval;
+}
+
 DataGenerator::Ptr DataGenerator::create(PolynomialDegree polynomial_degree,
                                          std::uint64_t vector_size,
                                          std::uint64_t batch_size_input,
-                                         hebench::APIBridge::DataType data_type)
+                                         hebench::APIBridge::DataType data_type,
+                                         RunArena::Ptr p_arena)
 {
-    DataGenerator::Ptr retval = DataGenerator::Ptr(new DataGenerator());
+    DataGenerator::Ptr retval = DataGenerator::Ptr(new DataGenerator(p_arena));
     retval->init(polynomial_degree, vector_size, batch_size_input, data_type);
     return retval;
 }
@@ -272,6 +355,14 @@ void DataGenerator::init(PolynomialDegree polynomial_degree,
 
     assert(InputDim0 + OutputDim0 >= 4);
 
+    m_polynomial_degree = polynomial_degree;
+    m_vector_size       = vector_size;
+    m_data_type         = data_type;
+    m_error_count       = 0;
+    m_error_max         = 0.0;
+    m_error_sum         = 0.0;
+    m_error_sum_sq      = 0.0;
+
     // number of samples in each input parameter and output
     std::size_t batch_sizes[InputDim0 + OutputDim0] = {
         1, // W
@@ -314,6 +405,8 @@ void DataGenerator::init(PolynomialDegree polynomial_degree,
     } // end for
 
     // output
+    HarnessOverhead::Scope overhead_scope(HarnessOverhead::GroundTruthPhaseName);
+    std::vector<hebench::APIBridge::NativeDataBuffer *> results(OutputDim0);
     //#pragma omp parallel for
     for (std::uint64_t input_i = 0; input_i < batch_sizes[2]; ++input_i)
     {
@@ -322,17 +415,69 @@ void DataGenerator::init(PolynomialDegree polynomial_degree,
         std::uint64_t r_i   = getResultIndex(ppi);
 
         // generate the data
-        DataGeneratorHelper::logisticRegressionInference(data_type, polynomial_degree,
-                                                         getResultData(0).p_buffers[r_i].p, // result
-                                                         getParameterData(Index_W).p_buffers[0].p, // W
-                                                         getParameterData(Index_b).p_buffers[0].p, // b
-                                                         getParameterData(Index_X).p_buffers[input_i].p, // X
-                                                         vector_size);
+        results.front() = &getResultData(0).p_buffers[r_i]; // result
+        computeResult(results, ppi);
     } // end for
 
     // all data has been generated at this point
 }
 
+void DataGenerator::computeResultUnchecked(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                           const std::uint64_t *param_data_pack_indices)
+{
+    DataGeneratorHelper::logisticRegressionInference(m_data_type, m_polynomial_degree,
+                                                     results.front()->p, // result
+                                                     getParameterData(Index_W).p_buffers[param_data_pack_indices[Index_W]].p, // W
+                                                     getParameterData(Index_b).p_buffers[param_data_pack_indices[Index_b]].p, // b
+                                                     getParameterData(Index_X).p_buffers[param_data_pack_indices[Index_X]].p, // X
+                                                     m_vector_size);
+}
+
+void DataGenerator::addActivationError(const hebench::APIBridge::NativeDataBuffer &result,
+                                       const std::uint64_t *param_data_pack_indices)
+{
+    if (!result.p || result.size < PartialDataLoader::sizeOf(m_data_type))
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid result buffer."));
+    if (!param_data_pack_indices)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid null 'param_data_pack_indices'."));
+
+    double exact = DataGeneratorHelper::logisticRegressionExact(m_data_type,
+                                                                getParameterData(Index_W).p_buffers[param_data_pack_indices[Index_W]].p, // W
+                                                                getParameterData(Index_b).p_buffers[param_data_pack_indices[Index_b]].p, // b
+                                                                getParameterData(Index_X).p_buffers[param_data_pack_indices[Index_X]].p, // X
+                                                                m_vector_size);
+    double value = (m_data_type == hebench::APIBridge::DataType::Float32 ?
+                        static_cast<double>(*reinterpret_cast<const float *>(result.p)) :
+                        *reinterpret_cast<const double *>(result.p));
+    double error = std::abs(value - exact);
+
+    ++m_error_count;
+    m_error_max = std::max(m_error_max, error);
+    m_error_sum += error;
+    m_error_sum_sq += error * error;
+}
+
+void DataGenerator::appendActivationError(hebench::Utilities::TimingReportEx &out_report)
+{
+    if (m_error_count <= 0)
+        return;
+
+    std::stringstream ss;
+    ss << std::setprecision(17)
+       << ActivationErrorFooterTitle << std::endl
+       << "Degree,Results,Max absolute error,Mean absolute error,RMS error" << std::endl
+       << getDegree(m_polynomial_degree) << "," << m_error_count << ","
+       << m_error_max << ","
+       << m_error_sum / m_error_count << ","
+       << std::sqrt(m_error_sum_sq / m_error_count);
+    out_report.appendFooter(ss.str());
+
+    m_error_count  = 0;
+    m_error_max    = 0.0;
+    m_error_sum    = 0.0;
+    m_error_sum_sq = 0.0;
+}
+
 } // namespace LogisticRegression
 } // namespace TestHarness
 } // namespace hebench
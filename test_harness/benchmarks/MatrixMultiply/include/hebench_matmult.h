@@ -66,22 +66,68 @@ private:
 public:
     typedef std::shared_ptr<DataGenerator> Ptr;
 
+    /**
+     * @brief Generates the input matrices and, optionally, the ground truth.
+     * @param[in] p_arena Arena of the benchmark run from which to allocate the
+     * data descriptors.
+     * @param[in] b_compute_ground_truth Specifies whether ground truth will be
+     * computed and stored. If false, result buffers only hold their size and
+     * results must be checked with validateResultFreivalds().
+     */
     static DataGenerator::Ptr create(std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b,
                                      std::uint64_t batch_size_mat_a,
                                      std::uint64_t batch_size_mat_b,
-                                     hebench::APIBridge::DataType data_type);
+                                     hebench::APIBridge::DataType data_type,
+                                     RunArena::Ptr p_arena,
+                                     bool b_compute_ground_truth = true);
 
     ~DataGenerator() override {}
 
+    bool canComputeResult() const override { return true; }
+    void computeResultUnchecked(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                const std::uint64_t *param_data_pack_indices) override;
+
+    /**
+     * @brief Validates the result of a multiplication using Freivalds' algorithm.
+     * @param[in] param_data_pack_indices Indices of the input matrices used for
+     * the multiplication. See IDataLoader::getResultIndex().
+     * @param[in] outputs Result of the multiplication to validate.
+     * @param[in] rounds Number of rounds of the check. An incorrect result passes
+     * each round with probability at most one half.
+     * @param[in] seed Seed for the random projections. Combined with
+     * \p param_data_pack_indices, so that every result gets different projections.
+     * @returns `true` if result is valid.
+     * @throws std::runtime_error if result is not valid.
+     * @details For random vectors `r` with elements in {-1, 1}, checks that
+     * `C * r` matches `A * (B * r)`, which takes quadratic time instead of the
+     * cubic time needed to compute ground truth. Integer results are projected
+     * exactly and must match. Floating point results are compared with the
+     * same relative tolerance used when validating against ground truth: each
+     * row of `C * r` may deviate by the sum over its elements of `|r_j|` times
+     * the tolerance of element `j`.
+     */
+    bool validateResultFreivalds(const std::uint64_t *param_data_pack_indices,
+                                 const std::vector<hebench::APIBridge::NativeDataBuffer *> &outputs,
+                                 std::uint64_t rounds,
+                                 std::uint64_t seed) const;
+
 private:
-    static constexpr std::size_t InputDim0  = 2;
-    static constexpr std::size_t OutputDim0 = 1;
+    static constexpr std::size_t InputDim0      = 2;
+    static constexpr std::size_t OutputDim0     = 1;
+    static constexpr double ValidationTolerance = 0.01; // relative, per element, as in ground truth validation
+
+    std::uint64_t m_rows_a;
+    std::uint64_t m_cols_a;
+    std::uint64_t m_cols_b;
+    hebench::APIBridge::DataType m_data_type;
 
-    DataGenerator() {}
+    DataGenerator(RunArena::Ptr p_arena) :
+        PartialDataLoader(p_arena) {}
     void init(std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b,
               std::uint64_t batch_size_mat_a,
               std::uint64_t batch_size_mat_b,
-              hebench::APIBridge::DataType data_type);
+              hebench::APIBridge::DataType data_type,
+              bool b_compute_ground_truth);
 };
 
 } // namespace MatrixMultiply
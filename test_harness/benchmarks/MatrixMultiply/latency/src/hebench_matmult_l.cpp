@@ -140,10 +140,13 @@ void Benchmark::init(const IBenchmarkDescription::Description &description)
 
     timer.start();
     // generates random matrices for input and generates (computes) ground truth
+    // unless results are validated with Freivalds' algorithm
     m_data         = DataGenerator::create(mat_dims[0].first, mat_dims[0].second, // M0
                                    mat_dims[1].second, // M1
                                    batch_sizes[0], batch_sizes[1],
-                                   m_descriptor.data_type);
+                                   m_descriptor.data_type,
+                                   getRunArena(),
+                                   m_benchmark_configuration.probabilistic_validation_rounds <= 0);
     p_timing_event = timer.stop<std::milli>();
 
     ss = std::stringstream();
@@ -165,6 +168,11 @@ bool Benchmark::validateResult(IDataLoader::Ptr dataset,
     assert(dataset->getParameterCount() == BenchmarkDescriptionCategory::OpParameterCount
            && dataset->getResultCount() == BenchmarkDescriptionCategory::OpResultCount);
 
+    if (m_benchmark_configuration.probabilistic_validation_rounds > 0)
+        return m_data->validateResultFreivalds(param_data_pack_indices, outputs,
+                                               m_benchmark_configuration.probabilistic_validation_rounds,
+                                               m_benchmark_configuration.random_seed);
+
     return BenchmarkLatency::validateResult(dataset, param_data_pack_indices, outputs, data_type);
 }
 
@@ -70,7 +70,9 @@ void BenchmarkDescription::completeDescription(const Engine &engine,
     std::uint64_t result_batch_size = computeSampleSizes(batch_sizes,
                                                          OpParameterCount,
                                                          default_batch_size,
+                                                         pre_token->getBenchmarkConfiguration(this).operand_sample_sizes,
                                                          pre_token->getDescriptor(this));
+    describeSampleSizes(pre_token->description, batch_sizes, OpParameterCount, pre_token->getDescriptor(this));
 
     // complete header with workload specifics
     ss << ", , M = M0 x M1" << std::endl
@@ -140,6 +142,7 @@ void Benchmark::init(const IBenchmarkDescription::Description &description)
     BenchmarkDescription::computeSampleSizes(batch_sizes,
                                              BenchmarkDescription::OpParameterCount,
                                              default_batch_size,
+                                             m_benchmark_configuration.operand_sample_sizes,
                                              m_descriptor);
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Generating workload...") << std::endl;
@@ -148,10 +151,13 @@ void Benchmark::init(const IBenchmarkDescription::Description &description)
 
     timer.start();
     // generates random matrices for input and generates (computes) ground truth
+    // unless results are validated with Freivalds' algorithm
     m_data         = DataGenerator::create(mat_dims[0].first, mat_dims[0].second, // M0
                                    mat_dims[1].second, // M1
                                    batch_sizes[0], batch_sizes[1],
-                                   m_descriptor.data_type);
+                                   m_descriptor.data_type,
+                                   getRunArena(),
+                                   m_benchmark_configuration.probabilistic_validation_rounds <= 0);
     p_timing_event = timer.stop<std::milli>();
 
     ss = std::stringstream();
@@ -173,6 +179,11 @@ bool Benchmark::validateResult(IDataLoader::Ptr dataset,
     assert(dataset->getParameterCount() == BenchmarkDescriptionCategory::OpParameterCount
            && dataset->getResultCount() == BenchmarkDescriptionCategory::OpResultCount);
 
+    if (m_benchmark_configuration.probabilistic_validation_rounds > 0)
+        return m_data->validateResultFreivalds(param_data_pack_indices, outputs,
+                                               m_benchmark_configuration.probabilistic_validation_rounds,
+                                               m_benchmark_configuration.random_seed);
+
     return BenchmarkOffline::validateResult(dataset, param_data_pack_indices, outputs, data_type);
 }
 
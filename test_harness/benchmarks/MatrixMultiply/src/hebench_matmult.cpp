@@ -2,11 +2,16 @@
 // Copyright (C) 2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <sstream>
+#include <type_traits>
 
 #include "../include/hebench_matmult.h"
 #include "benchmarks/datagen_helper/include/datagen_helper.h"
+#include "include/hebench_math_utils.h"
+#include "include/hebench_overhead.h"
 
 namespace hebench {
 namespace TestHarness {
@@ -107,6 +112,18 @@ public:
     static void matMul(hebench::APIBridge::DataType data_type,
                        void *mat_result, const void *mat_a, const void *mat_b,
                        std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b);
+    /**
+     * @brief Performs one round of Freivalds' check of mat_result == mat_a * mat_b.
+     * @param[in] projection Random vector of `cols_b` elements in {-1, 1}.
+     * @param[in] tolerance Relative tolerance per element of the result. Not
+     * used for integer data types, which are checked exactly.
+     * @return Indices of the rows of the result that failed the check.
+     */
+    static std::vector<std::uint64_t> freivalds(hebench::APIBridge::DataType data_type,
+                                                const void *mat_result, const void *mat_a, const void *mat_b,
+                                                std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b,
+                                                const std::vector<double> &projection,
+                                                double tolerance);
 
 protected:
     DataGeneratorHelper() {}
@@ -177,6 +194,48 @@ void DataGeneratorHelper::matMul(hebench::APIBridge::DataType data_type,
     } // end switch
 }
 
+std::vector<std::uint64_t> DataGeneratorHelper::freivalds(hebench::APIBridge::DataType data_type,
+                                                          const void *mat_result, const void *mat_a, const void *mat_b,
+                                                          std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b,
+                                                          const std::vector<double> &projection,
+                                                          double tolerance)
+{
+    std::vector<std::uint64_t> retval;
+
+    switch (data_type)
+    {
+    case hebench::APIBridge::DataType::Int32:
+        retval = hebench::Utilities::Math::freivalds<std::int32_t>(reinterpret_cast<const std::int32_t *>(mat_result),
+                                         reinterpret_cast<const std::int32_t *>(mat_a), reinterpret_cast<const std::int32_t *>(mat_b),
+                                         rows_a, cols_a, cols_b, projection, tolerance);
+        break;
+
+    case hebench::APIBridge::DataType::Int64:
+        retval = hebench::Utilities::Math::freivalds<std::int64_t>(reinterpret_cast<const std::int64_t *>(mat_result),
+                                         reinterpret_cast<const std::int64_t *>(mat_a), reinterpret_cast<const std::int64_t *>(mat_b),
+                                         rows_a, cols_a, cols_b, projection, tolerance);
+        break;
+
+    case hebench::APIBridge::DataType::Float32:
+        retval = hebench::Utilities::Math::freivalds<float>(reinterpret_cast<const float *>(mat_result),
+                                  reinterpret_cast<const float *>(mat_a), reinterpret_cast<const float *>(mat_b),
+                                  rows_a, cols_a, cols_b, projection, tolerance);
+        break;
+
+    case hebench::APIBridge::DataType::Float64:
+        retval = hebench::Utilities::Math::freivalds<double>(reinterpret_cast<const double *>(mat_result),
+                                   reinterpret_cast<const double *>(mat_a), reinterpret_cast<const double *>(mat_b),
+                                   rows_a, cols_a, cols_b, projection, tolerance);
+        break;
+
+    default:
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Unknown data type."));
+        break;
+    } // end switch
+
+    return retval;
+}
+
 //---------------------
 // class DataGenerator
 //---------------------
@@ -184,17 +243,20 @@ void DataGeneratorHelper::matMul(hebench::APIBridge::DataType data_type,
 DataGenerator::Ptr DataGenerator::create(std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b,
                                          std::uint64_t batch_size_mat_a,
                                          std::uint64_t batch_size_mat_b,
-                                         hebench::APIBridge::DataType data_type)
+                                         hebench::APIBridge::DataType data_type,
+                                         RunArena::Ptr p_arena,
+                                         bool b_compute_ground_truth)
 {
-    DataGenerator::Ptr retval = DataGenerator::Ptr(new DataGenerator());
-    retval->init(rows_a, cols_a, cols_b, batch_size_mat_a, batch_size_mat_b, data_type);
+    DataGenerator::Ptr retval = DataGenerator::Ptr(new DataGenerator(p_arena));
+    retval->init(rows_a, cols_a, cols_b, batch_size_mat_a, batch_size_mat_b, data_type, b_compute_ground_truth);
     return retval;
 }
 
 void DataGenerator::init(std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b,
                          std::uint64_t batch_size_mat_a,
                          std::uint64_t batch_size_mat_b,
-                         hebench::APIBridge::DataType data_type)
+                         hebench::APIBridge::DataType data_type,
+                         bool b_compute_ground_truth)
 {
     // Load/generate and initialize the data for matrix multiplication:
     // M2 = M0 * M1
@@ -205,6 +267,11 @@ void DataGenerator::init(std::uint64_t rows_a, std::uint64_t cols_a, std::uint64
         batch_size_mat_b,
         batch_size_mat_a * batch_size_mat_b
     };
+    m_rows_a    = rows_a;
+    m_cols_a    = cols_a;
+    m_cols_b    = cols_b;
+    m_data_type = data_type;
+
     // initialize base data (data packs)
     PartialDataLoader::init(InputDim0, batch_sizes, OutputDim0);
 
@@ -225,7 +292,8 @@ void DataGenerator::init(std::uint64_t rows_a, std::uint64_t cols_a, std::uint64
     allocate(buffer_sizes, // sizes (in bytes) for each input matrix
              InputDim0, // number of input matrices
              buffer_sizes + InputDim0, // sizes (in bytes) for each output matrix
-             OutputDim0); // number of output matrices
+             OutputDim0, // number of output matrices
+             b_compute_ground_truth); // ground truth is only stored when computed
 
     // at this point all NativeDataBuffers have been allocated and pointed to the correct locations
 
@@ -246,28 +314,99 @@ void DataGenerator::init(std::uint64_t rows_a, std::uint64_t cols_a, std::uint64
     } // end for
 
     // output
-    //#pragma omp parallel for collapse(2)
-    for (std::uint64_t m0_i = 0; m0_i < batch_sizes[0]; ++m0_i)
+    if (b_compute_ground_truth)
     {
-        for (std::uint64_t m1_i = 0; m1_i < batch_sizes[1]; ++m1_i)
+        HarnessOverhead::Scope overhead_scope(HarnessOverhead::GroundTruthPhaseName);
+        std::vector<hebench::APIBridge::NativeDataBuffer *> results(OutputDim0);
+        //#pragma omp parallel for collapse(2)
+        for (std::uint64_t m0_i = 0; m0_i < batch_sizes[0]; ++m0_i)
         {
-            // find the index for the result buffer based on the input indices
-            std::uint64_t ppi[] = { m0_i, m1_i };
-            std::uint64_t r_i   = getResultIndex(ppi);
+            for (std::uint64_t m1_i = 0; m1_i < batch_sizes[1]; ++m1_i)
+            {
+                // find the index for the result buffer based on the input indices
+                std::uint64_t ppi[] = { m0_i, m1_i };
+                std::uint64_t r_i   = getResultIndex(ppi);
 
-            // generate the data
-            DataGeneratorHelper::matMul(data_type,
-                                        getResultData(0).p_buffers[r_i].p,
-                                        getParameterData(0).p_buffers[m0_i].p,
-                                        getParameterData(1).p_buffers[m1_i].p,
-                                        mat_dims[0].first, mat_dims[0].second, // dims for m0
-                                        mat_dims[1].second); // dims for m1
+                // generate the data
+                results.front() = &getResultData(0).p_buffers[r_i];
+                computeResult(results, ppi);
+            } // end for
         } // end for
-    } // end for
+    } // end if
 
     // all data has been generated at this point
 }
 
+void DataGenerator::computeResultUnchecked(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                           const std::uint64_t *param_data_pack_indices)
+{
+    // M2 = M0 * M1
+    DataGeneratorHelper::matMul(m_data_type,
+                                results.front()->p,
+                                getParameterData(0).p_buffers[param_data_pack_indices[0]].p,
+                                getParameterData(1).p_buffers[param_data_pack_indices[1]].p,
+                                m_rows_a, m_cols_a, // dims for m0
+                                m_cols_b); // dims for m1
+}
+
+bool DataGenerator::validateResultFreivalds(const std::uint64_t *param_data_pack_indices,
+                                            const std::vector<hebench::APIBridge::NativeDataBuffer *> &outputs,
+                                            std::uint64_t rounds,
+                                            std::uint64_t seed) const
+{
+    static constexpr const std::size_t MaxErrorPrint = 10;
+
+    if (!param_data_pack_indices)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid null argument 'param_data_pack_indices'."));
+    for (std::size_t param_i = 0; param_i < InputDim0; ++param_i)
+        if (param_data_pack_indices[param_i] >= getParameterData(param_i).buffer_count)
+            throw std::out_of_range(IL_LOG_MSG_CLASS("Index out of range: 'param_data_pack_indices[" + std::to_string(param_i) + "]'."));
+    if (outputs.size() != OutputDim0)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid number of outputs: 'outputs'."));
+    if (!outputs.front() || !outputs.front()->p)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Unexpected null output component in: 'outputs'."));
+    if (outputs.front()->size < getResultData(0).p_buffers[0].size)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Buffer in outputs is not large enough to contain the expected output: 'outputs'."));
+
+    // every result gets its own reproducible projections
+    std::seed_seq seed_sequence({ seed, param_data_pack_indices[0], param_data_pack_indices[1] });
+    std::mt19937_64 rand(seed_sequence);
+    std::bernoulli_distribution sign;
+    std::vector<double> projection(m_cols_b);
+    std::vector<std::uint64_t> failed_rows;
+
+    for (std::uint64_t round_i = 0; round_i < rounds && failed_rows.empty(); ++round_i)
+    {
+        for (double &r : projection)
+            r = sign(rand) ? 1.0 : -1.0;
+        failed_rows = DataGeneratorHelper::freivalds(m_data_type,
+                                                     outputs.front()->p,
+                                                     getParameterData(0).p_buffers[param_data_pack_indices[0]].p,
+                                                     getParameterData(1).p_buffers[param_data_pack_indices[1]].p,
+                                                     m_rows_a, m_cols_a, m_cols_b,
+                                                     projection,
+                                                     ValidationTolerance);
+    } // end for
+
+    if (!failed_rows.empty())
+    {
+        std::stringstream ss;
+        ss << "Rows failing Freivalds check, " << failed_rows.size() << std::endl
+           << "Failed row indices, ";
+        for (std::size_t i = 0; i < failed_rows.size() && i < MaxErrorPrint; ++i)
+        {
+            ss << failed_rows[i];
+            if (i + 1 < failed_rows.size() && i + 1 < MaxErrorPrint)
+                ss << ", ";
+        } // end for
+        if (failed_rows.size() > MaxErrorPrint)
+            ss << ", ...";
+        throw std::runtime_error(ss.str());
+    } // end if
+
+    return true;
+}
+
 } // namespace MatrixMultiply
 } // namespace TestHarness
 } // namespace hebench
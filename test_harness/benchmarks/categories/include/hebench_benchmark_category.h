@@ -31,6 +31,30 @@ private:
 public:
     typedef std::shared_ptr<PartialBenchmarkCategory> Ptr;
 
+    static constexpr const char *WarmupEventName            = "Warmup";
+    static constexpr const char *PlaintextBaselineEventName = "Plaintext baseline";
+    /**
+     * @brief Span that encloses decoding and validation of all results, when
+     * validating.
+     * @details Its children are the decoding events. The rest of the span is
+     * validation, which is harness time, not backend cost.
+     */
+    static constexpr const char *DecodingValidationEventName = "Decoding and Validation";
+    static constexpr const char *ValidationPhaseName         = "Validation";
+
+    /**
+     * @brief Finds whether events of the specified type measure a top level
+     * phase of the backend workload.
+     * @param[in] event_type_header Header of the event type in the report.
+     * @returns `false` for harness time (warm-up, plaintext baseline, decoding
+     * and validation) and for sub-phases reported by the backend, which are
+     * named "<parent>: <name>" and already accounted for in their parent.
+     * @returns `true` otherwise.
+     * @details Relies on event type headers only, so that it works the same
+     * on reports loaded from files that predate spans.
+     */
+    static bool isBackendPhase(const std::string &event_type_header);
+
     ~PartialBenchmarkCategory() override;
 
 protected:
@@ -124,6 +148,68 @@ protected:
                            const std::uint64_t *param_data_pack_indices,
                            const std::vector<hebench::APIBridge::NativeDataBuffer *> &outputs,
                            hebench::APIBridge::DataType data_type) const;
+    /**
+     * @brief Appends to the report footer the error of the results validated
+     * during the run against the exact function that the ground truth of the
+     * workload approximates.
+     * @param[in,out] out_report Report of the benchmark run.
+     * @details Called after all results have been validated successfully, when
+     * requested by the run configuration. The default implementation does
+     * nothing, since the ground truth of most workloads is exact. Workloads
+     * that override this method are expected to measure the error during
+     * validateResult().
+     * @sa IBenchmark::RunConfig::b_reference_error
+     */
+    virtual void appendReferenceError(hebench::Utilities::TimingReportEx &out_report);
+
+    /**
+     * @brief Marks the start of a new phase of the run.
+     * @param[in] phase_name Name of the phase.
+     * @details Publishes the phase in the live metrics and the harness overhead
+     * accounting, and starts measuring the change in resident memory during
+     * the phase.
+     * @sa beginPhaseMemory()
+     */
+    void setPhase(const std::string &phase_name);
+
+    /**
+     * @brief Times the plaintext computation of the operation on the dataset and
+     * adds the slowdown factor of the backend with respect to it to the report.
+     * @param[in,out] out_report Report of the benchmark run. Must already contain
+     * the events for the backend run.
+     * @param[in] dataset Dataset used for the backend operation.
+     * @param[in] batch_sizes Number of samples of each parameter, starting from
+     * the first, used on each operation. Each operation computes the results for
+     * all combinations of these samples.
+     * @param[in] warmup_iterations Number of operations to run before timing.
+     * @param[in] min_test_time_ms Minimum time to spend timing operations.
+     * @param[in] min_iterations Minimum number of operations to time.
+     * @details Operations are timed in groups as large as needed to make timing
+     * overhead negligible. Every operation over the batch counts as one iteration
+     * per result computed, the same as the backend operation.
+     *
+     * The slowdown factor of each phase is its total wall time per operation of
+     * the benchmark divided by the average wall time of a plaintext operation.
+     * The end to end factor adds up all phases except initialization and
+     * warm-up. Factors are appended to the report footer.
+     *
+     * Nothing is done if \p dataset cannot compute results.
+     */
+    void runPlaintextBaseline(hebench::Utilities::TimingReportEx &out_report,
+                              IDataLoader::Ptr dataset,
+                              const std::vector<std::uint64_t> &batch_sizes,
+                              std::uint64_t warmup_iterations,
+                              std::uint64_t min_test_time_ms,
+                              std::uint64_t min_iterations);
+
+private:
+    /**
+     * @brief Minimum wall time for a plaintext baseline event.
+     */
+    static constexpr double PlaintextMinEventTimeMs = 1.0;
+
+    static void appendSlowdownFactors(hebench::Utilities::TimingReportEx &out_report,
+                                      std::uint32_t baseline_event_id, std::uint64_t results_per_op);
 };
 
 } // namespace TestHarness
@@ -4,12 +4,19 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iostream>
 #include <sstream>
+#include <unordered_map>
+
+#include "modules/timer/include/timer.h"
 
 #include "hebench/api_bridge/api.h"
 
 #include "../include/hebench_benchmark_category.h"
+#include "include/hebench_live_metrics.h"
 #include "include/hebench_math_utils.h"
+#include "include/hebench_overhead.h"
+#include "include/hebench_progress.h"
 #include "include/hebench_utilities.h"
 
 namespace hebench {
@@ -91,6 +98,15 @@ PartialBenchmarkCategory::~PartialBenchmarkCategory()
 {
 }
 
+bool PartialBenchmarkCategory::isBackendPhase(const std::string &event_type_header)
+{
+    return event_type_header.find(": ") == std::string::npos
+           && event_type_header != WarmupEventName
+           && event_type_header != PlaintextBaselineEventName
+           && event_type_header != DecodingValidationEventName
+           && event_type_header != ValidationPhaseName;
+}
+
 bool PartialBenchmarkCategory::validateResult(IDataLoader::Ptr dataset,
                                               const std::uint64_t *param_data_pack_indices,
                                               const std::vector<hebench::APIBridge::NativeDataBuffer *> &outputs,
@@ -105,13 +121,15 @@ bool PartialBenchmarkCategory::validateResult(IDataLoader::Ptr dataset,
     if (outputs.size() != dataset->getResultCount())
         throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid number of outputs: 'outputs'."));
 
-    std::vector<const hebench::APIBridge::NativeDataBuffer *> truths =
+    RunArena::vector<const hebench::APIBridge::NativeDataBuffer *> truths =
         dataset->getResultFor(param_data_pack_indices);
 
     if (!truths.empty() && !outputs.empty() && truths.front())
     {
         if (!outputs.front())
             throw std::invalid_argument(IL_LOG_MSG_CLASS("Unexpected null output component in: 'outputs'."));
+        if (!truths.front()->p)
+            throw std::logic_error(IL_LOG_MSG_CLASS("Ground truth was not stored by dataset: validation requires an override."));
 
         if (outputs.front()->size < truths.front()->size)
             throw std::invalid_argument(IL_LOG_MSG_CLASS("Buffer in outputs is not large enough to contain the expected output: 'outputs'."));
@@ -191,7 +209,7 @@ void PartialBenchmarkCategory::logResult(std::ostream &os,
        << "Number of result components (received), " << outputs.size() << std::endl
        << std::endl;
 
-    std::vector<const hebench::APIBridge::NativeDataBuffer *> truths =
+    RunArena::vector<const hebench::APIBridge::NativeDataBuffer *> truths =
         dataset->getResultFor(param_data_pack_indices);
 
     // param_data_pack_indices already validated by previous call
@@ -216,7 +234,10 @@ void PartialBenchmarkCategory::logResult(std::ostream &os,
     for (std::size_t result_component_i = 0; result_component_i < truths.size(); ++result_component_i)
     {
         assert(truths[result_component_i]);
-        os << result_component_i << ", " << truths[result_component_i]->size / IDataLoader::sizeOf(data_type) << std::endl;
+        os << result_component_i << ", " << truths[result_component_i]->size / IDataLoader::sizeOf(data_type);
+        if (!truths[result_component_i]->p)
+            os << " (not stored)";
+        os << std::endl;
 
         if (result_component_i > 0)
             ss << ", ";
@@ -249,9 +270,11 @@ void PartialBenchmarkCategory::logResult(std::ostream &os,
         all_values.push_back(&dataset->getParameterData(param_i).p_buffers[param_data_pack_indices[param_i]]);
         os << param_i << ", ";
     } // end for
-    // ground truth
+    // ground truth (datasets validating on the fly may not store it)
     for (std::size_t result_component_i = 0; result_component_i < truths.size(); ++result_component_i)
     {
+        if (!truths[result_component_i]->p)
+            continue;
         all_values.push_back(truths[result_component_i]);
         os << result_component_i << ", ";
     } // end for
@@ -269,5 +292,192 @@ void PartialBenchmarkCategory::logResult(std::ostream &os,
                                              data_type, true, ", ");
 }
 
+void PartialBenchmarkCategory::appendReferenceError(hebench::Utilities::TimingReportEx &out_report)
+{
+    (void)out_report;
+}
+
+void PartialBenchmarkCategory::setPhase(const std::string &phase_name)
+{
+    LiveMetrics::setPhase(phase_name);
+    HarnessOverhead::setPhase(phase_name);
+    beginPhaseMemory(phase_name);
+}
+
+void PartialBenchmarkCategory::runPlaintextBaseline(hebench::Utilities::TimingReportEx &out_report,
+                                                    IDataLoader::Ptr dataset,
+                                                    const std::vector<std::uint64_t> &batch_sizes,
+                                                    std::uint64_t warmup_iterations,
+                                                    std::uint64_t min_test_time_ms,
+                                                    std::uint64_t min_iterations)
+{
+    if (!dataset->canComputeResult())
+    {
+        std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("Plaintext baseline not supported by dataset (skipping).") << std::endl;
+        return;
+    } // end if
+    if (batch_sizes.size() != dataset->getParameterCount())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid number of batch sizes. Expected " + std::to_string(dataset->getParameterCount())
+                                                     + ", but " + std::to_string(batch_sizes.size()) + " received."));
+
+    LiveMetrics::setPhase(PlaintextBaselineEventName);
+    HarnessOverhead::setPhase(PlaintextBaselineEventName);
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Starting plaintext baseline.") << std::endl;
+
+    // prepare indices and output buffers for every result of an operation,
+    // so that the timed loop only computes
+
+    std::uint64_t param_count    = dataset->getParameterCount();
+    std::uint64_t result_count   = dataset->getResultCount();
+    std::uint64_t results_per_op = 1;
+    std::uint64_t result_size    = 0;
+    for (std::size_t param_i = 0; param_i < batch_sizes.size(); ++param_i)
+    {
+        if (batch_sizes[param_i] <= 0 || batch_sizes[param_i] > dataset->getParameterData(param_i).buffer_count)
+            throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid batch size for parameter " + std::to_string(param_i) + "."));
+        results_per_op *= batch_sizes[param_i];
+    } // end for
+    for (std::uint64_t result_component_i = 0; result_component_i < result_count; ++result_component_i)
+        result_size += dataset->getResultData(result_component_i).p_buffers[0].size;
+
+    std::vector<std::uint8_t> raw_result_buffer(results_per_op * result_size);
+    std::vector<hebench::APIBridge::NativeDataBuffer> result_buffers(results_per_op * result_count);
+    std::vector<std::vector<hebench::APIBridge::NativeDataBuffer *>> results(results_per_op);
+    std::vector<std::uint64_t> data_pack_indices(results_per_op * param_count);
+    // ComponentCounter increments starting from component 0,
+    // but we want to increment starting from most significant component,
+    // so, reverse the sizes:
+    hebench::Utilities::Math::ComponentCounter param_counter(std::vector<std::size_t>(batch_sizes.rbegin(), batch_sizes.rend()));
+    std::uint64_t offset = 0;
+    for (std::uint64_t result_i = 0; result_i < results_per_op; ++result_i)
+    {
+        const auto &count = param_counter.getCount();
+        std::copy(count.rbegin(), count.rend(), data_pack_indices.begin() + result_i * param_count);
+        results[result_i].resize(result_count);
+        for (std::uint64_t result_component_i = 0; result_component_i < result_count; ++result_component_i)
+        {
+            hebench::APIBridge::NativeDataBuffer &buffer = result_buffers[result_i * result_count + result_component_i];
+            buffer.p                                     = raw_result_buffer.data() + offset;
+            buffer.size                                  = dataset->getResultData(result_component_i).p_buffers[0].size;
+            buffer.tag                                   = 0;
+            offset += buffer.size;
+            results[result_i][result_component_i] = &buffer;
+        } // end for
+        param_counter.inc();
+    } // end for
+
+    // validate arguments once with a full operation
+    for (std::size_t result_i = 0; result_i < results.size(); ++result_i)
+        dataset->computeResult(results[result_i], data_pack_indices.data() + result_i * param_count);
+
+    auto compute_operation = [&dataset, &results, &data_pack_indices, param_count]() {
+        for (std::size_t result_i = 0; result_i < results.size(); ++result_i)
+            dataset->computeResultUnchecked(results[result_i], data_pack_indices.data() + result_i * param_count);
+    };
+
+    for (std::uint64_t rep_i = 0; rep_i < warmup_iterations; ++rep_i)
+        compute_operation();
+
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Minimum time: " + std::to_string(min_test_time_ms) + " ms") << std::endl;
+
+    hebench::Common::EventTimer<true> timer; // high precision
+    hebench::Common::TimingReportEvent::Ptr p_timing_event;
+    std::uint32_t event_id = getEventIDNext();
+    out_report.addEventType(event_id, PlaintextBaselineEventName);
+    std::uint64_t op_count      = 0;
+    std::uint64_t ops_per_event = 1;
+    double elapsed_ms           = 0.0;
+    Progress::beginPhase(PlaintextBaselineEventName);
+    while (op_count < min_iterations || elapsed_ms < min_test_time_ms)
+    {
+        timer.start();
+        for (std::uint64_t op_i = 0; op_i < ops_per_event; ++op_i)
+            compute_operation();
+        p_timing_event = timer.stop<DefaultTimeInterval>(event_id, ops_per_event * results_per_op, nullptr);
+        double event_ms = p_timing_event->elapsedWallTime<std::milli>();
+        elapsed_ms += event_ms;
+        out_report.addEvent<DefaultTimeInterval>(p_timing_event, std::string(PlaintextBaselineEventName));
+        Progress::advance(ops_per_event);
+        op_count += ops_per_event;
+
+        // group more operations per event until timing overhead is negligible
+        if (event_ms < PlaintextMinEventTimeMs)
+            ops_per_event *= 2;
+    } // end while
+    Progress::endPhase();
+
+    appendSlowdownFactors(out_report, event_id, results_per_op);
+
+    std::cout << IOS_MSG_DONE << std::endl;
+}
+
+void PartialBenchmarkCategory::appendSlowdownFactors(hebench::Utilities::TimingReportEx &out_report,
+                                                     std::uint32_t baseline_event_id, std::uint64_t results_per_op)
+{
+    struct PhaseTime
+    {
+        std::string name;
+        double wall_time_s;
+    };
+    std::vector<PhaseTime> phases;
+    std::unordered_map<std::uint32_t, std::size_t> phase_index;
+    double baseline_wall_time_s  = 0.0;
+    std::uint64_t baseline_count = 0;
+    std::uint32_t main_event_id  = out_report.getMainEventType();
+    std::uint64_t op_count       = 0; // operations of the benchmark
+
+    const hebench::TestHarness::Report::TimingReportEventC *p_events = out_report.getEventsData();
+    for (std::uint64_t event_i = 0; p_events && event_i < out_report.getEventCount(); ++event_i)
+    {
+        const hebench::TestHarness::Report::TimingReportEventC &event = p_events[event_i];
+        double wall_time_s                                            = (event.wall_time_end - event.wall_time_start)
+                                     * event.time_interval_ratio_num / event.time_interval_ratio_den;
+        if (event.event_type_id == baseline_event_id)
+        {
+            baseline_wall_time_s += wall_time_s;
+            baseline_count += event.iterations / results_per_op;
+        } // end if
+        else
+        {
+            auto it = phase_index.find(event.event_type_id);
+            if (it == phase_index.end())
+            {
+                it = phase_index.emplace(event.event_type_id, phases.size()).first;
+                phases.push_back({ out_report.getEventTypeHeader(event.event_type_id), 0.0 });
+            } // end if
+            phases[it->second].wall_time_s += wall_time_s;
+            // main events count one iteration per result, same as the baseline
+            if (event.event_type_id == main_event_id)
+                op_count += event.iterations / results_per_op;
+        } // end else
+    } // end for
+    if (baseline_count <= 0 || baseline_wall_time_s <= 0.0 || op_count <= 0)
+        return;
+
+    double op_wall_time_s = baseline_wall_time_s / baseline_count;
+    double end_to_end     = 0.0;
+    std::stringstream ss;
+    ss << "Plaintext baseline" << std::endl
+       << "Average wall time per operation (s)," << op_wall_time_s << std::endl
+       << "Phase,Slowdown factor" << std::endl;
+    for (const PhaseTime &phase : phases)
+    {
+        if (!isBackendPhase(phase.name))
+            continue;
+        // phases that run once per benchmark, such as encoding in latency,
+        // are amortized over all operations
+        double phase_wall_time_s = phase.wall_time_s / op_count;
+        if (phase.name != "Initialization")
+            end_to_end += phase_wall_time_s;
+        ss << phase.name << "," << phase_wall_time_s / op_wall_time_s << std::endl;
+    } // end for
+    ss << "End to end," << end_to_end / op_wall_time_s;
+    out_report.appendFooter(ss.str());
+
+    ss = std::stringstream();
+    ss << "Plaintext slowdown (end to end): " << end_to_end / op_wall_time_s << "x";
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+}
+
 } // namespace TestHarness
 } // namespace hebench
@@ -14,7 +14,10 @@
 
 #include "hebench/api_bridge/api.h"
 #include "include/hebench_engine.h"
+#include "include/hebench_live_metrics.h"
 #include "include/hebench_math_utils.h"
+#include "include/hebench_overhead.h"
+#include "include/hebench_progress.h"
 
 #include "../include/hebench_benchmark_latency.h"
 
@@ -50,6 +53,8 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     std::uint32_t event_id = getEventIDNext();
     std::string event_name;
     hebench::Common::TimingReportEvent::Ptr p_timing_event;
+    // short-lived collections for this run are allocated from the benchmark arena
+    std::pmr::memory_resource *p_run_resource = getRunArena()->resource();
 
     // The following is simplified since latency test is predefined to have a
     // single sample for each parameter and result
@@ -69,7 +74,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     // param_packs[1].param_position = 1; // B is the second parameter, so, position 1
 
     // create the data packs
-    std::vector<hebench::APIBridge::DataPack> param_packs(p_dataset->getParameterCount());
+    RunArena::vector<hebench::APIBridge::DataPack> param_packs(p_dataset->getParameterCount(), p_run_resource);
     for (std::size_t param_i = 0; param_i < param_packs.size(); ++param_i)
     {
         assert(p_dataset->getParameterData(param_i).param_position == param_i);
@@ -85,8 +90,8 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     // packed_parameters.pack_count = op_params_count;
 
     // separate param packs in encrypted/plain
-    std::vector<hebench::APIBridge::PackedData> packed_parameters(2);
-    std::vector<std::vector<hebench::APIBridge::DataPack>> packed_parameters_data_packs(packed_parameters.size());
+    RunArena::vector<hebench::APIBridge::PackedData> packed_parameters(2, p_run_resource);
+    RunArena::vector<RunArena::vector<hebench::APIBridge::DataPack>> packed_parameters_data_packs(packed_parameters.size(), p_run_resource);
     std::bitset<sizeof(std::uint32_t)> cipher_param_mask(m_descriptor.cipher_param_mask);
     for (std::size_t i = 0; i < param_packs.size(); ++i)
     {
@@ -113,9 +118,10 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     // Handle h_encoded_inputs;
     // encode(h_benchmark, &packed_parameters, &h_encoded_inputs);
 
+    setPhase("Encoding");
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Encoding.") << std::endl;
 
-    std::vector<RAIIHandle> h_inputs(packed_parameters.size());
+    RunArena::vector<RAIIHandle> h_inputs(packed_parameters.size(), p_run_resource);
     for (std::size_t i = 0; i < packed_parameters.size(); ++i)
     {
         event_id = getEventIDNext();
@@ -127,6 +133,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
             validateRetCode(hebench::APIBridge::encode(handle(), &packed_parameters[i], &h_inputs[i].handle));
             p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
             out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+            addSubPhaseEvents(out_report, *p_timing_event, event_name);
         } // end if
         else
             std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Pack " + std::to_string(i) + " is empty (skipping).") << std::endl;
@@ -138,6 +145,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
     event_id   = getEventIDNext();
     event_name = "Encryption";
+    setPhase(event_name);
 
     // Handle h_cipher_inputs;
     // encrypt(h_benchmark, h_encoded_inputs, &h_cipher_inputs);
@@ -154,6 +162,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
         validateRetCode(hebench::APIBridge::encrypt(handle(), h_inputs.front().handle, &encrypted_input));
         p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
         out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+        addSubPhaseEvents(out_report, *p_timing_event, event_name);
 
         // overwrite the first input handle by its encrypted version
         h_inputs.front() = encrypted_input; // old handle automatically destroyed by RAII
@@ -167,6 +176,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
     event_id   = getEventIDNext();
     event_name = "Loading";
+    setPhase(event_name);
 
     // Handle h_remote_inputs;
     // load(h_benchmark,
@@ -174,7 +184,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     //      &h_remote_inputs);
 
     // prepare handles for loading
-    std::vector<hebench::APIBridge::Handle> h_inputs_local;
+    RunArena::vector<hebench::APIBridge::Handle> h_inputs_local(p_run_resource);
     for (std::size_t i = 0; i < packed_parameters.size(); ++i)
     {
         if (packed_parameters[i].pack_count > 0)
@@ -192,6 +202,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
                                              &h_inputs_remote.handle));
     p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
     out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+    addSubPhaseEvents(out_report, *p_timing_event, event_name);
 
     std::cout << IOS_MSG_OK << std::endl;
 
@@ -215,7 +226,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     // params[1].batch_size = 10; // for parameter B we will be using 10 values
     // params[1].value_index = 0; // starting with the first.
 
-    std::vector<hebench::APIBridge::ParameterIndexer> params(p_dataset->getParameterCount());
+    RunArena::vector<hebench::APIBridge::ParameterIndexer> params(p_dataset->getParameterCount(), p_run_resource);
     for (std::size_t i = 0; i < params.size(); ++i)
     {
         params[i].batch_size  = batch_size;
@@ -225,7 +236,8 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     // operate
 
     event_id   = getEventIDNext();
-    event_name = "Warmup";
+    event_name = WarmupEventName;
+    setPhase(event_name);
 
     // Handle h_remote_result;
     // operate(h_benchmark,
@@ -252,6 +264,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
                                                         &h_result_remote.handle));
             p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
             out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+            addSubPhaseEvents(out_report, *p_timing_event, event_name);
         } // end for
 
         std::cout << IOS_MSG_DONE << std::endl;
@@ -270,21 +283,26 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Starting latency test.") << std::endl
               << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Requested time: " + std::to_string(m_descriptor.cat_params.latency.min_test_time_ms) + " ms") << std::endl
               << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Actual time: " + std::to_string(min_test_time_ms) + " ms") << std::endl;
+    std::uint64_t min_op_count = std::max<std::uint64_t>(bench_config.min_latency_iterations, 2);
+    if (bench_config.min_latency_iterations > 0)
+        std::cout << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Minimum operations: " + std::to_string(min_op_count)) << std::endl;
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Testing...") << std::endl;
 
     event_id   = getEventIDNext();
     event_name = "Operation";
+    setPhase(event_name);
 
     out_report.addEventType(event_id, event_name, true);
 
     // measure the operation after warm up
-    std::vector<RAIIHandle> h_remote_results;
-    h_remote_results.reserve(20); // initial capacity for 20 iterations
+    RunArena::vector<RAIIHandle> h_remote_results(p_run_resource);
+    h_remote_results.reserve(std::max<std::uint64_t>(min_op_count, 20)); // initial capacity for, at least, 20 iterations
     out_report.setEventCapacity(out_report.getEventCapacity() + h_remote_results.capacity());
     std::uint64_t op_count = 0;
     double elapsed_ms      = 0.0;
-    while (op_count < 2 || elapsed_ms < min_test_time_ms)
+    Progress::beginPhase(event_name);
+    while (op_count < min_op_count || elapsed_ms < min_test_time_ms)
     {
         hebench::APIBridge::Handle h_result_remote;
         timer.start();
@@ -293,6 +311,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
                                                     &h_result_remote));
         p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
         elapsed_ms += p_timing_event->elapsedWallTime<std::milli>();
+        LiveMetrics::recordOperation(p_timing_event->elapsedWallTime<std::milli>(), 1);
         // check if we have enough capacity
         if (h_remote_results.capacity() == h_remote_results.size()
             && elapsed_ms > 0.0)
@@ -307,12 +326,13 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
             h_remote_results.reserve(max_capacity);
         } // end if
         out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+        addSubPhaseEvents(out_report, *p_timing_event, event_name);
         h_remote_results.emplace_back(h_result_remote);
+        Progress::advance();
 
         ++op_count;
     } // end while
-
-    std::cout << IOS_MSG_DONE << std::endl;
+    Progress::endPhase();
 
     // clean up data we no longer need
 
@@ -328,10 +348,12 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
     event_id   = getEventIDNext();
     event_name = "Store";
+    setPhase(event_name);
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Retrieving data from remote backend...") << std::endl;
 
-    std::vector<RAIIHandle> h_cipher_results(h_remote_results.size());
+    RunArena::vector<RAIIHandle> h_cipher_results(h_remote_results.size(), p_run_resource);
+    Progress::beginPhase(event_name, h_remote_results.size());
     for (std::size_t i = 0; i < h_remote_results.size(); ++i)
     {
         // store(h_benchmark, h_remote_result,
@@ -345,6 +367,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
                                                   1));
         p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
         out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+        addSubPhaseEvents(out_report, *p_timing_event, event_name);
 
         // clean up data we no longer need
         // destroyHandle(h_remote_result);
@@ -352,19 +375,21 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
         // even though it is RAII, it is better to free up space on remote manually here,
         // just in case it is a device with low memory capacity
         h_remote_results[i].destroy();
+        Progress::advance();
     } // end for
+    Progress::endPhase();
     h_remote_results.clear();
 
-    std::cout << IOS_MSG_OK << std::endl;
-
     // decrypt results
 
     event_id   = getEventIDNext();
     event_name = "Decryption";
+    setPhase(event_name);
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decrypting results...") << std::endl;
 
-    std::vector<RAIIHandle> h_plain_results(h_cipher_results.size());
+    RunArena::vector<RAIIHandle> h_plain_results(h_cipher_results.size(), p_run_resource);
+    Progress::beginPhase(event_name, h_cipher_results.size());
     for (std::size_t i = 0; i < h_cipher_results.size(); ++i)
     {
         // Handle h_plain_result;
@@ -374,6 +399,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
         validateRetCode(hebench::APIBridge::decrypt(handle(), h_cipher_results[i].handle, &h_plain_results[i].handle));
         p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
         out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+        addSubPhaseEvents(out_report, *p_timing_event, event_name);
 
         // // clean up data we no longer need
         // destroyHandle(h_cipher_output);
@@ -381,11 +407,11 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
         // even though it is RAII, it is better to free up space here,
         // just in case these local handles are large
         h_cipher_results[i].destroy();
+        Progress::advance();
     } // end for
+    Progress::endPhase();
     h_cipher_results.clear();
 
-    std::cout << IOS_MSG_OK << std::endl;
-
     // allocate space for decoded results
 
     // NativeDataBuffer p_raw_results[?]; // allocate space for all outputs
@@ -406,8 +432,9 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
     // point to the allocated buffers
 
-    std::vector<hebench::APIBridge::NativeDataBuffer> raw_results(p_dataset->getResultCount(),
-                                                                  hebench::APIBridge::NativeDataBuffer({ 0, 0, 0 }));
+    RunArena::vector<hebench::APIBridge::NativeDataBuffer> raw_results(p_dataset->getResultCount(),
+                                                                       hebench::APIBridge::NativeDataBuffer({ 0, 0, 0 }),
+                                                                       p_run_resource);
     std::uint64_t offset_p = 0;
     for (std::uint64_t result_pos = 0; result_pos < p_dataset->getResultCount(); ++result_pos)
     {
@@ -426,7 +453,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     // results_pack.buffer_count = A_count// B_count;
     // results_pack.param_position = 0; // we are retrieving results in the first position into this data pack
 
-    std::vector<hebench::APIBridge::DataPack> results_pack(p_dataset->getResultCount());
+    RunArena::vector<hebench::APIBridge::DataPack> results_pack(p_dataset->getResultCount(), p_run_resource);
     for (std::size_t result_pos = 0; result_pos < results_pack.size(); ++result_pos)
     {
         results_pack[result_pos].p_buffers      = &raw_results[result_pos];
@@ -446,62 +473,45 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
     event_id   = getEventIDNext();
     event_name = "Decoding";
+    setPhase(event_name);
 
     if (run_config.b_validate_results)
         std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decoding and Validation.") << std::endl;
     else
         std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decoding...") << std::endl;
 
-    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Result", false);
-
-    std::size_t mini_reports_cnt        = 3;
-    std::size_t report_every_n_elements = h_plain_results.size() / 7 + 1;
-    if (report_every_n_elements <= 0)
-        report_every_n_elements = 1;
-    std::size_t report_every_n_by_3_elements = report_every_n_elements / 4;
-    if (report_every_n_by_3_elements <= 0)
-        report_every_n_by_3_elements = 1;
-    std::size_t progress_report_batch = 0;
+    // decoding events of every result are children of the span: the rest
+    // of the span is validation time
+    std::uint32_t span_event_id   = 0;
+    std::uint64_t span_iterations = 0;
+    if (run_config.b_validate_results)
+    {
+        span_event_id = getEventIDNext();
+        timer.startSpan();
+    } // end if
 
     bool b_valid = true;
+    Progress::beginPhase(run_config.b_validate_results ? DecodingValidationEventName : event_name,
+                         h_plain_results.size());
     for (std::size_t i = 0; i < h_plain_results.size(); ++i)
     {
         const auto &h_plain = h_plain_results[i].handle;
         if (b_valid)
         {
-            if (i == 0 || (i + 1) % report_every_n_elements == 0)
-            {
-                // report operation to show sign of life
-                while (mini_reports_cnt++ < 3)
-                    std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
-                mini_reports_cnt      = 0;
-                progress_report_batch = 0;
-                std::cout << hebench::Logging::GlobalLogger::log(" " + std::to_string(i + 1), false) << std::flush;
-            } // end if
-
             // decode(Handle h_benchmark, h_plain_result, &packed_results);
 
             timer.start();
             validateRetCode(hebench::APIBridge::decode(handle(), h_plain, &packed_results));
             p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
             out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
-
-            //            if (i + 1 < h_plain_results.size() && mini_reports_cnt < 3
-            //                && (mini_reports_cnt == 0 || (i + 1) % report_every_n_by_3_elements == 0))
-            if (mini_reports_cnt < 3
-                && progress_report_batch > 0
-                && progress_report_batch % report_every_n_by_3_elements == 0)
-            {
-                // report operation to show sign of life
-                ++mini_reports_cnt;
-                std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
-            } // end if
+            addSubPhaseEvents(out_report, *p_timing_event, event_name);
+            ++span_iterations; // results decoded
 
             // validate output
             if (run_config.b_validate_results)
             {
                 std::string s_error_msg;
-                std::vector<std::uint64_t> data_pack_indices;
+                RunArena::vector<std::uint64_t> data_pack_indices(p_run_resource);
                 std::vector<hebench::APIBridge::NativeDataBuffer *> outputs;
                 try
                 {
@@ -517,6 +527,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
                     } // end for
 
                     data_pack_indices.resize(p_dataset->getParameterCount(), 0);
+                    HarnessOverhead::Scope overhead_scope(HarnessOverhead::ValidationPhaseName);
                     b_valid = validateResult(p_dataset, data_pack_indices.data(),
                                              outputs,
                                              m_descriptor.data_type);
@@ -533,7 +544,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
                 if (!b_valid)
                 {
-                    std::cout << hebench::Logging::GlobalLogger::log("", true) << std::endl;
+                    Progress::endPhase();
                     ss = std::stringstream();
                     ss << "Validation failed" << std::endl
                        << "Result, " << i + 1 << std::endl;
@@ -550,7 +561,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
                 } // end else
             } // end if
 
-            ++progress_report_batch;
+            Progress::advance();
         } // end if
 
         // clean up data we no longer need
@@ -559,22 +570,16 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
         // just in case these local handles are large
         h_plain_results[i].destroy();
     } // end for
+    Progress::endPhase();
     h_plain_results.clear();
+    if (run_config.b_validate_results)
+    {
+        p_timing_event = timer.stopSpan<DefaultTimeInterval>(span_event_id, span_iterations, nullptr);
+        out_report.addEvent<DefaultTimeInterval>(p_timing_event, std::string(DecodingValidationEventName));
+    } // end if
 
     if (b_valid)
-    {
-        // report valid op
-        if ((op_count) % report_every_n_elements != 0)
-        {
-            // pretty-print end of result report
-            while (mini_reports_cnt++ < 3)
-                std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
-            std::cout << hebench::Logging::GlobalLogger::log(" " + std::to_string(op_count)) << std::endl;
-        } // end if
-        else
-            std::cout << hebench::Logging::GlobalLogger::log("") << std::endl;
         std::cout << IOS_MSG_OK << std::endl;
-    } // end if
 
     if (!run_config.b_validate_results)
     {
@@ -582,6 +587,17 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
         std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("Validation skipped.") << std::endl;
     } // end if
 
+    if (b_valid && run_config.b_validate_results && run_config.b_reference_error)
+        appendReferenceError(out_report);
+
+    appendPhaseMemory(out_report);
+
+    if (b_valid && run_config.b_plaintext_baseline)
+        runPlaintextBaseline(out_report, p_dataset,
+                             std::vector<std::uint64_t>(p_dataset->getParameterCount(), 1),
+                             m_descriptor.cat_params.latency.warmup_iterations_count,
+                             min_test_time_ms, 2);
+
     std::cout << IOS_MSG_DONE << hebench::Logging::GlobalLogger::log("Test Completed.") << std::endl;
 
     return b_valid;
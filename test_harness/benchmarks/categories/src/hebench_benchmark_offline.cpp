@@ -14,7 +14,9 @@
 
 #include "hebench/api_bridge/api.h"
 #include "include/hebench_engine.h"
+#include "include/hebench_live_metrics.h"
 #include "include/hebench_math_utils.h"
+#include "include/hebench_progress.h"
 
 #include "../include/hebench_benchmark_offline.h"
 
@@ -51,6 +53,8 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     std::uint32_t event_id = getEventIDNext();
     std::string event_name;
     hebench::Common::TimingReportEvent::Ptr p_timing_event;
+    // short-lived collections for this run are allocated from the benchmark arena
+    std::pmr::memory_resource *p_run_resource = getRunArena()->resource();
 
     // prepare the parameters for encoding
 
@@ -65,7 +69,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     // param_packs[1].param_position = 1; // B is the second parameter, so, position 1
 
     // create the data packs
-    std::vector<hebench::APIBridge::DataPack> param_packs(p_dataset->getParameterCount());
+    RunArena::vector<hebench::APIBridge::DataPack> param_packs(p_dataset->getParameterCount(), p_run_resource);
     for (std::size_t param_i = 0; param_i < param_packs.size(); ++param_i)
     {
         assert(p_dataset->getParameterData(param_i).param_position == param_i);
@@ -81,8 +85,8 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     // packed_parameters.pack_count = op_params_count;
 
     // separate param packs in encrypted/plain
-    std::vector<hebench::APIBridge::PackedData> packed_parameters(2);
-    std::vector<std::vector<hebench::APIBridge::DataPack>> packed_parameters_data_packs(packed_parameters.size());
+    RunArena::vector<hebench::APIBridge::PackedData> packed_parameters(2, p_run_resource);
+    RunArena::vector<RunArena::vector<hebench::APIBridge::DataPack>> packed_parameters_data_packs(packed_parameters.size(), p_run_resource);
     std::bitset<sizeof(std::uint32_t)> cipher_param_mask(m_descriptor.cipher_param_mask);
     for (std::size_t i = 0; i < param_packs.size(); ++i)
     {
@@ -109,9 +113,10 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     // Handle h_encoded_inputs;
     // encode(h_benchmark, &packed_parameters, &h_encoded_inputs);
 
+    setPhase("Encoding");
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Encoding.") << std::endl;
 
-    std::vector<RAIIHandle> h_inputs(packed_parameters.size());
+    RunArena::vector<RAIIHandle> h_inputs(packed_parameters.size(), p_run_resource);
     for (std::size_t i = 0; i < packed_parameters.size(); ++i)
     {
         event_id = getEventIDNext();
@@ -123,6 +128,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
             validateRetCode(hebench::APIBridge::encode(handle(), &packed_parameters[i], &h_inputs[i].handle));
             p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
             out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+            addSubPhaseEvents(out_report, *p_timing_event, event_name);
         } // end if
         else
             std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Pack " + std::to_string(i) + " is empty (skipping).") << std::endl;
@@ -134,6 +140,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
 
     event_id   = getEventIDNext();
     event_name = "Encryption";
+    setPhase(event_name);
 
     // Handle h_cipher_inputs;
     // encrypt(h_benchmark, h_encoded_inputs, &h_cipher_inputs);
@@ -150,6 +157,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
         validateRetCode(hebench::APIBridge::encrypt(handle(), h_inputs.front().handle, &encrypted_input));
         p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
         out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+        addSubPhaseEvents(out_report, *p_timing_event, event_name);
 
         // overwrite the first input handle by its encrypted version
         h_inputs.front() = encrypted_input; // old handle automatically destroyed by RAII
@@ -163,6 +171,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
 
     event_id   = getEventIDNext();
     event_name = "Loading";
+    setPhase(event_name);
 
     // Handle h_remote_inputs;
     // load(h_benchmark,
@@ -170,7 +179,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     //      &h_remote_inputs);
 
     // prepare handles for loading
-    std::vector<hebench::APIBridge::Handle> h_inputs_local;
+    RunArena::vector<hebench::APIBridge::Handle> h_inputs_local(p_run_resource);
     for (std::size_t i = 0; i < packed_parameters.size(); ++i)
     {
         if (packed_parameters[i].pack_count > 0)
@@ -188,6 +197,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
                                              &h_inputs_remote.handle));
     p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
     out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+    addSubPhaseEvents(out_report, *p_timing_event, event_name);
 
     std::cout << IOS_MSG_OK << std::endl;
 
@@ -211,7 +221,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     // params[1].batch_size = 10; // for parameter B we will be using 10 values
     // params[1].value_index = 0; // starting with the first.
 
-    std::vector<hebench::APIBridge::ParameterIndexer> params(p_dataset->getParameterCount());
+    RunArena::vector<hebench::APIBridge::ParameterIndexer> params(p_dataset->getParameterCount(), p_run_resource);
     std::uint64_t num_results = 1;
     for (std::size_t i = 0; i < params.size(); ++i)
     {
@@ -235,17 +245,16 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
 
     event_id   = getEventIDNext();
     event_name = "Operation";
+    setPhase(event_name);
 
     out_report.addEventType(event_id, event_name, true);
 
-    // TODO: (nice to have) maybe have a way to report progress or check if backend is stuck
-    // since this operation can be time consuming.
-
     RAIIHandle h_remote_results;
     std::size_t iteration_count    = 0;
     std::size_t iteration_capacity = 20; // initial capacity for 20 iterations
     double elapsed_ms              = 0.0;
     out_report.setEventCapacity(out_report.getEventCapacity() + iteration_capacity);
+    Progress::beginPhase(event_name);
     while (iteration_count <= 0 || elapsed_ms < min_test_time_ms)
     {
         if (iteration_count > 0)
@@ -257,6 +266,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
                                                     &h_remote_results.handle));
         p_timing_event = timer.stop<DefaultTimeInterval>(event_id, num_results, nullptr);
         elapsed_ms += p_timing_event->elapsedWallTime<std::milli>();
+        LiveMetrics::recordOperation(p_timing_event->elapsedWallTime<std::milli>(), num_results);
 
         // check if we have enough capacity
         if (iteration_capacity == iteration_count
@@ -272,9 +282,12 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
             iteration_capacity = max_capacity;
         } // end if
         out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+        addSubPhaseEvents(out_report, *p_timing_event, event_name);
+        Progress::advance();
 
         ++iteration_count;
     } // end while
+    Progress::endPhase();
 
     ss = std::stringstream();
     ss << "Elapsed time: " << p_timing_event->elapsedWallTime<std::milli>() << "ms";
@@ -294,6 +307,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
 
     event_id   = getEventIDNext();
     event_name = "Store";
+    setPhase(event_name);
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Retrieving data from remote backend...") << std::endl;
 
@@ -309,6 +323,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
                                               1));
     p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
     out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+    addSubPhaseEvents(out_report, *p_timing_event, event_name);
 
     // clean up data we no longer need
     // destroyHandle(h_remote_result);
@@ -323,6 +338,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
 
     event_id   = getEventIDNext();
     event_name = "Decryption";
+    setPhase(event_name);
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decrypting results...") << std::endl;
 
@@ -334,6 +350,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     validateRetCode(hebench::APIBridge::decrypt(handle(), h_cipher_results.handle, &h_plain_results.handle));
     p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
     out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+    addSubPhaseEvents(out_report, *p_timing_event, event_name);
 
     // // clean up data we no longer need
     // destroyHandle(h_cipher_output);
@@ -369,7 +386,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
 
     // point to the allocated buffers
 
-    std::vector<std::vector<hebench::APIBridge::NativeDataBuffer>> raw_results(p_dataset->getResultCount());
+    RunArena::vector<RunArena::vector<hebench::APIBridge::NativeDataBuffer>> raw_results(p_dataset->getResultCount(), p_run_resource);
     std::uint64_t offset_p = 0;
     for (std::uint64_t result_component_i = 0; result_component_i < raw_results.size(); ++result_component_i)
     {
@@ -394,7 +411,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     // results_pack.buffer_count = A_count// B_count;
     // results_pack.param_position = 0; // we are retrieving results in the first position into this data pack
 
-    std::vector<hebench::APIBridge::DataPack> results_packs(raw_results.size());
+    RunArena::vector<hebench::APIBridge::DataPack> results_packs(raw_results.size(), p_run_resource);
     for (std::uint64_t result_component_i = 0; result_component_i < results_packs.size(); ++result_component_i)
     {
         results_packs[result_component_i].p_buffers      = raw_results[result_component_i].data();
@@ -414,15 +431,26 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
 
     event_id   = getEventIDNext();
     event_name = "Decoding";
+    setPhase(event_name);
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decoding...") << std::endl;
 
+    // decoding events of every result are children of the span: the rest
+    // of the span is validation time
+    std::uint32_t span_event_id = 0;
+    if (run_config.b_validate_results)
+    {
+        span_event_id = getEventIDNext();
+        timer.startSpan();
+    } // end if
+
     // decode(Handle h_benchmark, h_plain_result, &packed_results);
 
     timer.start();
     validateRetCode(hebench::APIBridge::decode(handle(), h_plain_results.handle, &packed_results));
     p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
     out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+    addSubPhaseEvents(out_report, *p_timing_event, event_name);
 
     // clean up data we no longer need
 
@@ -436,19 +464,9 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
 
     if (run_config.b_validate_results)
     {
+        setPhase(ValidationPhaseName);
         std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Validation.") << std::endl;
 
-        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Result", false);
-
-        std::size_t mini_reports_cnt        = 3;
-        std::size_t report_every_n_elements = num_results / 7 + 1;
-        if (report_every_n_elements <= 0)
-            report_every_n_elements = 1;
-        std::size_t report_every_n_by_3_elements = report_every_n_elements / 4;
-        if (report_every_n_by_3_elements <= 0)
-            report_every_n_by_3_elements = 1;
-        std::size_t progress_report_batch = 0;
-
         // initialize loop limits
         std::vector<std::size_t> params_count(p_dataset->getParameterCount());
         for (std::uint64_t param_i = 0; param_i < p_dataset->getParameterCount(); ++param_i)
@@ -461,37 +479,21 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
         // looping variables
         hebench::Utilities::Math::ComponentCounter param_counter(params_count);
         std::size_t result_i = 0;
+        // reused across iterations to avoid per-result allocations
+        std::vector<hebench::APIBridge::NativeDataBuffer *> outputs;
+        RunArena::vector<std::uint64_t> data_pack_indices(p_run_resource);
         // validate the result of the operation evaluated on all sample combinations per parameter
+        Progress::beginPhase(ValidationPhaseName, num_results);
         do
         {
             assert(result_i < num_results);
 
-            if (result_i == 0 || (result_i + 1) % report_every_n_elements == 0)
-            {
-                // report operation to show sign of life
-                while (mini_reports_cnt++ < 3)
-                    std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
-                mini_reports_cnt      = 0;
-                progress_report_batch = 0;
-                std::cout << hebench::Logging::GlobalLogger::log(" " + std::to_string(result_i + 1), false) << std::flush;
-            } // end if
-
-            if (mini_reports_cnt < 3
-                && progress_report_batch > 0
-                && progress_report_batch % report_every_n_by_3_elements == 0)
-            {
-                // report operation to show sign of life
-                ++mini_reports_cnt;
-                std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
-            } // end if
-
             // validate output
             std::string s_error_msg;
-            std::vector<hebench::APIBridge::NativeDataBuffer *> outputs;
-            std::vector<std::uint64_t> data_pack_indices;
+            data_pack_indices.clear();
             try
             {
-                outputs.resize(p_dataset->getResultCount());
+                outputs.assign(p_dataset->getResultCount(), nullptr);
                 assert(packed_results.pack_count >= outputs.size());
                 for (std::uint64_t result_component_i = 0; result_component_i < outputs.size(); ++result_component_i)
                 {
@@ -526,7 +528,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
 
             if (!b_valid)
             {
-                std::cout << hebench::Logging::GlobalLogger::log("", true) << std::endl;
+                Progress::endPhase();
                 ss = std::stringstream();
                 ss << "Validation failed" << std::endl
                    << "Result, " << result_i + 1 << std::endl;
@@ -542,24 +544,16 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
                 out_report.appendFooter(ss.str());
             } // end else
 
-            ++progress_report_batch;
+            Progress::advance();
             ++result_i; // next result
         } while (b_valid && !param_counter.inc());
+        Progress::endPhase();
+
+        p_timing_event = timer.stopSpan<DefaultTimeInterval>(span_event_id, result_i, nullptr);
+        out_report.addEvent<DefaultTimeInterval>(p_timing_event, std::string(DecodingValidationEventName));
 
         if (b_valid)
-        {
-            // report valid op
-            if ((num_results) % report_every_n_elements != 0)
-            {
-                // pretty-print end of result report
-                while (mini_reports_cnt++ < 3)
-                    std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
-                std::cout << hebench::Logging::GlobalLogger::log(" " + std::to_string(num_results)) << std::endl;
-            } // end if
-            else
-                std::cout << hebench::Logging::GlobalLogger::log("") << std::endl;
             std::cout << IOS_MSG_OK << std::endl;
-        } // end if
     } // end if
     else
     {
@@ -567,6 +561,19 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
         std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("Validation skipped.") << std::endl;
     } // end else
 
+    if (b_valid && run_config.b_validate_results && run_config.b_reference_error)
+        appendReferenceError(out_report);
+
+    appendPhaseMemory(out_report);
+
+    if (b_valid && run_config.b_plaintext_baseline)
+    {
+        std::vector<std::uint64_t> batch_sizes(p_dataset->getParameterCount());
+        for (std::size_t param_i = 0; param_i < batch_sizes.size(); ++param_i)
+            batch_sizes[param_i] = p_dataset->getParameterData(param_i).buffer_count;
+        runPlaintextBaseline(out_report, p_dataset, batch_sizes, 0, min_test_time_ms, 1);
+    } // end if
+
     std::cout << IOS_MSG_DONE << hebench::Logging::GlobalLogger::log("Test Completed.") << std::endl;
 
     return b_valid;
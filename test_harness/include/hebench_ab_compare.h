@@ -0,0 +1,145 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_AB_Compare_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_AB_Compare_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <filesystem>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "modules/logging/include/logging.h"
+
+#include "hebench_report_fingerprint.h"
+
+#include "hebench_engine.h"
+#include "hebench_program_config.h"
+#include "hebench_types_harness.h"
+
+namespace hebench {
+namespace APIBridge {
+struct DynamicLib;
+}
+} // namespace hebench
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Paired comparison of the main event wall time of several backends
+ * run interleaved in the same process.
+ * @details Each benchmark is run by every backend once per round, in a
+ * shuffled order each round, so that slow drifts of the machine (thermal
+ * state, background load, frequency scaling) affect all backends alike.
+ * Every backend is compared against the baseline (backend 0) using the
+ * per-round differences, which cancels the drift shared by both backends in
+ * the same round. Rounds where either backend failed are excluded.
+ */
+class ABComparison
+{
+private:
+    IL_DECLARE_CLASS_NAME(ABComparison)
+
+public:
+    static constexpr std::size_t BaselineIndex = 0;
+
+    /**
+     * @brief Backend library loaded for comparison and its engine.
+     */
+    struct Backend
+    {
+        std::string label;
+        std::filesystem::path lib_path;
+        hebench::APIBridge::DynamicLib *p_lib;
+        Engine::Ptr p_engine;
+        Report::cpp::Fingerprint fingerprint; // machine fingerprint plus this backend
+
+        Backend(const std::string &_label, const std::filesystem::path &_lib_path,
+                hebench::APIBridge::DynamicLib *_p_lib, Engine::Ptr _p_engine,
+                const Report::cpp::Fingerprint &machine_fingerprint);
+        Backend(Backend &&) = default;
+        ~Backend();
+
+        std::filesystem::path getRoundRootPath(const ProgramConfig &config, std::size_t round_i) const;
+    };
+
+    struct PairedStats
+    {
+        std::size_t rounds; // rounds where both backends succeeded
+        double baseline_mean_s;
+        double candidate_mean_s;
+        double diff_mean_s; // candidate - baseline
+        double diff_stddev_s;
+        double diff_ci95_s; // half width of the 95% confidence interval of diff_mean_s
+        double diff_relative; // diff_mean_s / baseline_mean_s
+    };
+
+    /**
+     * @param[in] backend_labels Names of the backends in the report. The first
+     * one is the baseline.
+     */
+    ABComparison(const std::vector<std::string> &backend_labels);
+
+    /**
+     * @brief Adds the average main event wall time of a benchmark for a
+     * backend in a round.
+     */
+    void addSample(const std::string &bench_path, std::size_t backend_i, std::size_t round_i, double wall_time_s);
+
+    /**
+     * @brief Computes the paired statistics of a backend against the baseline
+     * for a benchmark.
+     * @returns Statistics with `rounds` 0 if there are no rounds where both
+     * backends succeeded.
+     */
+    PairedStats compare(const std::string &bench_path, std::size_t backend_i) const;
+
+    void save2CSV(const std::filesystem::path &filename) const;
+    std::ostream &show(std::ostream &os) const;
+
+    /**
+     * @brief Loads the backends to compare against the baseline, each with
+     * its own engine.
+     * @param[in] p_baseline_lib Backend library loaded from command line,
+     * which remains the active library on output.
+     * @param[in] p_baseline_engine Engine of \p p_baseline_lib .
+     * @returns The baseline followed by the libraries to compare from
+     * \p config .
+     */
+    static std::vector<Backend> loadBackends(const ProgramConfig &config,
+                                             hebench::APIBridge::DynamicLib *p_baseline_lib,
+                                             Engine::Ptr p_baseline_engine,
+                                             const Report::cpp::Fingerprint &machine_fingerprint);
+    /**
+     * @brief Runs every benchmark requested on all backends, interleaved in
+     * shuffled order for the rounds requested, and saves the comparison.
+     * @details Every backend and round has its own reports and summary under
+     * the report root path.
+     * @returns Failed runs, one per backend and round.
+     */
+    static std::vector<std::string> run(std::vector<Backend> &backends,
+                                        const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                        const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                                        const ProgramConfig &config);
+
+private:
+    // round -> average main event wall time in seconds
+    typedef std::map<std::size_t, double> RoundSamples;
+
+    /**
+     * @brief Two-sided 95% critical value of the Student's t-distribution.
+     */
+    static double tCritical95(std::size_t degrees_of_freedom);
+
+    std::vector<std::string> m_backend_labels;
+    std::vector<std::string> m_bench_paths; // in order of first sample
+    std::map<std::string, std::vector<RoundSamples>> m_samples; // bench path -> samples per backend
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_AB_Compare_H_0596d40a3cce4b108a81595c50eb286d
@@ -0,0 +1,137 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Benchmark_Runner_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Benchmark_Runner_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "modules/logging/include/logging.h"
+
+#include "hebench_config.h"
+#include "hebench_daemon.h"
+#include "hebench_engine.h"
+#include "hebench_ibenchmark.h"
+#include "hebench_program_config.h"
+#include "hebench_types_harness.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Runs the benchmarks requested in the current process and summarizes
+ * their reports.
+ * @details Run modes that run benchmarks more than once, or in other
+ * processes, build on these facilities.
+ */
+class BenchmarkRunner
+{
+private:
+    IL_DECLARE_CLASS_NAME(BenchmarkRunner)
+
+public:
+    /**
+     * @brief Directory where the report of a benchmark is saved.
+     * @param[in] report_root_path Root of the reports of the run.
+     * @param[in] bench_path Path of the benchmark from its description. If
+     * absolute, \p report_root_path is ignored.
+     */
+    static std::filesystem::path getReportPath(const std::filesystem::path &report_root_path,
+                                               const std::string &bench_path);
+    /**
+     * @brief CSV report file of a benchmark.
+     * @sa getReportPath()
+     */
+    static std::filesystem::path getReportFilename(const std::filesystem::path &report_root_path,
+                                                   const std::string &bench_path);
+
+    /**
+     * @brief Loads the benchmarks to run and seeds the random generator with
+     * the seed of the configuration loaded.
+     * @param[in] bench_configuration Configuration facilities of the backend.
+     * @param[in] config_file Benchmark configuration file. If empty, the default
+     * configuration of the backend is loaded.
+     * @param[in,out] bench_config Default configuration for benchmarks. On
+     * output, overridden by the defaults in \p config_file .
+     */
+    static std::vector<BenchmarkRequest> loadConfiguration(const hebench::Utilities::BenchmarkConfiguration &bench_configuration,
+                                                           const std::filesystem::path &config_file,
+                                                           IBenchmarkDescription::BenchmarkConfig &bench_config);
+
+    /**
+     * @brief Runs benchmarks and saves their reports.
+     * @param[in] report_root_path Root path where to save the reports.
+     * @param[out] failed_benchmarks Benchmark paths of failed benchmarks are
+     * appended here.
+     * @param[in] p_bench_cache If not null, the last benchmark initialized is
+     * kept in this cache and reused when requested again.
+     * @throws hebench::Common::ErrorException on critical backend errors. Other
+     * errors fail the benchmark and the run continues.
+     */
+    static void run(Engine &engine,
+                    const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                    const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                    const ProgramConfig &config,
+                    const std::filesystem::path &report_root_path,
+                    std::vector<std::string> &failed_benchmarks,
+                    BenchmarkCache *p_bench_cache = nullptr);
+    /**
+     * @brief Runs benchmarks as independent jobs on the coordinator workers
+     * and collects their reports in the report root path.
+     * @returns Benchmark paths of failed benchmarks.
+     */
+    static std::vector<std::string> runDistributed(const Engine &engine,
+                                                   const hebench::Utilities::BenchmarkConfiguration &bench_configuration,
+                                                   const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                                   const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                                                   const ProgramConfig &config);
+
+    /**
+     * @brief Saves the summary of every benchmark ran next to its report and,
+     * optionally, an overview in standard output.
+     * @param[in] input_root_path Root path of the reports.
+     * @param[in] output_root_path Root path where to save the summaries.
+     */
+    static void generateSummary(const Engine &engine,
+                                const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                const std::vector<BenchmarkRequest> &benchmarks_ran,
+                                const std::filesystem::path &input_root_path,
+                                const std::filesystem::path &output_root_path,
+                                bool do_stdout_summary = true);
+    static void generateSummary(const Engine &engine,
+                                const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                const std::vector<BenchmarkRequest> &benchmarks_ran,
+                                const std::filesystem::path &input_root_path,
+                                bool do_stdout_summary = true);
+    /**
+     * @sa CipherMaskAnalysis
+     */
+    static void generateCipherMaskSummary(const Engine &engine,
+                                          const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                          const std::vector<BenchmarkRequest> &benchmarks_ran,
+                                          const ProgramConfig &config);
+    /**
+     * @sa LogRegDegreeAnalysis
+     */
+    static void generateLogRegDegreeSummary(const Engine &engine,
+                                            const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                            const std::vector<BenchmarkRequest> &benchmarks_ran,
+                                            const ProgramConfig &config);
+
+private:
+    /**
+     * @brief Prints a floating point value with up to a number of digits
+     * after decimal point with no trailing zeroes.
+     */
+    static std::string toDoubleVariableFrac(double x, int up_to_digits_after_dot);
+
+    BenchmarkRunner() = default;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Benchmark_Runner_H_0596d40a3cce4b108a81595c50eb286d
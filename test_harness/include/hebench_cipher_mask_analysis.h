@@ -0,0 +1,127 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Cipher_Mask_Analysis_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Cipher_Mask_Analysis_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "modules/logging/include/logging.h"
+
+#include "hebench_report_cpp.h"
+#include "hebench_report_fingerprint.h"
+
+#include "hebench_ibenchmark.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Compares the cost of benchmarks that differ only in which operation
+ * parameters are encrypted.
+ * @details Benchmarks are grouped when they share workload, workload
+ * parameters, category, data type, scheme, security and extra description,
+ * that is, their description paths differ only in the cipher mask component.
+ *
+ * The cost of a phase is its wall time per iteration, added up over all event
+ * types of the phase (for example, all encoded packs), and the change in
+ * resident memory during the phase, as recorded in the report footer by the
+ * benchmark run. Backend sub-phases, warm-up time and the plaintext baseline
+ * are ignored.
+ *
+ * Every member of a group is compared against the reference member, the one
+ * with the fewest encrypted parameters. The cost of encrypting an individual
+ * parameter is the average difference between every pair of members whose
+ * masks differ only in that parameter.
+ */
+class CipherMaskAnalysis
+{
+private:
+    IL_DECLARE_CLASS_NAME(CipherMaskAnalysis)
+
+public:
+    /**
+     * @brief Adds the report of a successful benchmark run.
+     * @param[in] description Description of the benchmark run.
+     * @param[in] report Report of the run.
+     * @throws std::invalid_argument if the machine or backend fingerprint of
+     * \p report differs from that of the reports already in its group, since
+     * their costs are not comparable.
+     */
+    void addReport(const IBenchmarkDescription::Description &description,
+                   const hebench::TestHarness::Report::cpp::TimingReport &report);
+
+    /**
+     * @brief Number of groups with more than one cipher mask.
+     */
+    std::size_t getGroupCount() const;
+
+    /**
+     * @brief Saves the cost of every phase of every group member and its
+     * difference against the reference member of the group.
+     */
+    void saveDeltas2CSV(const std::filesystem::path &filename) const;
+    /**
+     * @brief Saves the cost of encrypting each individual parameter on every
+     * phase of every group.
+     */
+    void saveOperands2CSV(const std::filesystem::path &filename) const;
+    std::ostream &show(std::ostream &os) const;
+
+private:
+    struct PhaseCost
+    {
+        double wall_time_s        = 0.0;
+        std::int64_t memory_bytes = 0;
+        bool b_has_wall_time      = false;
+        bool b_has_memory         = false;
+    };
+    struct Member
+    {
+        std::uint32_t cipher_param_mask;
+        std::map<std::string, PhaseCost> phases;
+    };
+    struct Group
+    {
+        std::string path; // description path with "*" for the cipher mask
+        std::vector<std::string> phase_names; // in order of first appearance
+        std::vector<Member> members;
+        hebench::TestHarness::Report::cpp::Fingerprint fingerprint; // of the first member added
+    };
+    struct OperandCost
+    {
+        std::string operand;
+        std::size_t pairs;
+        std::map<std::string, PhaseCost> phases; // average difference
+    };
+
+    static constexpr std::uint32_t AllCipherMask = 0xFFFFFFFF;
+    static constexpr const char *TotalPhaseName  = "Total";
+
+    static std::string getGroupPath(const IBenchmarkDescription::Description &description);
+    static std::string getPhaseName(const std::string &event_type_header);
+    static void readPhaseMemory(const std::string &footer, std::map<std::string, PhaseCost> &phases,
+                                std::vector<std::string> &phase_names);
+    static PhaseCost getPhaseTotal(const Member &member);
+    static PhaseCost getPhaseCost(const Member &member, const std::string &phase_name);
+    static void subtract(PhaseCost &result, const PhaseCost &lhs, const PhaseCost &rhs);
+    /**
+     * @brief Member of the group with the fewest encrypted parameters.
+     */
+    static const Member &getReference(const Group &group);
+    static std::vector<OperandCost> computeOperandCosts(const Group &group);
+
+    std::vector<Group> m_groups;
+    std::map<std::string, std::size_t> m_group_index; // group path -> index in m_groups
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Cipher_Mask_Analysis_H_0596d40a3cce4b108a81595c50eb286d
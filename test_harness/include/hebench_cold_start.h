@@ -0,0 +1,147 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Cold_Start_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Cold_Start_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <filesystem>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "modules/logging/include/logging.h"
+
+#include "hebench_config.h"
+#include "hebench_engine.h"
+#include "hebench_program_config.h"
+#include "hebench_types_harness.h"
+#include "hebench_utilities.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Measures the cold-start latency of a benchmark: the time from
+ * loading the backend library in a fresh process to the first decoded result.
+ * @details Every cold-start sample is taken by a fresh Test Harness child
+ * process, executed from the same binary, that loads the backend, creates the
+ * engine, initializes the benchmark and runs it once. The child times each of
+ * these steps and saves them in a sample file that the parent collects. From
+ * the benchmark run, only the first event of each type is kept, since that is
+ * the one paid on a cold start.
+ */
+class ColdStart
+{
+private:
+    IL_DECLARE_CLASS_NAME(ColdStart)
+
+public:
+    struct Phase
+    {
+        std::string name;
+        double wall_time_ms;
+        /**
+         * @brief Whether this phase is part of the time to first result.
+         * @details Sub-phases reported by the backend overlap their parent
+         * phase and are excluded, as is harness time such as validation.
+         * @sa PartialBenchmarkCategory::isBackendPhase()
+         */
+        bool b_in_total;
+    };
+    typedef std::vector<Phase> Sample;
+
+    static constexpr const char *PhaseLibraryLoad    = "Library load";
+    static constexpr const char *PhaseEngineInit     = "Engine initialization";
+    static constexpr const char *PhaseFirstOperation = "First operation";
+    static constexpr const char *PhaseTotal          = "Time to first result";
+    static constexpr const char *ChildConfigFile     = "cold_start_config.yaml";
+    static constexpr const char *ChildSampleFile     = "cold_start_sample.csv";
+    static constexpr const char *ChildLogFile        = "cold_start_child.log";
+
+    /**
+     * @brief Appends to \p sample the phases of a benchmark run.
+     * @param[in,out] sample Sample where to append the phases.
+     * @param[in] report Report of the benchmark run.
+     * @details Adds one phase per event type with the duration of its first
+     * event. Warm-up and operation events are merged into a single phase with
+     * the first operation. Finally, adds phase PhaseTotal with the sum of all
+     * phases in the sample that are part of the total.
+     */
+    static void completeSample(Sample &sample, const hebench::Utilities::TimingReportEx &report);
+    static void saveSample(const std::filesystem::path &filename, const Sample &sample);
+    static Sample loadSample(const std::filesystem::path &filename);
+
+    /**
+     * @brief Evicts the contents of a file from the page cache.
+     * @details Pages mapped by any running process stay in cache, thus,
+     * the backend library must not be loaded by this process when called.
+     * Dependencies of the file are not affected.
+     */
+    static void dropPageCache(const std::filesystem::path &filename);
+    /**
+     * @brief Takes one cold-start sample in a fresh child process.
+     * @param[in] child_args Command line arguments for the child Test Harness,
+     * which must include the argument to save the sample in \p sample_file .
+     * @param[in] sample_file File where the child saves its sample.
+     * @param[in] log_file File where the standard output of the child is
+     * redirected. Overwritten if it exists.
+     * @throws std::runtime_error if the child fails.
+     */
+    static Sample runChild(const std::vector<std::string> &child_args,
+                           const std::filesystem::path &sample_file,
+                           const std::filesystem::path &log_file);
+
+    /**
+     * @brief Writes the distribution of each phase across all samples
+     * in CSV format.
+     */
+    static void saveReport(const std::filesystem::path &filename, const std::vector<Sample> &samples);
+    static std::ostream &showReport(std::ostream &os, const std::vector<Sample> &samples);
+
+    /**
+     * @brief Measures the cold-start latency of every benchmark requested.
+     * @param[in,out] p_engine Engine of the backend. Released on output,
+     * along with \p p_bench_configuration and the backend library, so that
+     * the library is not mapped by this process while sampling.
+     * @returns Benchmark paths of benchmarks that failed.
+     * @details Saves the report of each benchmark in file
+     * ProgramConfig::ColdStartReportFile under its report path.
+     */
+    static std::vector<std::string> run(Engine::Ptr &p_engine,
+                                        std::shared_ptr<hebench::Utilities::BenchmarkConfiguration> &p_bench_configuration,
+                                        const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                        const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                                        const ProgramConfig &config);
+    /**
+     * @brief Takes the sample requested by the parent Test Harness of a
+     * cold-start child.
+     * @param[in,out] sample Phases timed by this process before the benchmark
+     * was created. On output, completed with the benchmark run.
+     * @details Saves the sample in the file requested by the parent.
+     * @throws std::runtime_error if the benchmark fails.
+     */
+    static void takeSample(Engine &engine,
+                           const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                           const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                           const ProgramConfig &config,
+                           Sample &sample);
+
+private:
+    struct PhaseStats
+    {
+        std::string name;
+        std::vector<double> wall_times_ms;
+    };
+
+    static std::vector<PhaseStats> computeStats(const std::vector<Sample> &samples);
+    static double percentile(const std::vector<double> &sorted_values, double pct);
+
+    ColdStart() = default;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Cold_Start_H_0596d40a3cce4b108a81595c50eb286d
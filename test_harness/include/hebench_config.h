@@ -43,6 +43,12 @@ public:
     std::vector<hebench::TestHarness::BenchmarkRequest> loadConfiguration(const std::string &yaml_filename,
                                                                           hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig &default_bench_config) const;
     const std::vector<hebench::TestHarness::BenchmarkRequest> &getDefaultConfiguration() const { return m_default_benchmarks; }
+    /**
+     * @brief Loads the runtime environment knobs to sweep from a configuration file.
+     * @returns The knobs in map "env_sweep" at the root of the file, or an
+     * empty list if the map is not present.
+     */
+    static std::vector<hebench::TestHarness::EnvKnob> loadEnvSweep(const std::string &yaml_filename);
 
 private:
     std::weak_ptr<hebench::TestHarness::Engine> m_wp_engine;
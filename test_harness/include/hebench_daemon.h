@@ -0,0 +1,129 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Daemon_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Daemon_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "modules/general/include/nocopy.h"
+#include "modules/logging/include/logging.h"
+
+#include "hebench_ibenchmark.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Keeps an initialized benchmark, and the dataset it owns, alive
+ * between runs.
+ * @details Benchmarks are keyed by their description (descriptor, workload
+ * parameters and category parameters, as listed in the report header) and by
+ * the benchmark configuration that affects their dataset.
+ *
+ * Engine allows a single benchmark to exist at a time, so only the last
+ * benchmark stored is kept: clients must call clear() before creating a
+ * benchmark that was not found in the cache.
+ */
+class BenchmarkCache
+{
+public:
+    DISABLE_COPY(BenchmarkCache)
+    DISABLE_MOVE(BenchmarkCache)
+private:
+    IL_DECLARE_CLASS_NAME(BenchmarkCache)
+
+public:
+    BenchmarkCache() = default;
+
+    static std::string getKey(const IBenchmarkDescription::Description &description,
+                              const IBenchmarkDescription::BenchmarkConfig &bench_config);
+
+    /**
+     * @brief Retrieves the benchmark stored under the specified key.
+     * @returns The benchmark or null if no benchmark is stored under \p key.
+     */
+    IBenchmark::Ptr find(const std::string &key);
+    /**
+     * @brief Stores a benchmark, replacing the benchmark previously stored.
+     */
+    void store(const std::string &key, IBenchmark::Ptr p_bench);
+    /**
+     * @brief Destroys the stored benchmark, if any.
+     */
+    void clear();
+
+    std::uint64_t getHitCount() const { return m_hit_count; }
+    std::uint64_t getMissCount() const { return m_miss_count; }
+
+private:
+    std::string m_key;
+    IBenchmark::Ptr m_p_bench;
+    std::uint64_t m_hit_count  = 0;
+    std::uint64_t m_miss_count = 0;
+};
+
+/**
+ * @brief Serves benchmark run requests over a local Unix socket, keeping the
+ * backend loaded and the last initialized benchmark warm between requests.
+ * @details Clients connect, send a single request line and receive the
+ * response lines until the daemon closes the connection. Requests are served
+ * one at a time. Supported requests:
+ *
+ * - `run <benchmark_config_file>`: runs the benchmarks in the configuration
+ * file. Response is `OK` on success or `FAILED <count>` followed by the path
+ * of each failed benchmark, one per line.
+ * - `evict`: destroys the cached benchmark. Response is `OK`.
+ * - `status`: response is `OK <hits> <misses>` with the benchmark cache
+ * statistics.
+ * - `shutdown`: response is `OK` and the daemon stops serving.
+ *
+ * Any error is responded as `ERROR <message>`.
+ */
+class HarnessDaemon
+{
+private:
+    IL_DECLARE_CLASS_NAME(HarnessDaemon)
+
+public:
+    /**
+     * @brief Maximum length, in bytes, of a request line.
+     */
+    static constexpr std::size_t MaxRequestSize = 4096;
+
+    /**
+     * @brief Runs the benchmarks requested.
+     * @param[in] config_file Benchmark configuration file to run.
+     * @param[in] bench_cache Cache of initialized benchmarks kept alive
+     * between requests.
+     * @returns Paths of the benchmarks that failed.
+     */
+    typedef std::function<std::vector<std::string>(const std::filesystem::path &config_file,
+                                                   BenchmarkCache &bench_cache)>
+        RunHandler;
+
+    /**
+     * @brief Listens on the specified Unix socket and serves requests until
+     * a `shutdown` request is received.
+     * @param[in] socket_path Path of the Unix socket to create. Any existing
+     * file at this path is replaced.
+     * @param[in] handler Function that runs every `run` request.
+     * @details Requests that fail are reported to the client and the cached
+     * benchmark is destroyed, since its state is unknown. Critical backend
+     * errors are reported to the client and then propagated.
+     */
+    static void serve(const std::string &socket_path, const RunHandler &handler);
+
+private:
+    HarnessDaemon() = default;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Daemon_H_0596d40a3cce4b108a81595c50eb286d
@@ -0,0 +1,179 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Distributed_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Distributed_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "modules/general/include/nocopy.h"
+#include "modules/logging/include/logging.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Independent unit of work dispatched by a DistributedCoordinator.
+ */
+struct DistributedJob
+{
+    /**
+     * @brief Path of the benchmark report relative to the report root.
+     * @details Used as key for historical run times.
+     */
+    std::string bench_path;
+    /**
+     * @brief Benchmark configuration file (YAML) that contains only this job.
+     */
+    std::string config;
+};
+
+/**
+ * @brief Distributes benchmark jobs over TCP to worker Test Harness instances.
+ * @details Jobs are handed, one at a time, to every connected worker (see
+ * DistributedWorker). Jobs are dispatched longest first, based on the run
+ * times recorded in a history file by previous sweeps, which balances the
+ * load across workers (jobs without history are estimated as the mean of the
+ * known ones).
+ *
+ * Workers send heartbeats while running a job. A worker whose connection
+ * fails or that stops sending heartbeats is considered lost and its current
+ * job is re-dispatched to the remaining workers, up to MaxJobAttempts times.
+ *
+ * Report files produced by a job are sent back by the worker and written
+ * under the coordinator report root, so that the summary can be generated
+ * locally as if all benchmarks had been run on this host.
+ *
+ * Coordinator and workers share a secret token: the coordinator presents it
+ * on connection and workers drop connections that do not present it before
+ * any job configuration is accepted. The token is sent in clear text, thus,
+ * it protects workers from jobs sent by unauthorized hosts, but not from
+ * eavesdroppers. Use a trusted network or a tunnel in such case.
+ *
+ * All hosts are expected to be identical: same Test Harness version and
+ * backend, same platform byte order.
+ */
+class DistributedCoordinator
+{
+public:
+    DISABLE_COPY(DistributedCoordinator)
+    DISABLE_MOVE(DistributedCoordinator)
+private:
+    IL_DECLARE_CLASS_NAME(DistributedCoordinator)
+
+public:
+    /**
+     * @brief Maximum number of times a job is dispatched before it is
+     * considered failed.
+     */
+    static constexpr std::size_t MaxJobAttempts = 3;
+    /**
+     * @brief Time, in milliseconds, without messages from a busy worker
+     * before it is considered lost.
+     */
+    static constexpr std::size_t WorkerTimeoutMs = 60000;
+
+    /**
+     * @brief Constructs a new coordinator.
+     * @param[in] workers Addresses of the workers in the form `host:port`.
+     * @param[in] token Secret token shared with the workers.
+     * @param[in] report_root Directory where to store the report files
+     * collected from workers.
+     * @param[in] history_file File where historical job run times are
+     * loaded from and saved to. Empty to disable history.
+     */
+    DistributedCoordinator(const std::vector<std::string> &workers,
+                           const std::string &token,
+                           const std::filesystem::path &report_root,
+                           const std::filesystem::path &history_file);
+
+    /**
+     * @brief Runs all jobs on the workers and waits for them to complete.
+     * @param[in] jobs Jobs to run.
+     * @returns Paths of the benchmarks that failed or could not be run.
+     * @details Reports of failed jobs are removed from the report root to
+     * signal failure. History is updated with the run times of the jobs that
+     * completed successfully.
+     */
+    std::vector<std::string> run(const std::vector<DistributedJob> &jobs);
+
+private:
+    class Impl;
+
+    std::vector<std::string> m_workers;
+    std::string m_token;
+    std::filesystem::path m_report_root;
+    std::filesystem::path m_history_file;
+};
+
+/**
+ * @brief Serves benchmark jobs sent by a DistributedCoordinator.
+ */
+class DistributedWorker
+{
+private:
+    IL_DECLARE_CLASS_NAME(DistributedWorker)
+
+public:
+    /**
+     * @brief Interval, in milliseconds, between heartbeats sent to the
+     * coordinator while a job is running.
+     */
+    static constexpr std::size_t HeartbeatIntervalMs = 5000;
+    /**
+     * @brief Time, in milliseconds, a coordinator has to present the token
+     * after connecting before it is dropped.
+     */
+    static constexpr std::size_t AuthTimeoutMs = 10000;
+    /**
+     * @brief Address on which workers listen by default: loopback only.
+     */
+    static constexpr const char *DefaultBindAddress = "127.0.0.1";
+
+    /**
+     * @brief Runs a job.
+     * @param[in] config_file Benchmark configuration file for the job.
+     * @param[in] report_root Directory where the job must write its reports.
+     * @returns `true` if the benchmark succeeded, `false` otherwise.
+     */
+    typedef std::function<bool(const std::filesystem::path &config_file,
+                               const std::filesystem::path &report_root)>
+        JobHandler;
+
+    /**
+     * @brief Listens for a coordinator on the specified TCP address and port
+     * and runs the jobs it sends.
+     * @param[in] bind_address Host name or IP address of the local interface
+     * to listen on. Use DefaultBindAddress to accept local coordinators only.
+     * @param[in] port TCP port to listen on.
+     * @param[in] token Secret token shared with the coordinators. Must not be
+     * empty.
+     * @param[in] work_dir Directory where to store configuration and reports
+     * of the job being run. Contents are removed after they are sent to the
+     * coordinator.
+     * @param[in] handler Function that runs every job received.
+     * @details Coordinators are served one at a time. Connections that do not
+     * present \p token within AuthTimeoutMs are dropped without receiving any
+     * message. After a coordinator disconnects, the worker waits for the next one. This method only returns
+     * by throwing, for example, when the handler throws, which is reported to
+     * the coordinator as a failed job before the exception is propagated.
+     */
+    static void serve(const std::string &bind_address,
+                      std::uint16_t port,
+                      const std::string &token,
+                      const std::filesystem::path &work_dir,
+                      const JobHandler &handler);
+
+private:
+    DistributedWorker() = default;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Distributed_H_0596d40a3cce4b108a81595c50eb286d
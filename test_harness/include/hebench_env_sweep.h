@@ -0,0 +1,154 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Env_Sweep_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Env_Sweep_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "modules/logging/include/logging.h"
+
+#include "hebench_report_cpp.h"
+#include "hebench_report_fingerprint.h"
+
+#include "hebench_engine.h"
+#include "hebench_ibenchmark.h"
+#include "hebench_program_config.h"
+#include "hebench_types_harness.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Runs benchmarks under every combination of a set of runtime
+ * environment knobs and finds the best combination per benchmark.
+ * @details Each combination runs all benchmarks in a fresh Test Harness child
+ * process, executed from the same binary, with:
+ * - transparent huge pages disabled with `prctl(PR_SET_THP_DISABLE)`, if
+ * requested;
+ * - libraries preloaded with `LD_PRELOAD`, such as alternative allocators;
+ * - environment variables set or unset, such as `MALLOC_ARENA_MAX` or
+ * `OMP_WAIT_POLICY`.
+ *
+ * Children record the knobs in effect in the environment group of the
+ * fingerprint of every report. Combinations are compared on the average time
+ * per iteration of the main event of each benchmark; the first combination,
+ * made of the first value of every knob, is the reference.
+ */
+class EnvSweep
+{
+private:
+    IL_DECLARE_CLASS_NAME(EnvSweep)
+
+public:
+    static constexpr const char *KnobTHP             = "THP";
+    static constexpr const char *KnobPreload         = "LD_PRELOAD";
+    static constexpr const char *THPDefault          = "default";
+    static constexpr const char *THPDisabled         = "disabled";
+    static constexpr const char *Unset               = "(unset)";
+    static constexpr const char *CombinationsDirName = "env_sweep";
+    static constexpr const char *ResultsFile         = "env_sweep_results.csv";
+    static constexpr const char *SummaryFile         = "env_sweep_summary.csv";
+    static constexpr const char *ChildLogFile        = "env_sweep_child.log";
+
+    /**
+     * @brief Value of every knob, in the order of the knobs.
+     */
+    typedef std::vector<std::string> Combination;
+
+    struct Result
+    {
+        std::size_t combination_index;
+        bool b_succeeded;
+        std::string message; // reason for failure, if failed
+        double mean_ms; // time per iteration of the main event
+        double stddev_ms;
+        std::uint64_t event_count;
+    };
+
+    struct BenchmarkResults
+    {
+        std::string name;
+        std::vector<Result> results; // one per combination
+    };
+
+    /**
+     * @brief Expands the knobs into all combinations of their values.
+     * @details The first knob varies the slowest.
+     */
+    static std::vector<Combination> expand(const std::vector<EnvKnob> &knobs);
+    /**
+     * @brief Describes a combination as `name=value` pairs separated by spaces.
+     */
+    static std::string toString(const std::vector<EnvKnob> &knobs, const Combination &combination);
+    /**
+     * @brief Names of the knobs, as a command line argument for the child.
+     */
+    static std::string toChildArgument(const std::vector<EnvKnob> &knobs);
+
+    /**
+     * @brief Runs a Test Harness child process with a combination of knobs applied.
+     * @param[in] log_file File where the standard output of the child is
+     * redirected. Overwritten if it exists.
+     * @throws std::runtime_error if the child fails.
+     */
+    static void runChild(const std::vector<EnvKnob> &knobs,
+                         const Combination &combination,
+                         const std::vector<std::string> &child_args,
+                         const std::filesystem::path &log_file);
+    /**
+     * @brief Adds the current state of the knobs of this process to the
+     * environment group of a fingerprint.
+     * @param[in] child_arg Names of the knobs, as generated by toChildArgument().
+     */
+    static void addToFingerprint(hebench::TestHarness::Report::cpp::Fingerprint &fingerprint,
+                                 const std::string &child_arg);
+
+    /**
+     * @brief Summarizes the main events of a report into a result.
+     * @details Result fails if the report has no main events.
+     */
+    static Result summarizeReport(std::size_t combination_index,
+                                  const hebench::TestHarness::Report::cpp::TimingReport &report);
+    /**
+     * @brief Index of the successful result with the lowest mean, or the count
+     * of results if none succeeded.
+     */
+    static std::size_t findBest(const std::vector<Result> &results);
+
+    static void save2CSV(const std::filesystem::path &summary_filename,
+                         const std::filesystem::path &results_filename,
+                         const std::vector<EnvKnob> &knobs,
+                         const std::vector<Combination> &combinations,
+                         const std::vector<BenchmarkResults> &bench_results);
+    static std::ostream &show(std::ostream &os,
+                              const std::vector<EnvKnob> &knobs,
+                              const std::vector<Combination> &combinations,
+                              const std::vector<BenchmarkResults> &bench_results);
+
+    /**
+     * @brief Runs the benchmarks requested once per combination of the knobs,
+     * all benchmarks of a combination in the same child process.
+     * @returns Benchmark paths of benchmarks that failed on every combination.
+     * @details Saves the results of all combinations in files SummaryFile and
+     * ResultsFile under the report root path.
+     */
+    static std::vector<std::string> run(Engine &engine,
+                                        const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                        const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                                        const std::vector<EnvKnob> &env_knobs,
+                                        const ProgramConfig &config);
+
+private:
+    EnvSweep() = default;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Env_Sweep_H_0596d40a3cce4b108a81595c50eb286d
@@ -0,0 +1,65 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Fingerprint_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Fingerprint_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "modules/logging/include/logging.h"
+
+#include "hebench_report_fingerprint.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Collects the fingerprint of the machine, build and backend running
+ * the benchmarks.
+ * @details Machine information is read from procfs and sysfs. Entries that
+ * cannot be read on this platform, or require elevated privileges (such as
+ * memory speed), are set to `Unknown`.
+ */
+class FingerprintCollector
+{
+private:
+    IL_DECLARE_CLASS_NAME(FingerprintCollector)
+
+public:
+    static constexpr const char *LibraryHashKey = "Library hash (FNV-1a 64)";
+
+    /**
+     * @brief Collects the machine and build fingerprint.
+     * @details Machine configuration does not change during a run, so, this
+     * is expected to be called once at startup.
+     */
+    static hebench::TestHarness::Report::cpp::Fingerprint collect();
+    /**
+     * @brief Adds the backend library entries to a fingerprint.
+     * @param[in,out] fingerprint Fingerprint to complete.
+     * @param[in] backend_lib_path Path of the backend library loaded.
+     * @param[in] lib_hash Hash of the library already recorded under
+     * LibraryHashKey by the parent process. If empty, the library is hashed.
+     * @details Child processes receive the hash from their parent instead of
+     * reading the whole library again before their timed phases.
+     */
+    static void addBackend(hebench::TestHarness::Report::cpp::Fingerprint &fingerprint,
+                           const std::filesystem::path &backend_lib_path,
+                           const std::string &lib_hash = std::string());
+    /**
+     * @brief Computes the FNV-1a 64 bits hash of the contents of a file.
+     * @throws std::runtime_error if the file cannot be read.
+     */
+    static std::uint64_t hashFile(const std::filesystem::path &filename);
+
+private:
+    FingerprintCollector() = default;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Fingerprint_H_0596d40a3cce4b108a81595c50eb286d
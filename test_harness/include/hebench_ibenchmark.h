@@ -5,16 +5,21 @@
 #ifndef _HEBench_Harness_IBenchmark_H_0596d40a3cce4b108a81595c50eb286d
 #define _HEBench_Harness_IBenchmark_H_0596d40a3cce4b108a81595c50eb286d
 
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "modules/general/include/nocopy.h"
 #include "modules/logging/include/logging.h"
 
 #include "hebench/api_bridge/types.h"
+#include "subphase_timings.h"
+
 #include "hebench_idata_loader.h"
+#include "hebench_run_arena.h"
 #include "hebench_utilities.h"
 
 namespace hebench {
@@ -55,6 +60,29 @@ public:
          * stated in the workload specification.
          */
         std::uint64_t default_sample_size;
+        /**
+         * @brief Number of rounds of probabilistic validation of results for
+         * workloads that support it.
+         * @details When 0, results are validated against pre-computed ground truth.
+         * Otherwise, supporting workloads skip computing ground truth and validate
+         * each result with a randomized check instead, where an incorrect result
+         * passes each round with probability at most one half.
+         */
+        std::uint64_t probabilistic_validation_rounds = 0;
+        /**
+         * @brief Minimum number of operations timed by latency tests.
+         * @details Latency tests time operations until both, this number of
+         * operations and the minimum test time, are reached. Regardless of this
+         * value, latency tests time, at least, two operations.
+         */
+        std::uint64_t min_latency_iterations = 0;
+        /**
+         * @brief Sample size for each operation parameter in offline category.
+         * @details If element `i` is not 0, it replaces the default sample size
+         * for operation parameter `i` when the backend specifies 0 for the
+         * sample size of that parameter.
+         */
+        std::vector<std::uint64_t> operand_sample_sizes;
     };
     /**
      * @brief Contains fields that describe a benchmark.
@@ -77,6 +105,28 @@ public:
          * can be used as a relative directory path. This may be several directories deep.
          */
         std::string path;
+        /**
+         * @brief Workload of the benchmark descriptor.
+         */
+        hebench::APIBridge::Workload workload = hebench::APIBridge::Workload::MatrixMultiply;
+        /**
+         * @brief Cipher parameter mask of the benchmark descriptor.
+         * @details Benchmarks that differ only in this mask share their
+         * description path, except for the component named after the mask.
+         * @sa PartialBenchmarkDescription::getCipherMaskName()
+         */
+        std::uint32_t cipher_param_mask = 0;
+        /**
+         * @brief Sample size of each operation parameter, for offline category.
+         * @details Empty for other categories.
+         */
+        std::vector<std::uint64_t> sample_sizes;
+        /**
+         * @brief Indices of the operation parameters whose sample size is
+         * chosen by Test Harness, for offline category.
+         * @sa BenchmarkConfig::operand_sample_sizes
+         */
+        std::vector<std::size_t> flexible_sample_params;
     };
 
     /**
@@ -263,6 +313,9 @@ public:
      * @param[in] param_count Number of parameters for the workload operation.
      * @param[in] default_batch_size If a batch size is set to 0 in the descriptor,
      * this value will be used as default instead.
+     * @param[in] operand_sample_sizes If a batch size is set to 0 in the descriptor,
+     * a non-zero value at the same index in this collection is used instead of
+     * \p default_batch_size.
      * @param[in] bench_desc HEBench API benchmark descriptor from which to extract the
      * workload batch sizes.
      * @return The batch size for the result of the operation.
@@ -270,12 +323,36 @@ public:
     static std::uint64_t computeSampleSizes(std::uint64_t *sample_sizes,
                                             std::size_t param_count,
                                             std::uint64_t default_sample_size,
+                                            const std::vector<std::uint64_t> &operand_sample_sizes,
                                             const hebench::APIBridge::BenchmarkDescriptor &bench_desc);
+    /**
+     * @brief Adds the sample sizes of an offline benchmark to its description.
+     * @param[out] description Description to receive the sample sizes and the
+     * parameters with flexible sample size.
+     * @param[in] sample_sizes Array with \p param_count elements with the sample
+     * sizes, as returned by computeSampleSizes().
+     * @param[in] param_count Number of parameters for the workload operation.
+     * @param[in] bench_desc HEBench API benchmark descriptor used to compute
+     * the sample sizes.
+     */
+    static void describeSampleSizes(Description &description,
+                                    const std::uint64_t *sample_sizes,
+                                    std::size_t param_count,
+                                    const hebench::APIBridge::BenchmarkDescriptor &bench_desc);
 
 public:
     PartialBenchmarkDescription();
     ~PartialBenchmarkDescription() override;
 
+    /**
+     * @brief Name of the description path component for a cipher parameter mask.
+     * @param[in] cipher_param_mask Mask of encrypted operation parameters.
+     * @return "all_plain", "all_cipher", or one character per parameter, up to
+     * the last encrypted one: 'c' for encrypted parameters and 'p' for
+     * plaintext parameters.
+     */
+    static std::string getCipherMaskName(std::uint32_t cipher_param_mask);
+
     /**
      * @brief Implementation of IBenchmarkDescription::matchBenchmarkDescriptor().
      * @details Clients should not override this method.
@@ -412,6 +489,20 @@ public:
         * that have been already validated or when creating and debugging new backends.
         */
         bool b_validate_results;
+        /**
+        * @brief Specifies whether the benchmark will also time the plaintext computation
+        * of the operation on the same dataset as baseline for the backend.
+        * @details The plaintext baseline and the slowdown factor of the backend with
+        * respect to it are added to the report.
+        */
+        bool b_plaintext_baseline;
+        /**
+        * @brief Specifies whether benchmarks whose ground truth approximates an exact
+        * function will also measure the error of the validated results against it.
+        * @details The error is appended to the report footer. Only used when
+        * validating results.
+        */
+        bool b_reference_error;
     };
 
     virtual ~IBenchmark() = default;
@@ -432,6 +523,12 @@ public:
      * on any other errors.
      */
     virtual bool run(hebench::Utilities::TimingReportEx &out_report, RunConfig &config) = 0;
+    /**
+     * @brief Prepares an initialized benchmark to run again on a new report.
+     * @details Called before reusing a benchmark that already ran, such as
+     * one kept warm between daemon requests. Default does nothing.
+     */
+    virtual void prepareReuse() {}
 
     virtual std::weak_ptr<Engine> getEngine() const          = 0;
     virtual const hebench::APIBridge::Handle &handle() const = 0;
@@ -471,6 +568,14 @@ public:
 public:
     typedef std::shared_ptr<PartialBenchmark> Ptr;
 
+    /**
+     * @brief Title of the report footer block with the change in resident
+     * memory of each phase of the run.
+     * @details The block is followed by line "Phase,Delta (bytes)" and one
+     * line per phase measured. See appendPhaseMemory().
+     */
+    static constexpr const char *PhaseMemoryFooterTitle = "Resident memory";
+
     ~PartialBenchmark() override;
 
     std::weak_ptr<Engine> getEngine() const override { return m_p_engine; }
@@ -503,6 +608,12 @@ public:
         return ++m_current_event_id;
     }
 
+    /**
+     * @brief Restarts event IDs from `getEventIDStart()`, so that a reused
+     * benchmark reports the same IDs as a fresh one.
+     */
+    void prepareReuse() override { m_current_event_id = getEventIDStart(); }
+
     /**
      * @brief Initializes the partial benchmark members.
      * @param[in] description The text description generated for this benchmark.
@@ -586,10 +697,62 @@ protected:
      * \p last_error to `true`.
      */
     void validateRetCode(hebench::APIBridge::ErrorCode err_code, bool last_error = true) const;
+    /**
+     * @brief Adds to the report the sub-phase timings pushed by the backend
+     * during the last API Bridge call.
+     * @param[in,out] out_report Report where to add the sub-phase events.
+     * @param[in] parent_event Timing event of the API Bridge call.
+     * @param[in] parent_event_name Name of the event type of \p parent_event .
+     * @details Must be called after every timed API Bridge call. Each sub-phase
+     * is added as a child event of type "<parent event name>: <sub-phase name>"
+     * that starts with the parent event and lasts the time reported by the
+     * backend. Child event types get their own IDs, so they are summarized
+     * separately from their parent.
+     *
+     * Does nothing if the backend does not export the sub-phase timing
+     * extension.
+     * @sa hebench::APIBridge::SubPhaseTimings
+     */
+    void addSubPhaseEvents(hebench::Utilities::TimingReportEx &out_report,
+                           const hebench::Common::TimingReportEvent &parent_event,
+                           const std::string &parent_event_name);
+    /**
+     * @brief Starts measuring the change in resident memory of the process
+     * during a phase of the run.
+     * @param[in] phase_name Name of the phase.
+     * @details Ends the phase being measured, if any. Phases measured are
+     * added to the report by appendPhaseMemory().
+     */
+    void beginPhaseMemory(const std::string &phase_name);
+    /**
+     * @brief Ends the phase being measured, if any.
+     */
+    void endPhaseMemory();
+    /**
+     * @brief Ends the phase being measured, if any, and appends the change in
+     * resident memory of every phase measured to the report footer.
+     * @param[in,out] out_report Report where to append the footer block.
+     * @details Memory freed during a phase results in negative changes.
+     * Measurements include the memory of Test Harness itself, thus, they are
+     * meant to be compared between runs of benchmarks that share workload.
+     * @sa PhaseMemoryFooterTitle
+     */
+    void appendPhaseMemory(hebench::Utilities::TimingReportEx &out_report);
+    /**
+     * @brief Memory arena scoped to this benchmark.
+     * @details Data loaders created during initialization should receive this
+     * arena to allocate their descriptors from it. Category runners should
+     * allocate their short-lived collections from it. The memory in the arena
+     * is released when this benchmark and every object holding the arena are
+     * destroyed.
+     */
+    const RunArena::Ptr &getRunArena() const { return m_p_run_arena; }
 
 private:
     void internalInit(const IBenchmarkDescription::DescriptionToken &description_token);
 
+    // declared first so that arena outlives all other members and derived objects
+    RunArena::Ptr m_p_run_arena;
     IBenchmarkDescription::DescriptionToken::FriendKeyAccess m_key_adk; // friend key to access description token
     std::shared_ptr<Engine> m_p_engine;
     hebench::APIBridge::Handle m_handle;
@@ -598,6 +761,12 @@ private:
     std::vector<hebench::APIBridge::WorkloadParam> m_workload_params;
     IBenchmarkDescription::BenchmarkConfig m_bench_config;
     std::uint32_t m_current_event_id;
+    std::map<std::pair<std::uint32_t, std::string>, std::uint32_t> m_subphase_event_ids; // (parent ID, sub-phase name) -> child ID
+    std::vector<hebench::APIBridge::SubPhaseTiming> m_subphase_timings;
+    std::uint64_t m_subphase_dropped_count;
+    std::vector<std::pair<std::string, std::int64_t>> m_phase_memory; // (phase name, change in resident bytes)
+    std::string m_memory_phase_name; // phase being measured, empty if none
+    std::uint64_t m_memory_phase_start;
     bool m_b_constructed;
     bool m_b_initialized;
 };
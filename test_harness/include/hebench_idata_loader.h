@@ -7,12 +7,14 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "modules/general/include/nocopy.h"
 #include "modules/logging/include/logging.h"
 
 #include "hebench/api_bridge/types.h"
+#include "hebench_run_arena.h"
 #include "hebench_types_harness.h"
 
 namespace hebench {
@@ -40,31 +42,42 @@ public:
      * @brief Creates shallow packed data that self cleans up.
      * @param[in] data_pack_count Number of DataPack objects that will be pointed to
      * by this PackedData.
+     * @param[in] p_arena Arena from which to allocate the descriptors. If null,
+     * the global default memory resource is used.
      * @return A smart pointer to a PackedData structure.
      * @details The returned PackedData will self clean up its p_data_packs field
      * when it goes out of scope.
      *
+     * PackedData and its p_data_packs array are allocated from \p p_arena, which
+     * is kept alive until they are released.
+     *
      * Clients can use the created PackedData by pointing to their DataPack objects
      * in the pre-allocated p_data_packs field array.
      */
     static unique_ptr_custom_deleter<hebench::APIBridge::PackedData>
-    createPackedData(std::uint64_t data_pack_count);
+    createPackedData(std::uint64_t data_pack_count, RunArena::Ptr p_arena = RunArena::Ptr());
     /**
      * @brief Creates shallow data pack that self cleans up.
      * @param[in] buffer_count Number of NativeDataBuffer objects pointed to by this
      * DataPack.
      * @param[in] param_position Parameter position of this DataPack.
+     * @param[in] p_arena Arena from which to allocate the descriptors. If null,
+     * the global default memory resource is used.
      * @return A smart pointer to a DataPack structure.
      * @details The returned DataPack will self clean up its p_buffers field
      * when it goes out of scope.
      *
+     * DataPack and its p_buffers array are allocated from \p p_arena, which
+     * is kept alive until they are released.
+     *
      * Clients can use the created DataPack by pointing to their NativeDataBuffer objects
      * in the pre-allocated p_buffers field array.
      */
     static unique_ptr_custom_deleter<hebench::APIBridge::DataPack>
-    createDataPack(std::uint64_t buffer_count, std::uint64_t param_position);
+    createDataPack(std::uint64_t buffer_count, std::uint64_t param_position,
+                   RunArena::Ptr p_arena = RunArena::Ptr());
     static unique_ptr_custom_deleter<hebench::APIBridge::NativeDataBuffer>
-    createDataBuffer(std::uint64_t size, std::int64_t tag);
+    createDataBuffer(std::uint64_t size, std::int64_t tag, RunArena::Ptr p_arena = RunArena::Ptr());
 
     /**
      * @brief Number of parameter components (operands) for the represented operation.
@@ -120,9 +133,11 @@ public:
      * (result[0][r_i], result[1][r_i], ..., result[n-1][r_i])
      * @endcode
      * where r_i is the index of the `NativeDataBuffer`s for the result in the second dimension.
+     *
+     * Returned collection is allocated from the run arena of this loader, if any.
      * @sa getResultIndex()
      */
-    virtual std::vector<const hebench::APIBridge::NativeDataBuffer *> getResultFor(const std::uint64_t *param_data_pack_indices) = 0;
+    virtual RunArena::vector<const hebench::APIBridge::NativeDataBuffer *> getResultFor(const std::uint64_t *param_data_pack_indices) = 0;
     /**
      * @brief Computes the index of the result NativeDataBuffer given the indices
      * of the input data.
@@ -188,6 +203,43 @@ public:
      */
     virtual std::uint64_t getResultIndex(const std::uint64_t *param_data_pack_indices) = 0;
 
+    /**
+     * @brief Specifies whether this loader can compute results in plaintext
+     * using computeResult().
+     */
+    virtual bool canComputeResult() const { return false; }
+    /**
+     * @brief Computes, in plaintext, the result of the operation on the specified
+     * input samples.
+     * @param[in] results Buffers where to store each component of the result. Must
+     * contain, at least, getResultCount() buffers, each, at least, of the same size,
+     * in bytes, as the corresponding ground truth buffer.
+     * @param[in] param_data_pack_indices Collection of indices for data sample to
+     * use inside each parameter pack. Number of elements pointed must be, at least,
+     * `parameterCount()`.
+     * @throw std::out_of_range if any index is out of range.
+     * @throws std::invalid_argument if \p param_data_pack_indices is null or
+     * \p results is not valid.
+     * @throws std::logic_error if canComputeResult() is `false`.
+     * @details This is the same computation that produces the ground truth. Test Harness
+     * times it to obtain the plaintext baseline of a benchmark, thus, implementations
+     * should not allocate memory nor perform other work unrelated to the operation.
+     */
+    virtual void computeResult(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                               const std::uint64_t *param_data_pack_indices);
+    /**
+     * @brief Same as computeResult() without validating the arguments.
+     * @details Callers must have validated the same arguments with a previous
+     * call to computeResult(). Test Harness uses this method to keep argument
+     * checks out of the timed plaintext baseline. Default implementation calls
+     * computeResult().
+     */
+    virtual void computeResultUnchecked(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                        const std::uint64_t *param_data_pack_indices)
+    {
+        computeResult(results, param_data_pack_indices);
+    }
+
     /**
      * @brief Total data loaded by this loader in bytes.
      */
@@ -229,12 +281,30 @@ public:
     const hebench::APIBridge::DataPack &getParameterData(std::uint64_t param_position) const override;
     std::uint64_t getResultCount() const override { return m_output_data.size(); }
     const hebench::APIBridge::DataPack &getResultData(std::uint64_t param_position) const override;
-    std::vector<const hebench::APIBridge::NativeDataBuffer *> getResultFor(const std::uint64_t *param_data_pack_indices) override;
+    RunArena::vector<const hebench::APIBridge::NativeDataBuffer *> getResultFor(const std::uint64_t *param_data_pack_indices) override;
     std::uint64_t getResultIndex(const std::uint64_t *param_data_pack_indices) override;
+    /**
+     * @brief Validates the arguments and computes the result with
+     * computeResultUnchecked().
+     * @details Derived classes that can compute results override
+     * computeResultUnchecked() instead of this method.
+     */
+    void computeResult(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                       const std::uint64_t *param_data_pack_indices) override;
+    void computeResultUnchecked(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                const std::uint64_t *param_data_pack_indices) override;
     std::uint64_t getTotalDataLoaded() const override { return m_raw_buffer.size(); }
 
 protected:
-    PartialDataLoader() {}
+    /**
+     * @brief Constructs a data loader that allocates its descriptors from the
+     * specified arena.
+     * @param[in] p_arena Arena of the benchmark run that owns this loader. If
+     * null, the global default memory resource is used.
+     * @details The arena is kept alive for as long as this loader exists.
+     */
+    PartialDataLoader(RunArena::Ptr p_arena) :
+        m_p_arena(std::move(p_arena)) {}
     /**
      * @brief Initializes dimensions of inputs and outputs. No allocation is performed.
      * @param[in] input_dim Dimension of the input (to become getParameterCount()).
@@ -270,8 +340,16 @@ protected:
                   const std::uint64_t *output_buffer_sizes,
                   std::size_t output_buffer_sizes_count,
                   bool allocate_output = true);
+    /**
+     * @brief Validates the arguments for computeResult().
+     * @throws std::out_of_range if any index is out of range.
+     * @throws std::invalid_argument if any argument is invalid.
+     */
+    void checkComputeResultArgs(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                const std::uint64_t *param_data_pack_indices) const;
 
 private:
+    RunArena::Ptr m_p_arena;
     std::vector<unique_ptr_custom_deleter<hebench::APIBridge::DataPack>> m_input_data;
     // output data is ordered such that each element of the data pack
     // is the result of the input parameters picked in row major order
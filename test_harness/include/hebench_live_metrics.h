@@ -0,0 +1,117 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Live_Metrics_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Live_Metrics_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "modules/logging/include/logging.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Static class that publishes live metrics of the current run.
+ * @details When initialized, a background thread periodically renders the
+ * current state of the run in Prometheus text exposition format and
+ * publishes it by atomically rewriting a text file, serving it over a local
+ * Unix domain socket, or both. Any scraper (node exporter textfile collector,
+ * `socat`, `curl --unix-socket`, etc.) can then read the state of a running
+ * benchmark without interfering with it.
+ *
+ * Hooks called from the benchmark runners only update atomic counters and
+ * a fixed-size ring of latency samples; all formatting and I/O happen in the
+ * publisher thread.
+ *
+ * If LiveMetrics is not initialized, calls to the update methods are cheap
+ * no-ops.
+ */
+class LiveMetrics
+{
+private:
+    IL_DECLARE_CLASS_NAME(LiveMetrics)
+
+public:
+    /**
+     * @brief Number of most recent operation samples used to compute rolling
+     * rate and latency quantiles.
+     */
+    static constexpr std::size_t RollingWindowSize = 1024;
+
+    /**
+     * @brief Initializes LiveMetrics and starts the publisher thread.
+     * @param[in] file_path Path to the Prometheus text file to rewrite
+     * periodically. Empty string to disable file output.
+     * @param[in] socket_path Path of the Unix domain socket to serve metrics on.
+     * Empty string to disable socket output.
+     * @param[in] interval_ms Interval, in milliseconds, between file rewrites.
+     * @throws std::runtime_error if both paths are empty or the socket cannot
+     * be created.
+     * @details Every call to initialize() must have a matching call to
+     * terminate(). Calling initialize() while already initialized terminates
+     * the previous session first.
+     */
+    static void initialize(const std::string &file_path,
+                           const std::string &socket_path,
+                           std::size_t interval_ms);
+    /**
+     * @brief Stops the publisher thread, writes a final snapshot and removes
+     * the socket file, if any.
+     */
+    static void terminate();
+    static bool isInitialized();
+
+    /**
+     * @brief Sets the total number of benchmarks to run.
+     */
+    static void setTotalBenchmarks(std::uint64_t total);
+    /**
+     * @brief Marks the beginning of a new benchmark.
+     * @param[in] run_index Zero-based index of the benchmark in the run.
+     * @param[in] benchmark_id Backend benchmark index.
+     * @param[in] path Report path of the benchmark.
+     * @details Resets operation counters and rolling latency samples.
+     */
+    static void beginBenchmark(std::uint64_t run_index,
+                               std::uint64_t benchmark_id,
+                               const std::string &path);
+    /**
+     * @brief Marks the current benchmark as completed.
+     * @param[in] succeeded Whether the benchmark completed successfully.
+     */
+    static void endBenchmark(bool succeeded);
+    /**
+     * @brief Sets the name of the phase currently executing.
+     */
+    static void setPhase(const std::string &phase);
+    /**
+     * @brief Records a completed operation.
+     * @param[in] wall_time_ms Wall time, in milliseconds, for the operation.
+     * @param[in] count Number of operations completed, for batched operations.
+     * @details This is the only hook intended to be called inside measured
+     * loops, after the timer for the operation stops. It does not allocate
+     * nor perform I/O, and returns after a single relaxed atomic load when
+     * live metrics are not initialized.
+     */
+    static void recordOperation(double wall_time_ms, std::uint64_t count = 1);
+
+private:
+    class Publisher;
+
+    // accessed through std::atomic_* shared_ptr overloads; null when not initialized
+    static std::shared_ptr<Publisher> m_p_publisher;
+    // fast check for hooks in measured loops: skips shared_ptr access when not initialized
+    static std::atomic<bool> m_b_enabled;
+
+    LiveMetrics() = default;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Live_Metrics_H_0596d40a3cce4b108a81595c50eb286d
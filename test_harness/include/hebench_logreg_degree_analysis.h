@@ -0,0 +1,133 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_LogReg_Degree_Analysis_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_LogReg_Degree_Analysis_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "modules/logging/include/logging.h"
+
+#include "hebench_report_cpp.h"
+#include "hebench_report_fingerprint.h"
+
+#include "hebench_ibenchmark.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Compares the cost and accuracy of Logistic Regression benchmarks that
+ * differ only in the degree of the polynomial that approximates the sigmoid.
+ * @details Benchmarks are grouped when they share workload parameters,
+ * category, data type, cipher mask, scheme, security and extra description,
+ * that is, their description paths differ only in the workload component.
+ * Only reports with the error of the results against the exact sigmoid in
+ * their footer are considered.
+ *
+ * The cost of a phase is its wall time per iteration, added up over all event
+ * types of the phase. Backend sub-phases, warm-up time and the plaintext
+ * baseline are ignored.
+ *
+ * Every member of a group is compared against the reference member, the one
+ * with the lowest polynomial degree. Cost growth is related to multiplicative
+ * depth: the depth of a polynomial of degree `d` is `ceil(log2(d))`, the
+ * depth of computing its highest power by repeated squaring, leaving out the
+ * multiplications by the coefficients and the linear regression, which are
+ * the same for all degrees.
+ */
+class LogRegDegreeAnalysis
+{
+private:
+    IL_DECLARE_CLASS_NAME(LogRegDegreeAnalysis)
+
+public:
+    /**
+     * @brief Adds the report of a successful benchmark run.
+     * @param[in] description Description of the benchmark run.
+     * @param[in] report Report of the run.
+     * @returns `true` if the report was added.
+     * @returns `false` if \p report has no activation error in its footer,
+     * such as reports of other workloads.
+     * @throws std::invalid_argument if the machine or backend fingerprint of
+     * \p report differs from that of the reports already in its group, since
+     * their costs are not comparable.
+     */
+    bool addReport(const IBenchmarkDescription::Description &description,
+                   const hebench::TestHarness::Report::cpp::TimingReport &report);
+
+    /**
+     * @brief Number of groups with more than one degree.
+     */
+    std::size_t getGroupCount() const;
+
+    /**
+     * @brief Saves the cost of every phase of every group member, its growth
+     * with respect to the reference member and the error of its results.
+     */
+    void save2CSV(const std::filesystem::path &filename) const;
+    std::ostream &show(std::ostream &os) const;
+
+    /**
+     * @brief Multiplicative depth of a polynomial of the specified degree.
+     * @return `ceil(log2(degree))`, or 0 if \p degree is 0 (exact sigmoid).
+     */
+    static unsigned int getPolynomialDepth(unsigned int degree);
+    /**
+     * @brief Finds whether benchmarks of the specified workload are compared
+     * by polynomial degree.
+     * @returns `true` for the Logistic Regression workloads, with exact
+     * sigmoid or any of its polynomial approximations.
+     * @details Benchmarks of these workloads must run on the same input data
+     * to be comparable.
+     */
+    static bool isComparedWorkload(hebench::APIBridge::Workload workload);
+
+private:
+    struct Error
+    {
+        std::uint64_t result_count;
+        double max_abs;
+        double mean_abs;
+        double rms;
+    };
+    struct Member
+    {
+        unsigned int degree;
+        Error error;
+        std::map<std::string, double> phases; // wall time per iteration (s)
+    };
+    struct Group
+    {
+        std::string path; // description path with "*" for the workload
+        std::vector<std::string> phase_names; // in order of first appearance
+        std::vector<Member> members;
+        hebench::TestHarness::Report::cpp::Fingerprint fingerprint; // of the first member added
+    };
+
+    static constexpr const char *TotalPhaseName = "Total";
+
+    static std::string getGroupPath(const IBenchmarkDescription::Description &description);
+    static std::string getActivationName(unsigned int degree);
+    static bool readError(const std::string &footer, unsigned int &degree, Error &error);
+    static double getPhaseCost(const Member &member, const std::string &phase_name, bool &b_found);
+    /**
+     * @brief Member of the group with the lowest polynomial degree.
+     * @details The exact sigmoid is the reference only if no polynomial is in
+     * the group.
+     */
+    static const Member &getReference(const Group &group);
+
+    std::vector<Group> m_groups;
+    std::map<std::string, std::size_t> m_group_index; // group path -> index in m_groups
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_LogReg_Degree_Analysis_H_0596d40a3cce4b108a81595c50eb286d
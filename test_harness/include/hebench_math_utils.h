@@ -5,6 +5,7 @@
 #ifndef _HEBench_Harness_MathUtils_H_0596d40a3cce4b108a81595c50eb286d
 #define _HEBench_Harness_MathUtils_H_0596d40a3cce4b108a81595c50eb286d
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <type_traits>
@@ -63,6 +64,26 @@ almostEqual(const T *a, const T *b,
  * (2, 1)
  * @endcode
  */
+/**
+ * @brief Performs one round of Freivalds' check of
+ * `mat_result == mat_a * mat_b`.
+ * @param[in] mat_result Matrix of `rows_a` x `cols_b` elements, in row major order.
+ * @param[in] mat_a Matrix of `rows_a` x `cols_a` elements, in row major order.
+ * @param[in] mat_b Matrix of `cols_a` x `cols_b` elements, in row major order.
+ * @param[in] projection Random vector of `cols_b` elements in {-1, 1}.
+ * @param[in] tolerance Relative tolerance per element of the result. Not
+ * used for integer types, which are checked exactly.
+ * @return Indices of the rows of the result that failed the check.
+ * @details For floating point types, a row fails when the projections differ
+ * by more than the sum of the tolerances of the row elements, so a result
+ * with every element within tolerance never fails.
+ */
+template <class T>
+std::vector<std::uint64_t> freivalds(const T *mat_result, const T *mat_a, const T *mat_b,
+                                     std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b,
+                                     const std::vector<double> &projection,
+                                     double tolerance);
+
 class ComponentCounter
 {
 public:
@@ -149,6 +170,77 @@ almostEqual(const T *a, const T *b, std::uint64_t count, double pct)
     return retval;
 }
 
+template <class T>
+std::vector<std::uint64_t> freivalds(const T *mat_result, const T *mat_a, const T *mat_b,
+                                     std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b,
+                                     const std::vector<double> &projection,
+                                     double tolerance)
+{
+    std::vector<std::uint64_t> retval;
+
+    if constexpr (std::is_integral<T>::value)
+    {
+        // exact projections: unsigned arithmetic wraps around the same way
+        // as the ground truth does in the width of T
+        using U = typename std::make_unsigned<T>::type;
+        std::vector<U> r(cols_b);
+        for (std::uint64_t col_b = 0; col_b < cols_b; ++col_b)
+            r[col_b] = projection[col_b] < 0.0 ? static_cast<U>(0) - static_cast<U>(1) : static_cast<U>(1);
+
+        // B * r
+        std::vector<U> mat_b_r(cols_a, 0);
+        for (std::uint64_t row_b = 0; row_b < cols_a; ++row_b)
+            for (std::uint64_t col_b = 0; col_b < cols_b; ++col_b)
+                mat_b_r[row_b] += static_cast<U>(mat_b[row_b * cols_b + col_b]) * r[col_b];
+
+        // compare A * (B * r) against C * r, row by row
+        for (std::uint64_t row_a = 0; row_a < rows_a; ++row_a)
+        {
+            U expected = 0;
+            for (std::uint64_t col_a = 0; col_a < cols_a; ++col_a)
+                expected += static_cast<U>(mat_a[row_a * cols_a + col_a]) * mat_b_r[col_a];
+            U received = 0;
+            for (std::uint64_t col_b = 0; col_b < cols_b; ++col_b)
+                received += static_cast<U>(mat_result[row_a * cols_b + col_b]) * r[col_b];
+            if (received != expected)
+                retval.push_back(row_a);
+        } // end for
+    } // end if
+    else
+    {
+        // B * r
+        std::vector<double> mat_b_r(cols_a, 0.0);
+        for (std::uint64_t row_b = 0; row_b < cols_a; ++row_b)
+            for (std::uint64_t col_b = 0; col_b < cols_b; ++col_b)
+                mat_b_r[row_b] += static_cast<double>(mat_b[row_b * cols_b + col_b]) * projection[col_b];
+
+        // compare A * (B * r) against C * r, row by row
+        for (std::uint64_t row_a = 0; row_a < rows_a; ++row_a)
+        {
+            double expected = 0.0;
+            for (std::uint64_t col_a = 0; col_a < cols_a; ++col_a)
+                expected += static_cast<double>(mat_a[row_a * cols_a + col_a]) * mat_b_r[col_a];
+
+            double received = 0.0;
+            double bound    = 0.0; // sum of |r_j| * tol_j
+            for (std::uint64_t col_b = 0; col_b < cols_b; ++col_b)
+            {
+                double value = static_cast<double>(mat_result[row_a * cols_b + col_b]);
+                received += value * projection[col_b];
+                // same per element tolerance as ground truth validation: relative
+                // for large values, absolute for values close to 0
+                bound += std::abs(projection[col_b]) * std::max(std::abs(value), 1.0) * tolerance;
+            } // end for
+
+            // a result with every element within tolerance never exceeds the bound
+            if (std::abs(received - expected) > bound)
+                retval.push_back(row_a);
+        } // end for
+    } // end else
+
+    return retval;
+}
+
 } // namespace Math
 } // namespace Utilities
 } // namespace hebench
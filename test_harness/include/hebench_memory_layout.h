@@ -0,0 +1,185 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Memory_Layout_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Memory_Layout_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modules/logging/include/logging.h"
+
+#include "hebench_report_cpp.h"
+
+#include "hebench_config.h"
+#include "hebench_engine.h"
+#include "hebench_program_config.h"
+#include "hebench_types_harness.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Runs benchmarks under randomized memory layouts to separate the
+ * timing variance caused by code and data placement from the variance within
+ * a run.
+ * @details Every layout runs the benchmark in a fresh Test Harness child
+ * process, executed from the same binary, with:
+ * - address space layout randomization (ASLR) enabled or disabled with
+ * `personality()`, alternating between layouts;
+ * - a random amount of padding in the environment of the child, which shifts
+ * its initial stack;
+ * - random padding allocated on the heap and on the memory mapping area before
+ * the backend library is loaded, which shifts the library and the backend
+ * allocations;
+ * - a random offset of the stack of the thread that runs the benchmark.
+ *
+ * The same layouts are used for all benchmarks. Event times of the main event
+ * of every layout are aggregated with a one-way random effects model: the
+ * variance between layout means not explained by the variance within layouts
+ * is the layout-induced variance.
+ */
+class MemoryLayout
+{
+private:
+    IL_DECLARE_CLASS_NAME(MemoryLayout)
+
+public:
+    static constexpr const char *LayoutsDirName    = "layouts";
+    static constexpr const char *SamplesFile       = "layout_samples.csv";
+    static constexpr const char *SummaryFile       = "layout_summary.csv";
+    static constexpr const char *ChildLogFile      = "layout_child.log";
+    static constexpr const char *EnvPaddingVar     = "HEBENCH_LAYOUT_PADDING";
+    static constexpr std::size_t MaxEnvPadding     = 4096; // bytes
+    static constexpr std::size_t MaxHeapPadding    = 65536; // bytes: under the default mmap threshold, so it shifts the heap
+    static constexpr std::size_t MaxMappingPadding = 256; // pages
+    static constexpr std::size_t MaxStackOffset    = 4096; // bytes
+
+    struct Layout
+    {
+        std::size_t index;
+        bool b_aslr;
+        std::size_t env_padding; // bytes
+        std::size_t heap_padding; // bytes
+        std::size_t mapping_padding; // pages
+        std::size_t stack_offset; // bytes
+    };
+
+    struct Sample
+    {
+        Layout layout;
+        bool b_succeeded;
+        std::string message; // reason for failure, if failed
+        std::vector<double> event_times_ms; // time per iteration of each main event
+    };
+
+    struct Stats
+    {
+        std::size_t layout_count; // layouts that succeeded
+        std::size_t event_count;
+        double mean_ms;
+        double layout_stddev_ms; // layout-induced
+        double within_stddev_ms; // within a layout
+        double min_layout_mean_ms;
+        double max_layout_mean_ms;
+        /**
+         * @brief Fraction of the total variance induced by the layout, in range [0, 1].
+         */
+        double layout_share;
+    };
+
+    /**
+     * @brief Generates \p count random layouts from a seed.
+     * @details ASLR is enabled on even layouts and disabled on odd layouts.
+     */
+    static std::vector<Layout> generateLayouts(std::size_t count, std::uint64_t seed);
+
+    /**
+     * @brief Layout values applied inside the child process, as a command
+     * line argument for the child.
+     */
+    static std::string toChildArgument(const Layout &layout);
+    /**
+     * @brief Parses the layout values applied inside the child process.
+     * @details Only heap padding, memory mapping padding and stack offset are
+     * set in the result.
+     * @throws std::invalid_argument if \p arg is not valid.
+     */
+    static Layout fromChildArgument(const std::string &arg);
+    /**
+     * @brief Runs a Test Harness child process with the layout applied by
+     * the parent: ASLR and environment padding.
+     * @param[in] layout Layout for the child.
+     * @param[in] child_args Command line arguments for the child Test Harness,
+     * which must include the argument with the rest of the layout.
+     * @param[in] log_file File where the standard output of the child is
+     * redirected. Overwritten if it exists.
+     * @throws std::runtime_error if the child fails.
+     */
+    static void runChild(const Layout &layout,
+                         const std::vector<std::string> &child_args,
+                         const std::filesystem::path &log_file);
+    /**
+     * @brief Allocates the heap and memory mapping padding of the layout.
+     * @details Must be called by the child before loading the backend library.
+     * Padding is kept until the process exits.
+     */
+    static void applyPadding(const Layout &layout);
+    /**
+     * @brief Calls \p func with the stack of the calling thread offset as
+     * specified by the layout.
+     */
+    static void runWithStackOffset(const Layout &layout, const std::function<void()> &func);
+
+    /**
+     * @brief Extracts the time per iteration of every main event in a report.
+     */
+    static std::vector<double> getEventTimes(const hebench::TestHarness::Report::cpp::TimingReport &report);
+    static Stats computeStats(const std::vector<Sample> &samples);
+
+    static void saveSamples(const std::filesystem::path &filename, const std::vector<Sample> &samples);
+    /**
+     * @brief Saves the statistics of every benchmark in CSV format.
+     * @param[in] bench_stats Name of each benchmark and its statistics.
+     */
+    static void saveSummary(const std::filesystem::path &filename,
+                            const std::vector<std::pair<std::string, Stats>> &bench_stats);
+    static std::ostream &show(std::ostream &os, const std::vector<Sample> &samples);
+
+    /**
+     * @brief Runs every benchmark requested under ProgramConfig::layout_samples
+     * layouts, one child process per layout.
+     * @returns Benchmark paths of benchmarks where no layout succeeded.
+     * @details Saves the samples of each benchmark in file SamplesFile under
+     * its report path, and the statistics of all benchmarks in file
+     * SummaryFile under the report root path.
+     */
+    static std::vector<std::string> run(Engine &engine,
+                                        hebench::Utilities::BenchmarkConfiguration &bench_configuration,
+                                        const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                        const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                                        const ProgramConfig &config);
+    /**
+     * @brief Runs the benchmark requested by the parent Test Harness of a
+     * memory layout child with the stack offset of the layout.
+     * @throws std::runtime_error if the benchmark fails.
+     */
+    static void runInLayout(Engine &engine,
+                            const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                            const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                            const ProgramConfig &config);
+
+private:
+    MemoryLayout() = default;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Memory_Layout_H_0596d40a3cce4b108a81595c50eb286d
@@ -0,0 +1,162 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Operand_Sweep_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Operand_Sweep_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "modules/logging/include/logging.h"
+
+#include "hebench_report_cpp.h"
+
+#include "hebench_engine.h"
+#include "hebench_ibenchmark.h"
+#include "hebench_program_config.h"
+#include "hebench_types_harness.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Fits a per-operand cost model of an Offline benchmark by varying the
+ * sample size of one operand at a time.
+ * @details Starting from the default sample sizes (the base point), every
+ * operand whose sample size is chosen by Test Harness runs with each of the
+ * requested sample sizes while the other operands are held at their base
+ * sample size. Points that vary a single operand cannot tell the fixed cost of
+ * an operation from its cost per result, so one more point runs all flexible
+ * operands at the smallest requested sample size together.
+ *
+ * The average wall time of the operation at every point is fitted by least
+ * squares to:
+ * @code
+ * time = fixed + sum(per_sample[i] * samples[i]) + per_result * results
+ * @endcode
+ * where `results` is the number of results computed by the operation. When
+ * results are proportional to the samples of an operand, such as with a
+ * single flexible operand, the cost per result cannot be told from the cost
+ * per sample and is left out of the model.
+ */
+class OperandSweep
+{
+private:
+    IL_DECLARE_CLASS_NAME(OperandSweep)
+
+public:
+    static constexpr const char *PointsDirName = "operand_sweep";
+    static constexpr const char *SummaryFile   = "operand_sweep_summary.csv";
+    static constexpr const char *PointsFile    = "operand_sweep_points.csv";
+
+    struct Point
+    {
+        std::vector<std::uint64_t> sample_sizes; // one per operand
+        bool b_succeeded;
+        std::string message; // reason for failure, if failed
+        std::uint64_t result_count; // results computed per operation
+        double mean_ms; // wall time per operation
+        double stddev_ms;
+        std::uint64_t event_count;
+    };
+
+    struct CostModel
+    {
+        bool b_valid; // false if too few points succeeded to fit the model
+        bool b_per_result; // false if cost per result is left out of the model
+        double fixed_ms;
+        std::vector<double> per_sample_ms; // one per operand: NaN for operands not varied
+        double per_result_ms; // NaN if left out of the model
+        double residual_rms_ms;
+        /**
+         * @brief Slope of the wall time per operation over the sample size of
+         * each operand, from the base point and the points that vary only that
+         * operand: NaN for operands not varied.
+         * @details This is the measured cost of an extra sample of an operand
+         * while the others stay at their base sample size, including any
+         * results it adds.
+         */
+        std::vector<double> marginal_ms;
+    };
+
+    /**
+     * @param[in] name Name of the sweep in the reports.
+     * @param[in] description Description of the Offline benchmark at its base
+     * point, with the sample size of every operand.
+     * @param[in] request Sweep requested.
+     * @throws std::invalid_argument if the benchmark has no operand with
+     * flexible sample size, or the request has no sample sizes.
+     */
+    OperandSweep(const std::string &name,
+                 const IBenchmarkDescription::Description &description,
+                 const OperandSweepRequest &request);
+
+    const std::string &getName() const { return m_name; }
+    const std::vector<std::size_t> &getFlexibleOperands() const { return m_flexible_operands; }
+    /**
+     * @brief Sample sizes of every operand for every point, base point first.
+     */
+    const std::vector<std::vector<std::uint64_t>> &getPointSampleSizes() const { return m_point_sample_sizes; }
+
+    /**
+     * @brief Summarizes the main events of the report of the next point.
+     * @details Point fails if the report has no main events.
+     */
+    void addPoint(const hebench::TestHarness::Report::cpp::TimingReport &report);
+    void addFailedPoint(const std::string &message);
+    bool isDone() const { return m_points.size() >= m_point_sample_sizes.size(); }
+    const std::vector<Point> &getPoints() const { return m_points; }
+
+    /**
+     * @brief Fits the cost model to the points that succeeded.
+     */
+    CostModel fit() const;
+
+    static void save2CSV(const std::filesystem::path &summary_filename,
+                         const std::filesystem::path &points_filename,
+                         const std::vector<OperandSweep> &sweeps);
+    static std::ostream &show(std::ostream &os, const std::vector<OperandSweep> &sweeps);
+
+    /**
+     * @brief Moves the operand sweep requests out of the benchmarks to run.
+     * @returns The operand sweep requests.
+     */
+    static std::vector<BenchmarkRequest> extract(std::vector<BenchmarkRequest> &benchmarks_to_run);
+    /**
+     * @brief Runs every point of every operand sweep requested and saves the
+     * cost models fitted.
+     * @details Every point has its own reports and summary under
+     * PointsDirName in the report root path.
+     * @returns Names of the sweeps where no cost model could be fitted.
+     */
+    static std::vector<std::string> run(Engine &engine,
+                                        const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                        const std::vector<BenchmarkRequest> &operand_sweeps,
+                                        const ProgramConfig &config);
+
+private:
+    /**
+     * @brief Solves the least squares problem `x * coeffs = y`.
+     * @param[out] coeffs Coefficient for each column of \p x.
+     * @param[in] x Matrix with one row per point.
+     * @return `false` if the columns of \p x are linearly dependent.
+     */
+    static bool solveLeastSquares(std::vector<double> &coeffs,
+                                  const std::vector<std::vector<double>> &x,
+                                  const std::vector<double> &y);
+    static std::string toString(const std::vector<std::uint64_t> &sample_sizes);
+
+    std::string m_name;
+    std::vector<std::size_t> m_flexible_operands;
+    std::vector<std::vector<std::uint64_t>> m_point_sample_sizes;
+    std::vector<Point> m_points;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Operand_Sweep_H_0596d40a3cce4b108a81595c50eb286d
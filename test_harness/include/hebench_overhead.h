@@ -0,0 +1,111 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Overhead_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Overhead_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <filesystem>
+#include <ostream>
+#include <string>
+
+#include "modules/general/include/nocopy.h"
+#include "modules/logging/include/logging.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Static class that accounts for the wall time Test Harness spends in
+ * each of its own phases.
+ * @details At any time, exactly one phase is current, and elapsed wall time
+ * is credited to it when the phase changes. Time is accounted per benchmark,
+ * between beginBenchmark() and endBenchmark(), and for the run as a whole
+ * outside of benchmarks. Time not spent in any named phase is credited to
+ * OtherPhaseName, so phases always add up to the wall time of the run.
+ *
+ * Phases are named by the code that runs them: benchmark initialization
+ * (data generation, ground truth, backend initialization), each stage of
+ * the category runners, validation, report writing and summary generation.
+ *
+ * Hooks are meant to be called from the main thread only and are never
+ * called inside timed loops.
+ */
+class HarnessOverhead
+{
+private:
+    IL_DECLARE_CLASS_NAME(HarnessOverhead)
+
+public:
+    static constexpr const char *OtherPhaseName          = "Other";
+    static constexpr const char *DataGenerationPhaseName = "Data generation";
+    static constexpr const char *GroundTruthPhaseName    = "Ground truth";
+    static constexpr const char *BackendInitPhaseName    = "Backend initialization";
+    static constexpr const char *ValidationPhaseName     = "Validation";
+    static constexpr const char *ReportPhaseName         = "Report writing";
+    static constexpr const char *SummaryPhaseName        = "Summary";
+    static constexpr const char *ReportFile              = "harness_overhead.csv";
+
+    /**
+     * @brief Makes a phase current during its lifetime.
+     * @details On destruction, the phase that was current on construction
+     * becomes current again, even if nested code changed the phase.
+     */
+    class Scope
+    {
+    public:
+        DISABLE_COPY(Scope)
+        DISABLE_MOVE(Scope)
+
+    public:
+        Scope(const std::string &phase_name);
+        ~Scope();
+
+    private:
+        std::string m_previous_phase_name;
+    };
+
+    /**
+     * @brief Makes the specified phase current.
+     * @param[in] phase_name Name of the new phase.
+     * @details Wall time since the last phase change is credited to the
+     * previous phase.
+     */
+    static void setPhase(const std::string &phase_name);
+    static std::string getPhase();
+    /**
+     * @brief Starts accounting time for a benchmark.
+     * @param[in] bench_path Report path of the benchmark.
+     * @details Current phase becomes OtherPhaseName.
+     */
+    static void beginBenchmark(const std::string &bench_path);
+    /**
+     * @brief Ends accounting time for the current benchmark, if any.
+     * @details Subsequent time is accounted for the run as a whole, in
+     * phase OtherPhaseName.
+     */
+    static void endBenchmark();
+    /**
+     * @brief Discards all time accounted so far.
+     */
+    static void reset();
+
+    /**
+     * @brief Saves the wall time of every phase of every benchmark, followed
+     * by the total of every phase over the run.
+     */
+    static void save2CSV(const std::filesystem::path &filename);
+    /**
+     * @brief Prints the total wall time of every phase over the run and its
+     * share of the run, largest first.
+     */
+    static std::ostream &show(std::ostream &os);
+
+private:
+    HarnessOverhead() = default;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Overhead_H_0596d40a3cce4b108a81595c50eb286d
@@ -0,0 +1,114 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Program_Config_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Program_Config_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "modules/args_parser/include/args_parser.h"
+
+#include "hebench_report_fingerprint.h"
+
+#include "hebench_ibenchmark.h"
+#include "hebench_run_modes.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Test Harness configuration from command line.
+ */
+struct ProgramConfig
+{
+    std::filesystem::path backend_lib_path;
+    std::filesystem::path config_file;
+    bool b_dump_config;
+    bool b_validate_results;
+    bool b_plaintext_baseline;
+    std::uint64_t probabilistic_validation_rounds;
+    std::uint64_t random_seed;
+    std::size_t report_delay_ms;
+    std::filesystem::path report_root_path;
+    bool b_show_run_overview;
+    bool b_cipher_mask_summary;
+    bool b_logreg_degree_summary;
+    std::string metrics_file;
+    std::string metrics_socket;
+    std::size_t metrics_interval_ms;
+    std::size_t progress_interval_ms;
+    std::vector<std::string> coordinator_workers;
+    std::filesystem::path job_history_file;
+    std::uint16_t worker_port;
+    std::string worker_bind_address;
+    std::string distributed_token; // shared by coordinator and workers
+    std::string daemon_socket;
+    bool b_record_api_calls;
+    std::size_t cold_start_samples;
+    bool b_cold_start_drop_cache;
+    std::filesystem::path cold_start_child_file;
+    std::vector<std::filesystem::path> compare_backend_lib_paths;
+    std::size_t ab_rounds;
+    std::size_t layout_samples;
+    std::string layout_child; // layout applied by a memory layout child, empty otherwise
+    std::string env_sweep_child; // knobs swept by the parent of an environment sweep child, empty otherwise
+    std::string backend_lib_hash; // hashed by the parent of a child process, empty otherwise
+    RunModes run_modes; // requested from command line
+    Report::cpp::Fingerprint fingerprint; // collected at startup
+
+    static constexpr const char *DefaultConfigFile       = "";
+    static constexpr std::uint64_t DefaultMinTestTime    = 0;
+    static constexpr std::uint64_t DefaultSampleSize     = 0;
+    static constexpr std::size_t DefaultReportDelay      = 1000;
+    static constexpr const char *DefaultRootPath         = ".";
+    static constexpr std::size_t DefaultMetricsInterval  = 1000;
+    static constexpr std::size_t DefaultProgressInterval = 5000;
+    static constexpr const char *DefaultJobHistoryFile   = "hebench_job_history.csv";
+    static constexpr const char *WorkerDirName           = "hebench_worker";
+    static constexpr const char *APICallsRecordingFile   = "api_calls.rec";
+    static constexpr const char *ColdStartReportFile     = "cold_start.csv";
+    static constexpr std::size_t DefaultABRounds         = 3;
+    static constexpr const char *ABSummaryFile           = "ab_summary.csv";
+    static constexpr const char *ABBackendsFile          = "ab_backends.csv";
+    static constexpr const char *CipherMaskSummaryFile   = "cipher_mask_summary.csv";
+    static constexpr const char *CipherMaskOperandsFile  = "cipher_mask_operands.csv";
+    static constexpr const char *LogRegDegreeSummaryFile = "logreg_degree_summary.csv";
+
+    void initializeConfig(const hebench::ArgsParser &parser);
+    static std::ostream &showBenchmarkDefaults(std::ostream &os, const IBenchmarkDescription::BenchmarkConfig &bench_config);
+    std::ostream &showConfig(std::ostream &os) const;
+    static std::ostream &showVersion(std::ostream &os);
+
+    /**
+     * @brief Command line arguments for a child Test Harness started by this
+     * one to run benchmarks in a fresh process.
+     * @param[in] child_config_file Benchmark configuration file for the child.
+     * @param[in] child_report_root_path Root path where the child saves its
+     * reports.
+     * @param[in] child_random_seed Seed used by the child when none is
+     * specified by \p child_config_file .
+     * @returns Arguments shared by all child modes. Callers append the
+     * argument that selects the child mode.
+     */
+    std::vector<std::string> getChildArgs(const std::filesystem::path &child_config_file,
+                                          const std::filesystem::path &child_report_root_path,
+                                          std::uint64_t child_random_seed) const;
+
+private:
+    static void validateBackendLibPath(const std::filesystem::path &lib_path);
+    static std::string readToken(const std::filesystem::path &token_file);
+    /**
+     * @brief Splits a comma separated list, skipping empty items.
+     */
+    static std::vector<std::string> splitList(const std::string &s);
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Program_Config_H_0596d40a3cce4b108a81595c50eb286d
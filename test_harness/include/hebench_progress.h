@@ -0,0 +1,90 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Progress_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Progress_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Static class that renders progress of long running phases to the console.
+ * @details Benchmark runners mark the beginning and end of a phase and bump
+ * an atomic counter for every step completed. A separate renderer thread
+ * draws the progress line (phase, done/total, rate and ETA) so that console
+ * output never blocks the measurement thread.
+ *
+ * When standard output is a terminal, the progress line is redrawn in place
+ * at a limited refresh rate. Otherwise, a new progress line is printed
+ * periodically, which keeps CI logs readable.
+ *
+ * If Progress is not initialized, calls to the update methods are cheap
+ * no-ops.
+ *
+ * While a phase is active, clients should not write to the console. Call
+ * endPhase() before writing.
+ */
+class Progress
+{
+public:
+    /**
+     * @brief Minimum time, in milliseconds, between redraws of the progress
+     * line on a terminal.
+     */
+    static constexpr std::size_t TerminalRefreshMs = 100;
+
+    /**
+     * @brief Initializes Progress and starts the renderer thread.
+     * @param[in] interval_ms Interval, in milliseconds, between progress lines
+     * when standard output is not a terminal. If 0, only the final line of each
+     * phase is printed in this case.
+     * @details Every call to initialize() must have a matching call to
+     * terminate(). Calling initialize() while already initialized terminates
+     * the previous session first.
+     */
+    static void initialize(std::size_t interval_ms);
+    /**
+     * @brief Ends any active phase and stops the renderer thread.
+     */
+    static void terminate();
+    static bool isInitialized();
+
+    /**
+     * @brief Starts tracking progress of a new phase.
+     * @param[in] phase Name of the phase to display.
+     * @param[in] total Total number of steps expected in the phase, or 0 if
+     * unknown. ETA is only displayed when the total is known.
+     * @details Any active phase is ended first.
+     */
+    static void beginPhase(const std::string &phase, std::uint64_t total = 0);
+    /**
+     * @brief Records completed steps in the active phase.
+     * @details This is the only method intended to be called inside measured
+     * loops. It does not allocate nor perform I/O.
+     */
+    static void advance(std::uint64_t count = 1);
+    /**
+     * @brief Ends the active phase, if any, and prints its final progress line.
+     * @details Output is synchronized with the renderer thread, so clients can
+     * write to the console safely after this method returns.
+     */
+    static void endPhase();
+
+private:
+    class Renderer;
+
+    // accessed through std::atomic_* shared_ptr overloads; null when not initialized
+    static std::shared_ptr<Renderer> m_p_renderer;
+
+    Progress() = default;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Progress_H_0596d40a3cce4b108a81595c50eb286d
@@ -0,0 +1,94 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Run_Arena_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Run_Arena_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "modules/general/include/nocopy.h"
+#include "modules/logging/include/logging.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Memory arena scoped to a benchmark run.
+ * @details Small, short-lived allocations performed by the harness during a
+ * benchmark run (data pack descriptors, handle collections, per-result
+ * validation structures, etc.) are served from a pool on top of a monotonic
+ * buffer. Freed blocks are recycled by the pool during the run, and all the
+ * memory is returned to the system in one shot when the arena is destroyed.
+ * This keeps the harness from fragmenting the heap shared with the backend.
+ *
+ * Every PartialBenchmark owns an arena and passes it explicitly to the objects
+ * that allocate from it, such as its data loader. Objects allocated from an
+ * arena that may outlive the benchmark must hold a reference to the arena
+ * (a `RunArena::Ptr`) to keep it alive.
+ *
+ * Large payload buffers should not be allocated from the arena since they
+ * bypass the pool and would be retained until the arena is destroyed.
+ *
+ * RunArena is not thread-safe.
+ */
+class RunArena
+{
+public:
+    DISABLE_COPY(RunArena)
+    DISABLE_MOVE(RunArena)
+private:
+    IL_DECLARE_CLASS_NAME(RunArena)
+
+public:
+    typedef std::shared_ptr<RunArena> Ptr;
+
+    template <typename T>
+    using allocator = std::pmr::polymorphic_allocator<T>;
+    template <typename T>
+    using vector = std::pmr::vector<T>;
+
+    /**
+     * @brief Size, in bytes, of the first chunk reserved by a new arena.
+     */
+    static constexpr std::size_t DefaultInitialSize = 64 * 1024;
+
+    static Ptr create(std::size_t initial_size = DefaultInitialSize);
+
+    ~RunArena();
+
+    std::pmr::memory_resource *resource() { return &m_pool; }
+    /**
+     * @brief Total bytes reserved by this arena from the system.
+     */
+    std::uint64_t getBytesReserved() const { return m_upstream.bytes_reserved; }
+
+private:
+    /**
+     * @brief Forwards to the default resource and keeps track of the memory reserved.
+     */
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::uint64_t bytes_reserved = 0;
+
+    protected:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+    };
+
+    RunArena(std::size_t initial_size);
+
+    CountingResource m_upstream;
+    std::pmr::monotonic_buffer_resource m_monotonic;
+    std::pmr::unsynchronized_pool_resource m_pool;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Run_Arena_H_0596d40a3cce4b108a81595c50eb286d
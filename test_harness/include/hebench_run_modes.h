@@ -0,0 +1,89 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Run_Modes_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Run_Modes_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "modules/logging/include/logging.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Set of run modes requested for Test Harness.
+ * @details Modes are requested through command line arguments or the
+ * benchmark configuration file. Rules for combining modes are kept in a
+ * single table: every pair of modes is mutually exclusive unless the table
+ * lists it as compatible. The table is validated at compile time to cover
+ * every mode, in order, with symmetric compatibility.
+ *
+ * When no exclusive mode is enabled, Test Harness runs the benchmarks
+ * requested locally.
+ */
+class RunModes
+{
+private:
+    IL_DECLARE_CLASS_NAME(RunModes)
+
+public:
+    enum class Mode : std::uint32_t
+    {
+        DumpConfig,
+        Worker,
+        Coordinator,
+        Daemon,
+        ColdStart,
+        ColdStartChild,
+        ABComparison,
+        LayoutRandomization,
+        LayoutChild,
+        EnvSweep,
+        EnvSweepChild,
+        SLOSearch,
+        OperandSweep,
+        Count // number of modes; not a mode
+    };
+
+    /**
+     * @brief Function that runs a mode.
+     */
+    typedef std::function<void()> Handler;
+
+    RunModes() :
+        m_enabled(0) {}
+
+    /**
+     * @brief Enables a mode.
+     * @throws std::runtime_error if \p mode cannot be combined with a mode
+     * already enabled.
+     */
+    void enable(Mode mode);
+    bool isEnabled(Mode mode) const;
+    /**
+     * @brief Name of the mode used in messages, in lower case.
+     */
+    static const char *getName(Mode mode);
+
+    /**
+     * @brief Runs the handler of the enabled mode.
+     * @param[in] handlers Handler for each mode that this call dispatches.
+     * @param[in] default_handler Called when none of the modes in \p handlers
+     * is enabled.
+     * @throws std::logic_error if more than one mode in \p handlers is enabled.
+     */
+    void dispatch(const std::vector<std::pair<Mode, Handler>> &handlers,
+                  const Handler &default_handler) const;
+
+private:
+    std::uint32_t m_enabled; // bit per mode
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Run_Modes_H_0596d40a3cce4b108a81595c50eb286d
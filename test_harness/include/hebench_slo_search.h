@@ -0,0 +1,164 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_SLO_Search_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_SLO_Search_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "modules/logging/include/logging.h"
+
+#include "hebench_report_cpp.h"
+
+#include "hebench_engine.h"
+#include "hebench_ibenchmark.h"
+#include "hebench_program_config.h"
+#include "hebench_types_harness.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Searches the largest value of a workload parameter for which a
+ * quantile of the operation latency stays under a bound (the SLO).
+ * @details Each probe runs the Latency benchmark with the parameter at a
+ * candidate value, timing enough operations to bound the quantile with the
+ * requested confidence. A probe is feasible when the upper confidence bound of
+ * the quantile is under the bound; probes that fail to run are infeasible.
+ *
+ * The parameter grows exponentially, in 1, 2, 4, ... increments from its
+ * initial value, until a probe is infeasible or the largest value requested
+ * is reached. Then, binary search between the last feasible and the first
+ * infeasible probes finds the largest feasible value, assuming latency does
+ * not decrease as the parameter grows.
+ */
+class SLOCapacitySearch
+{
+private:
+    IL_DECLARE_CLASS_NAME(SLOCapacitySearch)
+
+public:
+    static constexpr const char *ProbesDirName = "slo_search";
+    static constexpr const char *SummaryFile   = "slo_search_summary.csv";
+    static constexpr const char *ProbesFile    = "slo_search_probes.csv";
+
+    struct LatencyStats
+    {
+        std::uint64_t samples;
+        double quantile_ms; // point estimate
+        double upper_bound_ms; // upper confidence bound of the quantile: infinity if too few samples
+    };
+
+    struct Probe
+    {
+        std::uint64_t step_count; // increments from the initial value
+        std::string value;
+        LatencyStats stats;
+        bool b_feasible;
+        std::string message; // reason why the probe failed to run, if it did
+    };
+
+    /**
+     * @param[in] name Name of the search in the reports.
+     * @param[in] w_params Workload parameters of the benchmark, with the
+     * searched parameter at its initial value.
+     * @param[in] request Search requested.
+     * @throws std::invalid_argument if the searched parameter is not an integer
+     * parameter in \p w_params.
+     */
+    SLOCapacitySearch(const std::string &name,
+                      const std::vector<hebench::APIBridge::WorkloadParam> &w_params,
+                      const SLOSearchRequest &request);
+
+    /**
+     * @brief Smallest number of samples for which the upper confidence bound
+     * of a quantile exists.
+     */
+    static std::uint64_t computeMinSamples(double quantile, double confidence);
+    /**
+     * @brief Computes the quantile of the latencies and its distribution-free
+     * upper confidence bound, based on order statistics.
+     * @param[in] latencies_ms Latency samples in milliseconds.
+     */
+    static LatencyStats computeLatencyStats(std::vector<double> latencies_ms, double quantile, double confidence);
+    /**
+     * @brief Extracts the latency of every main event in a report.
+     */
+    static std::vector<double> getLatencies(const hebench::TestHarness::Report::cpp::TimingReport &report);
+    static bool isLatencyBenchmark(const IBenchmarkDescription::Description &description);
+
+    const std::string &getName() const { return m_name; }
+    const SLOSearchRequest &getRequest() const { return m_request; }
+    /**
+     * @brief Number of operations to time per probe.
+     */
+    std::uint64_t getSamplesPerProbe() const;
+
+    bool isDone() const { return m_b_done; }
+    /**
+     * @brief Workload parameters for the next probe.
+     * @throws std::logic_error if search is done.
+     */
+    std::vector<hebench::APIBridge::WorkloadParam> getNextParams() const;
+    void addProbe(const LatencyStats &stats);
+    void addFailedProbe(const std::string &message);
+
+    const std::vector<Probe> &getProbes() const { return m_probes; }
+    /**
+     * @brief Largest feasible probe, or null if none was feasible.
+     */
+    const Probe *getMaxFeasible() const;
+    /**
+     * @brief Smallest infeasible probe, or null if none was infeasible.
+     */
+    const Probe *getMinInfeasible() const;
+
+    static void save2CSV(const std::filesystem::path &summary_filename,
+                         const std::filesystem::path &probes_filename,
+                         const std::vector<SLOCapacitySearch> &searches);
+    static std::ostream &show(std::ostream &os, const std::vector<SLOCapacitySearch> &searches);
+
+    /**
+     * @brief Moves the capacity search requests out of the benchmarks to run.
+     * @returns The capacity search requests.
+     */
+    static std::vector<BenchmarkRequest> extract(std::vector<BenchmarkRequest> &benchmarks_to_run);
+    /**
+     * @brief Runs the probes of every capacity search requested and saves the
+     * result of the searches.
+     * @details Every probe has its own report and summary under ProbesDirName
+     * in the report root path.
+     * @returns Names of the searches where no probe ran.
+     * @throws std::runtime_error if a search is requested on a benchmark that
+     * is not a Latency benchmark.
+     */
+    static std::vector<std::string> run(Engine &engine,
+                                        const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                        const std::vector<BenchmarkRequest> &slo_searches,
+                                        const ProgramConfig &config);
+
+private:
+    std::string getValue(std::uint64_t step_count) const;
+    void completeProbe(Probe &probe);
+
+    std::string m_name;
+    std::vector<hebench::APIBridge::WorkloadParam> m_w_params;
+    SLOSearchRequest m_request;
+    std::vector<Probe> m_probes;
+    std::uint64_t m_next_step_count;
+    std::uint64_t m_feasible_step_count; // largest feasible so far
+    std::uint64_t m_infeasible_step_count; // smallest infeasible so far
+    bool m_b_feasible_found;
+    bool m_b_infeasible_found;
+    bool m_b_done;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_SLO_Search_H_0596d40a3cce4b108a81595c50eb286d
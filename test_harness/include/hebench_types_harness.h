@@ -34,6 +34,75 @@ constexpr const char *FileNameNoExtReport  = "report";
 constexpr const char *FileNameNoExtSummary = "summary";
 
 typedef std::vector<std::vector<hebench::APIBridge::WorkloadParam>> WorkloadArgumentsSets;
+/**
+ * @brief Specifies a search for the largest value of a workload parameter for
+ * which a quantile of the operation latency stays under a bound.
+ * @details Search is requested when `quantile` is positive. The parameter grows
+ * from its value in the set of arguments, in increments of `step`.
+ */
+struct SLOSearchRequest
+{
+    /**
+     * @brief Index of the workload parameter to grow. Must be an integer parameter.
+     */
+    std::size_t param_index = 0;
+    /**
+     * @brief Increment between consecutive values of the parameter.
+     */
+    std::uint64_t step = 1;
+    /**
+     * @brief Largest number of increments to grow the parameter.
+     */
+    std::uint64_t max_steps = 0;
+    /**
+     * @brief Quantile of the operation latency constrained, in range (0, 1).
+     */
+    double quantile = 0.0;
+    /**
+     * @brief Bound for the quantile of the operation latency, in milliseconds.
+     */
+    double max_latency_ms = 0.0;
+    /**
+     * @brief Confidence level required for the quantile to be under the bound.
+     */
+    double confidence = 0.95;
+    /**
+     * @brief Minimum number of operations timed per probe. If 0, the smallest
+     * number required to bound the quantile with the requested confidence is used.
+     */
+    std::uint64_t min_samples = 0;
+};
+/**
+ * @brief Specifies an analysis of the cost of each operand of an Offline
+ * benchmark, where the sample size of one operand varies at a time.
+ * @details Analysis is requested when `sample_sizes` is not empty.
+ */
+struct OperandSweepRequest
+{
+    /**
+     * @brief Sample sizes to run for every operand whose sample size is chosen
+     * by Test Harness, while the other operands are held at their default sample size.
+     */
+    std::vector<std::uint64_t> sample_sizes;
+};
+/**
+ * @brief Runtime environment knob swept across child Test Harness processes.
+ * @details Every combination of the values of all knobs requested runs in its
+ * own child process.
+ */
+struct EnvKnob
+{
+    /**
+     * @brief Transparent huge pages (EnvSweep::KnobTHP), preloaded libraries
+     * (EnvSweep::KnobPreload) or name of an environment variable.
+     */
+    std::string name;
+    /**
+     * @brief Values to sweep. An empty value unsets the environment variable
+     * or preloads no library.
+     */
+    std::vector<std::string> values;
+};
 /**
  * @brief Specifies the index of the benchmark as registered by backend and all
  * the workload parameters requested to benchmark.
@@ -51,6 +120,16 @@ struct BenchmarkRequest
      * - `sets_w_params[i][j]` is argument for workload parameter `j` in set `i`
      */
     std::vector<std::vector<hebench::APIBridge::WorkloadParam>> sets_w_params;
+    /**
+     * @brief Capacity search to perform on every set of arguments instead of a
+     * single run, if requested.
+     */
+    SLOSearchRequest slo_search;
+    /**
+     * @brief Operand cost analysis to perform on every set of arguments instead
+     * of a single run, if requested.
+     */
+    OperandSweepRequest operand_sweep;
 };
 
 } // namespace TestHarness
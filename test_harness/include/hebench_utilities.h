@@ -45,6 +45,12 @@ void writeToFile(const std::string &filename, std::function<void(std::ostream &)
 void writeToFile(const std::string &filename,
                  const char *p_data, std::size_t size,
                  bool b_binary, bool b_append = false);
+/**
+ * @brief Retrieves the current resident set size of this process.
+ * @return Resident memory in bytes, or 0 if it cannot be determined on this
+ * platform.
+ */
+std::uint64_t getResidentMemoryBytes();
 
 /**
  * @brief Writes the collection of `NativeDataBuffer` as columns to the specified
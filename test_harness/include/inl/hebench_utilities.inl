@@ -81,6 +81,9 @@ TimingReportEx::convert2C(const hebench::Common::TimingReportEvent &timing_event
     retval.wall_time_start         = timing_event.timeStartWall<TimeInterval>();
     retval.wall_time_end           = timing_event.timeEndWall<TimeInterval>();
     retval.iterations              = timing_event.iterations();
+    retval.span_id                 = timing_event.span_id;
+    retval.parent_span_id          = timing_event.parent_span_id;
+    retval.depth                   = timing_event.depth;
     copyString(retval.description, MAX_TIME_REPORT_EVENT_DESCRIPTION_SIZE, timing_event.description);
 
     return retval;
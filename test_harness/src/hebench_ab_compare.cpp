@@ -0,0 +1,372 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "dynamic_lib_load.h"
+
+#include "include/hebench_ab_compare.h"
+#include "include/hebench_benchmark_runner.h"
+#include "include/hebench_config.h"
+#include "include/hebench_fingerprint.h"
+#include "include/hebench_live_metrics.h"
+#include "include/hebench_utilities.h"
+
+namespace hebench {
+namespace TestHarness {
+
+ABComparison::Backend::Backend(const std::string &_label, const std::filesystem::path &_lib_path,
+                               hebench::APIBridge::DynamicLib *_p_lib, Engine::Ptr _p_engine,
+                               const Report::cpp::Fingerprint &machine_fingerprint) :
+    label(_label), lib_path(_lib_path), p_lib(_p_lib), p_engine(_p_engine), fingerprint(machine_fingerprint)
+{
+    FingerprintCollector::addBackend(fingerprint, lib_path);
+}
+
+ABComparison::Backend::~Backend()
+{
+    // engine handles must be destroyed by the library that created them
+    try
+    {
+        if (p_engine)
+        {
+            hebench::APIBridge::DynamicLibLoad::ActiveLibraryScope lib_scope(p_lib);
+            p_engine.reset();
+        } // end if
+    }
+    catch (...)
+    {
+        // library already unloaded
+    }
+}
+
+std::filesystem::path ABComparison::Backend::getRoundRootPath(const ProgramConfig &config, std::size_t round_i) const
+{
+    return config.report_root_path / label / ("round_" + std::to_string(round_i));
+}
+
+ABComparison::ABComparison(const std::vector<std::string> &backend_labels) :
+    m_backend_labels(backend_labels)
+{
+    if (m_backend_labels.size() < 2)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("At least two backends are required for comparison."));
+}
+
+void ABComparison::addSample(const std::string &bench_path, std::size_t backend_i, std::size_t round_i, double wall_time_s)
+{
+    if (backend_i >= m_backend_labels.size())
+        throw std::out_of_range(IL_LOG_MSG_CLASS("Invalid backend index."));
+    auto it = m_samples.find(bench_path);
+    if (it == m_samples.end())
+    {
+        it = m_samples.emplace(bench_path, std::vector<RoundSamples>(m_backend_labels.size())).first;
+        m_bench_paths.push_back(bench_path);
+    } // end if
+    it->second[backend_i][round_i] = wall_time_s;
+}
+
+double ABComparison::tCritical95(std::size_t degrees_of_freedom)
+{
+    static const double t_table[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                      2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                      2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+    constexpr std::size_t TableSize = sizeof(t_table) / sizeof(t_table[0]);
+    if (degrees_of_freedom <= 0)
+        return 0.0;
+    // normal approximation for large samples
+    return degrees_of_freedom <= TableSize ? t_table[degrees_of_freedom - 1] : 1.96;
+}
+
+ABComparison::PairedStats ABComparison::compare(const std::string &bench_path, std::size_t backend_i) const
+{
+    PairedStats retval = {};
+    auto it            = m_samples.find(bench_path);
+    if (it == m_samples.end() || backend_i >= m_backend_labels.size())
+        return retval;
+
+    const RoundSamples &baseline  = it->second[BaselineIndex];
+    const RoundSamples &candidate = it->second[backend_i];
+    std::vector<double> diffs;
+    for (const auto &baseline_sample : baseline)
+    {
+        auto candidate_it = candidate.find(baseline_sample.first);
+        if (candidate_it != candidate.end())
+        {
+            retval.baseline_mean_s += baseline_sample.second;
+            retval.candidate_mean_s += candidate_it->second;
+            diffs.push_back(candidate_it->second - baseline_sample.second);
+        } // end if
+    } // end for
+
+    retval.rounds = diffs.size();
+    if (retval.rounds > 0)
+    {
+        retval.baseline_mean_s /= retval.rounds;
+        retval.candidate_mean_s /= retval.rounds;
+        for (double diff : diffs)
+            retval.diff_mean_s += diff;
+        retval.diff_mean_s /= retval.rounds;
+        if (retval.rounds > 1)
+        {
+            double variance = 0.0;
+            for (double diff : diffs)
+                variance += (diff - retval.diff_mean_s) * (diff - retval.diff_mean_s);
+            variance /= retval.rounds - 1;
+            retval.diff_stddev_s = std::sqrt(variance);
+            retval.diff_ci95_s   = tCritical95(retval.rounds - 1) * retval.diff_stddev_s / std::sqrt(static_cast<double>(retval.rounds));
+        } // end if
+        if (retval.baseline_mean_s != 0.0)
+            retval.diff_relative = retval.diff_mean_s / retval.baseline_mean_s;
+    } // end if
+
+    return retval;
+}
+
+void ABComparison::save2CSV(const std::filesystem::path &filename) const
+{
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + filename.string()));
+
+    fnum << std::setprecision(9)
+         << "Benchmark,Baseline,Candidate,Rounds,Baseline mean (s),Candidate mean (s),"
+         << "Difference mean (s),Difference std dev (s),Difference 95% CI low (s),Difference 95% CI high (s),"
+         << "Relative difference (%),Significant" << std::endl;
+    for (const std::string &bench_path : m_bench_paths)
+    {
+        for (std::size_t backend_i = BaselineIndex + 1; backend_i < m_backend_labels.size(); ++backend_i)
+        {
+            PairedStats stats = compare(bench_path, backend_i);
+            fnum << "\"" << bench_path << "\"," << m_backend_labels[BaselineIndex] << ","
+                 << m_backend_labels[backend_i] << "," << stats.rounds << ",";
+            if (stats.rounds > 0)
+            {
+                // significant when the confidence interval excludes 0
+                bool b_significant = stats.rounds > 1 && std::abs(stats.diff_mean_s) > stats.diff_ci95_s;
+                fnum << stats.baseline_mean_s << "," << stats.candidate_mean_s << ","
+                     << stats.diff_mean_s << "," << stats.diff_stddev_s << ","
+                     << stats.diff_mean_s - stats.diff_ci95_s << "," << stats.diff_mean_s + stats.diff_ci95_s << ","
+                     << stats.diff_relative * 100.0 << "," << (b_significant ? "Yes" : "No");
+            } // end if
+            else
+                fnum << ",,,,,,,";
+            fnum << std::endl;
+        } // end for
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing A/B comparison: " + filename.string()));
+}
+
+std::ostream &ABComparison::show(std::ostream &os) const
+{
+    for (std::size_t bench_i = 0; bench_i < m_bench_paths.size(); ++bench_i)
+    {
+        os << bench_i + 1 << ". " << m_bench_paths[bench_i] << std::endl;
+        for (std::size_t backend_i = BaselineIndex + 1; backend_i < m_backend_labels.size(); ++backend_i)
+        {
+            PairedStats stats = compare(m_bench_paths[bench_i], backend_i);
+            os << "    " << m_backend_labels[backend_i] << " vs " << m_backend_labels[BaselineIndex] << ": ";
+            if (stats.rounds <= 0)
+                os << "no successful paired rounds" << std::endl;
+            else
+            {
+                os << std::showpos << std::fixed << std::setprecision(2) << stats.diff_relative * 100.0 << "%";
+                if (stats.rounds > 1 && stats.baseline_mean_s != 0.0)
+                    os << " +/- " << std::noshowpos << stats.diff_ci95_s * 100.0 / stats.baseline_mean_s << "% (95% CI)";
+                os << std::noshowpos << std::defaultfloat << " over " << stats.rounds << " rounds" << std::endl;
+            } // end else
+        } // end for
+    } // end for
+    return os;
+}
+
+std::vector<ABComparison::Backend> ABComparison::loadBackends(const ProgramConfig &config,
+                                                              hebench::APIBridge::DynamicLib *p_baseline_lib,
+                                                              Engine::Ptr p_baseline_engine,
+                                                              const Report::cpp::Fingerprint &machine_fingerprint)
+{
+    std::vector<Backend> retval;
+    std::stringstream ss;
+
+    retval.reserve(config.compare_backend_lib_paths.size() + 1);
+    retval.emplace_back("backend_0", config.backend_lib_path, p_baseline_lib, p_baseline_engine, machine_fingerprint);
+    for (const std::filesystem::path &lib_path : config.compare_backend_lib_paths)
+    {
+        ss = std::stringstream();
+        ss << "Initializing compared Backend from shared library:" << std::endl
+           << lib_path;
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+        hebench::APIBridge::DynamicLib *p_lib = hebench::APIBridge::DynamicLibLoad::loadLibrary(lib_path);
+        hebench::APIBridge::DynamicLibLoad::setActiveLibrary(p_baseline_lib);
+        Engine::Ptr p_engine;
+        {
+            hebench::APIBridge::DynamicLibLoad::ActiveLibraryScope lib_scope(p_lib);
+            p_engine = Engine::create();
+        }
+        retval.emplace_back("backend_" + std::to_string(retval.size()), lib_path, p_lib, p_engine,
+                            machine_fingerprint);
+        std::cout << IOS_MSG_OK << std::endl;
+    } // end for
+
+    return retval;
+}
+
+std::vector<std::string> ABComparison::run(std::vector<Backend> &backends,
+                                           const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                           const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                                           const ProgramConfig &config)
+{
+    std::vector<std::string> retval;
+    std::stringstream ss;
+
+    std::vector<std::string> labels;
+    for (const Backend &backend : backends)
+        labels.push_back(backend.label);
+    ABComparison comparison(labels);
+
+    // backends run in a different order every round, reproducible from the seed
+    std::mt19937_64 rand_order(bench_config.random_seed);
+    std::vector<std::size_t> backend_order(backends.size());
+    std::iota(backend_order.begin(), backend_order.end(), 0);
+
+    std::size_t total_runs = hebench::Utilities::BenchmarkConfiguration::countBenchmarks2Run(benchmarks_to_run)
+                             * config.ab_rounds * backends.size();
+    std::size_t run_i = 0;
+    std::vector<BenchmarkRequest> benchmarks_compared;
+    for (std::size_t bench_i = 0; bench_i < benchmarks_to_run.size(); ++bench_i)
+    {
+        for (std::size_t params_i = 0; params_i < benchmarks_to_run[bench_i].sets_w_params.size(); ++params_i)
+        {
+            BenchmarkRequest bench_request;
+            bench_request.benchmark_index = benchmarks_to_run[bench_i].benchmark_index;
+            bench_request.sets_w_params.push_back(benchmarks_to_run[bench_i].sets_w_params[params_i]);
+
+            // benchmarks not offered by every backend cannot be compared
+            auto describe = [&bench_config, &bench_request](const Backend &backend) -> std::string {
+                hebench::APIBridge::DynamicLibLoad::ActiveLibraryScope lib_scope(backend.p_lib);
+                return backend.p_engine->describeBenchmark(bench_config, bench_request.benchmark_index, bench_request.sets_w_params.front())
+                    ->description.path;
+            };
+            std::string bench_path = describe(backends[BaselineIndex]);
+            std::string mismatch;
+            for (std::size_t backend_i = 0; mismatch.empty() && backend_i < backends.size(); ++backend_i)
+            {
+                if (backend_i == BaselineIndex)
+                    continue;
+                try
+                {
+                    if (describe(backends[backend_i]) != bench_path)
+                        mismatch = "Backend \"" + backends[backend_i].lib_path.string() + "\" does not offer the same benchmark as the baseline.";
+                }
+                catch (std::exception &ex)
+                {
+                    mismatch = "Backend \"" + backends[backend_i].lib_path.string() + "\" failed to describe the benchmark: " + ex.what();
+                }
+                if (!mismatch.empty())
+                    retval.push_back(backends[backend_i].label + ": " + bench_path);
+            } // end for
+            if (!mismatch.empty())
+            {
+                // skip the benchmark and compare the rest
+                std::cout << std::endl
+                          << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("Skipping A/B comparison of " + bench_path + ":\n" + mismatch) << std::endl;
+                run_i += config.ab_rounds * backends.size();
+                continue;
+            } // end if
+            benchmarks_compared.push_back(bench_request);
+
+            for (std::size_t round_i = 0; round_i < config.ab_rounds; ++round_i)
+            {
+                std::shuffle(backend_order.begin(), backend_order.end(), rand_order);
+                for (std::size_t backend_i : backend_order)
+                {
+                    const Backend &backend                = backends[backend_i];
+                    std::filesystem::path round_root_path = backend.getRoundRootPath(config, round_i);
+
+                    ss = std::stringstream();
+                    ss << "A/B run " << run_i + 1 << "/" << total_runs << ": " << backend.label
+                       << ", round " << round_i << std::endl
+                       << bench_path;
+                    std::cout << std::endl
+                              << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+                    hebench::APIBridge::DynamicLibLoad::ActiveLibraryScope lib_scope(backend.p_lib);
+                    // same input data for every backend and round
+                    hebench::Utilities::RandomGenerator::setRandomSeed(bench_config.random_seed);
+                    // reports identify the backend that produced them
+                    ProgramConfig backend_config = config;
+                    backend_config.fingerprint   = backend.fingerprint;
+                    std::vector<std::string> run_failed;
+                    BenchmarkRunner::run(*backend.p_engine, bench_config, { bench_request }, backend_config, round_root_path, run_failed);
+                    ++run_i;
+
+                    if (!run_failed.empty())
+                    {
+                        retval.push_back(backend.label + ", round " + std::to_string(round_i) + ": " + bench_path);
+                        continue;
+                    } // end if
+
+                    Report::cpp::TimingReport report =
+                        Report::cpp::TimingReport::loadReportFromCSVFile(BenchmarkRunner::getReportFilename(round_root_path, bench_path));
+                    if (report.getEventCount() > 0)
+                    {
+                        // average wall time of the main event
+                        Report::TimingReportEventC tre;
+                        std::stringstream summary_csv;
+                        report.generateSummaryCSV(tre, summary_csv);
+                        comparison.addSample(bench_path, backend_i, round_i,
+                                             (tre.wall_time_end - tre.wall_time_start) * tre.time_interval_ratio_num / tre.time_interval_ratio_den);
+                    } // end if
+                } // end for
+            } // end for
+        } // end for
+    } // end for
+
+    // summaries for every backend and round
+    LiveMetrics::setPhase("Summary");
+    for (const Backend &backend : backends)
+    {
+        hebench::APIBridge::DynamicLibLoad::ActiveLibraryScope lib_scope(backend.p_lib);
+        for (std::size_t round_i = 0; round_i < config.ab_rounds; ++round_i)
+            BenchmarkRunner::generateSummary(*backend.p_engine, bench_config, benchmarks_compared,
+                                             backend.getRoundRootPath(config, round_i), false);
+    } // end for
+
+    hebench::Utilities::writeToFile(
+        config.report_root_path / ProgramConfig::ABBackendsFile,
+        [&backends](std::ostream &os) -> void {
+            os << "Backend,Library" << std::endl;
+            for (const Backend &backend : backends)
+                os << backend.label << ",\"" << backend.lib_path.string() << "\"" << std::endl;
+        },
+        false, false);
+    comparison.save2CSV(config.report_root_path / ProgramConfig::ABSummaryFile);
+
+    if (config.b_show_run_overview)
+    {
+        ss = std::stringstream();
+        ss << "A/B comparison (wall time relative to " << backends.front().label << "):" << std::endl
+           << std::endl;
+        comparison.show(ss);
+        std::cout << std::endl
+                  << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    } // end if
+    ss = std::stringstream();
+    ss << "A/B comparison saved to: " << std::endl
+       << config.report_root_path / ProgramConfig::ABSummaryFile;
+    std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+    return retval;
+}
+
+} // namespace TestHarness
+} // namespace hebench
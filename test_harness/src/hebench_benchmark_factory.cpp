@@ -10,6 +10,7 @@
 #include "hebench/api_bridge/api.h"
 
 #include "include/hebench_benchmark_factory.h"
+#include "include/hebench_overhead.h"
 
 namespace hebench {
 namespace TestHarness {
@@ -38,8 +39,14 @@ IBenchmark::Ptr BenchmarkFactory::createBenchmark(std::shared_ptr<Engine> p_engi
     {
         // perform initialization of the benchmark
         const PartialBenchmark::FriendPrivateKey key;
-        p_retval->init(p_token->description);
-        p_retval->initBackend(out_report, key);
+        {
+            HarnessOverhead::Scope overhead_scope(HarnessOverhead::DataGenerationPhaseName);
+            p_retval->init(p_token->description);
+        }
+        {
+            HarnessOverhead::Scope overhead_scope(HarnessOverhead::BackendInitPhaseName);
+            p_retval->initBackend(out_report, key);
+        }
         p_retval->postInit();
         p_retval->checkInitializationState(key);
     }
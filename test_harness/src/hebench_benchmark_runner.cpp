@@ -0,0 +1,572 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "modules/general/include/error.h"
+
+#include "dynamic_lib_load.h"
+
+#include "include/hebench_benchmark_runner.h"
+#include "include/hebench_cipher_mask_analysis.h"
+#include "include/hebench_distributed.h"
+#include "include/hebench_live_metrics.h"
+#include "include/hebench_logreg_degree_analysis.h"
+#include "include/hebench_overhead.h"
+#include "include/hebench_progress.h"
+#include "include/hebench_utilities.h"
+
+namespace hebench {
+namespace TestHarness {
+
+std::filesystem::path BenchmarkRunner::getReportPath(const std::filesystem::path &report_root_path,
+                                                     const std::string &bench_path)
+{
+    std::filesystem::path report_path = bench_path;
+    return report_path.is_absolute() ? report_path : report_root_path / report_path;
+}
+
+std::filesystem::path BenchmarkRunner::getReportFilename(const std::filesystem::path &report_root_path,
+                                                         const std::string &bench_path)
+{
+    std::filesystem::path retval = getReportPath(report_root_path, bench_path);
+    retval /= FileNameNoExtReport;
+    retval += ".csv";
+    return retval;
+}
+
+std::vector<BenchmarkRequest> BenchmarkRunner::loadConfiguration(const hebench::Utilities::BenchmarkConfiguration &bench_configuration,
+                                                                 const std::filesystem::path &config_file,
+                                                                 IBenchmarkDescription::BenchmarkConfig &bench_config)
+{
+    std::vector<BenchmarkRequest> retval = config_file.empty() ?
+                                               bench_configuration.getDefaultConfiguration() :
+                                               bench_configuration.loadConfiguration(config_file, bench_config);
+    hebench::Utilities::RandomGenerator::setRandomSeed(bench_config.random_seed);
+    return retval;
+}
+
+std::string BenchmarkRunner::toDoubleVariableFrac(double x, int up_to_digits_after_dot)
+{
+    std::string retval;
+    std::stringstream ss;
+    if (up_to_digits_after_dot < 0)
+        up_to_digits_after_dot = 0;
+    ss << std::fixed << std::setprecision(up_to_digits_after_dot) << x;
+    retval = ss.str();
+    retval.erase(retval.find_last_not_of(".0") + 1);
+    return retval;
+}
+
+void BenchmarkRunner::generateSummary(const Engine &engine,
+                                      const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                      const std::vector<BenchmarkRequest> &benchmarks_ran,
+                                      const std::filesystem::path &input_root_path,
+                                      const std::filesystem::path &output_root_path,
+                                      bool do_stdout_summary)
+{
+    constexpr int ScreenColSize  = 80;
+    constexpr int AveWallColSize = ScreenColSize / 8;
+    constexpr int AveCPUColSize  = ScreenColSize / 8;
+    //constexpr int BenchNameColSize = ScreenColSize * 9 / 16;
+    constexpr int BenchNameColSize = ScreenColSize - AveWallColSize - AveCPUColSize - 15;
+
+    HarnessOverhead::Scope overhead_scope(HarnessOverhead::SummaryPhaseName);
+    std::stringstream ss;
+
+    if (do_stdout_summary)
+    {
+        std::cout << " " << std::setfill(' ') << std::setw(BenchNameColSize) << std::left << std::string("Benchmark").substr(0, BenchNameColSize) << " | "
+                  << std::setw(AveWallColSize + 3) << std::right << std::string("Ave Wall time").substr(0, AveWallColSize + 3) << " | "
+                  << std::setw(AveWallColSize + 3) << std::right << std::string("Ave CPU time").substr(0, AveCPUColSize + 3) << std::endl;
+        std::cout << std::setfill('=') << std::setw(ScreenColSize) << std::left << "=" << std::endl;
+    } // end if
+
+    // reports summarized together are expected to share the same fingerprint
+    Report::cpp::Fingerprint reference_fingerprint;
+    std::filesystem::path reference_filename;
+    std::vector<std::string> fingerprint_warnings;
+
+    std::size_t bench_total = 0;
+    for (std::size_t bench_i = 0; bench_i < benchmarks_ran.size(); ++bench_i)
+    {
+        for (std::size_t params_i = 0; params_i < benchmarks_ran[bench_i].sets_w_params.size(); ++params_i)
+        {
+            BenchmarkFactory::BenchmarkToken::Ptr description_token =
+                engine.describeBenchmark(bench_config,
+                                         benchmarks_ran[bench_i].benchmark_index,
+                                         benchmarks_ran[bench_i].sets_w_params[params_i]);
+
+            // retrieve the correct input and output paths
+            std::filesystem::path report_filename = description_token->description.path;
+            std::filesystem::path report_path     = getReportFilename(input_root_path, description_token->description.path);
+            std::filesystem::path output_path     = getReportPath(output_root_path, description_token->description.path);
+
+            // generate output directory if it doesn't exits
+            std::filesystem::create_directories(output_path);
+            output_path /= FileNameNoExtSummary;
+            output_path += ".csv";
+
+            if (do_stdout_summary)
+            {
+                ss = std::stringstream();
+                ss << (bench_total + 1) << ". " << report_filename.generic_string();
+                std::cout << " " << std::setfill(' ') << std::setw(BenchNameColSize) << std::left << ss.str().substr(0, BenchNameColSize) << " | ";
+            } // end if
+
+            try
+            {
+                // load input report
+                Report::cpp::TimingReport report =
+                    Report::cpp::TimingReport::loadReportFromCSVFile(report_path);
+                Report::cpp::Fingerprint fingerprint =
+                    Report::cpp::Fingerprint::fromHeader(report.getHeader());
+                if (reference_fingerprint.empty())
+                {
+                    reference_fingerprint = fingerprint;
+                    reference_filename    = report_filename;
+                } // end if
+                else
+                {
+                    std::vector<Report::cpp::Fingerprint::Difference> diffs =
+                        Report::cpp::Fingerprint::compare(reference_fingerprint, fingerprint);
+                    if (!diffs.empty())
+                    {
+                        bool b_incompatible = std::any_of(diffs.begin(), diffs.end(),
+                                                          &Report::cpp::Fingerprint::isIncompatible);
+                        ss = std::stringstream();
+                        ss << (b_incompatible ? "Reports are not comparable: " : "Reports from different builds or environments: ")
+                           << report_filename.generic_string() << " vs " << reference_filename.generic_string() << std::endl
+                           << Report::cpp::Fingerprint::toString(diffs);
+                        fingerprint_warnings.push_back(ss.str());
+                    } // end if
+                } // end else
+                // generate summary
+                if (report.getEventCount() > 0)
+                {
+                    // output summary to file
+                    Report::TimingReportEventC tre;
+                    hebench::Utilities::writeToFile(
+                        output_path,
+                        [&report, &tre](std::ostream &os) -> void {
+                            report.generateSummaryCSV(tre, os);
+                        },
+                        false, false);
+
+                    // output overview of summary to stdout
+                    if (do_stdout_summary)
+                    {
+                        Report::TimingPrefixedSeconds timing_prefix;
+                        double elapsed_time_secs;
+
+                        elapsed_time_secs = (tre.wall_time_end - tre.wall_time_start) * tre.time_interval_ratio_num / tre.time_interval_ratio_den;
+                        Report::cpp::TimingReport::computeTimingPrefix(timing_prefix, elapsed_time_secs);
+                        ss = std::stringstream();
+                        ss << timing_prefix.symbol << "s";
+                        std::cout << std::setw(AveWallColSize) << std::right
+                                  << toDoubleVariableFrac(timing_prefix.value, 2).substr(0, AveWallColSize)
+                                  << std::setfill(' ') << std::setw(3) << std::right << ss.str() << " | ";
+
+                        elapsed_time_secs = (tre.cpu_time_end - tre.cpu_time_start) * tre.time_interval_ratio_num / tre.time_interval_ratio_den;
+                        Report::cpp::TimingReport::computeTimingPrefix(timing_prefix, elapsed_time_secs);
+                        ss = std::stringstream();
+                        ss << timing_prefix.symbol << "s";
+                        std::cout << std::setw(AveCPUColSize) << std::right
+                                  << toDoubleVariableFrac(timing_prefix.value, 2).substr(0, AveCPUColSize)
+                                  << std::setfill(' ') << std::setw(3) << std::right << ss.str() << std::endl;
+                    } // end if
+                } // end if
+                else if (do_stdout_summary)
+                    std::cout << "Validation Failed" << std::endl;
+            }
+            catch (...)
+            {
+                if (do_stdout_summary)
+                    std::cout << "Load Failed" << std::endl;
+            }
+            if (do_stdout_summary)
+                std::cout << std::setfill('-') << std::setw(ScreenColSize) << std::left << "-" << std::endl;
+
+            ++bench_total; // count the benchmark
+        } // end for
+    } // end for
+
+    for (const std::string &warning : fingerprint_warnings)
+        std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log(warning) << std::endl;
+}
+
+void BenchmarkRunner::generateSummary(const Engine &engine,
+                                      const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                      const std::vector<BenchmarkRequest> &benchmarks_ran,
+                                      const std::filesystem::path &input_root_path,
+                                      bool do_stdout_summary)
+{
+    generateSummary(engine, bench_config, benchmarks_ran, input_root_path, input_root_path, do_stdout_summary);
+}
+
+void BenchmarkRunner::generateCipherMaskSummary(const Engine &engine,
+                                                const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                                const std::vector<BenchmarkRequest> &benchmarks_ran,
+                                                const ProgramConfig &config)
+{
+    HarnessOverhead::Scope overhead_scope(HarnessOverhead::SummaryPhaseName);
+    std::stringstream ss;
+    CipherMaskAnalysis analysis;
+
+    for (std::size_t bench_i = 0; bench_i < benchmarks_ran.size(); ++bench_i)
+    {
+        for (std::size_t params_i = 0; params_i < benchmarks_ran[bench_i].sets_w_params.size(); ++params_i)
+        {
+            BenchmarkFactory::BenchmarkToken::Ptr description_token =
+                engine.describeBenchmark(bench_config,
+                                         benchmarks_ran[bench_i].benchmark_index,
+                                         benchmarks_ran[bench_i].sets_w_params[params_i]);
+            std::filesystem::path report_path = getReportFilename(config.report_root_path, description_token->description.path);
+            try
+            {
+                Report::cpp::TimingReport report =
+                    Report::cpp::TimingReport::loadReportFromCSVFile(report_path);
+                // failed benchmarks have no events
+                if (report.getEventCount() > 0)
+                    analysis.addReport(description_token->description, report);
+            }
+            catch (std::exception &ex)
+            {
+                std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("Skipping report " + report_path.string() + ": " + ex.what()) << std::endl;
+            }
+        } // end for
+    } // end for
+
+    if (analysis.getGroupCount() <= 0)
+    {
+        std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("No benchmarks ran that differ only in cipher mask.") << std::endl;
+        return;
+    } // end if
+
+    analysis.saveDeltas2CSV(config.report_root_path / ProgramConfig::CipherMaskSummaryFile);
+    analysis.saveOperands2CSV(config.report_root_path / ProgramConfig::CipherMaskOperandsFile);
+
+    if (config.b_show_run_overview)
+    {
+        ss = std::stringstream();
+        ss << "Cipher mask summary (total time and memory relative to reference):" << std::endl
+           << std::endl;
+        analysis.show(ss);
+        std::cout << std::endl
+                  << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    } // end if
+    ss = std::stringstream();
+    ss << "Cipher mask summary saved to: " << std::endl
+       << config.report_root_path / ProgramConfig::CipherMaskSummaryFile << std::endl
+       << config.report_root_path / ProgramConfig::CipherMaskOperandsFile;
+    std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+}
+
+void BenchmarkRunner::generateLogRegDegreeSummary(const Engine &engine,
+                                                  const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                                  const std::vector<BenchmarkRequest> &benchmarks_ran,
+                                                  const ProgramConfig &config)
+{
+    HarnessOverhead::Scope overhead_scope(HarnessOverhead::SummaryPhaseName);
+    std::stringstream ss;
+    LogRegDegreeAnalysis analysis;
+
+    for (std::size_t bench_i = 0; bench_i < benchmarks_ran.size(); ++bench_i)
+    {
+        for (std::size_t params_i = 0; params_i < benchmarks_ran[bench_i].sets_w_params.size(); ++params_i)
+        {
+            BenchmarkFactory::BenchmarkToken::Ptr description_token =
+                engine.describeBenchmark(bench_config,
+                                         benchmarks_ran[bench_i].benchmark_index,
+                                         benchmarks_ran[bench_i].sets_w_params[params_i]);
+            std::filesystem::path report_path = getReportFilename(config.report_root_path, description_token->description.path);
+            try
+            {
+                Report::cpp::TimingReport report =
+                    Report::cpp::TimingReport::loadReportFromCSVFile(report_path);
+                // failed benchmarks have no events, other workloads have no activation error
+                if (report.getEventCount() > 0)
+                    analysis.addReport(description_token->description, report);
+            }
+            catch (std::exception &ex)
+            {
+                std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("Skipping report " + report_path.string() + ": " + ex.what()) << std::endl;
+            }
+        } // end for
+    } // end for
+
+    if (analysis.getGroupCount() <= 0)
+    {
+        std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("No Logistic Regression benchmarks ran that differ only in polynomial degree.") << std::endl;
+        return;
+    } // end if
+
+    analysis.save2CSV(config.report_root_path / ProgramConfig::LogRegDegreeSummaryFile);
+
+    if (config.b_show_run_overview)
+    {
+        ss = std::stringstream();
+        ss << "Logistic Regression degree summary (total time relative to lowest degree, error against exact sigmoid):" << std::endl
+           << std::endl;
+        analysis.show(ss);
+        std::cout << std::endl
+                  << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    } // end if
+    ss = std::stringstream();
+    ss << "Logistic Regression degree summary saved to: " << std::endl
+       << config.report_root_path / ProgramConfig::LogRegDegreeSummaryFile;
+    std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+}
+
+void BenchmarkRunner::run(Engine &engine,
+                          const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                          const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                          const ProgramConfig &config,
+                          const std::filesystem::path &report_root_path,
+                          std::vector<std::string> &failed_benchmarks,
+                          BenchmarkCache *p_bench_cache)
+{
+    std::stringstream ss;
+    std::size_t total_runs = hebench::Utilities::BenchmarkConfiguration::countBenchmarks2Run(benchmarks_to_run);
+
+    // iterate through the registered benchmarks and execute them
+    std::size_t run_i = 0;
+    for (std::size_t bench_i = 0; bench_i < benchmarks_to_run.size(); ++bench_i)
+    {
+        for (std::size_t params_i = 0; params_i < benchmarks_to_run[bench_i].sets_w_params.size(); ++params_i)
+        {
+            bool b_non_critical_error = false;
+            bool b_succeeded          = false;
+            std::string bench_path;
+            hebench::Utilities::TimingReportEx report;
+            try
+            {
+                ss = std::stringstream();
+                ss << "(" << bench_i << ", " << params_i << ")";
+                bench_path = ss.str();
+
+                ss = std::stringstream();
+                ss << " Progress: " << (run_i * 100 / total_runs) << "%" << std::endl
+                   << "           " << run_i << "/" << total_runs;
+                std::cout << std::endl
+                          << "==================" << std::endl
+                          << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl
+                          << "==================" << std::endl;
+
+                if (config.report_delay_ms > 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(config.report_delay_ms));
+
+                // obtain the text description of the benchmark to print out
+                BenchmarkFactory::BenchmarkToken::Ptr bench_token =
+                    engine.describeBenchmark(bench_config, benchmarks_to_run[bench_i].benchmark_index, benchmarks_to_run[bench_i].sets_w_params[params_i]);
+
+                bench_path = bench_token->description.path;
+                LiveMetrics::beginBenchmark(run_i,
+                                            benchmarks_to_run[bench_i].benchmark_index,
+                                            bench_path);
+                HarnessOverhead::beginBenchmark((report_root_path / bench_path).generic_string());
+
+                // print header
+
+                // prints
+                // ===========================
+                //  Workload: <workload name>
+                // ===========================
+                std::string s_workload_name = "Workload: " + bench_token->description.workload_name;
+                std::size_t fill_size       = s_workload_name.length() + 2;
+                if (fill_size > 79)
+                    fill_size = 79;
+                std::cout << std::endl
+                          << std::setfill('=') << std::setw(fill_size) << "=" << std::endl
+                          << " " << hebench::Logging::GlobalLogger::log(s_workload_name) << std::endl
+                          << std::setw(fill_size) << "=" << std::setfill(' ') << std::endl;
+
+                std::cout << std::endl
+                          << bench_token->description.header << std::endl;
+
+                // create the benchmark
+                // polynomial degrees of the same workload are compared on the same input data
+                if (config.b_logreg_degree_summary
+                    && LogRegDegreeAnalysis::isComparedWorkload(bench_token->description.workload))
+                    hebench::Utilities::RandomGenerator::setRandomSeed(bench_config.random_seed);
+                report.setHeader(bench_token->description.header);
+                report.appendHeader(config.fingerprint.toHeader());
+                if (config.b_record_api_calls)
+                {
+                    std::filesystem::path recording_path = report_root_path / bench_path;
+                    std::filesystem::create_directories(recording_path);
+                    recording_path /= ProgramConfig::APICallsRecordingFile;
+                    hebench::APIBridge::DynamicLibLoad::beginRecording(recording_path);
+                } // end if
+                IBenchmark::Ptr p_bench;
+                std::string bench_cache_key;
+                if (p_bench_cache)
+                {
+                    bench_cache_key = BenchmarkCache::getKey(bench_token->description, bench_config);
+                    p_bench         = p_bench_cache->find(bench_cache_key);
+                } // end if
+                if (p_bench)
+                {
+                    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Reusing initialized benchmark from cache.") << std::endl;
+                    report.appendFooter("Initialization reused from a previous run: not included in this report.");
+                    p_bench->prepareReuse();
+                } // end if
+                else
+                {
+                    if (p_bench_cache)
+                        p_bench_cache->clear(); // engine allows a single benchmark at a time
+                    p_bench = engine.createBenchmark(bench_token, report);
+                    if (p_bench_cache)
+                        p_bench_cache->store(bench_cache_key, p_bench);
+                } // end else
+
+                IBenchmark::RunConfig run_config;
+                run_config.b_validate_results   = config.b_validate_results;
+                run_config.b_plaintext_baseline = config.b_plaintext_baseline;
+                run_config.b_reference_error    = config.b_logreg_degree_summary;
+
+                // run the workload (category runners account for their own stages)
+                {
+                    HarnessOverhead::Scope overhead_scope(HarnessOverhead::OtherPhaseName);
+                    b_succeeded = p_bench->run(report, run_config);
+                }
+
+                if (!b_succeeded)
+                {
+                    std::cout << IOS_MSG_FAILED << hebench::Logging::GlobalLogger::log(bench_token->description.workload_name) << std::endl;
+                    failed_benchmarks.push_back(bench_path);
+                    report.clear(); // report event data is no longer valid for a failed run
+                    if (p_bench_cache)
+                        p_bench_cache->clear(); // do not reuse a benchmark that failed
+                } // end if
+            }
+            catch (hebench::Common::ErrorException &err_num)
+            {
+                if (err_num.getErrorCode() == HEBENCH_ECODE_CRITICAL_ERROR)
+                    throw; // critical failure
+                else
+                {
+                    // no critical error: report and move on to the next benchmark
+
+                    Progress::endPhase();
+
+                    b_non_critical_error = true;
+                    if (p_bench_cache)
+                        p_bench_cache->clear(); // do not reuse a benchmark that failed
+
+                    failed_benchmarks.push_back(bench_path);
+                    report.clear(); // report event data is no longer valid for a failed run
+
+                    ss = std::stringstream();
+                    ss << "Workload backend failed with message: " << std::endl
+                       << err_num.what();
+                    std::cout << std::endl
+                              << IOS_MSG_ERROR << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+                } // end else
+            }
+            hebench::APIBridge::DynamicLibLoad::endRecording();
+
+            // create the path to output report
+            std::filesystem::path report_path     = getReportPath(report_root_path, bench_path);
+            std::filesystem::path report_filename = getReportFilename(report_root_path, bench_path);
+
+            ss = std::stringstream();
+            ss << "Saving report to: " << std::endl
+               << report_path;
+            std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+            LiveMetrics::setPhase("Saving report");
+
+            // output CSV report
+            if (b_non_critical_error)
+            {
+                // delete any previous report in this location to signal failure
+                if (std::filesystem::exists(report_filename)
+                    && std::filesystem::is_regular_file(report_filename))
+                    std::filesystem::remove(report_filename);
+            } // end if
+            else
+            {
+                HarnessOverhead::Scope overhead_scope(HarnessOverhead::ReportPhaseName);
+                std::filesystem::create_directories(report_path);
+                report.save2CSV(report_filename);
+            } // end else
+
+            std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log("Report saved.") << std::endl;
+            LiveMetrics::endBenchmark(b_succeeded);
+            HarnessOverhead::endBenchmark();
+
+            ++run_i;
+        } // end for
+
+        // benchmark cleaned up here automatically
+    } // end for
+
+    ss = std::stringstream();
+    ss << " Progress: 100%" << std::endl
+       << "           " << total_runs << "/" << total_runs;
+    std::cout << std::endl
+              << "==================" << std::endl
+              << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl
+              << "==================" << std::endl;
+}
+
+std::vector<std::string> BenchmarkRunner::runDistributed(const Engine &engine,
+                                                         const hebench::Utilities::BenchmarkConfiguration &bench_configuration,
+                                                         const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                                         const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                                                         const ProgramConfig &config)
+{
+    std::stringstream ss;
+
+    // expand configuration into one independent job per benchmark
+    std::vector<DistributedJob> jobs;
+    std::filesystem::path job_config_file = config.report_root_path / "hebench_job_config.yaml";
+    for (std::size_t bench_i = 0; bench_i < benchmarks_to_run.size(); ++bench_i)
+    {
+        for (std::size_t params_i = 0; params_i < benchmarks_to_run[bench_i].sets_w_params.size(); ++params_i)
+        {
+            BenchmarkFactory::BenchmarkToken::Ptr bench_token =
+                engine.describeBenchmark(bench_config, benchmarks_to_run[bench_i].benchmark_index, benchmarks_to_run[bench_i].sets_w_params[params_i]);
+
+            BenchmarkRequest job_request;
+            job_request.benchmark_index = benchmarks_to_run[bench_i].benchmark_index;
+            job_request.sets_w_params.push_back(benchmarks_to_run[bench_i].sets_w_params[params_i]);
+            bench_configuration.saveConfiguration(job_config_file, { job_request }, bench_config);
+
+            DistributedJob job;
+            job.bench_path = bench_token->description.path;
+            std::ifstream fnum(job_config_file);
+            ss = std::stringstream();
+            ss << fnum.rdbuf();
+            job.config = ss.str();
+            jobs.push_back(job);
+        } // end for
+    } // end for
+    std::filesystem::remove(job_config_file);
+
+    ss = std::stringstream();
+    ss << "Dispatching " << jobs.size() << " jobs to " << config.coordinator_workers.size() << " workers...";
+    std::cout << std::endl
+              << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    LiveMetrics::setPhase("Distributed run");
+
+    DistributedCoordinator coordinator(config.coordinator_workers,
+                                       config.distributed_token,
+                                       config.report_root_path,
+                                       config.job_history_file);
+    std::vector<std::string> retval = coordinator.run(jobs);
+
+    std::cout << IOS_MSG_DONE << std::endl;
+
+    return retval;
+}
+
+} // namespace TestHarness
+} // namespace hebench
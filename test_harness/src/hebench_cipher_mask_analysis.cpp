@@ -0,0 +1,407 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <bitset>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "benchmarks/categories/include/hebench_benchmark_category.h"
+#include "include/hebench_cipher_mask_analysis.h"
+
+namespace hebench {
+namespace TestHarness {
+
+std::string CipherMaskAnalysis::getGroupPath(const IBenchmarkDescription::Description &description)
+{
+    // replace the cipher mask component of the path
+    std::string mask_name = PartialBenchmarkDescription::getCipherMaskName(description.cipher_param_mask);
+    std::filesystem::path bench_path(description.path);
+    std::filesystem::path retval;
+    bool b_replaced = false;
+    std::vector<std::filesystem::path> components(bench_path.begin(), bench_path.end());
+    // mask is followed by scheme, security and extra description
+    constexpr std::size_t MaskPositionFromEnd = 4;
+    for (std::size_t i = 0; i < components.size(); ++i)
+    {
+        if (!b_replaced && i + MaskPositionFromEnd == components.size() && components[i] == mask_name)
+        {
+            retval /= "*";
+            b_replaced = true;
+        } // end if
+        else
+            retval /= components[i];
+    } // end for
+    if (!b_replaced)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Cipher mask not found in benchmark path: " + description.path));
+    return retval.generic_string();
+}
+
+std::string CipherMaskAnalysis::getPhaseName(const std::string &event_type_header)
+{
+    static const std::string EncodingPackPrefix = "Encoding pack ";
+
+    if (!PartialBenchmarkCategory::isBackendPhase(event_type_header))
+        return std::string();
+    // packs depend on the mask: all of them make up the encoding phase
+    if (event_type_header.compare(0, EncodingPackPrefix.size(), EncodingPackPrefix) == 0)
+        return "Encoding";
+    return event_type_header;
+}
+
+void CipherMaskAnalysis::readPhaseMemory(const std::string &footer, std::map<std::string, PhaseCost> &phases,
+                                         std::vector<std::string> &phase_names)
+{
+    std::istringstream is(footer);
+    std::string line;
+    bool b_found = false;
+    while (!b_found && std::getline(is, line))
+        b_found = (line == PartialBenchmark::PhaseMemoryFooterTitle);
+    if (b_found && std::getline(is, line)) // skip column names
+    {
+        while (std::getline(is, line))
+        {
+            std::size_t comma_pos = line.find_last_of(',');
+            if (comma_pos == std::string::npos)
+                break;
+            std::int64_t memory_bytes;
+            std::istringstream is_value(line.substr(comma_pos + 1));
+            if (!(is_value >> memory_bytes))
+                break;
+            std::string phase_name = line.substr(0, comma_pos);
+            auto it                = phases.find(phase_name);
+            if (it == phases.end())
+            {
+                it = phases.emplace(phase_name, PhaseCost()).first;
+                phase_names.push_back(phase_name);
+            } // end if
+            it->second.memory_bytes += memory_bytes;
+            it->second.b_has_memory = true;
+        } // end while
+    } // end if
+}
+
+void CipherMaskAnalysis::addReport(const IBenchmarkDescription::Description &description,
+                                   const hebench::TestHarness::Report::cpp::TimingReport &report)
+{
+    using Fingerprint = hebench::TestHarness::Report::cpp::Fingerprint;
+
+    std::string group_path  = getGroupPath(description);
+    Fingerprint fingerprint = Fingerprint::fromHeader(report.getHeader());
+    auto it                 = m_group_index.find(group_path);
+    if (it == m_group_index.end())
+    {
+        it = m_group_index.emplace(group_path, m_groups.size()).first;
+        m_groups.emplace_back();
+        m_groups.back().path        = group_path;
+        m_groups.back().fingerprint = fingerprint;
+    } // end if
+    Group &group = m_groups[it->second];
+
+    std::vector<Fingerprint::Difference> diffs = Fingerprint::compare(group.fingerprint, fingerprint);
+    diffs.erase(std::remove_if(diffs.begin(), diffs.end(),
+                               [](const Fingerprint::Difference &diff) { return !Fingerprint::isIncompatible(diff); }),
+                diffs.end());
+    if (!diffs.empty())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Fingerprint differs from the other reports in group " + group_path
+                                                     + ":\n" + Fingerprint::toString(diffs)));
+
+    Member member;
+    member.cipher_param_mask = description.cipher_param_mask;
+
+    // wall time per iteration of every event type, added up by phase
+    struct EventTypeTime
+    {
+        double wall_time_s       = 0.0;
+        std::uint64_t iterations = 0;
+    };
+    std::vector<std::uint32_t> event_type_ids; // in order of first appearance
+    std::map<std::uint32_t, EventTypeTime> event_type_times;
+    const hebench::TestHarness::Report::TimingReportEventC *p_events = report.getEventsData();
+    for (std::uint64_t event_i = 0; p_events && event_i < report.getEventCount(); ++event_i)
+    {
+        const hebench::TestHarness::Report::TimingReportEventC &event = p_events[event_i];
+        auto time_it                                                  = event_type_times.find(event.event_type_id);
+        if (time_it == event_type_times.end())
+        {
+            time_it = event_type_times.emplace(event.event_type_id, EventTypeTime()).first;
+            event_type_ids.push_back(event.event_type_id);
+        } // end if
+        time_it->second.wall_time_s += (event.wall_time_end - event.wall_time_start)
+                                       * event.time_interval_ratio_num / event.time_interval_ratio_den;
+        time_it->second.iterations += event.iterations;
+    } // end for
+
+    std::vector<std::string> phase_names;
+    for (std::uint32_t event_type_id : event_type_ids)
+    {
+        std::string phase_name = getPhaseName(report.getEventTypeHeader(event_type_id));
+        if (!phase_name.empty() && event_type_times[event_type_id].iterations > 0)
+        {
+            auto phase_it = member.phases.find(phase_name);
+            if (phase_it == member.phases.end())
+            {
+                phase_it = member.phases.emplace(phase_name, PhaseCost()).first;
+                phase_names.push_back(phase_name);
+            } // end if
+            phase_it->second.wall_time_s += event_type_times[event_type_id].wall_time_s / event_type_times[event_type_id].iterations;
+            phase_it->second.b_has_wall_time = true;
+        } // end if
+    } // end for
+    readPhaseMemory(report.getFooter(), member.phases, phase_names);
+
+    for (const std::string &phase_name : phase_names)
+        if (std::find(group.phase_names.begin(), group.phase_names.end(), phase_name) == group.phase_names.end())
+            group.phase_names.push_back(phase_name);
+    group.members.emplace_back(std::move(member));
+}
+
+std::size_t CipherMaskAnalysis::getGroupCount() const
+{
+    std::size_t retval = 0;
+    for (const Group &group : m_groups)
+        if (group.members.size() > 1)
+            ++retval;
+    return retval;
+}
+
+CipherMaskAnalysis::PhaseCost CipherMaskAnalysis::getPhaseCost(const Member &member, const std::string &phase_name)
+{
+    if (phase_name == TotalPhaseName)
+        return getPhaseTotal(member);
+    auto it = member.phases.find(phase_name);
+    return it == member.phases.end() ? PhaseCost() : it->second;
+}
+
+CipherMaskAnalysis::PhaseCost CipherMaskAnalysis::getPhaseTotal(const Member &member)
+{
+    PhaseCost retval;
+    for (const auto &phase : member.phases)
+    {
+        retval.wall_time_s += phase.second.wall_time_s;
+        retval.memory_bytes += phase.second.memory_bytes;
+        retval.b_has_wall_time = retval.b_has_wall_time || phase.second.b_has_wall_time;
+        retval.b_has_memory    = retval.b_has_memory || phase.second.b_has_memory;
+    } // end for
+    return retval;
+}
+
+void CipherMaskAnalysis::subtract(PhaseCost &result, const PhaseCost &lhs, const PhaseCost &rhs)
+{
+    result.b_has_wall_time = lhs.b_has_wall_time && rhs.b_has_wall_time;
+    result.b_has_memory    = lhs.b_has_memory && rhs.b_has_memory;
+    result.wall_time_s     = result.b_has_wall_time ? lhs.wall_time_s - rhs.wall_time_s : 0.0;
+    result.memory_bytes    = result.b_has_memory ? lhs.memory_bytes - rhs.memory_bytes : 0;
+}
+
+const CipherMaskAnalysis::Member &CipherMaskAnalysis::getReference(const Group &group)
+{
+    const Member *p_retval = &group.members.front();
+    for (const Member &member : group.members)
+    {
+        std::size_t cipher_count     = std::bitset<32>(member.cipher_param_mask).count();
+        std::size_t ref_cipher_count = std::bitset<32>(p_retval->cipher_param_mask).count();
+        if (cipher_count < ref_cipher_count
+            || (cipher_count == ref_cipher_count && member.cipher_param_mask < p_retval->cipher_param_mask))
+            p_retval = &member;
+    } // end for
+    return *p_retval;
+}
+
+std::vector<CipherMaskAnalysis::OperandCost> CipherMaskAnalysis::computeOperandCosts(const Group &group)
+{
+    std::vector<OperandCost> retval;
+
+    // number of parameters is only known from explicit masks
+    std::size_t param_count = 0;
+    for (const Member &member : group.members)
+        if (member.cipher_param_mask != AllCipherMask)
+            while (param_count < 32 && (member.cipher_param_mask >> param_count) != 0)
+                ++param_count;
+    auto normalize = [param_count](std::uint32_t mask) -> std::uint32_t {
+        return mask == AllCipherMask && param_count > 0 ? static_cast<std::uint32_t>((1ULL << param_count) - 1) : mask;
+    };
+
+    // pairs of members whose masks differ only in the operand
+    std::vector<std::pair<std::string, std::uint32_t>> operands;
+    for (std::size_t param_i = 0; param_i < param_count; ++param_i)
+        operands.emplace_back(std::to_string(param_i), static_cast<std::uint32_t>(1) << param_i);
+    if (param_count <= 0)
+        operands.emplace_back("All", AllCipherMask);
+    for (const auto &operand : operands)
+    {
+        OperandCost cost;
+        cost.operand = operand.first;
+        cost.pairs   = 0;
+        for (const Member &without : group.members)
+        {
+            std::uint32_t without_mask = normalize(without.cipher_param_mask);
+            if ((without_mask & operand.second) != 0)
+                continue;
+            for (const Member &with : group.members)
+            {
+                if (normalize(with.cipher_param_mask) != (without_mask | operand.second))
+                    continue;
+                ++cost.pairs;
+                for (const std::string &phase_name : group.phase_names)
+                {
+                    PhaseCost delta;
+                    subtract(delta, getPhaseCost(with, phase_name), getPhaseCost(without, phase_name));
+                    PhaseCost &sum = cost.phases[phase_name];
+                    sum.wall_time_s += delta.wall_time_s;
+                    sum.memory_bytes += delta.memory_bytes;
+                    sum.b_has_wall_time = sum.b_has_wall_time || delta.b_has_wall_time;
+                    sum.b_has_memory    = sum.b_has_memory || delta.b_has_memory;
+                } // end for
+            } // end for
+        } // end for
+        if (cost.pairs > 0)
+        {
+            for (auto &phase : cost.phases)
+            {
+                phase.second.wall_time_s /= cost.pairs;
+                phase.second.memory_bytes /= static_cast<std::int64_t>(cost.pairs);
+            } // end for
+            retval.emplace_back(std::move(cost));
+        } // end if
+    } // end for
+
+    return retval;
+}
+
+void CipherMaskAnalysis::saveDeltas2CSV(const std::filesystem::path &filename) const
+{
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + filename.string()));
+
+    fnum << std::setprecision(9)
+         << "Benchmark group,Cipher mask,Reference mask,Phase,"
+         << "Wall time (s),Delta wall time (s),Resident memory (bytes),Delta resident memory (bytes)" << std::endl;
+    for (const Group &group : m_groups)
+    {
+        if (group.members.size() <= 1)
+            continue;
+        const Member &reference = getReference(group);
+        std::vector<std::string> phase_names(group.phase_names);
+        phase_names.push_back(TotalPhaseName);
+        for (const Member &member : group.members)
+        {
+            for (const std::string &phase_name : phase_names)
+            {
+                PhaseCost cost = getPhaseCost(member, phase_name);
+                PhaseCost delta;
+                subtract(delta, cost, getPhaseCost(reference, phase_name));
+                fnum << "\"" << group.path << "\","
+                     << PartialBenchmarkDescription::getCipherMaskName(member.cipher_param_mask) << ","
+                     << PartialBenchmarkDescription::getCipherMaskName(reference.cipher_param_mask) << ","
+                     << phase_name << ",";
+                if (cost.b_has_wall_time)
+                    fnum << cost.wall_time_s;
+                fnum << ",";
+                if (delta.b_has_wall_time)
+                    fnum << delta.wall_time_s;
+                fnum << ",";
+                if (cost.b_has_memory)
+                    fnum << cost.memory_bytes;
+                fnum << ",";
+                if (delta.b_has_memory)
+                    fnum << delta.memory_bytes;
+                fnum << std::endl;
+            } // end for
+        } // end for
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing cipher mask analysis: " + filename.string()));
+}
+
+void CipherMaskAnalysis::saveOperands2CSV(const std::filesystem::path &filename) const
+{
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + filename.string()));
+
+    fnum << std::setprecision(9)
+         << "Benchmark group,Encrypted operand,Pairs,Phase,Delta wall time (s),Delta resident memory (bytes)" << std::endl;
+    for (const Group &group : m_groups)
+    {
+        if (group.members.size() <= 1)
+            continue;
+        std::vector<OperandCost> operand_costs = computeOperandCosts(group);
+        for (const OperandCost &operand_cost : operand_costs)
+        {
+            PhaseCost total;
+            for (const std::string &phase_name : group.phase_names)
+            {
+                auto it = operand_cost.phases.find(phase_name);
+                if (it == operand_cost.phases.end())
+                    continue;
+                const PhaseCost &cost = it->second;
+                total.wall_time_s += cost.wall_time_s;
+                total.memory_bytes += cost.memory_bytes;
+                total.b_has_wall_time = total.b_has_wall_time || cost.b_has_wall_time;
+                total.b_has_memory    = total.b_has_memory || cost.b_has_memory;
+                fnum << "\"" << group.path << "\"," << operand_cost.operand << "," << operand_cost.pairs << ","
+                     << phase_name << ",";
+                if (cost.b_has_wall_time)
+                    fnum << cost.wall_time_s;
+                fnum << ",";
+                if (cost.b_has_memory)
+                    fnum << cost.memory_bytes;
+                fnum << std::endl;
+            } // end for
+            fnum << "\"" << group.path << "\"," << operand_cost.operand << "," << operand_cost.pairs << ","
+                 << TotalPhaseName << "," << total.wall_time_s << "," << total.memory_bytes << std::endl;
+        } // end for
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing cipher mask analysis: " + filename.string()));
+}
+
+std::ostream &CipherMaskAnalysis::show(std::ostream &os) const
+{
+    std::size_t group_i = 0;
+    for (const Group &group : m_groups)
+    {
+        if (group.members.size() <= 1)
+            continue;
+        const Member &reference   = getReference(group);
+        PhaseCost reference_total = getPhaseTotal(reference);
+        os << ++group_i << ". " << group.path << std::endl
+           << "    Reference: " << PartialBenchmarkDescription::getCipherMaskName(reference.cipher_param_mask) << std::endl;
+        for (const Member &member : group.members)
+        {
+            if (&member == &reference)
+                continue;
+            PhaseCost delta;
+            subtract(delta, getPhaseTotal(member), reference_total);
+            os << "    " << PartialBenchmarkDescription::getCipherMaskName(member.cipher_param_mask) << ": "
+               << std::showpos << std::fixed << std::setprecision(3) << delta.wall_time_s * 1000.0 << " ms";
+            if (reference_total.wall_time_s > 0.0)
+                os << " (" << std::setprecision(2) << delta.wall_time_s * 100.0 / reference_total.wall_time_s << "%)";
+            if (delta.b_has_memory)
+                os << ", " << std::setprecision(2) << delta.memory_bytes / (1024.0 * 1024.0) << " MB";
+            os << std::noshowpos << std::defaultfloat << std::endl;
+        } // end for
+        for (const OperandCost &operand_cost : computeOperandCosts(group))
+        {
+            PhaseCost total;
+            for (const auto &phase : operand_cost.phases)
+            {
+                total.wall_time_s += phase.second.wall_time_s;
+                total.memory_bytes += phase.second.memory_bytes;
+            } // end for
+            os << "    Encrypting operand " << operand_cost.operand << ": "
+               << std::showpos << std::fixed << std::setprecision(3) << total.wall_time_s * 1000.0 << " ms, "
+               << std::setprecision(2) << total.memory_bytes / (1024.0 * 1024.0) << " MB"
+               << std::noshowpos << std::defaultfloat << " (" << operand_cost.pairs << " pairs)" << std::endl;
+        } // end for
+    } // end for
+    return os;
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -0,0 +1,356 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "dynamic_lib_load.h"
+
+#include "benchmarks/categories/include/hebench_benchmark_category.h"
+#include "include/hebench_cold_start.h"
+#include "include/hebench_live_metrics.h"
+#include "include/hebench_progress.h"
+
+namespace hebench {
+namespace TestHarness {
+
+void ColdStart::completeSample(Sample &sample, const hebench::Utilities::TimingReportEx &report)
+{
+    std::uint32_t main_event_id = report.getMainEventType();
+    const hebench::TestHarness::Report::TimingReportEventC *p_events = report.getEventsData();
+    std::unordered_set<std::uint32_t> types_found;
+    bool b_operation_found = false;
+
+    for (std::uint64_t event_i = 0; p_events && event_i < report.getEventCount(); ++event_i)
+    {
+        const hebench::TestHarness::Report::TimingReportEventC &event = p_events[event_i];
+        if (types_found.count(event.event_type_id) > 0)
+            continue;
+        types_found.insert(event.event_type_id);
+
+        std::string header = report.getEventTypeHeader(event.event_type_id);
+        Phase phase;
+        phase.name         = header;
+        phase.wall_time_ms = (event.wall_time_end - event.wall_time_start)
+                             * event.time_interval_ratio_num * 1000.0 / event.time_interval_ratio_den;
+        phase.b_in_total   = PartialBenchmarkCategory::isBackendPhase(header);
+        if (event.event_type_id == main_event_id || header == PartialBenchmarkCategory::WarmupEventName)
+        {
+            // the first of warm-up or operation is the first operation
+            if (b_operation_found)
+                continue;
+            b_operation_found = true;
+            phase.name        = PhaseFirstOperation;
+            phase.b_in_total  = true;
+        } // end if
+        sample.push_back(phase);
+    } // end for
+
+    Phase total;
+    total.name         = PhaseTotal;
+    total.wall_time_ms = 0.0;
+    total.b_in_total   = false;
+    for (const Phase &phase : sample)
+        if (phase.b_in_total)
+            total.wall_time_ms += phase.wall_time_ms;
+    sample.push_back(total);
+}
+
+void ColdStart::saveSample(const std::filesystem::path &filename, const Sample &sample)
+{
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + filename.string()));
+    fnum << std::setprecision(17);
+    for (const Phase &phase : sample)
+        fnum << phase.wall_time_ms << "," << (phase.b_in_total ? 1 : 0) << "," << phase.name << std::endl;
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing cold-start sample: " + filename.string()));
+}
+
+ColdStart::Sample ColdStart::loadSample(const std::filesystem::path &filename)
+{
+    Sample retval;
+    std::ifstream fnum(filename);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for reading: " + filename.string()));
+    std::string line;
+    while (std::getline(fnum, line))
+    {
+        // wall_time_ms,in_total,name (name may contain commas)
+        std::size_t comma_0 = line.find(',');
+        std::size_t comma_1 = comma_0 == std::string::npos ? comma_0 : line.find(',', comma_0 + 1);
+        if (comma_1 == std::string::npos)
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Invalid cold-start sample file: " + filename.string()));
+        Phase phase;
+        phase.wall_time_ms = std::stod(line.substr(0, comma_0));
+        phase.b_in_total   = line.substr(comma_0 + 1, comma_1 - comma_0 - 1) == "1";
+        phase.name         = line.substr(comma_1 + 1);
+        retval.push_back(phase);
+    } // end while
+    return retval;
+}
+
+void ColdStart::dropPageCache(const std::filesystem::path &filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file: " + filename.string()));
+    // write back any dirty pages first, otherwise, they cannot be dropped
+    fdatasync(fd);
+    int err_num = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+    if (err_num != 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not drop page cache for file: " + filename.string()
+                                                  + ": " + std::strerror(err_num)));
+}
+
+ColdStart::Sample ColdStart::runChild(const std::vector<std::string> &child_args,
+                                      const std::filesystem::path &sample_file,
+                                      const std::filesystem::path &log_file)
+{
+    std::vector<char *> argv;
+    std::string arg0 = "test_harness";
+    argv.push_back(arg0.data());
+    for (const std::string &arg : child_args)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    std::filesystem::remove(sample_file);
+    int log_fd = open(log_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (log_fd < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + log_file.string()));
+
+    // make sure buffered output is not duplicated by the child
+    std::cout.flush();
+    std::cerr.flush();
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // child: a fresh process image from the same binary
+        dup2(log_fd, STDOUT_FILENO);
+        dup2(log_fd, STDERR_FILENO);
+        close(log_fd);
+        execv("/proc/self/exe", argv.data());
+        _exit(127);
+    } // end if
+    close(log_fd);
+    if (pid < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS(std::string("Could not create child process: ") + std::strerror(errno)));
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+            throw std::runtime_error(IL_LOG_MSG_CLASS(std::string("Error waiting for child process: ") + std::strerror(errno)));
+    } // end while
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !std::filesystem::exists(sample_file))
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Cold-start child process failed. See output in: " + log_file.string()));
+
+    Sample retval = loadSample(sample_file);
+    std::filesystem::remove(sample_file);
+    return retval;
+}
+
+double ColdStart::percentile(const std::vector<double> &sorted_values, double pct)
+{
+    // nearest rank
+    if (sorted_values.empty())
+        return 0.0;
+    std::size_t rank = static_cast<std::size_t>(std::ceil(pct * sorted_values.size()));
+    return sorted_values[rank > 0 ? rank - 1 : 0];
+}
+
+std::vector<ColdStart::PhaseStats> ColdStart::computeStats(const std::vector<Sample> &samples)
+{
+    std::vector<PhaseStats> retval;
+    std::unordered_map<std::string, std::size_t> phase_index;
+    for (const Sample &sample : samples)
+    {
+        for (const Phase &phase : sample)
+        {
+            auto it = phase_index.find(phase.name);
+            if (it == phase_index.end())
+            {
+                it = phase_index.emplace(phase.name, retval.size()).first;
+                retval.emplace_back();
+                retval.back().name = phase.name;
+            } // end if
+            retval[it->second].wall_times_ms.push_back(phase.wall_time_ms);
+        } // end for
+    } // end for
+    for (PhaseStats &stats : retval)
+        std::sort(stats.wall_times_ms.begin(), stats.wall_times_ms.end());
+    return retval;
+}
+
+void ColdStart::saveReport(const std::filesystem::path &filename, const std::vector<Sample> &samples)
+{
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + filename.string()));
+
+    fnum << "Phase,Samples,Mean (ms),Std dev (ms),Min (ms),Median (ms),90th percentile (ms),Max (ms)" << std::endl;
+    for (const PhaseStats &stats : computeStats(samples))
+    {
+        const std::vector<double> &values = stats.wall_times_ms;
+        double mean                       = 0.0;
+        double variance                   = 0.0;
+        for (double value : values)
+            mean += value;
+        mean /= values.size();
+        for (double value : values)
+            variance += (value - mean) * (value - mean);
+        if (values.size() > 1)
+            variance /= values.size() - 1;
+        fnum << "\"" << stats.name << "\"," << values.size() << ","
+             << mean << "," << std::sqrt(variance) << ","
+             << values.front() << "," << percentile(values, 0.5) << ","
+             << percentile(values, 0.9) << "," << values.back() << std::endl;
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing cold-start report: " + filename.string()));
+}
+
+std::ostream &ColdStart::showReport(std::ostream &os, const std::vector<Sample> &samples)
+{
+    os << std::left << std::setw(32) << "Phase" << std::right
+       << std::setw(14) << "Median (ms)"
+       << std::setw(14) << "P90 (ms)"
+       << std::setw(14) << "Max (ms)" << std::endl;
+    for (const PhaseStats &stats : computeStats(samples))
+    {
+        os << std::left << std::setw(32) << stats.name << std::right << std::fixed << std::setprecision(3)
+           << std::setw(14) << percentile(stats.wall_times_ms, 0.5)
+           << std::setw(14) << percentile(stats.wall_times_ms, 0.9)
+           << std::setw(14) << stats.wall_times_ms.back() << std::endl;
+    } // end for
+    os << std::defaultfloat;
+    return os;
+}
+
+void ColdStart::takeSample(Engine &engine,
+                           const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                           const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                           const ProgramConfig &config,
+                           Sample &sample)
+{
+    if (benchmarks_to_run.size() != 1 || benchmarks_to_run.front().sets_w_params.size() != 1)
+        throw std::runtime_error("Cold-start child requires a configuration with exactly one benchmark.");
+
+    BenchmarkFactory::BenchmarkToken::Ptr bench_token =
+        engine.describeBenchmark(bench_config, benchmarks_to_run.front().benchmark_index, benchmarks_to_run.front().sets_w_params.front());
+
+    hebench::Utilities::TimingReportEx report;
+    report.setHeader(bench_token->description.header);
+    IBenchmark::Ptr p_bench = engine.createBenchmark(bench_token, report);
+
+    IBenchmark::RunConfig run_config;
+    run_config.b_validate_results   = config.b_validate_results;
+    run_config.b_plaintext_baseline = false; // not part of the cold start
+    run_config.b_reference_error    = false;
+    if (!p_bench->run(report, run_config))
+        throw std::runtime_error("Benchmark failed: " + bench_token->description.path);
+
+    completeSample(sample, report);
+    saveSample(config.cold_start_child_file, sample);
+}
+
+std::vector<std::string> ColdStart::run(Engine::Ptr &p_engine,
+                                        std::shared_ptr<hebench::Utilities::BenchmarkConfiguration> &p_bench_configuration,
+                                        const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                        const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                                        const ProgramConfig &config)
+{
+    std::vector<std::string> retval;
+    std::stringstream ss;
+
+    // expand configuration into one configuration file per benchmark
+    std::vector<std::filesystem::path> bench_paths;
+    for (std::size_t bench_i = 0; bench_i < benchmarks_to_run.size(); ++bench_i)
+    {
+        for (std::size_t params_i = 0; params_i < benchmarks_to_run[bench_i].sets_w_params.size(); ++params_i)
+        {
+            BenchmarkFactory::BenchmarkToken::Ptr bench_token =
+                p_engine->describeBenchmark(bench_config, benchmarks_to_run[bench_i].benchmark_index, benchmarks_to_run[bench_i].sets_w_params[params_i]);
+
+            BenchmarkRequest bench_request;
+            bench_request.benchmark_index = benchmarks_to_run[bench_i].benchmark_index;
+            bench_request.sets_w_params.push_back(benchmarks_to_run[bench_i].sets_w_params[params_i]);
+            std::filesystem::path report_path = config.report_root_path / bench_token->description.path;
+            std::filesystem::create_directories(report_path);
+            p_bench_configuration->saveConfiguration(report_path / ChildConfigFile, { bench_request }, bench_config);
+            bench_paths.push_back(bench_token->description.path);
+        } // end for
+    } // end for
+
+    // the backend must not be loaded by this process while sampling,
+    // otherwise, its pages remain cached and mapped
+    p_bench_configuration.reset();
+    p_engine.reset();
+    hebench::APIBridge::DynamicLibLoad::unloadLibrary();
+
+    for (std::size_t run_i = 0; run_i < bench_paths.size(); ++run_i)
+    {
+        std::filesystem::path report_path = config.report_root_path / bench_paths[run_i];
+        std::filesystem::path sample_file = report_path / ChildSampleFile;
+        std::vector<Sample> samples;
+
+        ss = std::stringstream();
+        ss << "Cold start " << run_i + 1 << "/" << bench_paths.size() << ": " << bench_paths[run_i].string();
+        std::cout << std::endl
+                  << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+        LiveMetrics::beginBenchmark(run_i, run_i, bench_paths[run_i].string());
+        LiveMetrics::setPhase("Cold start");
+
+        std::vector<std::string> child_args = config.getChildArgs(report_path / ChildConfigFile, report_path, bench_config.random_seed);
+        child_args.insert(child_args.end(), { "--cold_start_child", sample_file.string() });
+
+        try
+        {
+            Progress::beginPhase("Cold start", config.cold_start_samples);
+            for (std::size_t sample_i = 0; sample_i < config.cold_start_samples; ++sample_i)
+            {
+                if (config.b_cold_start_drop_cache)
+                    dropPageCache(config.backend_lib_path);
+                samples.emplace_back(runChild(child_args, sample_file, report_path / ChildLogFile));
+                Progress::advance();
+            } // end for
+            Progress::endPhase();
+
+            saveReport(report_path / ProgramConfig::ColdStartReportFile, samples);
+            ss = std::stringstream();
+            showReport(ss, samples);
+            std::cout << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl
+                      << IOS_MSG_OK << hebench::Logging::GlobalLogger::log("Cold-start report saved to: " + (report_path / ProgramConfig::ColdStartReportFile).string()) << std::endl;
+            LiveMetrics::endBenchmark(true);
+        }
+        catch (std::runtime_error &ex)
+        {
+            // report and move on to the next benchmark
+            Progress::endPhase();
+            retval.push_back(bench_paths[run_i].string());
+            std::cout << IOS_MSG_ERROR << hebench::Logging::GlobalLogger::log(ex.what()) << std::endl;
+            LiveMetrics::endBenchmark(false);
+        }
+    } // end for
+
+    return retval;
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -11,12 +11,14 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 
 #include <yaml-cpp/yaml.h>
 
 #include "../include/hebench_config.h"
 #include "include/hebench_engine.h"
+#include "include/hebench_env_sweep.h"
 #include "include/hebench_ibenchmark.h"
 #include "include/hebench_math_utils.h"
 #include "include/hebench_utilities.h"
@@ -54,6 +56,8 @@ public:
                                             const YAML::Node &yaml_bench,
                                             const hebench::TestHarness::Engine &engine,
                                             const hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig &default_bench_config);
+    static std::vector<std::string> importYAML2KnobValues(const YAML::Node &yaml_values,
+                                                          const std::string &knob_name);
 
 private:
     template <typename T>
@@ -71,6 +75,35 @@ private:
         return static_cast<std::size_t>((tmp_to - tmp_from) / param_step) + 1;
     }
 
+    template <typename T>
+    static void computeSLOSearchRange(hebench::TestHarness::SLOSearchRequest &slo_search,
+                                      const YAML::Node &node_from,
+                                      const YAML::Node &node_to,
+                                      const YAML::Node &node_step)
+    {
+        T param_step = node_step.as<T>();
+        if constexpr (std::is_signed<T>::value)
+        {
+            if (param_step < static_cast<T>(0))
+                throw std::runtime_error("Field \"step\" of a searched parameter cannot be negative.");
+        }
+        if (param_step == static_cast<T>(0))
+            param_step = static_cast<T>(1);
+        T tmp_to   = node_to.as<T>();
+        T tmp_from = node_from.as<T>();
+        if (tmp_to < tmp_from)
+            tmp_to = tmp_from;
+        slo_search.step      = static_cast<std::uint64_t>(param_step);
+        slo_search.max_steps = static_cast<std::uint64_t>((tmp_to - tmp_from) / param_step);
+    }
+
+    static void importYAML2SLOSearch(hebench::TestHarness::SLOSearchRequest &slo_search,
+                                     const YAML::Node &yaml_bench,
+                                     std::size_t benchmark_index);
+    static void importYAML2OperandSweep(hebench::TestHarness::OperandSweepRequest &operand_sweep,
+                                        const YAML::Node &yaml_bench,
+                                        std::size_t benchmark_index);
+
     template <typename T>
     static T computeParamValue(std::size_t count,
                                const YAML::Node &node_from,
@@ -84,6 +117,84 @@ private:
 // class ConfigImporterImpl
 //--------------------------
 
+void ConfigImporterImpl::importYAML2SLOSearch(hebench::TestHarness::SLOSearchRequest &slo_search,
+                                              const YAML::Node &yaml_bench,
+                                              std::size_t benchmark_index)
+{
+    YAML::Node yaml_search = yaml_bench["slo_search"];
+    std::stringstream ss;
+    ss << "In \"slo_search\" for benchmark ID " << benchmark_index << ": ";
+    if (!yaml_search["param"].IsDefined())
+        throw std::runtime_error(ss.str() + "field \"param\" not found.");
+    if (!yaml_search["quantile"].IsDefined())
+        throw std::runtime_error(ss.str() + "field \"quantile\" not found.");
+    if (!yaml_search["max_latency_ms"].IsDefined())
+        throw std::runtime_error(ss.str() + "field \"max_latency_ms\" not found.");
+
+    slo_search.param_index    = yaml_search["param"].as<decltype(slo_search.param_index)>();
+    slo_search.quantile       = yaml_search["quantile"].as<decltype(slo_search.quantile)>();
+    slo_search.max_latency_ms = yaml_search["max_latency_ms"].as<decltype(slo_search.max_latency_ms)>();
+    if (yaml_search["confidence"].IsDefined())
+        slo_search.confidence = yaml_search["confidence"].as<decltype(slo_search.confidence)>();
+    if (yaml_search["min_samples"].IsDefined())
+        slo_search.min_samples = yaml_search["min_samples"].as<decltype(slo_search.min_samples)>();
+
+    if (slo_search.param_index >= yaml_bench["params"].size())
+        throw std::runtime_error(ss.str() + "field \"param\" is not a valid parameter index.");
+    if (!(slo_search.quantile > 0.0 && slo_search.quantile < 1.0))
+        throw std::runtime_error(ss.str() + "field \"quantile\" must be in range (0, 1).");
+    if (!(slo_search.max_latency_ms > 0.0))
+        throw std::runtime_error(ss.str() + "field \"max_latency_ms\" must be positive.");
+    if (!(slo_search.confidence > 0.0 && slo_search.confidence < 1.0))
+        throw std::runtime_error(ss.str() + "field \"confidence\" must be in range (0, 1).");
+}
+
+void ConfigImporterImpl::importYAML2OperandSweep(hebench::TestHarness::OperandSweepRequest &operand_sweep,
+                                                 const YAML::Node &yaml_bench,
+                                                 std::size_t benchmark_index)
+{
+    YAML::Node yaml_sweep = yaml_bench["operand_sweep"];
+    std::stringstream ss;
+    ss << "In \"operand_sweep\" for benchmark ID " << benchmark_index << ": ";
+    if (!yaml_sweep["sample_sizes"].IsDefined())
+        throw std::runtime_error(ss.str() + "field \"sample_sizes\" not found.");
+    if (!yaml_sweep["sample_sizes"].IsSequence() || yaml_sweep["sample_sizes"].size() <= 0)
+        throw std::runtime_error(ss.str() + "field \"sample_sizes\" must be a non-empty sequence.");
+
+    operand_sweep.sample_sizes = yaml_sweep["sample_sizes"].as<decltype(operand_sweep.sample_sizes)>();
+    for (std::uint64_t sample_size : operand_sweep.sample_sizes)
+        if (sample_size == 0)
+            throw std::runtime_error(ss.str() + "sample sizes must be positive.");
+}
+
+std::vector<std::string> ConfigImporterImpl::importYAML2KnobValues(const YAML::Node &yaml_values,
+                                                                   const std::string &knob_name)
+{
+    std::vector<std::string> retval;
+    if (!yaml_values.IsSequence() || yaml_values.size() <= 0)
+        throw std::runtime_error("In \"env_sweep\": values for knob \"" + knob_name + "\" must be a non-empty sequence.");
+    for (std::size_t value_i = 0; value_i < yaml_values.size(); ++value_i)
+    {
+        if (yaml_values[value_i].IsSequence())
+        {
+            // list of libraries to preload
+            std::string value;
+            for (std::size_t item_i = 0; item_i < yaml_values[value_i].size(); ++item_i)
+            {
+                if (item_i > 0)
+                    value += ":";
+                value += yaml_values[value_i][item_i].as<std::string>();
+            } // end for
+            retval.push_back(value);
+        } // end if
+        else if (yaml_values[value_i].IsNull())
+            retval.emplace_back();
+        else
+            retval.push_back(yaml_values[value_i].as<std::string>());
+    } // end for
+    return retval;
+}
+
 void ConfigImporterImpl::importYAML2BenchmarkRequest(TestHarness::BenchmarkRequest &bench_req,
                                                      const YAML::Node &yaml_bench,
                                                      const TestHarness::Engine &engine,
@@ -98,6 +209,21 @@ void ConfigImporterImpl::importYAML2BenchmarkRequest(TestHarness::BenchmarkReque
         throw std::runtime_error(ss.str());
     } // end if
 
+    // capacity search grows its parameter during the run instead of expanding its range
+    bool b_slo_search = yaml_bench["slo_search"].IsDefined();
+    if (b_slo_search)
+        importYAML2SLOSearch(bench_req.slo_search, yaml_bench, bench_req.benchmark_index);
+    if (yaml_bench["operand_sweep"].IsDefined())
+    {
+        if (b_slo_search)
+        {
+            std::stringstream ss;
+            ss << "Benchmark ID " << bench_req.benchmark_index << " cannot specify both \"slo_search\" and \"operand_sweep\".";
+            throw std::runtime_error(ss.str());
+        } // end if
+        importYAML2OperandSweep(bench_req.operand_sweep, yaml_bench, bench_req.benchmark_index);
+    } // end if
+
     if (yaml_bench["params"].size() > 0)
     {
         // create a component counter to iterate over the parameters using from-to-step model
@@ -184,6 +310,29 @@ void ConfigImporterImpl::importYAML2BenchmarkRequest(TestHarness::BenchmarkReque
                    << yaml_bench["params"][param_i]["type"].as<std::string>() << ".";
                 throw std::runtime_error(ss.str());
             } // end if
+
+            if (b_slo_search && param_i == bench_req.slo_search.param_index)
+            {
+                // searched parameter starts at "from" in every set
+                if (param_type == "uint64")
+                    computeSLOSearchRange<std::uint64_t>(bench_req.slo_search,
+                                                         yaml_param_value["from"],
+                                                         yaml_param_value["to"],
+                                                         yaml_param_value["step"]);
+                else if (param_type == "int64")
+                    computeSLOSearchRange<std::int64_t>(bench_req.slo_search,
+                                                        yaml_param_value["from"],
+                                                        yaml_param_value["to"],
+                                                        yaml_param_value["step"]);
+                else
+                {
+                    std::stringstream ss;
+                    ss << "Parameter index " << param_i << " searched in \"slo_search\" must be an integer type"
+                       << ", benchmark ID " << bench_req.benchmark_index << ".";
+                    throw std::runtime_error(ss.str());
+                } // end else
+                component_sizes[param_i] = 1;
+            } // end if
         } // end for
 
         hebench::Utilities::Math::ComponentCounter c_counter(component_sizes);
@@ -440,6 +589,16 @@ void BenchmarkConfiguration::saveConfiguration(const std::string &yaml_filename,
         << YAML::Key << "random_seed" << YAML::Value << default_bench_config.random_seed;
     out << YAML::Newline << YAML::Newline;
 
+    ss = std::stringstream();
+    ss << "Number of rounds of probabilistic validation for workloads that support" << std::endl
+       << "it (currently, Matrix Multiplication). When positive, ground truth is not" << std::endl
+       << "computed and each result is checked with Freivalds' algorithm instead:" << std::endl
+       << "an incorrect result passes with probability at most 2^-rounds. Defaults" << std::endl
+       << "to 0 (validate against ground truth) if not present.";
+    out << YAML::Comment(ss.str())
+        << YAML::Key << "probabilistic_validation_rounds" << YAML::Value << default_bench_config.probabilistic_validation_rounds;
+    out << YAML::Newline << YAML::Newline;
+
     out << YAML::EndMap;
 
     // output benchmark list
@@ -462,6 +621,58 @@ void BenchmarkConfiguration::saveConfiguration(const std::string &yaml_filename,
         false, false);
 }
 
+std::vector<hebench::TestHarness::EnvKnob> BenchmarkConfiguration::loadEnvSweep(const std::string &yaml_filename)
+{
+    std::vector<hebench::TestHarness::EnvKnob> retval;
+
+    YAML::Node root = YAML::LoadFile(yaml_filename);
+    if (!root["env_sweep"].IsDefined())
+        return retval;
+    YAML::Node yaml_sweep = root["env_sweep"];
+    if (!yaml_sweep.IsMap())
+        throw std::runtime_error("Value for map \"env_sweep\" is not a valid YAML map.");
+
+    if (yaml_sweep["thp"].IsDefined())
+    {
+        retval.push_back({ hebench::TestHarness::EnvSweep::KnobTHP,
+                           ConfigImporterImpl::importYAML2KnobValues(yaml_sweep["thp"], "thp") });
+        for (const std::string &value : retval.back().values)
+            if (value != hebench::TestHarness::EnvSweep::THPDefault && value != hebench::TestHarness::EnvSweep::THPDisabled)
+                throw std::runtime_error("In \"env_sweep\": values for knob \"thp\" must be \""
+                                         + std::string(hebench::TestHarness::EnvSweep::THPDefault) + "\" or \""
+                                         + std::string(hebench::TestHarness::EnvSweep::THPDisabled) + "\".");
+    } // end if
+    if (yaml_sweep["preload"].IsDefined())
+    {
+        retval.push_back({ hebench::TestHarness::EnvSweep::KnobPreload,
+                           ConfigImporterImpl::importYAML2KnobValues(yaml_sweep["preload"], "preload") });
+        for (const std::string &value : retval.back().values)
+        {
+            // a missing library would only be reported by the loader of every child
+            std::istringstream is(value);
+            std::string lib_path;
+            while (std::getline(is, lib_path, ':'))
+                if (!lib_path.empty() && !std::filesystem::exists(lib_path))
+                    throw std::runtime_error("In \"env_sweep\": library to preload not found: " + lib_path);
+        } // end for
+    } // end if
+    if (yaml_sweep["env"].IsDefined())
+    {
+        if (!yaml_sweep["env"].IsMap())
+            throw std::runtime_error("In \"env_sweep\": value for map \"env\" is not a valid YAML map.");
+        for (auto it = yaml_sweep["env"].begin(); it != yaml_sweep["env"].end(); ++it)
+        {
+            std::string name = it->first.as<std::string>();
+            if (name.empty() || name.find_first_of("=,") != std::string::npos
+                || name == hebench::TestHarness::EnvSweep::KnobTHP || name == hebench::TestHarness::EnvSweep::KnobPreload)
+                throw std::runtime_error("In \"env_sweep\": invalid environment variable name: \"" + name + "\".");
+            retval.push_back({ name, ConfigImporterImpl::importYAML2KnobValues(it->second, name) });
+        } // end for
+    } // end if
+
+    return retval;
+}
+
 std::vector<hebench::TestHarness::BenchmarkRequest> BenchmarkConfiguration::loadConfiguration(const std::string &yaml_filename,
                                                                                               hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig &default_bench_config) const
 {
@@ -487,6 +698,9 @@ std::vector<hebench::TestHarness::BenchmarkRequest> BenchmarkConfiguration::load
     if (root["random_seed"].IsDefined())
         default_bench_config.random_seed =
             root["random_seed"].as<decltype(default_bench_config.random_seed)>();
+    if (root["probabilistic_validation_rounds"].IsDefined())
+        default_bench_config.probabilistic_validation_rounds =
+            root["probabilistic_validation_rounds"].as<decltype(default_bench_config.probabilistic_validation_rounds)>();
 
     root = root["benchmark"];
     if (!root.IsSequence())
@@ -496,14 +710,17 @@ std::vector<hebench::TestHarness::BenchmarkRequest> BenchmarkConfiguration::load
         if (!root[i]["ID"].IsDefined())
             throw std::runtime_error("Field \"ID\" not found on benchmark.");
         std::size_t id = root[i]["ID"].as<std::size_t>();
-        // add benchmark requests for the same ID into the same structure
-        if (map_bench_reqs.count(id) <= 0)
+        // add benchmark requests for the same ID into the same structure,
+        // except capacity searches and operand sweeps, which are configured per request
+        bool b_per_request = root[i]["slo_search"].IsDefined() || root[i]["operand_sweep"].IsDefined();
+        if (b_per_request || map_bench_reqs.count(id) <= 0)
         {
-            map_bench_reqs[id] = retval.size();
+            if (!b_per_request)
+                map_bench_reqs[id] = retval.size();
             retval.emplace_back();
             retval.back().benchmark_index = id;
         } // end if
-        hebench::TestHarness::BenchmarkRequest &bench_req = retval[map_bench_reqs[id]];
+        hebench::TestHarness::BenchmarkRequest &bench_req = b_per_request ? retval.back() : retval[map_bench_reqs[id]];
         ConfigImporterImpl::importYAML2BenchmarkRequest(bench_req, root[i], *p_engine, default_bench_config);
     } // end for
 
@@ -0,0 +1,238 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "modules/general/include/error.h"
+#include "modules/logging/include/logging.h"
+
+#include "../include/hebench_daemon.h"
+#include "hebench/api_bridge/types.h"
+
+namespace hebench {
+namespace TestHarness {
+
+namespace {
+
+/**
+ * @brief Reads a request line from a client.
+ * @returns The line without the trailing end of line.
+ * @throws std::runtime_error if the connection fails or the request is too long.
+ */
+std::string receiveLine(int socket_fd)
+{
+    std::string retval;
+    char ch = '\0';
+    while (ch != '\n')
+    {
+        ssize_t received = ::recv(socket_fd, &ch, 1, 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received < 0)
+            throw std::runtime_error("Connection to client lost: " + std::string(std::strerror(errno)));
+        if (received == 0)
+            break; // client may omit the last end of line
+        if (ch != '\n' && ch != '\r')
+            retval.push_back(ch);
+        if (retval.size() > HarnessDaemon::MaxRequestSize)
+            throw std::runtime_error("Request too long.");
+    } // end while
+    return retval;
+}
+
+/**
+ * @brief Sends a response to a client.
+ * @details Errors are ignored: clients may leave without waiting for the
+ * response, which must not stop the daemon.
+ */
+void sendResponse(int socket_fd, const std::string &response)
+{
+    const char *p    = response.data();
+    std::size_t size = response.size();
+    while (size > 0)
+    {
+        ssize_t written = ::send(socket_fd, p, size, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            break;
+        p += written;
+        size -= static_cast<std::size_t>(written);
+    } // end while
+}
+
+std::string toSingleLine(std::string s)
+{
+    for (char &ch : s)
+        if (ch == '\n' || ch == '\r')
+            ch = ' ';
+    return s;
+}
+
+} // namespace
+
+//----------------------
+// class BenchmarkCache
+//----------------------
+
+std::string BenchmarkCache::getKey(const IBenchmarkDescription::Description &description,
+                                   const IBenchmarkDescription::BenchmarkConfig &bench_config)
+{
+    std::stringstream ss;
+    ss << description.path << std::endl
+       << description.header << std::endl
+       << bench_config.random_seed << ", "
+       << bench_config.default_min_test_time_ms << ", "
+       << bench_config.default_sample_size << ", "
+       << bench_config.probabilistic_validation_rounds << ", "
+       << bench_config.min_latency_iterations;
+    return ss.str();
+}
+
+IBenchmark::Ptr BenchmarkCache::find(const std::string &key)
+{
+    IBenchmark::Ptr retval;
+    if (m_p_bench && key == m_key)
+    {
+        retval = m_p_bench;
+        ++m_hit_count;
+    } // end if
+    else
+        ++m_miss_count;
+    return retval;
+}
+
+void BenchmarkCache::store(const std::string &key, IBenchmark::Ptr p_bench)
+{
+    clear();
+    m_key     = key;
+    m_p_bench = p_bench;
+}
+
+void BenchmarkCache::clear()
+{
+    m_p_bench.reset();
+    m_key.clear();
+}
+
+//---------------------
+// class HarnessDaemon
+//---------------------
+
+void HarnessDaemon::serve(const std::string &socket_path, const RunHandler &handler)
+{
+    struct sockaddr_un addr;
+    if (socket_path.size() >= sizeof(addr.sun_path))
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Daemon socket path is too long: " + socket_path));
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to create daemon socket: " + std::string(std::strerror(errno))));
+    // close listening socket and remove it from the file system on any exit path
+    std::unique_ptr<int, std::function<void(int *)>> p_listen_fd(&listen_fd, [&socket_path](int *p_fd) {
+        ::close(*p_fd);
+        ::unlink(socket_path.c_str());
+    });
+
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    ::unlink(socket_path.c_str()); // remove stale socket from a previous run
+    if (bind(listen_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0
+        || listen(listen_fd, 8) != 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to bind daemon socket \"" + socket_path + "\": " + std::strerror(errno)));
+
+    // cached benchmark must be destroyed before the engine, so, it lives in here
+    BenchmarkCache bench_cache;
+
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Daemon waiting for requests on " + socket_path + "...") << std::endl;
+
+    bool b_shutdown = false;
+    while (!b_shutdown)
+    {
+        int client_fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client_fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to accept daemon connection: " + std::string(std::strerror(errno))));
+        } // end if
+        std::unique_ptr<int, void (*)(int *)> p_client_fd(&client_fd, [](int *p_fd) { ::close(*p_fd); });
+
+        std::exception_ptr p_critical_ex;
+        std::stringstream response;
+        try
+        {
+            std::string request = receiveLine(client_fd);
+            std::string command = request.substr(0, request.find(' '));
+            std::string argument;
+            if (command.size() < request.size())
+                argument = request.substr(command.size() + 1);
+
+            std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Daemon request: " + request) << std::endl;
+
+            if (command == "run")
+            {
+                if (argument.empty())
+                    throw std::invalid_argument("Missing benchmark configuration file.");
+                std::vector<std::string> failed_benchmarks = handler(argument, bench_cache);
+                if (failed_benchmarks.empty())
+                    response << "OK" << std::endl;
+                else
+                {
+                    response << "FAILED " << failed_benchmarks.size() << std::endl;
+                    for (const std::string &bench_path : failed_benchmarks)
+                        response << bench_path << std::endl;
+                } // end else
+            } // end if
+            else if (command == "evict")
+            {
+                bench_cache.clear();
+                response << "OK" << std::endl;
+            } // end else if
+            else if (command == "status")
+                response << "OK " << bench_cache.getHitCount() << " " << bench_cache.getMissCount() << std::endl;
+            else if (command == "shutdown")
+            {
+                b_shutdown = true;
+                response << "OK" << std::endl;
+            } // end else if
+            else
+                throw std::invalid_argument("Unknown request \"" + command + "\".");
+        }
+        catch (hebench::Common::ErrorException &err_num)
+        {
+            bench_cache.clear();
+            response = std::stringstream();
+            response << "ERROR " << toSingleLine(err_num.what()) << std::endl;
+            if (err_num.getErrorCode() == HEBENCH_ECODE_CRITICAL_ERROR)
+                p_critical_ex = std::current_exception();
+        }
+        catch (std::exception &ex)
+        {
+            bench_cache.clear();
+            response = std::stringstream();
+            response << "ERROR " << toSingleLine(ex.what()) << std::endl;
+        }
+
+        sendResponse(client_fd, response.str());
+        if (p_critical_ex)
+            std::rethrow_exception(p_critical_ex);
+    } // end while
+
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Daemon shut down.") << std::endl;
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -0,0 +1,866 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "modules/logging/include/logging.h"
+
+#include "../include/hebench_benchmark_runner.h"
+#include "../include/hebench_distributed.h"
+#include "../include/hebench_types_harness.h"
+#include "include/hebench_version.h"
+
+namespace hebench {
+namespace TestHarness {
+
+namespace {
+
+constexpr std::uint32_t FrameMagic      = 0x44424548; // "HEBD"
+constexpr std::uint32_t ProtocolVersion = 2;
+constexpr std::uint64_t MaxTokenSize    = 4096; // bytes accepted before authentication
+
+enum class FrameType : std::uint32_t
+{
+    Hello     = 1, // worker -> coordinator: worker identity
+    Job       = 2, // coordinator -> worker: job id and configuration
+    Heartbeat = 3, // worker -> coordinator: job still running
+    Result    = 4, // worker -> coordinator: job outcome and report files
+    Auth      = 5 // coordinator -> worker: shared token, first message sent
+};
+
+struct FrameHeader
+{
+    std::uint32_t magic;
+    std::uint32_t type;
+    std::uint64_t size;
+};
+
+/**
+ * @brief Identity that coordinator and workers must share to work together.
+ */
+std::string getIdentity()
+{
+    std::stringstream ss;
+    ss << "protocol " << ProtocolVersion << "; "
+       << HEBENCH_TEST_HARNESS_APP_NAME << " v"
+       << HEBENCH_TEST_HARNESS_VERSION_MAJOR << "."
+       << HEBENCH_TEST_HARNESS_VERSION_MINOR << "."
+       << HEBENCH_TEST_HARNESS_VERSION_REVISION << "-"
+       << HEBENCH_TEST_HARNESS_VERSION_BUILD;
+    return ss.str();
+}
+
+/**
+ * @brief Compares tokens in time independent of where they differ.
+ */
+bool isSameToken(const std::string &lhs, const std::string &rhs)
+{
+    unsigned char diff = lhs.size() == rhs.size() ? 0 : 1;
+    std::size_t size   = std::max(lhs.size(), rhs.size());
+    for (std::size_t i = 0; i < size; ++i)
+        diff |= static_cast<unsigned char>((i < lhs.size() ? lhs[i] : 0) ^ (i < rhs.size() ? rhs[i] : 0));
+    return diff == 0;
+}
+
+class PayloadWriter
+{
+public:
+    void putU64(std::uint64_t value) { m_data.append(reinterpret_cast<const char *>(&value), sizeof(value)); }
+    void putString(const std::string &value)
+    {
+        putU64(value.size());
+        m_data.append(value);
+    }
+    const std::string &data() const { return m_data; }
+
+private:
+    std::string m_data;
+};
+
+class PayloadReader
+{
+private:
+    IL_DECLARE_CLASS_NAME(PayloadReader)
+
+public:
+    PayloadReader(const std::string &data) :
+        m_data(data), m_pos(0) {}
+
+    std::uint64_t getU64()
+    {
+        std::uint64_t retval;
+        check(sizeof(retval));
+        std::memcpy(&retval, m_data.data() + m_pos, sizeof(retval));
+        m_pos += sizeof(retval);
+        return retval;
+    }
+    std::string getString()
+    {
+        std::uint64_t size = getU64();
+        check(size);
+        std::string retval = m_data.substr(m_pos, size);
+        m_pos += size;
+        return retval;
+    }
+
+private:
+    void check(std::uint64_t size) const
+    {
+        if (size > m_data.size() - m_pos)
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Malformed message received."));
+    }
+
+    const std::string &m_data;
+    std::size_t m_pos;
+};
+
+/**
+ * @brief Framed message connection over a TCP socket.
+ * @details Sending is thread-safe. Receiving must be done from a single thread.
+ */
+class Connection
+{
+public:
+    DISABLE_COPY(Connection)
+    DISABLE_MOVE(Connection)
+private:
+    IL_DECLARE_CLASS_NAME(Connection)
+
+public:
+    Connection(int socket_fd, const std::string &address) :
+        m_socket_fd(socket_fd), m_address(address) {}
+    ~Connection() { ::close(m_socket_fd); }
+
+    static std::unique_ptr<Connection> connectTo(const std::string &address);
+
+    const std::string &address() const { return m_address; }
+
+    void send(FrameType type, const std::string &payload = std::string());
+    /**
+     * @brief Receives the next message.
+     * @param[in] timeout_ms Maximum time to wait for data. Negative to wait
+     * indefinitely.
+     * @param[in] max_size Maximum size of the payload accepted.
+     * @returns `false` if no message started arriving before timeout.
+     * @throws std::runtime_error if connection is closed or fails, or the
+     * payload is larger than \p max_size.
+     */
+    bool receive(FrameType &type, std::string &payload, int timeout_ms,
+                 std::uint64_t max_size = std::numeric_limits<std::uint64_t>::max());
+
+private:
+    void sendAll(const void *p_data, std::size_t size);
+    void receiveAll(void *p_data, std::size_t size, int timeout_ms);
+    bool waitReadable(int timeout_ms) const;
+
+    int m_socket_fd;
+    std::string m_address;
+    std::mutex m_send_mtx;
+};
+
+std::unique_ptr<Connection> Connection::connectTo(const std::string &address)
+{
+    std::size_t colon_pos = address.rfind(':');
+    if (colon_pos == std::string::npos || colon_pos == 0 || colon_pos + 1 >= address.size())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid worker address \"" + address + "\". Expected \"host:port\"."));
+    std::string s_host = address.substr(0, colon_pos);
+    std::string s_port = address.substr(colon_pos + 1);
+
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *p_addresses = nullptr;
+    int err                      = getaddrinfo(s_host.c_str(), s_port.c_str(), &hints, &p_addresses);
+    if (err != 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to resolve worker address \"" + address + "\": " + gai_strerror(err)));
+
+    int socket_fd = -1;
+    for (struct addrinfo *p = p_addresses; p && socket_fd < 0; p = p->ai_next)
+    {
+        socket_fd = socket(p->ai_family, p->ai_socktype | SOCK_CLOEXEC, p->ai_protocol);
+        if (socket_fd >= 0 && connect(socket_fd, p->ai_addr, p->ai_addrlen) != 0)
+        {
+            ::close(socket_fd);
+            socket_fd = -1;
+        } // end if
+    } // end for
+    freeaddrinfo(p_addresses);
+    if (socket_fd < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to connect to worker \"" + address + "\"."));
+
+    return std::make_unique<Connection>(socket_fd, address);
+}
+
+void Connection::send(FrameType type, const std::string &payload)
+{
+    FrameHeader header;
+    header.magic = FrameMagic;
+    header.type  = static_cast<std::uint32_t>(type);
+    header.size  = payload.size();
+
+    std::lock_guard<std::mutex> lock(m_send_mtx);
+    sendAll(&header, sizeof(header));
+    sendAll(payload.data(), payload.size());
+}
+
+bool Connection::receive(FrameType &type, std::string &payload, int timeout_ms, std::uint64_t max_size)
+{
+    if (!waitReadable(timeout_ms))
+        return false;
+
+    FrameHeader header;
+    receiveAll(&header, sizeof(header), timeout_ms);
+    if (header.magic != FrameMagic)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Invalid message received from \"" + m_address + "\"."));
+    if (header.size > max_size)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Message received from \"" + m_address + "\" is too large."));
+    type = static_cast<FrameType>(header.type);
+    payload.resize(header.size);
+    receiveAll(payload.data(), payload.size(), timeout_ms);
+
+    return true;
+}
+
+void Connection::sendAll(const void *p_data, std::size_t size)
+{
+    const char *p = reinterpret_cast<const char *>(p_data);
+    while (size > 0)
+    {
+        ssize_t written = ::send(m_socket_fd, p, size, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Connection to \"" + m_address + "\" lost: " + std::strerror(errno)));
+        p += written;
+        size -= static_cast<std::size_t>(written);
+    } // end while
+}
+
+void Connection::receiveAll(void *p_data, std::size_t size, int timeout_ms)
+{
+    char *p = reinterpret_cast<char *>(p_data);
+    while (size > 0)
+    {
+        if (!waitReadable(timeout_ms))
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Timed out receiving message from \"" + m_address + "\"."));
+        ssize_t received = ::recv(m_socket_fd, p, size, 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received == 0)
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Connection closed by \"" + m_address + "\"."));
+        if (received < 0)
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Connection to \"" + m_address + "\" lost: " + std::strerror(errno)));
+        p += received;
+        size -= static_cast<std::size_t>(received);
+    } // end while
+}
+
+bool Connection::waitReadable(int timeout_ms) const
+{
+    struct pollfd pfd;
+    pfd.fd     = m_socket_fd;
+    pfd.events = POLLIN;
+    int ready;
+    do
+    {
+        pfd.revents = 0;
+        ready       = poll(&pfd, 1, timeout_ms);
+    } while (ready < 0 && errno == EINTR);
+    if (ready < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Connection to \"" + m_address + "\" lost: " + std::strerror(errno)));
+    // hang-ups and errors are reported by the following recv()
+    return ready > 0;
+}
+
+std::string readBinaryFile(const std::filesystem::path &filename)
+{
+    std::ifstream fnum(filename, std::ios_base::in | std::ios_base::binary);
+    if (!fnum.is_open())
+        throw std::ios_base::failure("Failed to open file \"" + filename.string() + "\" for reading.");
+    return std::string(std::istreambuf_iterator<char>(fnum), std::istreambuf_iterator<char>());
+}
+
+void writeBinaryFile(const std::filesystem::path &filename, const std::string &data)
+{
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    if (!fnum.is_open())
+        throw std::ios_base::failure("Failed to open file \"" + filename.string() + "\" for writing.");
+    fnum.write(data.data(), data.size());
+    if (!fnum)
+        throw std::ios_base::failure("Error after opening file \"" + filename.string() + "\" for writing.");
+}
+
+} // namespace
+
+//------------------------------------
+// class DistributedCoordinator::Impl
+//------------------------------------
+
+/**
+ * @brief Shared state of a distributed run.
+ * @details Every worker is served by its own thread, which pulls jobs from a
+ * common queue sorted by decreasing estimated run time.
+ */
+class DistributedCoordinator::Impl
+{
+private:
+    IL_DECLARE_CLASS_NAME(DistributedCoordinator::Impl)
+
+public:
+    Impl(const std::vector<DistributedJob> &jobs,
+         const std::string &token,
+         const std::filesystem::path &report_root,
+         const std::filesystem::path &history_file);
+
+    void workerLoop(const std::string &address);
+    std::vector<std::string> finish();
+
+private:
+    enum class JobStatus
+    {
+        Pending,
+        Succeeded,
+        Failed
+    };
+
+    struct JobState
+    {
+        JobStatus status;
+        std::size_t attempts;
+        double elapsed_s;
+    };
+
+    void loadHistory();
+    void saveHistory() const;
+    void storeResult(std::size_t job_i, const std::string &payload, const std::string &address);
+    void log(const std::string &prefix, const std::string &msg);
+
+    const std::vector<DistributedJob> &m_jobs;
+    std::string m_token;
+    std::filesystem::path m_report_root;
+    std::filesystem::path m_history_file;
+    std::unordered_map<std::string, double> m_history;
+
+    std::mutex m_mtx; // protects job state and console output
+    std::condition_variable m_cv;
+    std::deque<std::size_t> m_pending;
+    std::size_t m_in_flight;
+    std::vector<JobState> m_job_states;
+};
+
+DistributedCoordinator::Impl::Impl(const std::vector<DistributedJob> &jobs,
+                                   const std::string &token,
+                                   const std::filesystem::path &report_root,
+                                   const std::filesystem::path &history_file) :
+    m_jobs(jobs),
+    m_token(token),
+    m_report_root(report_root),
+    m_history_file(history_file),
+    m_in_flight(0),
+    m_job_states(jobs.size(), JobState{ JobStatus::Pending, 0, 0.0 })
+{
+    loadHistory();
+
+    // estimate jobs without history as the mean of the known ones
+    double known_total       = 0.0;
+    std::size_t known_count  = 0;
+    std::vector<double> estimates(m_jobs.size(), -1.0);
+    for (std::size_t job_i = 0; job_i < m_jobs.size(); ++job_i)
+    {
+        auto it = m_history.find(m_jobs[job_i].bench_path);
+        if (it != m_history.end())
+        {
+            estimates[job_i] = it->second;
+            known_total += it->second;
+            ++known_count;
+        } // end if
+    } // end for
+    double default_estimate = known_count > 0 ? known_total / known_count : 0.0;
+    for (double &estimate : estimates)
+        if (estimate < 0.0)
+            estimate = default_estimate;
+
+    // longest processing time first: workers pull from the front of the queue
+    std::vector<std::size_t> order(m_jobs.size());
+    for (std::size_t job_i = 0; job_i < order.size(); ++job_i)
+        order[job_i] = job_i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&estimates](std::size_t a, std::size_t b) { return estimates[a] > estimates[b]; });
+    m_pending.assign(order.begin(), order.end());
+}
+
+void DistributedCoordinator::Impl::loadHistory()
+{
+    if (m_history_file.empty() || !std::filesystem::exists(m_history_file))
+        return;
+
+    std::ifstream fnum(m_history_file);
+    std::string s_line;
+    while (std::getline(fnum, s_line))
+    {
+        // each line is "<seconds>,<benchmark path>"
+        std::size_t comma_pos = s_line.find(',');
+        if (s_line.empty() || s_line.front() == '#' || comma_pos == std::string::npos)
+            continue;
+        try
+        {
+            m_history[s_line.substr(comma_pos + 1)] = std::stod(s_line.substr(0, comma_pos));
+        }
+        catch (...)
+        {
+            // ignore malformed lines
+        }
+    } // end while
+}
+
+void DistributedCoordinator::Impl::saveHistory() const
+{
+    if (m_history_file.empty())
+        return;
+
+    std::filesystem::path tmp_path = m_history_file;
+    tmp_path += ".tmp";
+    {
+        std::ofstream fnum(tmp_path, std::ios_base::out | std::ios_base::trunc);
+        if (!fnum.is_open())
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to open job history file: " + tmp_path.string()));
+        fnum << "# seconds,benchmark path" << std::endl;
+        for (const auto &entry : m_history)
+            fnum << entry.second << "," << entry.first << std::endl;
+    }
+    std::filesystem::rename(tmp_path, m_history_file);
+}
+
+void DistributedCoordinator::Impl::log(const std::string &prefix, const std::string &msg)
+{
+    // must be called with m_mtx locked
+    std::cout << prefix << hebench::Logging::GlobalLogger::log(msg) << std::endl;
+}
+
+void DistributedCoordinator::Impl::workerLoop(const std::string &address)
+{
+    std::unique_ptr<Connection> p_conn;
+    try
+    {
+        p_conn = Connection::connectTo(address);
+        p_conn->send(FrameType::Auth, m_token);
+        FrameType type;
+        std::string payload;
+        bool b_identified;
+        try
+        {
+            b_identified = p_conn->receive(type, payload, static_cast<int>(WorkerTimeoutMs))
+                           && type == FrameType::Hello;
+        }
+        catch (std::runtime_error &)
+        {
+            // workers drop connections with invalid tokens
+            b_identified = false;
+        }
+        if (!b_identified)
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Worker \"" + address + "\" did not identify itself. "
+                                                      + "Make sure coordinator and worker share the same token."));
+        if (payload != getIdentity())
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Worker \"" + address + "\" is not compatible: " + payload));
+
+        std::lock_guard<std::mutex> lock(m_mtx);
+        log(IOS_MSG_OK, "Connected to worker: " + address);
+    }
+    catch (std::exception &ex)
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        log(IOS_MSG_WARNING, ex.what());
+        return;
+    }
+
+    while (true)
+    {
+        std::size_t job_i;
+        {
+            std::unique_lock<std::mutex> lock(m_mtx);
+            // jobs in flight on other workers may still be re-dispatched
+            m_cv.wait(lock, [this]() { return !m_pending.empty() || m_in_flight == 0; });
+            if (m_pending.empty())
+                break; // all jobs completed
+
+            job_i = m_pending.front();
+            m_pending.pop_front();
+            ++m_in_flight;
+            ++m_job_states[job_i].attempts;
+            log(IOS_MSG_INFO, address + " <- " + m_jobs[job_i].bench_path);
+        }
+
+        bool b_completed = false;
+        std::string s_error;
+        try
+        {
+            PayloadWriter job_payload;
+            job_payload.putU64(job_i);
+            job_payload.putString(m_jobs[job_i].config);
+            p_conn->send(FrameType::Job, job_payload.data());
+
+            FrameType type;
+            std::string payload;
+            do
+            {
+                if (!p_conn->receive(type, payload, static_cast<int>(WorkerTimeoutMs)))
+                    throw std::runtime_error(IL_LOG_MSG_CLASS("Worker \"" + address + "\" stopped responding."));
+            } while (type == FrameType::Heartbeat);
+            if (type != FrameType::Result)
+                throw std::runtime_error(IL_LOG_MSG_CLASS("Unexpected message received from worker \"" + address + "\"."));
+
+            storeResult(job_i, payload, address);
+            b_completed = true;
+        }
+        catch (std::exception &ex)
+        {
+            s_error = ex.what();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mtx);
+        --m_in_flight;
+        if (!b_completed)
+        {
+            // worker lost: hand its job over to the remaining workers
+            log(IOS_MSG_WARNING, s_error);
+            if (m_job_states[job_i].attempts < MaxJobAttempts)
+            {
+                log(IOS_MSG_WARNING, "Re-dispatching job: " + m_jobs[job_i].bench_path);
+                m_pending.push_front(job_i);
+            } // end if
+            else
+            {
+                log(IOS_MSG_ERROR, "Job failed after " + std::to_string(MaxJobAttempts) + " attempts: " + m_jobs[job_i].bench_path);
+                m_job_states[job_i].status = JobStatus::Failed;
+            } // end else
+        } // end if
+        m_cv.notify_all();
+        if (!b_completed)
+            break;
+    } // end while
+}
+
+void DistributedCoordinator::Impl::storeResult(std::size_t job_i, const std::string &payload, const std::string &address)
+{
+    PayloadReader result(payload);
+    if (result.getU64() != job_i)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Result for unexpected job received from worker \"" + address + "\"."));
+    bool b_succeeded     = result.getU64() != 0;
+    double elapsed_s     = static_cast<double>(result.getU64()) / 1000.0;
+    std::string s_error  = result.getString();
+    std::uint64_t nfiles = result.getU64();
+
+    // drop any stale report in this location so that a failed job is not
+    // mistaken for a successful one
+    std::filesystem::path bench_path = m_jobs[job_i].bench_path;
+    if (bench_path.is_relative())
+        std::filesystem::remove(BenchmarkRunner::getReportFilename(m_report_root, bench_path));
+
+    for (std::uint64_t file_i = 0; file_i < nfiles; ++file_i)
+    {
+        std::filesystem::path file_path = result.getString();
+        std::string data                = result.getString();
+        bool b_valid_path               = !file_path.empty() && file_path.is_relative();
+        for (auto it = file_path.begin(); b_valid_path && it != file_path.end(); ++it)
+            b_valid_path = (*it != "..");
+        if (!b_valid_path)
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Invalid report file path received from worker \"" + address + "\": " + file_path.string()));
+
+        std::filesystem::path output_path = m_report_root / file_path;
+        std::filesystem::create_directories(output_path.parent_path());
+        writeBinaryFile(output_path, data);
+    } // end for
+
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_job_states[job_i].elapsed_s = elapsed_s;
+    if (b_succeeded)
+    {
+        m_job_states[job_i].status = JobStatus::Succeeded;
+        std::stringstream ss;
+        ss << address << " -> " << m_jobs[job_i].bench_path << " (" << elapsed_s << " s)";
+        log(IOS_MSG_OK, ss.str());
+    } // end if
+    else
+    {
+        m_job_states[job_i].status = JobStatus::Failed;
+        log(IOS_MSG_FAILED, address + " -> " + m_jobs[job_i].bench_path + (s_error.empty() ? std::string() : ": " + s_error));
+    } // end else
+}
+
+std::vector<std::string> DistributedCoordinator::Impl::finish()
+{
+    std::vector<std::string> retval;
+
+    for (std::size_t job_i = 0; job_i < m_jobs.size(); ++job_i)
+    {
+        switch (m_job_states[job_i].status)
+        {
+        case JobStatus::Succeeded:
+            m_history[m_jobs[job_i].bench_path] = m_job_states[job_i].elapsed_s;
+            break;
+
+        default:
+            // failed or never run because all workers were lost
+            retval.push_back(m_jobs[job_i].bench_path);
+            break;
+        } // end switch
+    } // end for
+
+    saveHistory();
+
+    return retval;
+}
+
+//------------------------------
+// class DistributedCoordinator
+//------------------------------
+
+DistributedCoordinator::DistributedCoordinator(const std::vector<std::string> &workers,
+                                               const std::string &token,
+                                               const std::filesystem::path &report_root,
+                                               const std::filesystem::path &history_file) :
+    m_workers(workers),
+    m_token(token),
+    m_report_root(report_root),
+    m_history_file(history_file)
+{
+    if (m_workers.empty())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("At least one worker is required."));
+    if (m_token.empty())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid empty token shared with workers."));
+}
+
+std::vector<std::string> DistributedCoordinator::run(const std::vector<DistributedJob> &jobs)
+{
+    Impl impl(jobs, m_token, m_report_root, m_history_file);
+
+    std::vector<std::thread> worker_threads;
+    worker_threads.reserve(m_workers.size());
+    for (const std::string &address : m_workers)
+        worker_threads.emplace_back(&Impl::workerLoop, &impl, address);
+    for (std::thread &worker_thread : worker_threads)
+        worker_thread.join();
+
+    return impl.finish();
+}
+
+//-------------------------
+// class DistributedWorker
+//-------------------------
+
+void DistributedWorker::serve(const std::string &bind_address,
+                              std::uint16_t port,
+                              const std::string &token,
+                              const std::filesystem::path &work_dir,
+                              const JobHandler &handler)
+{
+    if (token.empty())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid empty token shared with coordinators."));
+
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family              = AF_UNSPEC;
+    hints.ai_socktype            = SOCK_STREAM;
+    hints.ai_flags               = AI_PASSIVE;
+    struct addrinfo *p_addresses = nullptr;
+    std::string s_port           = std::to_string(port);
+    int err                      = getaddrinfo(bind_address.c_str(), s_port.c_str(), &hints, &p_addresses);
+    if (err != 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to resolve worker bind address \"" + bind_address + "\": " + gai_strerror(err)));
+
+    int listen_fd = -1;
+    int bind_err  = 0;
+    for (struct addrinfo *p = p_addresses; p && listen_fd < 0; p = p->ai_next)
+    {
+        listen_fd = socket(p->ai_family, p->ai_socktype | SOCK_CLOEXEC, p->ai_protocol);
+        if (listen_fd < 0)
+        {
+            bind_err = errno;
+            continue;
+        } // end if
+        int reuse = 1;
+        setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (bind(listen_fd, p->ai_addr, p->ai_addrlen) != 0
+            || listen(listen_fd, 1) != 0)
+        {
+            bind_err = errno;
+            ::close(listen_fd);
+            listen_fd = -1;
+        } // end if
+    } // end for
+    freeaddrinfo(p_addresses);
+    if (listen_fd < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to listen on " + bind_address + ":" + s_port + ": " + std::strerror(bind_err)));
+    // close listening socket on any exit path
+    std::unique_ptr<int, void (*)(int *)> p_listen_fd(&listen_fd, [](int *p_fd) { ::close(*p_fd); });
+
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Worker waiting for coordinator on " + bind_address + ":" + s_port + "...") << std::endl;
+
+    while (true)
+    {
+        struct sockaddr_storage client_addr;
+        socklen_t client_addr_len = sizeof(client_addr);
+        int client_fd             = accept4(listen_fd, reinterpret_cast<struct sockaddr *>(&client_addr), &client_addr_len, SOCK_CLOEXEC);
+        if (client_fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to accept coordinator connection: " + std::string(std::strerror(errno))));
+        } // end if
+
+        char client_host[NI_MAXHOST];
+        if (getnameinfo(reinterpret_cast<struct sockaddr *>(&client_addr), client_addr_len,
+                        client_host, sizeof(client_host), nullptr, 0, NI_NUMERICHOST)
+            != 0)
+            std::strcpy(client_host, "unknown");
+        Connection conn(client_fd, client_host);
+
+        // no job configuration is accepted before the token is presented
+        bool b_authorized = false;
+        try
+        {
+            FrameType type;
+            std::string payload;
+            b_authorized = conn.receive(type, payload, static_cast<int>(AuthTimeoutMs), MaxTokenSize)
+                           && type == FrameType::Auth
+                           && isSameToken(payload, token);
+        }
+        catch (std::exception &)
+        {
+            b_authorized = false;
+        }
+        if (!b_authorized)
+        {
+            std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("Rejected connection from " + conn.address() + ": invalid token.") << std::endl;
+            continue;
+        } // end if
+
+        std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log("Coordinator connected from " + conn.address() + ".") << std::endl;
+
+        std::exception_ptr p_handler_ex;
+        try
+        {
+            conn.send(FrameType::Hello, getIdentity());
+            FrameType type;
+            std::string payload;
+            while (!p_handler_ex && conn.receive(type, payload, -1))
+            {
+                if (type != FrameType::Job)
+                    throw std::runtime_error(IL_LOG_MSG_CLASS("Unexpected message received from coordinator."));
+
+                PayloadReader job(payload);
+                std::uint64_t job_id = job.getU64();
+                std::string s_config = job.getString();
+
+                std::filesystem::path job_dir     = work_dir / ("job_" + std::to_string(job_id));
+                std::filesystem::path report_root = job_dir / "reports";
+                std::filesystem::path config_file = job_dir / "config.yaml";
+                std::filesystem::remove_all(job_dir);
+                std::filesystem::create_directories(report_root);
+                writeBinaryFile(config_file, s_config);
+
+                // keep coordinator informed while the job runs
+                std::mutex heartbeat_mtx;
+                std::condition_variable heartbeat_cv;
+                bool b_job_done = false;
+                std::thread heartbeat_thread([&]() {
+                    std::unique_lock<std::mutex> lock(heartbeat_mtx);
+                    while (!heartbeat_cv.wait_for(lock, std::chrono::milliseconds(HeartbeatIntervalMs),
+                                                  [&b_job_done]() { return b_job_done; }))
+                    {
+                        try
+                        {
+                            conn.send(FrameType::Heartbeat);
+                        }
+                        catch (...)
+                        {
+                            break; // connection loss is detected by the main loop
+                        }
+                    } // end while
+                });
+
+                bool b_succeeded = false;
+                std::string s_error;
+                auto start_time = std::chrono::steady_clock::now();
+                try
+                {
+                    b_succeeded = handler(config_file, report_root);
+                }
+                catch (std::exception &ex)
+                {
+                    s_error      = ex.what();
+                    p_handler_ex = std::current_exception();
+                }
+                catch (...)
+                {
+                    s_error      = "Unknown error.";
+                    p_handler_ex = std::current_exception();
+                }
+                auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count();
+
+                {
+                    std::lock_guard<std::mutex> lock(heartbeat_mtx);
+                    b_job_done = true;
+                }
+                heartbeat_cv.notify_all();
+                heartbeat_thread.join();
+
+                // send back all report files produced by the job
+                std::vector<std::filesystem::path> files;
+                for (const auto &entry : std::filesystem::recursive_directory_iterator(report_root))
+                    if (entry.is_regular_file())
+                        files.push_back(entry.path());
+                PayloadWriter result;
+                result.putU64(job_id);
+                result.putU64(b_succeeded && !p_handler_ex ? 1 : 0);
+                result.putU64(static_cast<std::uint64_t>(elapsed_ms));
+                result.putString(s_error);
+                result.putU64(files.size());
+                for (const std::filesystem::path &file_path : files)
+                {
+                    result.putString(file_path.lexically_relative(report_root).generic_string());
+                    result.putString(readBinaryFile(file_path));
+                } // end for
+                conn.send(FrameType::Result, result.data());
+
+                std::filesystem::remove_all(job_dir);
+            } // end while
+        }
+        catch (std::exception &ex)
+        {
+            std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log(ex.what()) << std::endl;
+        }
+
+        if (p_handler_ex)
+            std::rethrow_exception(p_handler_ex);
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Coordinator disconnected.") << std::endl;
+    } // end while
+}
+
+} // namespace TestHarness
+} // namespace hebench
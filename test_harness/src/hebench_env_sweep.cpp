@@ -0,0 +1,425 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+#include <fcntl.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "include/hebench_benchmark_runner.h"
+#include "include/hebench_env_sweep.h"
+#include "include/hebench_live_metrics.h"
+#include "include/hebench_progress.h"
+
+extern char **environ;
+
+namespace hebench {
+namespace TestHarness {
+
+std::vector<EnvSweep::Combination> EnvSweep::expand(const std::vector<EnvKnob> &knobs)
+{
+    std::vector<Combination> retval(1);
+    for (const EnvKnob &knob : knobs)
+    {
+        std::vector<Combination> expanded;
+        expanded.reserve(retval.size() * knob.values.size());
+        for (const Combination &combination : retval)
+        {
+            for (const std::string &value : knob.values)
+            {
+                expanded.push_back(combination);
+                expanded.back().push_back(value);
+            } // end for
+        } // end for
+        retval.swap(expanded);
+    } // end for
+    return retval;
+}
+
+std::string EnvSweep::toString(const std::vector<EnvKnob> &knobs, const Combination &combination)
+{
+    std::stringstream ss;
+    for (std::size_t knob_i = 0; knob_i < knobs.size() && knob_i < combination.size(); ++knob_i)
+    {
+        if (knob_i > 0)
+            ss << " ";
+        ss << knobs[knob_i].name << "=" << (combination[knob_i].empty() ? Unset : combination[knob_i]);
+    } // end for
+    return ss.str();
+}
+
+std::string EnvSweep::toChildArgument(const std::vector<EnvKnob> &knobs)
+{
+    std::stringstream ss;
+    for (std::size_t knob_i = 0; knob_i < knobs.size(); ++knob_i)
+    {
+        if (knob_i > 0)
+            ss << ",";
+        ss << knobs[knob_i].name;
+    } // end for
+    return ss.str();
+}
+
+void EnvSweep::runChild(const std::vector<EnvKnob> &knobs,
+                        const Combination &combination,
+                        const std::vector<std::string> &child_args,
+                        const std::filesystem::path &log_file)
+{
+    if (combination.size() != knobs.size())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Combination does not match the knobs."));
+
+    std::vector<char *> argv;
+    std::string arg0 = "test_harness";
+    argv.push_back(arg0.data());
+    for (const std::string &arg : child_args)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    // environment of the child: ours, with the swept variables replaced
+    int thp_disable = -1; // inherited
+    std::unordered_set<std::string> env_names;
+    std::vector<std::string> env_values;
+    for (std::size_t knob_i = 0; knob_i < knobs.size(); ++knob_i)
+    {
+        if (knobs[knob_i].name == KnobTHP)
+            thp_disable = combination[knob_i] == THPDisabled ? 1 : 0;
+        else
+        {
+            env_names.insert(knobs[knob_i].name);
+            if (!combination[knob_i].empty())
+                env_values.push_back(knobs[knob_i].name + "=" + combination[knob_i]);
+        } // end else
+    } // end for
+    std::vector<char *> envp;
+    for (char **p_env = environ; p_env && *p_env; ++p_env)
+    {
+        const char *p_equal = std::strchr(*p_env, '=');
+        std::string name    = p_equal ? std::string(*p_env, p_equal - *p_env) : std::string(*p_env);
+        if (env_names.count(name) <= 0)
+            envp.push_back(*p_env);
+    } // end for
+    for (std::string &env_value : env_values)
+        envp.push_back(env_value.data());
+    envp.push_back(nullptr);
+
+    int log_fd = open(log_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (log_fd < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + log_file.string()));
+
+    // make sure buffered output is not duplicated by the child
+    std::cout.flush();
+    std::cerr.flush();
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // child: a fresh process image from the same binary
+        dup2(log_fd, STDOUT_FILENO);
+        dup2(log_fd, STDERR_FILENO);
+        close(log_fd);
+        // THP disable flag is inherited through execve
+        if (thp_disable >= 0 && prctl(PR_SET_THP_DISABLE, thp_disable, 0, 0, 0) < 0)
+            _exit(126);
+        execve("/proc/self/exe", argv.data(), envp.data());
+        _exit(127);
+    } // end if
+    close(log_fd);
+    if (pid < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS(std::string("Could not create child process: ") + std::strerror(errno)));
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+            throw std::runtime_error(IL_LOG_MSG_CLASS(std::string("Error waiting for child process: ") + std::strerror(errno)));
+    } // end while
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 126)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not set transparent huge pages for environment sweep child process."));
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Environment sweep child process failed. See output in: " + log_file.string()));
+}
+
+void EnvSweep::addToFingerprint(hebench::TestHarness::Report::cpp::Fingerprint &fingerprint,
+                                const std::string &child_arg)
+{
+    using Fingerprint = hebench::TestHarness::Report::cpp::Fingerprint;
+
+    // record the state in effect, rather than the state requested
+    std::istringstream is(child_arg);
+    std::string name;
+    while (std::getline(is, name, ','))
+    {
+        if (name.empty())
+            continue;
+        if (name == KnobTHP)
+        {
+            int thp_disable = prctl(PR_GET_THP_DISABLE, 0, 0, 0, 0);
+            fingerprint.set(Fingerprint::GroupEnvironment, name,
+                            thp_disable < 0 ? Fingerprint::Unknown : (thp_disable > 0 ? THPDisabled : THPDefault));
+        } // end if
+        else
+        {
+            const char *value = std::getenv(name.c_str());
+            fingerprint.set(Fingerprint::GroupEnvironment, name, value ? value : Unset);
+        } // end else
+    } // end while
+}
+
+EnvSweep::Result EnvSweep::summarizeReport(std::size_t combination_index,
+                                           const hebench::TestHarness::Report::cpp::TimingReport &report)
+{
+    Result retval            = {};
+    retval.combination_index = combination_index;
+
+    std::vector<double> times_ms;
+    std::uint32_t main_event_type = report.getMainEventType();
+    const hebench::TestHarness::Report::TimingReportEventC *p_events = report.getEventsData();
+    for (std::uint64_t event_i = 0; event_i < report.getEventCount(); ++event_i)
+    {
+        const hebench::TestHarness::Report::TimingReportEventC &event = p_events[event_i];
+        if (event.event_type_id == main_event_type && event.iterations > 0 && event.time_interval_ratio_den != 0)
+            times_ms.push_back((event.wall_time_end - event.wall_time_start) * 1000.0
+                               * event.time_interval_ratio_num / event.time_interval_ratio_den
+                               / event.iterations);
+    } // end for
+
+    retval.event_count = times_ms.size();
+    retval.b_succeeded = !times_ms.empty();
+    if (!retval.b_succeeded)
+        retval.message = "No events in report.";
+    else
+    {
+        for (double value : times_ms)
+            retval.mean_ms += value;
+        retval.mean_ms /= times_ms.size();
+        for (double value : times_ms)
+            retval.stddev_ms += (value - retval.mean_ms) * (value - retval.mean_ms);
+        if (times_ms.size() > 1)
+            retval.stddev_ms /= times_ms.size() - 1;
+        retval.stddev_ms = std::sqrt(retval.stddev_ms);
+    } // end else
+    return retval;
+}
+
+std::size_t EnvSweep::findBest(const std::vector<Result> &results)
+{
+    std::size_t retval = results.size();
+    for (std::size_t result_i = 0; result_i < results.size(); ++result_i)
+        if (results[result_i].b_succeeded
+            && (retval >= results.size() || results[result_i].mean_ms < results[retval].mean_ms))
+            retval = result_i;
+    return retval;
+}
+
+void EnvSweep::save2CSV(const std::filesystem::path &summary_filename,
+                        const std::filesystem::path &results_filename,
+                        const std::vector<EnvKnob> &knobs,
+                        const std::vector<Combination> &combinations,
+                        const std::vector<BenchmarkResults> &bench_results)
+{
+    std::ofstream fnum(results_filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + results_filename.string()));
+    fnum << "Benchmark,Combination,";
+    for (const EnvKnob &knob : knobs)
+        fnum << "\"" << knob.name << "\",";
+    fnum << "Status,Events,Mean (ms),Std dev (ms),Relative to best,Message" << std::endl;
+    fnum << std::setprecision(17);
+    for (const BenchmarkResults &bench : bench_results)
+    {
+        std::size_t best_i = findBest(bench.results);
+        for (const Result &result : bench.results)
+        {
+            fnum << "\"" << bench.name << "\"," << result.combination_index << ",";
+            for (const std::string &value : combinations.at(result.combination_index))
+                fnum << "\"" << (value.empty() ? Unset : value) << "\",";
+            fnum << (result.b_succeeded ? "OK" : "Failed") << "," << result.event_count << ",";
+            if (result.b_succeeded)
+                fnum << result.mean_ms << "," << result.stddev_ms << ","
+                     << result.mean_ms / bench.results[best_i].mean_ms;
+            else
+                fnum << ",,";
+            fnum << ",\"" << result.message << "\"" << std::endl;
+        } // end for
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing environment sweep results: " + results_filename.string()));
+    fnum.close();
+
+    fnum.open(summary_filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + summary_filename.string()));
+    fnum << "Benchmark,Combinations,Succeeded,Best combination,Best knobs,Best mean (ms),"
+         << "Reference mean (ms),Speedup over reference,Worst mean (ms)" << std::endl;
+    fnum << std::setprecision(17);
+    for (const BenchmarkResults &bench : bench_results)
+    {
+        std::size_t succeeded = 0;
+        double worst_ms       = 0.0;
+        for (const Result &result : bench.results)
+        {
+            if (!result.b_succeeded)
+                continue;
+            ++succeeded;
+            if (result.mean_ms > worst_ms)
+                worst_ms = result.mean_ms;
+        } // end for
+        std::size_t best_i = findBest(bench.results);
+        fnum << "\"" << bench.name << "\"," << bench.results.size() << "," << succeeded << ",";
+        if (best_i >= bench.results.size())
+        {
+            fnum << ",,,,," << std::endl;
+            continue;
+        } // end if
+        const Result &best = bench.results[best_i];
+        fnum << best.combination_index << ",\""
+             << toString(knobs, combinations.at(best.combination_index)) << "\","
+             << best.mean_ms << ",";
+        // reference is the first combination
+        if (!bench.results.empty() && bench.results.front().b_succeeded)
+            fnum << bench.results.front().mean_ms << "," << bench.results.front().mean_ms / best.mean_ms;
+        else
+            fnum << ",";
+        fnum << "," << worst_ms << std::endl;
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing environment sweep summary: " + summary_filename.string()));
+}
+
+std::ostream &EnvSweep::show(std::ostream &os,
+                             const std::vector<EnvKnob> &knobs,
+                             const std::vector<Combination> &combinations,
+                             const std::vector<BenchmarkResults> &bench_results)
+{
+    for (std::size_t bench_i = 0; bench_i < bench_results.size(); ++bench_i)
+    {
+        const BenchmarkResults &bench = bench_results[bench_i];
+        std::size_t best_i            = findBest(bench.results);
+        if (bench_i > 0)
+            os << std::endl;
+        os << bench_i + 1 << ". " << bench.name << std::endl;
+        if (best_i >= bench.results.size())
+        {
+            os << "   All combinations failed." << std::endl;
+            continue;
+        } // end if
+        const Result &best = bench.results[best_i];
+        os << "   Best: " << toString(knobs, combinations.at(best.combination_index)) << std::endl
+           << std::fixed << std::setprecision(3)
+           << "   Mean (ms): " << best.mean_ms;
+        if (bench.results.front().b_succeeded)
+            os << " (" << std::setprecision(2) << bench.results.front().mean_ms / best.mean_ms
+               << "x over reference)";
+        os << std::endl
+           << std::defaultfloat;
+    } // end for
+    return os;
+}
+
+std::vector<std::string> EnvSweep::run(Engine &engine,
+                                       const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                       const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                                       const std::vector<EnvKnob> &env_knobs,
+                                       const ProgramConfig &config)
+{
+    std::vector<std::string> retval;
+    std::stringstream ss;
+
+    std::vector<Combination> combinations = expand(env_knobs);
+    std::vector<BenchmarkResults> bench_results;
+    for (const BenchmarkRequest &bench_to_run : benchmarks_to_run)
+        for (const std::vector<hebench::APIBridge::WorkloadParam> &w_params : bench_to_run.sets_w_params)
+            bench_results.push_back({ engine.describeBenchmark(bench_config, bench_to_run.benchmark_index, w_params)->description.path, {} });
+
+    LiveMetrics::setPhase("Environment sweep");
+    Progress::beginPhase("Environment sweep", combinations.size());
+    for (std::size_t combination_i = 0; combination_i < combinations.size(); ++combination_i)
+    {
+        std::string knobs = toString(env_knobs, combinations[combination_i]);
+        ss                = std::stringstream();
+        ss << "Environment combination " << combination_i + 1 << "/" << combinations.size() << ":" << std::endl
+           << knobs;
+        std::cout << std::endl
+                  << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+        // all benchmarks of a combination run in the same child, with the same seed
+        std::filesystem::path combination_root_path = config.report_root_path / CombinationsDirName
+                                                      / ("combination_" + std::to_string(combination_i));
+        std::filesystem::create_directories(combination_root_path);
+        std::vector<std::string> child_args = config.getChildArgs(config.config_file, combination_root_path, bench_config.random_seed);
+        child_args.insert(child_args.end(), { "--env_sweep_child", toChildArgument(env_knobs) });
+
+        std::string child_error;
+        try
+        {
+            runChild(env_knobs, combinations[combination_i], child_args,
+                     combination_root_path / ChildLogFile);
+        }
+        catch (std::exception &ex)
+        {
+            child_error = ex.what();
+            std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log(child_error) << std::endl;
+        }
+
+        for (BenchmarkResults &bench : bench_results)
+        {
+            Result result            = {};
+            result.combination_index = combination_i;
+            result.message           = child_error;
+            if (child_error.empty())
+            {
+                try
+                {
+                    result = summarizeReport(
+                        combination_i,
+                        Report::cpp::TimingReport::loadReportFromCSVFile(
+                            BenchmarkRunner::getReportFilename(combination_root_path, bench.name)));
+                }
+                catch (std::exception &ex)
+                {
+                    result.message = ex.what();
+                }
+            } // end if
+            bench.results.push_back(result);
+        } // end for
+        Progress::advance();
+    } // end for
+    Progress::endPhase();
+
+    for (const BenchmarkResults &bench : bench_results)
+        if (findBest(bench.results) >= bench.results.size())
+            retval.push_back(bench.name);
+
+    save2CSV(config.report_root_path / SummaryFile,
+             config.report_root_path / ResultsFile,
+             env_knobs, combinations, bench_results);
+    if (config.b_show_run_overview)
+    {
+        ss = std::stringstream();
+        ss << "Best environment per benchmark:" << std::endl
+           << std::endl;
+        show(ss, env_knobs, combinations, bench_results);
+        std::cout << std::endl
+                  << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    } // end if
+    ss = std::stringstream();
+    ss << "Environment sweep summary saved to: " << std::endl
+       << config.report_root_path / SummaryFile;
+    std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+    return retval;
+}
+
+} // namespace TestHarness
+} // namespace hebench
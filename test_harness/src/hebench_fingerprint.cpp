@@ -0,0 +1,239 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <sys/utsname.h>
+
+#include "../include/hebench_fingerprint.h"
+#include "include/hebench_version.h"
+
+namespace hebench {
+namespace TestHarness {
+
+namespace {
+
+using Fingerprint = hebench::TestHarness::Report::cpp::Fingerprint;
+
+std::string trim(const std::string &s)
+{
+    static const char *WhiteSpace = " \t\r\n";
+    std::size_t first             = s.find_first_not_of(WhiteSpace);
+    if (first == std::string::npos)
+        return std::string();
+    return s.substr(first, s.find_last_not_of(WhiteSpace) - first + 1);
+}
+
+/**
+ * @brief Reads the first line of a file.
+ * @returns The trimmed line or Unknown if the file cannot be read.
+ */
+std::string readLine(const std::filesystem::path &filename)
+{
+    std::string retval;
+    std::ifstream fnum(filename);
+    if (!std::getline(fnum, retval) || trim(retval).empty())
+        return Fingerprint::Unknown;
+    return trim(retval);
+}
+
+void addCPU(Fingerprint &fingerprint)
+{
+    std::string model        = Fingerprint::Unknown;
+    std::size_t logical_cpus = 0;
+    std::set<std::string> sockets;
+    std::set<std::pair<std::string, std::string>> cores;
+
+    std::ifstream fnum("/proc/cpuinfo");
+    std::string line;
+    std::string physical_id;
+    while (std::getline(fnum, line))
+    {
+        std::size_t colon_pos = line.find(':');
+        if (colon_pos == std::string::npos)
+            continue;
+        std::string key   = trim(line.substr(0, colon_pos));
+        std::string value = trim(line.substr(colon_pos + 1));
+        if (key == "processor")
+            ++logical_cpus;
+        else if (key == "model name" && model == Fingerprint::Unknown)
+            model = value;
+        else if (key == "physical id")
+        {
+            physical_id = value;
+            sockets.insert(value);
+        } // end else if
+        else if (key == "core id")
+            cores.emplace(physical_id, value);
+    } // end while
+
+    fingerprint.set(Fingerprint::GroupMachine, "CPU model", model);
+    fingerprint.set(Fingerprint::GroupMachine, "Sockets", sockets.empty() ? Fingerprint::Unknown : std::to_string(sockets.size()));
+    fingerprint.set(Fingerprint::GroupMachine, "Cores", cores.empty() ? Fingerprint::Unknown : std::to_string(cores.size()));
+    fingerprint.set(Fingerprint::GroupMachine, "Logical CPUs", logical_cpus == 0 ? Fingerprint::Unknown : std::to_string(logical_cpus));
+}
+
+void addCaches(Fingerprint &fingerprint)
+{
+    const std::filesystem::path cache_path = "/sys/devices/system/cpu/cpu0/cache";
+    for (std::size_t index_i = 0;; ++index_i)
+    {
+        std::filesystem::path index_path = cache_path / ("index" + std::to_string(index_i));
+        std::error_code err;
+        if (!std::filesystem::is_directory(index_path, err))
+            break;
+        std::string level = readLine(index_path / "level");
+        std::string type  = readLine(index_path / "type");
+        std::string name  = "L" + level;
+        if (type == "Data")
+            name += "d";
+        else if (type == "Instruction")
+            name += "i";
+        fingerprint.set(Fingerprint::GroupMachine, name + " cache", readLine(index_path / "size"));
+    } // end for
+}
+
+void addMemory(Fingerprint &fingerprint)
+{
+    std::string mem_total = Fingerprint::Unknown;
+    std::ifstream fnum("/proc/meminfo");
+    std::string line;
+    while (std::getline(fnum, line))
+        if (line.rfind("MemTotal:", 0) == 0)
+        {
+            mem_total = trim(line.substr(line.find(':') + 1));
+            break;
+        } // end if
+    fingerprint.set(Fingerprint::GroupMachine, "Memory", mem_total);
+    // DIMM speed is only exposed through DMI tables, which require root
+    fingerprint.set(Fingerprint::GroupMachine, "Memory speed", Fingerprint::Unknown);
+}
+
+void addOS(Fingerprint &fingerprint)
+{
+    struct utsname os_name;
+    std::string kernel = Fingerprint::Unknown;
+    if (uname(&os_name) == 0)
+    {
+        std::stringstream ss;
+        ss << os_name.sysname << " " << os_name.release << " " << os_name.version << " " << os_name.machine;
+        kernel = ss.str();
+    } // end if
+    fingerprint.set(Fingerprint::GroupMachine, "Kernel", kernel);
+}
+
+void addFrequencyScaling(Fingerprint &fingerprint)
+{
+    const std::filesystem::path cpu_path = "/sys/devices/system/cpu";
+
+    fingerprint.set(Fingerprint::GroupMachine, "Frequency governor", readLine(cpu_path / "cpu0/cpufreq/scaling_governor"));
+
+    std::string smt = readLine(cpu_path / "smt/active");
+    if (smt != Fingerprint::Unknown)
+        smt = (smt == "0" ? "Off" : "On");
+    fingerprint.set(Fingerprint::GroupMachine, "SMT", smt);
+
+    // intel_pstate reports the opposite of the generic cpufreq boost flag
+    std::string turbo    = Fingerprint::Unknown;
+    std::string no_turbo = readLine(cpu_path / "intel_pstate/no_turbo");
+    std::string boost    = readLine(cpu_path / "cpufreq/boost");
+    if (no_turbo != Fingerprint::Unknown)
+        turbo = (no_turbo == "0" ? "On" : "Off");
+    else if (boost != Fingerprint::Unknown)
+        turbo = (boost == "0" ? "Off" : "On");
+    fingerprint.set(Fingerprint::GroupMachine, "Turbo", turbo);
+}
+
+void addBuild(Fingerprint &fingerprint)
+{
+    std::stringstream ss;
+#if defined(__clang__)
+    ss << "Clang " << __clang_version__;
+#elif defined(__GNUC__)
+    ss << "GCC " << __VERSION__;
+#else
+    ss << Fingerprint::Unknown;
+#endif
+    fingerprint.set(Fingerprint::GroupBuild, "Compiler", trim(ss.str()));
+    fingerprint.set(Fingerprint::GroupBuild, "Build type", trim(HEBENCH_TEST_HARNESS_BUILD_TYPE).empty() ? Fingerprint::Unknown : HEBENCH_TEST_HARNESS_BUILD_TYPE);
+    fingerprint.set(Fingerprint::GroupBuild, "Build flags", trim(HEBENCH_TEST_HARNESS_BUILD_FLAGS));
+
+    ss = std::stringstream();
+    ss << HEBENCH_TEST_HARNESS_VERSION_MAJOR << "."
+       << HEBENCH_TEST_HARNESS_VERSION_MINOR << "."
+       << HEBENCH_TEST_HARNESS_VERSION_REVISION << "-"
+       << HEBENCH_TEST_HARNESS_VERSION_BUILD;
+    fingerprint.set(Fingerprint::GroupBuild, "Test harness version", ss.str());
+}
+
+} // namespace
+
+Fingerprint FingerprintCollector::collect()
+{
+    Fingerprint retval;
+    addCPU(retval);
+    addCaches(retval);
+    addMemory(retval);
+    addOS(retval);
+    addFrequencyScaling(retval);
+    addBuild(retval);
+    return retval;
+}
+
+void FingerprintCollector::addBackend(Fingerprint &fingerprint,
+                                      const std::filesystem::path &backend_lib_path,
+                                      const std::string &lib_hash)
+{
+    std::error_code err;
+    std::filesystem::path lib_path = std::filesystem::canonical(backend_lib_path, err);
+    if (err)
+        lib_path = backend_lib_path;
+    std::uintmax_t lib_size = std::filesystem::file_size(lib_path, err);
+
+    std::stringstream ss;
+    if (lib_hash.empty())
+        ss << std::hex << std::setfill('0') << std::setw(16) << hashFile(lib_path);
+    else
+        ss << lib_hash;
+
+    fingerprint.set(Fingerprint::GroupBackend, "Library", lib_path.filename().string());
+    fingerprint.set(Fingerprint::GroupBackend, "Library size", err ? Fingerprint::Unknown : std::to_string(lib_size));
+    fingerprint.set(Fingerprint::GroupBackend, LibraryHashKey, ss.str());
+}
+
+std::uint64_t FingerprintCollector::hashFile(const std::filesystem::path &filename)
+{
+    constexpr std::uint64_t FNVOffsetBasis = 0xcbf29ce484222325ULL;
+    constexpr std::uint64_t FNVPrime       = 0x100000001b3ULL;
+
+    std::ifstream fnum(filename, std::ios_base::in | std::ios_base::binary);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to read file for hashing: " + filename.string()));
+
+    std::uint64_t retval = FNVOffsetBasis;
+    std::vector<char> buffer(1 << 16);
+    while (fnum)
+    {
+        fnum.read(buffer.data(), buffer.size());
+        std::streamsize count = fnum.gcount();
+        for (std::streamsize i = 0; i < count; ++i)
+        {
+            retval ^= static_cast<std::uint8_t>(buffer[i]);
+            retval *= FNVPrime;
+        } // end for
+    } // end while
+    if (fnum.bad())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error reading file for hashing: " + filename.string()));
+
+    return retval;
+}
+
+} // namespace TestHarness
+} // namespace hebench
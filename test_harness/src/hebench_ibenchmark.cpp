@@ -16,6 +16,8 @@
 #include "modules/timer/include/timer.h"
 
 #include "hebench/api_bridge/api.h"
+#include "dynamic_lib_load.h"
+
 #include "include/hebench_engine.h"
 #include "include/hebench_ibenchmark.h"
 #include "include/hebench_utilities.h"
@@ -54,6 +56,23 @@ std::unordered_set<std::size_t> PartialBenchmarkDescription::getCipherParamPosit
     return retval;
 }
 
+std::string PartialBenchmarkDescription::getCipherMaskName(std::uint32_t cipher_param_mask)
+{
+    std::stringstream ss;
+    std::unordered_set<std::size_t> cipher_param_pos = getCipherParamPositions(cipher_param_mask);
+    if (cipher_param_pos.empty())
+        ss << "all_plain";
+    else if (cipher_param_pos.size() >= sizeof(std::uint32_t) * 8)
+        ss << "all_cipher";
+    else
+    {
+        std::size_t max_elem = *std::max_element(cipher_param_pos.begin(), cipher_param_pos.end());
+        for (std::size_t i = 0; i <= max_elem; ++i)
+            ss << (cipher_param_pos.count(i) > 0 ? 'c' : 'p');
+    } // end else
+    return ss.str();
+}
+
 std::string PartialBenchmarkDescription::getCategoryName(hebench::APIBridge::Category category)
 {
     std::string retval;
@@ -109,19 +128,35 @@ std::string PartialBenchmarkDescription::getDataTypeName(hebench::APIBridge::Dat
 std::uint64_t PartialBenchmarkDescription::computeSampleSizes(std::uint64_t *sample_sizes,
                                                               std::size_t param_count,
                                                               std::uint64_t default_sample_size,
+                                                              const std::vector<std::uint64_t> &operand_sample_sizes,
                                                               const hebench::APIBridge::BenchmarkDescriptor &bench_desc)
 {
     std::uint64_t result_batch_size = 1;
     for (std::size_t param_i = 0; param_i < param_count; ++param_i)
     {
-        sample_sizes[param_i] = (bench_desc.cat_params.offline.data_count[param_i] == 0 ?
-                                     default_sample_size :
-                                     bench_desc.cat_params.offline.data_count[param_i]);
+        if (bench_desc.cat_params.offline.data_count[param_i] != 0)
+            sample_sizes[param_i] = bench_desc.cat_params.offline.data_count[param_i];
+        else if (param_i < operand_sample_sizes.size() && operand_sample_sizes[param_i] != 0)
+            sample_sizes[param_i] = operand_sample_sizes[param_i];
+        else
+            sample_sizes[param_i] = default_sample_size;
         result_batch_size *= sample_sizes[param_i];
     } // end for
     return result_batch_size;
 }
 
+void PartialBenchmarkDescription::describeSampleSizes(Description &description,
+                                                      const std::uint64_t *sample_sizes,
+                                                      std::size_t param_count,
+                                                      const hebench::APIBridge::BenchmarkDescriptor &bench_desc)
+{
+    description.sample_sizes.assign(sample_sizes, sample_sizes + param_count);
+    description.flexible_sample_params.clear();
+    for (std::size_t param_i = 0; param_i < param_count; ++param_i)
+        if (bench_desc.cat_params.offline.data_count[param_i] == 0)
+            description.flexible_sample_params.push_back(param_i);
+}
+
 IBenchmarkDescription::DescriptionToken::Ptr PartialBenchmarkDescription::matchBenchmarkDescriptor(const Engine &engine,
                                                                                                    const IBenchmarkDescription::BenchmarkConfig &bench_config,
                                                                                                    const hebench::APIBridge::Handle &h_desc,
@@ -211,20 +246,9 @@ void PartialBenchmarkDescription::describe(const Engine &engine,
         ss << "default";
     ss_path /= ss.str();
     // cipher/plain parameters
-    ss = std::stringstream();
     std::unordered_set<std::size_t> cipher_param_pos =
         PartialBenchmarkDescription::getCipherParamPositions(bench_desc.cipher_param_mask);
-    if (cipher_param_pos.empty())
-        ss << "all_plain";
-    else if (cipher_param_pos.size() >= sizeof(std::uint32_t) * 8)
-        ss << "all_cipher";
-    else
-    {
-        std::size_t max_elem = *std::max_element(cipher_param_pos.begin(), cipher_param_pos.end());
-        for (std::size_t i = 0; i <= max_elem; ++i)
-            ss << (cipher_param_pos.count(i) > 0 ? 'c' : 'p');
-    } // end else
-    ss_path /= ss.str();
+    ss_path /= PartialBenchmarkDescription::getCipherMaskName(bench_desc.cipher_param_mask);
     ss_path /= hebench::Utilities::convertToDirectoryName(s_scheme_name);
     ss_path /= hebench::Utilities::convertToDirectoryName(s_security_name);
     ss_path /= std::to_string(bench_desc.other);
@@ -290,8 +314,10 @@ void PartialBenchmarkDescription::describe(const Engine &engine,
         ss << std::endl;
     } // end else
 
-    description.header = ss.str();
-    description.path   = ss_path;
+    description.header            = ss.str();
+    description.path              = ss_path;
+    description.workload          = bench_desc.workload;
+    description.cipher_param_mask = bench_desc.cipher_param_mask;
 
     completeDescription(engine, pre_token);
 }
@@ -305,7 +331,10 @@ PartialBenchmark::PartialBenchmark(std::shared_ptr<Engine> p_engine,
     m_descriptor(m_benchmark_descriptor),
     m_params(m_workload_params),
     m_benchmark_configuration(m_bench_config),
+    m_p_run_arena(RunArena::create()),
     m_current_event_id(0),
+    m_subphase_dropped_count(0),
+    m_memory_phase_start(0),
     m_b_constructed(false),
     m_b_initialized(false)
 {
@@ -353,13 +382,19 @@ void PartialBenchmark::initBackend(hebench::Utilities::TimingReportEx &out_repor
     params.params = m_workload_params.data();
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Initializing backend benchmark...") << std::endl;
+    // discard sub-phases pushed outside of timed calls
+    hebench::APIBridge::SubPhaseTimings::drain(m_subphase_timings);
+    m_subphase_dropped_count = hebench::APIBridge::SubPhaseTimings::getDroppedCount();
+    beginPhaseMemory("Initialization");
     timer.start();
     validateRetCode(hebench::APIBridge::initBenchmark(m_p_engine->handle(),
                                                       m_h_descriptor,
                                                       m_workload_params.empty() ? nullptr : &params,
                                                       &m_handle));
     p_timing_event = timer.stop<DefaultTimeInterval>(getEventIDNext(), 1, nullptr);
+    endPhaseMemory();
     out_report.addEvent<DefaultTimeInterval>(p_timing_event, std::string("Initialization"));
+    addSubPhaseEvents(out_report, *p_timing_event, "Initialization");
     hebench::Logging::GlobalLogger::log("OK");
     std::cout << IOS_MSG_OK << std::endl;
     std::stringstream ss = std::stringstream();
@@ -381,5 +416,84 @@ void PartialBenchmark::validateRetCode(hebench::APIBridge::ErrorCode err_code, b
     m_p_engine->validateRetCode(err_code, last_error);
 }
 
+void PartialBenchmark::addSubPhaseEvents(hebench::Utilities::TimingReportEx &out_report,
+                                         const hebench::Common::TimingReportEvent &parent_event,
+                                         const std::string &parent_event_name)
+{
+    if (!hebench::APIBridge::DynamicLibLoad::hasSubPhaseTimings())
+        return;
+
+    hebench::APIBridge::SubPhaseTimings::drain(m_subphase_timings);
+    for (const hebench::APIBridge::SubPhaseTiming &timing : m_subphase_timings)
+    {
+        auto key = std::make_pair(parent_event.id, std::string(timing.name));
+        auto it  = m_subphase_event_ids.find(key);
+        if (it == m_subphase_event_ids.end())
+        {
+            it = m_subphase_event_ids.emplace(key, getEventIDNext()).first;
+            out_report.addEventType(it->second, parent_event_name + ": " + key.second);
+        } // end if
+
+        // child event starts with its parent and lasts what the backend reported
+        hebench::TestHarness::Report::TimingReportEventC tre_c =
+            hebench::Utilities::TimingReportEx::convert2C<DefaultTimeInterval>(parent_event);
+        tre_c.event_type_id  = it->second;
+        tre_c.iterations     = 1;
+        tre_c.span_id        = hebench::Common::TimingReportEvent::nextSpanID();
+        tre_c.parent_span_id = parent_event.span_id;
+        tre_c.depth          = parent_event.depth + 1;
+        tre_c.wall_time_end = tre_c.wall_time_start
+                              + static_cast<double>(timing.wall_time_ns) * DefaultTimeInterval::den / (DefaultTimeInterval::num * 1000000000.0);
+        tre_c.cpu_time_end = tre_c.cpu_time_start
+                             + static_cast<double>(timing.cpu_time_ns) * DefaultTimeInterval::den / (DefaultTimeInterval::num * 1000000000.0);
+        tre_c.description[0] = '\0';
+        out_report.addEvent(tre_c);
+    } // end for
+
+    std::uint64_t dropped_count = hebench::APIBridge::SubPhaseTimings::getDroppedCount();
+    if (dropped_count > m_subphase_dropped_count)
+    {
+        std::stringstream ss;
+        ss << "Sub-phase timing buffer full: " << (dropped_count - m_subphase_dropped_count)
+           << " sub-phases of event \"" << parent_event_name << "\" were dropped.";
+        std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+        m_subphase_dropped_count = dropped_count;
+    } // end if
+}
+
+void PartialBenchmark::beginPhaseMemory(const std::string &phase_name)
+{
+    endPhaseMemory();
+    m_memory_phase_name  = phase_name;
+    m_memory_phase_start = hebench::Utilities::getResidentMemoryBytes();
+}
+
+void PartialBenchmark::endPhaseMemory()
+{
+    if (!m_memory_phase_name.empty())
+    {
+        std::int64_t delta = static_cast<std::int64_t>(hebench::Utilities::getResidentMemoryBytes())
+                             - static_cast<std::int64_t>(m_memory_phase_start);
+        m_phase_memory.emplace_back(m_memory_phase_name, delta);
+        m_memory_phase_name.clear();
+    } // end if
+}
+
+void PartialBenchmark::appendPhaseMemory(hebench::Utilities::TimingReportEx &out_report)
+{
+    endPhaseMemory();
+    if (!m_phase_memory.empty())
+    {
+        std::stringstream ss;
+        ss << PhaseMemoryFooterTitle << std::endl
+           << "Phase,Delta (bytes)";
+        for (const auto &phase_memory : m_phase_memory)
+            ss << std::endl
+               << phase_memory.first << "," << phase_memory.second;
+        out_report.appendFooter(ss.str());
+        m_phase_memory.clear();
+    } // end if
+}
+
 } // namespace TestHarness
 } // namespace hebench
@@ -4,8 +4,10 @@
 
 #include <cassert>
 #include <functional>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 #include "../include/hebench_idata_loader.h"
 
@@ -46,33 +48,77 @@ std::size_t IDataLoader::sizeOf(hebench::APIBridge::DataType data_type)
     return retval;
 }
 
+void IDataLoader::computeResult(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                const std::uint64_t *param_data_pack_indices)
+{
+    (void)results;
+    (void)param_data_pack_indices;
+    throw std::logic_error(IL_LOG_MSG_CLASS("Data loader does not support computing results."));
+}
+
+/**
+ * @brief Memory resource of the specified arena or the global default memory
+ * resource if there is no arena.
+ */
+static std::pmr::memory_resource *getResource(const RunArena::Ptr &p_arena)
+{
+    return p_arena ? p_arena->resource() : std::pmr::get_default_resource();
+}
+
+/**
+ * @brief Allocates and value-initializes an array of C structs from the
+ * specified memory resource.
+ */
+template <typename T>
+static T *allocateArray(std::pmr::memory_resource *p_resource, std::uint64_t count)
+{
+    T *retval = RunArena::allocator<T>(p_resource).allocate(count);
+    std::uninitialized_value_construct_n(retval, count);
+    return retval;
+}
+
+/**
+ * @brief Frees an array allocated with allocateArray().
+ */
+template <typename T>
+static void deallocateArray(std::pmr::memory_resource *p_resource, T *p, std::uint64_t count)
+{
+    static_assert(std::is_trivially_destructible<T>::value, "Only C structs are expected.");
+    if (p)
+        RunArena::allocator<T>(p_resource).deallocate(p, count);
+}
+
 IDataLoader::unique_ptr_custom_deleter<hebench::APIBridge::PackedData>
-IDataLoader::createPackedData(std::uint64_t data_pack_count)
+IDataLoader::createPackedData(std::uint64_t data_pack_count, RunArena::Ptr p_arena)
 {
     unique_ptr_custom_deleter<hebench::APIBridge::PackedData> retval;
+    // deleter keeps the run arena alive until the descriptors are released
+    std::pmr::memory_resource *p_resource      = getResource(p_arena);
     hebench::APIBridge::DataPack *p_data_packs = nullptr;
+    hebench::APIBridge::PackedData *p_retval   = nullptr;
 
     try
     {
-        p_data_packs = new hebench::APIBridge::DataPack[data_pack_count];
+        p_data_packs = allocateArray<hebench::APIBridge::DataPack>(p_resource, data_pack_count);
+        p_retval     = allocateArray<hebench::APIBridge::PackedData>(p_resource, 1);
         retval       = unique_ptr_custom_deleter<hebench::APIBridge::PackedData>(
-            new hebench::APIBridge::PackedData(),
-            [](hebench::APIBridge::PackedData *p) {
+            p_retval,
+            [p_arena, p_resource, data_pack_count](hebench::APIBridge::PackedData *p) {
                 if (p)
                 {
-                    if (p->p_data_packs)
-                        delete[] p->p_data_packs;
-                    delete p;
+                    deallocateArray(p_resource, p->p_data_packs, data_pack_count);
+                    deallocateArray(p_resource, p, 1);
                 }
             });
+        p_retval = nullptr;
 
         retval->pack_count   = data_pack_count;
         retval->p_data_packs = p_data_packs;
     }
     catch (...)
     {
-        if (p_data_packs)
-            delete[] p_data_packs;
+        deallocateArray(p_resource, p_retval, 1);
+        deallocateArray(p_resource, p_data_packs, data_pack_count);
         throw;
     }
 
@@ -80,24 +126,28 @@ IDataLoader::createPackedData(std::uint64_t data_pack_count)
 }
 
 IDataLoader::unique_ptr_custom_deleter<hebench::APIBridge::DataPack>
-IDataLoader::createDataPack(std::uint64_t buffer_count, std::uint64_t param_position)
+IDataLoader::createDataPack(std::uint64_t buffer_count, std::uint64_t param_position, RunArena::Ptr p_arena)
 {
     unique_ptr_custom_deleter<hebench::APIBridge::DataPack> retval;
+    // deleter keeps the run arena alive until the descriptors are released
+    std::pmr::memory_resource *p_resource           = getResource(p_arena);
     hebench::APIBridge::NativeDataBuffer *p_buffers = nullptr;
+    hebench::APIBridge::DataPack *p_retval          = nullptr;
 
     try
     {
-        p_buffers = new hebench::APIBridge::NativeDataBuffer[buffer_count];
+        p_buffers = allocateArray<hebench::APIBridge::NativeDataBuffer>(p_resource, buffer_count);
+        p_retval  = allocateArray<hebench::APIBridge::DataPack>(p_resource, 1);
         retval    = unique_ptr_custom_deleter<hebench::APIBridge::DataPack>(
-            new hebench::APIBridge::DataPack(),
-            [](hebench::APIBridge::DataPack *p) {
+            p_retval,
+            [p_arena, p_resource, buffer_count](hebench::APIBridge::DataPack *p) {
                 if (p)
                 {
-                    if (p->p_buffers)
-                        delete[] p->p_buffers;
-                    delete p;
+                    deallocateArray(p_resource, p->p_buffers, buffer_count);
+                    deallocateArray(p_resource, p, 1);
                 }
             });
+        p_retval = nullptr;
 
         retval->buffer_count   = buffer_count;
         retval->param_position = param_position;
@@ -105,8 +155,8 @@ IDataLoader::createDataPack(std::uint64_t buffer_count, std::uint64_t param_posi
     }
     catch (...)
     {
-        if (p_buffers)
-            delete[] p_buffers;
+        deallocateArray(p_resource, p_retval, 1);
+        deallocateArray(p_resource, p_buffers, buffer_count);
         throw;
     }
 
@@ -114,17 +164,22 @@ IDataLoader::createDataPack(std::uint64_t buffer_count, std::uint64_t param_posi
 }
 
 IDataLoader::unique_ptr_custom_deleter<hebench::APIBridge::NativeDataBuffer>
-IDataLoader::createDataBuffer(std::uint64_t size, std::int64_t tag)
+IDataLoader::createDataBuffer(std::uint64_t size, std::int64_t tag, RunArena::Ptr p_arena)
 {
     unique_ptr_custom_deleter<hebench::APIBridge::NativeDataBuffer> retval;
-    std::uint8_t *p_buffer = nullptr;
+    // deleter keeps the run arena alive until the descriptor is released;
+    // payload is not allocated from the arena since it may be large
+    std::pmr::memory_resource *p_resource          = getResource(p_arena);
+    std::uint8_t *p_buffer                         = nullptr;
+    hebench::APIBridge::NativeDataBuffer *p_retval = nullptr;
 
     try
     {
         p_buffer = new std::uint8_t[size];
+        p_retval = allocateArray<hebench::APIBridge::NativeDataBuffer>(p_resource, 1);
         retval   = unique_ptr_custom_deleter<hebench::APIBridge::NativeDataBuffer>(
-            new hebench::APIBridge::NativeDataBuffer(),
-            [](hebench::APIBridge::NativeDataBuffer *p) {
+            p_retval,
+            [p_arena, p_resource](hebench::APIBridge::NativeDataBuffer *p) {
                 if (p)
                 {
                     if (p->p)
@@ -132,9 +187,10 @@ IDataLoader::createDataBuffer(std::uint64_t size, std::int64_t tag)
                         std::uint8_t *p_tmp = reinterpret_cast<std::uint8_t *>(p->p);
                         delete[] p_tmp;
                     }
-                    delete p;
+                    deallocateArray(p_resource, p, 1);
                 }
             });
+        p_retval = nullptr;
 
         retval->size = size;
         retval->tag  = tag;
@@ -142,6 +198,7 @@ IDataLoader::createDataBuffer(std::uint64_t size, std::int64_t tag)
     }
     catch (...)
     {
+        deallocateArray(p_resource, p_retval, 1);
         if (p_buffer)
             delete[] p_buffer;
         throw;
@@ -177,12 +234,12 @@ void PartialDataLoader::init(std::size_t input_dim,
         } // end if
 
         output_count_per_dim *= input_count_per_dim[i];
-        m_input_data[i] = createDataPack(input_count_per_dim[i], i);
+        m_input_data[i] = createDataPack(input_count_per_dim[i], i, m_p_arena);
     } // end for
 
     for (std::size_t i = 0; i < m_output_data.size(); ++i)
     {
-        m_output_data[i] = createDataPack(output_count_per_dim, i);
+        m_output_data[i] = createDataPack(output_count_per_dim, i, m_p_arena);
     } // end for
 }
 
@@ -223,8 +280,9 @@ void PartialDataLoader::allocate(const std::uint64_t *input_buffer_sizes,
     for (std::size_t i = 0; i < input_batch_sizes.size(); ++i)
         total_raw_size += input_buffer_sizes[i] * input_batch_sizes[i];
     output_start = total_raw_size;
-    for (std::size_t i = 0; i < output_batch_sizes.size(); ++i)
-        total_raw_size += output_buffer_sizes[i] * output_batch_sizes[i];
+    if (allocate_output)
+        for (std::size_t i = 0; i < output_batch_sizes.size(); ++i)
+            total_raw_size += output_buffer_sizes[i] * output_batch_sizes[i];
     // allocate space for the data buffers
     m_raw_buffer.resize(total_raw_size, 0);
 
@@ -303,10 +361,10 @@ const hebench::APIBridge::DataPack &PartialDataLoader::getResultData(std::uint64
     return *m_output_data.at(param_position);
 }
 
-std::vector<const hebench::APIBridge::NativeDataBuffer *>
+RunArena::vector<const hebench::APIBridge::NativeDataBuffer *>
 PartialDataLoader::getResultFor(const std::uint64_t *param_data_pack_indices)
 {
-    std::vector<const hebench::APIBridge::NativeDataBuffer *> retval;
+    RunArena::vector<const hebench::APIBridge::NativeDataBuffer *> retval(getResource(m_p_arena));
     std::uint64_t r_i = getResultIndex(param_data_pack_indices);
 
     retval.resize(getResultCount());
@@ -340,5 +398,36 @@ std::uint64_t PartialDataLoader::getResultIndex(const std::uint64_t *param_data_
     return retval;
 }
 
+void PartialDataLoader::computeResult(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                      const std::uint64_t *param_data_pack_indices)
+{
+    if (canComputeResult())
+        checkComputeResultArgs(results, param_data_pack_indices);
+    computeResultUnchecked(results, param_data_pack_indices);
+}
+
+void PartialDataLoader::computeResultUnchecked(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                               const std::uint64_t *param_data_pack_indices)
+{
+    // not supported unless overridden
+    IDataLoader::computeResult(results, param_data_pack_indices);
+}
+
+void PartialDataLoader::checkComputeResultArgs(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                               const std::uint64_t *param_data_pack_indices) const
+{
+    if (!param_data_pack_indices)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid null argument 'param_data_pack_indices'."));
+    for (std::size_t param_i = 0; param_i < getParameterCount(); ++param_i)
+        if (param_data_pack_indices[param_i] >= getParameterData(param_i).buffer_count)
+            throw std::out_of_range(IL_LOG_MSG_CLASS("Index out of range: 'param_data_pack_indices['" + std::to_string(param_i) + "] == " + std::to_string(param_data_pack_indices[param_i]) + ". Expected value less than " + std::to_string(getParameterData(param_i).buffer_count) + "."));
+    if (results.size() < getResultCount())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Insufficient buffers in 'results'."));
+    for (std::size_t result_component_i = 0; result_component_i < getResultCount(); ++result_component_i)
+        if (!results[result_component_i] || !results[result_component_i]->p
+            || results[result_component_i]->size < getResultData(result_component_i).p_buffers[0].size)
+            throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid buffer for result component " + std::to_string(result_component_i) + "."));
+}
+
 } // namespace TestHarness
 } // namespace hebench
@@ -0,0 +1,472 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "modules/logging/include/logging.h"
+
+#include "../include/hebench_live_metrics.h"
+#include "../include/hebench_utilities.h"
+
+namespace hebench {
+namespace TestHarness {
+
+namespace {
+
+struct OperationSample
+{
+    std::atomic<std::int64_t> end_ns;
+    std::atomic<double> wall_time_ms;
+    std::atomic<std::uint64_t> count;
+};
+
+struct LiveMetricsState
+{
+    std::chrono::steady_clock::time_point run_start;
+    std::atomic<std::uint64_t> total_benchmarks     = 0;
+    std::atomic<std::uint64_t> completed_benchmarks = 0;
+    std::atomic<std::uint64_t> failed_benchmarks    = 0;
+    std::atomic<std::uint64_t> run_index            = 0;
+    std::atomic<std::uint64_t> benchmark_id         = 0;
+    std::atomic<std::uint64_t> ops_done             = 0;
+    std::atomic<std::uint64_t> sample_next          = 0;
+    std::array<OperationSample, LiveMetrics::RollingWindowSize> samples;
+
+    std::mutex mtx_labels; // protects strings, which change seldom
+    std::string benchmark_path;
+    std::string phase;
+};
+
+std::int64_t steadyNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string escapeLabelValue(const std::string &s)
+{
+    std::string retval;
+    retval.reserve(s.size());
+    for (char ch : s)
+    {
+        switch (ch)
+        {
+        case '\\':
+            retval += "\\\\";
+            break;
+        case '"':
+            retval += "\\\"";
+            break;
+        case '\n':
+            retval += "\\n";
+            break;
+        default:
+            retval += ch;
+            break;
+        } // end switch
+    } // end for
+    return retval;
+}
+
+std::uint64_t readPeakResidentMemoryBytes()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024; // ru_maxrss is in KB in Linux
+}
+
+} // namespace
+
+class LiveMetrics::Publisher
+{
+private:
+    IL_DECLARE_CLASS_NAME(LiveMetrics::Publisher)
+
+public:
+    Publisher(const std::string &file_path,
+              const std::string &socket_path,
+              std::size_t interval_ms);
+    ~Publisher();
+
+    LiveMetricsState state;
+
+private:
+    std::filesystem::path m_file_path;
+    std::string m_socket_path;
+    std::chrono::milliseconds m_interval;
+    int m_socket_fd;
+    std::atomic<bool> m_b_stop;
+    std::thread m_thread;
+
+    void openSocket();
+    void closeSocket();
+    void publisherLoop();
+    void serveClient();
+    void writeFile(const std::string &s_metrics) const;
+    std::string render();
+};
+
+std::shared_ptr<LiveMetrics::Publisher> LiveMetrics::m_p_publisher;
+std::atomic<bool> LiveMetrics::m_b_enabled(false);
+
+LiveMetrics::Publisher::Publisher(const std::string &file_path,
+                                  const std::string &socket_path,
+                                  std::size_t interval_ms) :
+    m_file_path(file_path),
+    m_socket_path(socket_path),
+    m_interval(interval_ms > 0 ? interval_ms : 1),
+    m_socket_fd(-1),
+    m_b_stop(false)
+{
+    state.run_start = std::chrono::steady_clock::now();
+    for (auto &sample : state.samples)
+    {
+        sample.end_ns       = 0;
+        sample.wall_time_ms = 0.0;
+        sample.count        = 0;
+    } // end for
+
+    if (!m_socket_path.empty())
+        openSocket();
+    m_thread = std::thread(&Publisher::publisherLoop, this);
+}
+
+LiveMetrics::Publisher::~Publisher()
+{
+    m_b_stop = true;
+    if (m_thread.joinable())
+        m_thread.join();
+    // final snapshot so that scrapers see the end state of the run
+    if (!m_file_path.empty())
+    {
+        try
+        {
+            writeFile(render());
+        }
+        catch (...)
+        {
+            // nothing to do on destruction
+        }
+    } // end if
+    closeSocket();
+}
+
+void LiveMetrics::Publisher::openSocket()
+{
+    struct sockaddr_un addr;
+    if (m_socket_path.size() >= sizeof(addr.sun_path))
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Live metrics socket path is too long: " + m_socket_path));
+
+    m_socket_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_socket_fd < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to create live metrics socket: " + std::string(std::strerror(errno))));
+
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, m_socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    ::unlink(m_socket_path.c_str()); // remove stale socket from a previous run
+    if (bind(m_socket_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0
+        || listen(m_socket_fd, 8) != 0)
+    {
+        std::string s_error = std::strerror(errno);
+        closeSocket();
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to bind live metrics socket \"" + m_socket_path + "\": " + s_error));
+    } // end if
+}
+
+void LiveMetrics::Publisher::closeSocket()
+{
+    if (m_socket_fd >= 0)
+    {
+        ::close(m_socket_fd);
+        m_socket_fd = -1;
+        ::unlink(m_socket_path.c_str());
+    } // end if
+}
+
+void LiveMetrics::Publisher::publisherLoop()
+{
+    // poll in small slices so that termination is responsive
+    constexpr int MaxPollSliceMs = 100;
+
+    auto next_write = std::chrono::steady_clock::now();
+    while (!m_b_stop)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (!m_file_path.empty() && now >= next_write)
+        {
+            try
+            {
+                writeFile(render());
+            }
+            catch (...)
+            {
+                // never let metrics publishing interfere with the run
+            }
+            next_write = now + m_interval;
+        } // end if
+
+        int timeout_ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(next_write - now).count());
+        timeout_ms     = std::clamp(timeout_ms, 1, MaxPollSliceMs);
+        if (m_socket_fd >= 0)
+        {
+            struct pollfd pfd;
+            pfd.fd      = m_socket_fd;
+            pfd.events  = POLLIN;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, timeout_ms) > 0 && (pfd.revents & POLLIN))
+                serveClient();
+        } // end if
+        else
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+    } // end while
+}
+
+void LiveMetrics::Publisher::serveClient()
+{
+    int client_fd = accept4(m_socket_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (client_fd >= 0)
+    {
+        // respond with a minimal HTTP response so that both raw socket readers
+        // and HTTP scrapers over Unix sockets can consume the metrics
+        std::string s_metrics = render();
+        std::stringstream ss;
+        ss << "HTTP/1.0 200 OK\r\n"
+           << "Content-Type: text/plain; version=0.0.4\r\n"
+           << "Content-Length: " << s_metrics.size() << "\r\n"
+           << "\r\n"
+           << s_metrics;
+        std::string s_response = ss.str();
+        const char *p          = s_response.data();
+        std::size_t remaining  = s_response.size();
+        while (remaining > 0)
+        {
+            ssize_t written = ::send(client_fd, p, remaining, MSG_NOSIGNAL);
+            if (written <= 0)
+                break;
+            p += written;
+            remaining -= static_cast<std::size_t>(written);
+        } // end while
+        ::close(client_fd);
+    } // end if
+}
+
+void LiveMetrics::Publisher::writeFile(const std::string &s_metrics) const
+{
+    // write to a temporary file and rename, so that readers never see a partial file
+    std::filesystem::path tmp_path = m_file_path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream fnum(tmp_path, std::ios_base::out | std::ios_base::trunc);
+        if (!fnum.is_open())
+            throw std::runtime_error(IL_LOG_MSG_CLASS("Unable to open live metrics file: " + tmp_path.string()));
+        fnum << s_metrics;
+    }
+    std::filesystem::rename(tmp_path, m_file_path);
+}
+
+std::string LiveMetrics::Publisher::render()
+{
+    std::string s_path, s_phase;
+    {
+        std::lock_guard<std::mutex> lock(state.mtx_labels);
+        s_path  = state.benchmark_path;
+        s_phase = state.phase;
+    }
+
+    // collect rolling window
+    std::vector<double> latencies;
+    latencies.reserve(state.samples.size());
+    std::int64_t window_start_ns = std::numeric_limits<std::int64_t>::max();
+    std::int64_t window_end_ns   = 0;
+    std::uint64_t window_ops     = 0;
+    double window_sum_s          = 0.0;
+    for (const auto &sample : state.samples)
+    {
+        std::uint64_t count = sample.count.load(std::memory_order_relaxed);
+        if (count > 0)
+        {
+            double wall_time_ms = sample.wall_time_ms.load(std::memory_order_relaxed);
+            std::int64_t end_ns = sample.end_ns.load(std::memory_order_relaxed);
+            std::int64_t beg_ns = end_ns - static_cast<std::int64_t>(wall_time_ms * 1.0e6);
+            window_start_ns     = std::min(window_start_ns, beg_ns);
+            window_end_ns       = std::max(window_end_ns, end_ns);
+            window_ops += count;
+            window_sum_s += wall_time_ms / 1000.0;
+            latencies.push_back(wall_time_ms / 1000.0 / count);
+        } // end if
+    } // end for
+    std::sort(latencies.begin(), latencies.end());
+    double ops_per_sec = 0.0;
+    if (window_end_ns > window_start_ns)
+        ops_per_sec = window_ops * 1.0e9 / (window_end_ns - window_start_ns);
+
+    std::uint64_t total     = state.total_benchmarks;
+    std::uint64_t completed = state.completed_benchmarks;
+    double elapsed_s        = std::chrono::duration<double>(std::chrono::steady_clock::now() - state.run_start).count();
+
+    std::stringstream ss;
+    ss << "# HELP hebench_benchmarks_total Total number of benchmarks requested in this run." << std::endl
+       << "# TYPE hebench_benchmarks_total gauge" << std::endl
+       << "hebench_benchmarks_total " << total << std::endl
+       << "# HELP hebench_benchmarks_completed Number of benchmarks completed so far." << std::endl
+       << "# TYPE hebench_benchmarks_completed counter" << std::endl
+       << "hebench_benchmarks_completed " << completed << std::endl
+       << "# HELP hebench_benchmarks_failed Number of benchmarks failed so far." << std::endl
+       << "# TYPE hebench_benchmarks_failed counter" << std::endl
+       << "hebench_benchmarks_failed " << state.failed_benchmarks << std::endl
+       << "# HELP hebench_benchmarks_remaining Number of benchmarks still to run, including current." << std::endl
+       << "# TYPE hebench_benchmarks_remaining gauge" << std::endl
+       << "hebench_benchmarks_remaining " << (total > completed ? total - completed : 0) << std::endl
+       << "# HELP hebench_current_benchmark_info Benchmark currently running." << std::endl
+       << "# TYPE hebench_current_benchmark_info gauge" << std::endl
+       << "hebench_current_benchmark_info{run_index=\"" << state.run_index
+       << "\",benchmark_id=\"" << state.benchmark_id
+       << "\",path=\"" << escapeLabelValue(s_path)
+       << "\",phase=\"" << escapeLabelValue(s_phase) << "\"} 1" << std::endl
+       << "# HELP hebench_current_benchmark_operations Operations completed by the current benchmark, reset when a benchmark starts." << std::endl
+       << "# TYPE hebench_current_benchmark_operations gauge" << std::endl
+       << "hebench_current_benchmark_operations " << state.ops_done << std::endl
+       << "# HELP hebench_operations_per_second Rolling operation rate over the last samples." << std::endl
+       << "# TYPE hebench_operations_per_second gauge" << std::endl
+       << "hebench_operations_per_second " << ops_per_sec << std::endl
+       << "# HELP hebench_operation_latency_seconds Rolling operation latency over the last samples." << std::endl
+       << "# TYPE hebench_operation_latency_seconds summary" << std::endl;
+    for (double q : { 0.5, 0.9, 0.99 })
+    {
+        ss << "hebench_operation_latency_seconds{quantile=\"" << q << "\"} ";
+        if (latencies.empty())
+            ss << "NaN";
+        else
+            ss << latencies[std::min(latencies.size() - 1,
+                                     static_cast<std::size_t>(q * latencies.size()))];
+        ss << std::endl;
+    } // end for
+    ss << "hebench_operation_latency_seconds_sum " << window_sum_s << std::endl
+       << "hebench_operation_latency_seconds_count " << window_ops << std::endl
+       << "# HELP hebench_process_resident_memory_bytes Resident set size of the harness process." << std::endl
+       << "# TYPE hebench_process_resident_memory_bytes gauge" << std::endl
+       << "hebench_process_resident_memory_bytes " << hebench::Utilities::getResidentMemoryBytes() << std::endl
+       << "# HELP hebench_process_peak_resident_memory_bytes Peak resident set size of the harness process." << std::endl
+       << "# TYPE hebench_process_peak_resident_memory_bytes gauge" << std::endl
+       << "hebench_process_peak_resident_memory_bytes " << readPeakResidentMemoryBytes() << std::endl
+       << "# HELP hebench_run_elapsed_seconds Wall time since the run started." << std::endl
+       << "# TYPE hebench_run_elapsed_seconds gauge" << std::endl
+       << "hebench_run_elapsed_seconds " << elapsed_s << std::endl;
+    return ss.str();
+}
+
+void LiveMetrics::initialize(const std::string &file_path,
+                             const std::string &socket_path,
+                             std::size_t interval_ms)
+{
+    if (file_path.empty() && socket_path.empty())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Live metrics require an output file or a socket path."));
+    terminate();
+    std::atomic_store(&m_p_publisher, std::make_shared<Publisher>(file_path, socket_path, interval_ms));
+    m_b_enabled.store(true, std::memory_order_relaxed);
+}
+
+void LiveMetrics::terminate()
+{
+    m_b_enabled.store(false, std::memory_order_relaxed);
+    // publisher stops when last reference goes out of scope
+    std::atomic_exchange(&m_p_publisher, std::shared_ptr<Publisher>());
+}
+
+bool LiveMetrics::isInitialized()
+{
+    return static_cast<bool>(std::atomic_load(&m_p_publisher));
+}
+
+void LiveMetrics::setTotalBenchmarks(std::uint64_t total)
+{
+    std::shared_ptr<Publisher> p_publisher = std::atomic_load(&m_p_publisher);
+    if (p_publisher)
+        p_publisher->state.total_benchmarks = total;
+}
+
+void LiveMetrics::beginBenchmark(std::uint64_t run_index,
+                                 std::uint64_t benchmark_id,
+                                 const std::string &path)
+{
+    std::shared_ptr<Publisher> p_publisher = std::atomic_load(&m_p_publisher);
+    if (p_publisher)
+    {
+        LiveMetricsState &state = p_publisher->state;
+        state.run_index         = run_index;
+        state.benchmark_id      = benchmark_id;
+        state.ops_done          = 0;
+        for (auto &sample : state.samples)
+            sample.count.store(0, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(state.mtx_labels);
+        state.benchmark_path = path;
+        state.phase          = "Initialization";
+    } // end if
+}
+
+void LiveMetrics::endBenchmark(bool succeeded)
+{
+    std::shared_ptr<Publisher> p_publisher = std::atomic_load(&m_p_publisher);
+    if (p_publisher)
+    {
+        ++p_publisher->state.completed_benchmarks;
+        if (!succeeded)
+            ++p_publisher->state.failed_benchmarks;
+        std::lock_guard<std::mutex> lock(p_publisher->state.mtx_labels);
+        p_publisher->state.phase = "Completed";
+    } // end if
+}
+
+void LiveMetrics::setPhase(const std::string &phase)
+{
+    std::shared_ptr<Publisher> p_publisher = std::atomic_load(&m_p_publisher);
+    if (p_publisher)
+    {
+        std::lock_guard<std::mutex> lock(p_publisher->state.mtx_labels);
+        p_publisher->state.phase = phase;
+    } // end if
+}
+
+void LiveMetrics::recordOperation(double wall_time_ms, std::uint64_t count)
+{
+    // the flag may lag behind the publisher, which is checked below, so
+    // this only skips the shared_ptr access in the common, disabled case
+    if (count <= 0 || !m_b_enabled.load(std::memory_order_relaxed))
+        return;
+    std::shared_ptr<Publisher> p_publisher = std::atomic_load(&m_p_publisher);
+    if (p_publisher)
+    {
+        LiveMetricsState &state = p_publisher->state;
+        state.ops_done.fetch_add(count, std::memory_order_relaxed);
+        OperationSample &sample = state.samples[state.sample_next.fetch_add(1, std::memory_order_relaxed) % state.samples.size()];
+        sample.end_ns.store(steadyNowNs(), std::memory_order_relaxed);
+        sample.wall_time_ms.store(wall_time_ms, std::memory_order_relaxed);
+        sample.count.store(count, std::memory_order_relaxed);
+    } // end if
+}
+
+} // namespace TestHarness
+} // namespace hebench
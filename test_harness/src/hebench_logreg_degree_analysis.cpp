@@ -0,0 +1,264 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "benchmarks/LogisticRegression/include/hebench_logreg.h"
+#include "benchmarks/categories/include/hebench_benchmark_category.h"
+#include "include/hebench_logreg_degree_analysis.h"
+
+namespace hebench {
+namespace TestHarness {
+
+unsigned int LogRegDegreeAnalysis::getPolynomialDepth(unsigned int degree)
+{
+    unsigned int retval = 0;
+    // highest power reachable with retval squarings is 2^retval
+    while (degree > 0 && (1U << retval) < degree)
+        ++retval;
+    return retval;
+}
+
+bool LogRegDegreeAnalysis::isComparedWorkload(hebench::APIBridge::Workload workload)
+{
+    return workload == hebench::APIBridge::Workload::LogisticRegression
+           || workload == hebench::APIBridge::Workload::LogisticRegression_PolyD3
+           || workload == hebench::APIBridge::Workload::LogisticRegression_PolyD5
+           || workload == hebench::APIBridge::Workload::LogisticRegression_PolyD7;
+}
+
+std::string LogRegDegreeAnalysis::getGroupPath(const IBenchmarkDescription::Description &description)
+{
+    // replace the workload component of the path
+    std::filesystem::path bench_path(description.path);
+    std::filesystem::path retval;
+    auto it = bench_path.begin();
+    if (it == bench_path.end())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid empty benchmark path."));
+    retval = "*";
+    for (++it; it != bench_path.end(); ++it)
+        retval /= *it;
+    return retval.generic_string();
+}
+
+std::string LogRegDegreeAnalysis::getActivationName(unsigned int degree)
+{
+    // same as the benchmark header
+    return degree > 0 ? "sigmoid_pd" + std::to_string(degree) : std::string("sigmoid");
+}
+
+bool LogRegDegreeAnalysis::readError(const std::string &footer, unsigned int &degree, Error &error)
+{
+    std::istringstream is(footer);
+    std::string line;
+    bool b_found = false;
+    while (!b_found && std::getline(is, line))
+        b_found = (line == LogisticRegression::DataGenerator::ActivationErrorFooterTitle);
+    if (!b_found || !std::getline(is, line) || !std::getline(is, line)) // skip column names
+        return false;
+
+    std::istringstream is_values(line);
+    char comma[4];
+    is_values >> degree >> comma[0]
+        >> error.result_count >> comma[1]
+        >> error.max_abs >> comma[2]
+        >> error.mean_abs >> comma[3]
+        >> error.rms;
+    return !is_values.fail()
+           && std::all_of(std::begin(comma), std::end(comma), [](char c) { return c == ','; });
+}
+
+bool LogRegDegreeAnalysis::addReport(const IBenchmarkDescription::Description &description,
+                                     const hebench::TestHarness::Report::cpp::TimingReport &report)
+{
+    using Fingerprint = hebench::TestHarness::Report::cpp::Fingerprint;
+
+    Member member;
+    if (!readError(report.getFooter(), member.degree, member.error))
+        return false;
+
+    std::string group_path  = getGroupPath(description);
+    Fingerprint fingerprint = Fingerprint::fromHeader(report.getHeader());
+    auto it                 = m_group_index.find(group_path);
+    if (it == m_group_index.end())
+    {
+        it = m_group_index.emplace(group_path, m_groups.size()).first;
+        m_groups.emplace_back();
+        m_groups.back().path        = group_path;
+        m_groups.back().fingerprint = fingerprint;
+    } // end if
+    Group &group = m_groups[it->second];
+
+    std::vector<Fingerprint::Difference> diffs = Fingerprint::compare(group.fingerprint, fingerprint);
+    diffs.erase(std::remove_if(diffs.begin(), diffs.end(),
+                               [](const Fingerprint::Difference &diff) { return !Fingerprint::isIncompatible(diff); }),
+                diffs.end());
+    if (!diffs.empty())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Fingerprint differs from the other reports in group " + group_path
+                                                     + ":\n" + Fingerprint::toString(diffs)));
+
+    // wall time per iteration of every event type, added up by phase
+    struct EventTypeTime
+    {
+        double wall_time_s       = 0.0;
+        std::uint64_t iterations = 0;
+    };
+    std::vector<std::uint32_t> event_type_ids; // in order of first appearance
+    std::map<std::uint32_t, EventTypeTime> event_type_times;
+    const hebench::TestHarness::Report::TimingReportEventC *p_events = report.getEventsData();
+    for (std::uint64_t event_i = 0; p_events && event_i < report.getEventCount(); ++event_i)
+    {
+        const hebench::TestHarness::Report::TimingReportEventC &event = p_events[event_i];
+        auto time_it                                                  = event_type_times.find(event.event_type_id);
+        if (time_it == event_type_times.end())
+        {
+            time_it = event_type_times.emplace(event.event_type_id, EventTypeTime()).first;
+            event_type_ids.push_back(event.event_type_id);
+        } // end if
+        time_it->second.wall_time_s += (event.wall_time_end - event.wall_time_start)
+                                       * event.time_interval_ratio_num / event.time_interval_ratio_den;
+        time_it->second.iterations += event.iterations;
+    } // end for
+
+    for (std::uint32_t event_type_id : event_type_ids)
+    {
+        std::string phase_name = report.getEventTypeHeader(event_type_id);
+        if (!PartialBenchmarkCategory::isBackendPhase(phase_name)
+            || event_type_times[event_type_id].iterations <= 0)
+            continue;
+        member.phases[phase_name] += event_type_times[event_type_id].wall_time_s / event_type_times[event_type_id].iterations;
+        if (std::find(group.phase_names.begin(), group.phase_names.end(), phase_name) == group.phase_names.end())
+            group.phase_names.push_back(phase_name);
+    } // end for
+
+    // keep members sorted by degree
+    auto member_it = std::upper_bound(group.members.begin(), group.members.end(), member.degree,
+                                      [](unsigned int degree, const Member &rhs) { return degree < rhs.degree; });
+    group.members.insert(member_it, std::move(member));
+
+    return true;
+}
+
+std::size_t LogRegDegreeAnalysis::getGroupCount() const
+{
+    std::size_t retval = 0;
+    for (const Group &group : m_groups)
+        if (group.members.size() > 1)
+            ++retval;
+    return retval;
+}
+
+double LogRegDegreeAnalysis::getPhaseCost(const Member &member, const std::string &phase_name, bool &b_found)
+{
+    double retval = 0.0;
+    if (phase_name == TotalPhaseName)
+    {
+        b_found = !member.phases.empty();
+        for (const auto &phase : member.phases)
+            retval += phase.second;
+    } // end if
+    else
+    {
+        auto it = member.phases.find(phase_name);
+        b_found = (it != member.phases.end());
+        if (b_found)
+            retval = it->second;
+    } // end else
+    return retval;
+}
+
+const LogRegDegreeAnalysis::Member &LogRegDegreeAnalysis::getReference(const Group &group)
+{
+    // members are sorted by degree
+    auto it = std::find_if(group.members.begin(), group.members.end(),
+                           [](const Member &member) { return member.degree > 0; });
+    return it == group.members.end() ? group.members.front() : *it;
+}
+
+void LogRegDegreeAnalysis::save2CSV(const std::filesystem::path &filename) const
+{
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + filename.string()));
+
+    fnum << std::setprecision(9)
+         << "Benchmark group,Activation,Degree,Polynomial depth,Reference,Phase,"
+         << "Wall time (s),Growth,Growth per depth level,"
+         << "Results,Max absolute error,Mean absolute error,RMS error" << std::endl;
+    for (const Group &group : m_groups)
+    {
+        if (group.members.size() <= 1)
+            continue;
+        const Member &reference      = getReference(group);
+        unsigned int reference_depth = getPolynomialDepth(reference.degree);
+        std::vector<std::string> phase_names(group.phase_names);
+        phase_names.push_back(TotalPhaseName);
+        for (const Member &member : group.members)
+        {
+            unsigned int depth = getPolynomialDepth(member.degree);
+            for (const std::string &phase_name : phase_names)
+            {
+                bool b_found;
+                bool b_reference_found;
+                double cost           = getPhaseCost(member, phase_name, b_found);
+                double reference_cost = getPhaseCost(reference, phase_name, b_reference_found);
+                fnum << "\"" << group.path << "\"," << getActivationName(member.degree) << ","
+                     << member.degree << "," << depth << "," << getActivationName(reference.degree) << ","
+                     << phase_name << ",";
+                if (b_found)
+                    fnum << cost;
+                fnum << ",";
+                if (b_found && b_reference_found && reference_cost > 0.0)
+                {
+                    double growth = cost / reference_cost;
+                    fnum << growth << ",";
+                    if (depth > reference_depth)
+                        fnum << std::pow(growth, 1.0 / (depth - reference_depth));
+                } // end if
+                else
+                    fnum << ",";
+                fnum << "," << member.error.result_count << "," << member.error.max_abs << ","
+                     << member.error.mean_abs << "," << member.error.rms << std::endl;
+            } // end for
+        } // end for
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing polynomial degree analysis: " + filename.string()));
+}
+
+std::ostream &LogRegDegreeAnalysis::show(std::ostream &os) const
+{
+    std::size_t group_i = 0;
+    for (const Group &group : m_groups)
+    {
+        if (group.members.size() <= 1)
+            continue;
+        const Member &reference = getReference(group);
+        bool b_reference_found;
+        double reference_total = getPhaseCost(reference, TotalPhaseName, b_reference_found);
+        os << ++group_i << ". " << group.path << std::endl
+           << "    Reference: " << getActivationName(reference.degree) << std::endl;
+        for (const Member &member : group.members)
+        {
+            bool b_found;
+            double total = getPhaseCost(member, TotalPhaseName, b_found);
+            os << "    " << getActivationName(member.degree)
+               << " (depth " << getPolynomialDepth(member.degree) << "): "
+               << std::fixed << std::setprecision(3) << total * 1000.0 << " ms";
+            if (&member != &reference && b_reference_found && reference_total > 0.0)
+                os << " (x" << std::setprecision(2) << total / reference_total << ")";
+            os << std::defaultfloat << std::setprecision(3)
+               << ", max error " << member.error.max_abs
+               << ", RMS error " << member.error.rms << std::endl;
+        } // end for
+    } // end for
+    return os;
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -0,0 +1,450 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include <alloca.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/personality.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "include/hebench_benchmark_runner.h"
+#include "include/hebench_live_metrics.h"
+#include "include/hebench_memory_layout.h"
+#include "include/hebench_progress.h"
+
+extern char **environ;
+
+namespace hebench {
+namespace TestHarness {
+
+namespace {
+
+// padding allocated in the child: kept alive until process exits
+std::vector<void *> g_heap_padding;
+
+/**
+ * @brief Moves the stack pointer down by \p bytes before calling \p func.
+ * @details Not inlined, so that the allocation is not merged into the frame
+ * of the caller.
+ */
+__attribute__((noinline)) void callOffset(std::size_t bytes, const std::function<void()> &func)
+{
+    volatile char *p_offset = static_cast<volatile char *>(alloca(bytes + 1));
+    p_offset[0]             = 0; // keep the allocation
+    func();
+    p_offset[bytes] = 0; // keep the allocation alive during the call
+}
+
+} // namespace
+
+std::vector<MemoryLayout::Layout> MemoryLayout::generateLayouts(std::size_t count, std::uint64_t seed)
+{
+    std::vector<Layout> retval(count);
+    std::mt19937_64 rand_gen(seed);
+    std::uniform_int_distribution<std::size_t> env_dist(0, MaxEnvPadding - 1);
+    std::uniform_int_distribution<std::size_t> heap_dist(0, MaxHeapPadding - 1);
+    std::uniform_int_distribution<std::size_t> mapping_dist(0, MaxMappingPadding - 1);
+    std::uniform_int_distribution<std::size_t> stack_dist(0, MaxStackOffset - 1);
+    for (std::size_t i = 0; i < retval.size(); ++i)
+    {
+        retval[i].index           = i;
+        retval[i].b_aslr          = i % 2 == 0;
+        retval[i].env_padding     = env_dist(rand_gen);
+        retval[i].heap_padding    = heap_dist(rand_gen);
+        retval[i].mapping_padding = mapping_dist(rand_gen);
+        retval[i].stack_offset    = stack_dist(rand_gen);
+    } // end for
+    return retval;
+}
+
+std::string MemoryLayout::toChildArgument(const Layout &layout)
+{
+    std::stringstream ss;
+    ss << layout.heap_padding << "," << layout.mapping_padding << "," << layout.stack_offset;
+    return ss.str();
+}
+
+MemoryLayout::Layout MemoryLayout::fromChildArgument(const std::string &arg)
+{
+    Layout retval = {};
+    std::istringstream is(arg);
+    char comma_0 = 0;
+    char comma_1 = 0;
+    if (!(is >> retval.heap_padding >> comma_0 >> retval.mapping_padding >> comma_1 >> retval.stack_offset)
+        || comma_0 != ',' || comma_1 != ',' || !is.eof())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid memory layout: \"" + arg + "\"."));
+    if (retval.heap_padding >= MaxHeapPadding
+        || retval.mapping_padding >= MaxMappingPadding
+        || retval.stack_offset >= MaxStackOffset)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Memory layout out of range: \"" + arg + "\"."));
+    return retval;
+}
+
+void MemoryLayout::runChild(const Layout &layout,
+                            const std::vector<std::string> &child_args,
+                            const std::filesystem::path &log_file)
+{
+    std::vector<char *> argv;
+    std::string arg0 = "test_harness";
+    argv.push_back(arg0.data());
+    for (const std::string &arg : child_args)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    // environment of the child: ours, with the padding variable replaced
+    std::string env_prefix  = std::string(EnvPaddingVar) + "=";
+    std::string env_padding = env_prefix + std::string(layout.env_padding, 'x');
+    std::vector<char *> envp;
+    for (char **p_env = environ; p_env && *p_env; ++p_env)
+        if (std::strncmp(*p_env, env_prefix.c_str(), env_prefix.size()) != 0)
+            envp.push_back(*p_env);
+    envp.push_back(env_padding.data());
+    envp.push_back(nullptr);
+
+    int log_fd = open(log_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (log_fd < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + log_file.string()));
+
+    // make sure buffered output is not duplicated by the child
+    std::cout.flush();
+    std::cerr.flush();
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // child: a fresh process image from the same binary
+        dup2(log_fd, STDOUT_FILENO);
+        dup2(log_fd, STDERR_FILENO);
+        close(log_fd);
+        // personality is inherited through execve
+        int persona = personality(0xffffffff);
+        if (persona < 0
+            || personality(layout.b_aslr ? (persona & ~ADDR_NO_RANDOMIZE) : (persona | ADDR_NO_RANDOMIZE)) < 0)
+            _exit(126);
+        execve("/proc/self/exe", argv.data(), envp.data());
+        _exit(127);
+    } // end if
+    close(log_fd);
+    if (pid < 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS(std::string("Could not create child process: ") + std::strerror(errno)));
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+            throw std::runtime_error(IL_LOG_MSG_CLASS(std::string("Error waiting for child process: ") + std::strerror(errno)));
+    } // end while
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 126)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not set ASLR for memory layout child process."));
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Memory layout child process failed. See output in: " + log_file.string()));
+}
+
+void MemoryLayout::applyPadding(const Layout &layout)
+{
+    if (layout.heap_padding > 0)
+    {
+        // under the mmap threshold, this moves the program break
+        void *p = std::malloc(layout.heap_padding);
+        if (!p)
+            throw std::bad_alloc();
+        std::memset(p, 0, layout.heap_padding);
+        g_heap_padding.push_back(p);
+    } // end if
+    if (layout.mapping_padding > 0)
+    {
+        // shifts the addresses of later mappings, such as the backend library
+        std::size_t size = layout.mapping_padding * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        void *p          = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::runtime_error(IL_LOG_MSG_CLASS(std::string("Could not map memory layout padding: ") + std::strerror(errno)));
+    } // end if
+}
+
+void MemoryLayout::runWithStackOffset(const Layout &layout, const std::function<void()> &func)
+{
+    callOffset(layout.stack_offset, func);
+}
+
+std::vector<double> MemoryLayout::getEventTimes(const hebench::TestHarness::Report::cpp::TimingReport &report)
+{
+    std::vector<double> retval;
+    std::uint32_t main_event_type = report.getMainEventType();
+    const hebench::TestHarness::Report::TimingReportEventC *p_events = report.getEventsData();
+    for (std::uint64_t event_i = 0; event_i < report.getEventCount(); ++event_i)
+    {
+        const hebench::TestHarness::Report::TimingReportEventC &event = p_events[event_i];
+        if (event.event_type_id == main_event_type && event.iterations > 0 && event.time_interval_ratio_den != 0)
+            retval.push_back((event.wall_time_end - event.wall_time_start) * 1000.0
+                             * event.time_interval_ratio_num / event.time_interval_ratio_den
+                             / event.iterations);
+    } // end for
+    return retval;
+}
+
+MemoryLayout::Stats MemoryLayout::computeStats(const std::vector<Sample> &samples)
+{
+    // one-way random effects model, with layouts as groups of unequal sizes
+    Stats retval = {};
+    std::vector<double> layout_means;
+    std::vector<std::size_t> layout_sizes;
+    double sum = 0.0;
+    for (const Sample &sample : samples)
+    {
+        if (!sample.b_succeeded || sample.event_times_ms.empty())
+            continue;
+        double layout_sum = 0.0;
+        for (double value : sample.event_times_ms)
+            layout_sum += value;
+        sum += layout_sum;
+        layout_means.push_back(layout_sum / sample.event_times_ms.size());
+        layout_sizes.push_back(sample.event_times_ms.size());
+        retval.event_count += sample.event_times_ms.size();
+    } // end for
+    retval.layout_count = layout_means.size();
+    if (retval.layout_count <= 0)
+        return retval;
+
+    double n          = static_cast<double>(retval.event_count);
+    double k          = static_cast<double>(retval.layout_count);
+    retval.mean_ms    = sum / n;
+    double ss_between = 0.0;
+    double ss_within  = 0.0;
+    double sum_sizes2 = 0.0;
+    std::size_t layout_i = 0;
+    for (const Sample &sample : samples)
+    {
+        if (!sample.b_succeeded || sample.event_times_ms.empty())
+            continue;
+        double layout_mean = layout_means[layout_i];
+        for (double value : sample.event_times_ms)
+            ss_within += (value - layout_mean) * (value - layout_mean);
+        ss_between += layout_sizes[layout_i] * (layout_mean - retval.mean_ms) * (layout_mean - retval.mean_ms);
+        sum_sizes2 += static_cast<double>(layout_sizes[layout_i]) * layout_sizes[layout_i];
+        ++layout_i;
+    } // end for
+
+    // with one event per layout, within-layout variance cannot be estimated
+    double ms_within       = n > k ? ss_within / (n - k) : 0.0;
+    double layout_variance = 0.0;
+    if (retval.layout_count > 1)
+    {
+        double ms_between = ss_between / (k - 1);
+        double n0         = (n - sum_sizes2 / n) / (k - 1); // effective events per layout
+        layout_variance   = std::max(0.0, (ms_between - ms_within) / n0);
+    } // end if
+    retval.layout_stddev_ms   = std::sqrt(layout_variance);
+    retval.within_stddev_ms   = std::sqrt(ms_within);
+    retval.layout_share       = layout_variance + ms_within > 0.0 ? layout_variance / (layout_variance + ms_within) : 0.0;
+    retval.min_layout_mean_ms = *std::min_element(layout_means.begin(), layout_means.end());
+    retval.max_layout_mean_ms = *std::max_element(layout_means.begin(), layout_means.end());
+    return retval;
+}
+
+void MemoryLayout::saveSamples(const std::filesystem::path &filename, const std::vector<Sample> &samples)
+{
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + filename.string()));
+
+    fnum << "Layout,ASLR,Env padding (bytes),Heap padding (bytes),Mapping padding (pages),Stack offset (bytes),"
+         << "Status,Events,Mean (ms),Std dev (ms),Message" << std::endl;
+    fnum << std::setprecision(17);
+    for (const Sample &sample : samples)
+    {
+        const std::vector<double> &values = sample.event_times_ms;
+        double mean                       = 0.0;
+        double variance                   = 0.0;
+        for (double value : values)
+            mean += value;
+        if (!values.empty())
+            mean /= values.size();
+        for (double value : values)
+            variance += (value - mean) * (value - mean);
+        if (values.size() > 1)
+            variance /= values.size() - 1;
+        fnum << sample.layout.index << "," << (sample.layout.b_aslr ? "On" : "Off") << ","
+             << sample.layout.env_padding << "," << sample.layout.heap_padding << ","
+             << sample.layout.mapping_padding << "," << sample.layout.stack_offset << ","
+             << (sample.b_succeeded ? "OK" : "Failed") << "," << values.size() << ",";
+        if (values.empty())
+            fnum << ",";
+        else
+            fnum << mean << "," << std::sqrt(variance);
+        fnum << ",\"" << sample.message << "\"" << std::endl;
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing memory layout samples: " + filename.string()));
+}
+
+void MemoryLayout::saveSummary(const std::filesystem::path &filename,
+                               const std::vector<std::pair<std::string, Stats>> &bench_stats)
+{
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + filename.string()));
+
+    fnum << "Benchmark,Layouts,Events,Mean (ms),Layout std dev (ms),Within-layout std dev (ms),"
+         << "Layout share (%),Min layout mean (ms),Max layout mean (ms)" << std::endl;
+    fnum << std::setprecision(17);
+    for (const auto &[name, stats] : bench_stats)
+    {
+        fnum << "\"" << name << "\"," << stats.layout_count << "," << stats.event_count << ",";
+        if (stats.layout_count <= 0)
+            fnum << ",,,,,";
+        else
+            fnum << stats.mean_ms << "," << stats.layout_stddev_ms << "," << stats.within_stddev_ms << ","
+                 << stats.layout_share * 100.0 << "," << stats.min_layout_mean_ms << "," << stats.max_layout_mean_ms;
+        fnum << std::endl;
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing memory layout summary: " + filename.string()));
+}
+
+std::ostream &MemoryLayout::show(std::ostream &os, const std::vector<Sample> &samples)
+{
+    Stats stats = computeStats(samples);
+    os << "Layouts succeeded: " << stats.layout_count << " / " << samples.size() << std::endl;
+    if (stats.layout_count > 0)
+    {
+        os << std::fixed << std::setprecision(3)
+           << "Mean (ms): " << stats.mean_ms << std::endl
+           << "Layout-induced std dev (ms): " << stats.layout_stddev_ms
+           << " (" << std::setprecision(1) << stats.layout_share * 100.0 << "% of variance)" << std::endl
+           << std::setprecision(3)
+           << "Within-layout std dev (ms): " << stats.within_stddev_ms << std::endl
+           << "Layout means (ms): " << stats.min_layout_mean_ms << " - " << stats.max_layout_mean_ms << std::endl
+           << std::defaultfloat;
+    } // end if
+    return os;
+}
+
+std::vector<std::string> MemoryLayout::run(Engine &engine,
+                                           hebench::Utilities::BenchmarkConfiguration &bench_configuration,
+                                           const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                           const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                                           const ProgramConfig &config)
+{
+    std::vector<std::string> retval;
+    std::stringstream ss;
+
+    // same layouts for every benchmark
+    std::vector<Layout> layouts = generateLayouts(config.layout_samples, bench_config.random_seed);
+    std::vector<std::pair<std::string, Stats>> bench_stats;
+
+    std::size_t run_i      = 0;
+    std::size_t total_runs = hebench::Utilities::BenchmarkConfiguration::countBenchmarks2Run(benchmarks_to_run);
+    for (const BenchmarkRequest &bench_to_run : benchmarks_to_run)
+    {
+        for (const std::vector<hebench::APIBridge::WorkloadParam> &w_params : bench_to_run.sets_w_params)
+        {
+            BenchmarkFactory::BenchmarkToken::Ptr bench_token =
+                engine.describeBenchmark(bench_config, bench_to_run.benchmark_index, w_params);
+            std::string bench_path            = bench_token->description.path;
+            std::filesystem::path report_path = config.report_root_path / bench_path;
+            std::filesystem::path config_file = report_path / "layout_config.yaml";
+
+            BenchmarkRequest bench_request;
+            bench_request.benchmark_index = bench_to_run.benchmark_index;
+            bench_request.sets_w_params.push_back(w_params);
+            std::filesystem::create_directories(report_path);
+            bench_configuration.saveConfiguration(config_file, { bench_request }, bench_config);
+
+            ss = std::stringstream();
+            ss << "Memory layouts " << run_i + 1 << "/" << total_runs << ": " << bench_path;
+            std::cout << std::endl
+                      << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+            LiveMetrics::beginBenchmark(run_i, run_i, bench_path);
+            LiveMetrics::setPhase("Memory layouts");
+
+            // every layout has its own report under the layouts root of the benchmark
+            std::vector<Sample> samples;
+            Progress::beginPhase("Memory layouts", layouts.size());
+            for (const Layout &layout : layouts)
+            {
+                std::filesystem::path layout_root_path = report_path / LayoutsDirName
+                                                         / ("layout_" + std::to_string(layout.index));
+                std::filesystem::create_directories(layout_root_path);
+                std::vector<std::string> child_args = config.getChildArgs(config_file, layout_root_path, bench_config.random_seed);
+                child_args.insert(child_args.end(), { "--layout_child", toChildArgument(layout) });
+
+                samples.emplace_back();
+                Sample &sample = samples.back();
+                sample.layout  = layout;
+                try
+                {
+                    runChild(layout, child_args, layout_root_path / ChildLogFile);
+                    sample.event_times_ms = getEventTimes(
+                        Report::cpp::TimingReport::loadReportFromCSVFile(
+                            BenchmarkRunner::getReportFilename(layout_root_path, bench_path)));
+                    sample.b_succeeded = !sample.event_times_ms.empty();
+                    if (!sample.b_succeeded)
+                        sample.message = "No events in report.";
+                }
+                catch (std::exception &ex)
+                {
+                    // layouts that fail are recorded and left out of the statistics
+                    sample.b_succeeded = false;
+                    sample.message     = ex.what();
+                    std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log(ex.what()) << std::endl;
+                }
+                Progress::advance();
+            } // end for
+            Progress::endPhase();
+
+            saveSamples(report_path / SamplesFile, samples);
+            bench_stats.emplace_back(bench_path, computeStats(samples));
+            bool b_succeeded = bench_stats.back().second.layout_count > 0;
+            if (!b_succeeded)
+                retval.push_back(bench_path);
+            ss = std::stringstream();
+            show(ss, samples);
+            std::cout << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+            LiveMetrics::endBenchmark(b_succeeded);
+            ++run_i;
+        } // end for
+    } // end for
+
+    saveSummary(config.report_root_path / SummaryFile, bench_stats);
+    ss = std::stringstream();
+    ss << "Memory layout summary saved to: " << std::endl
+       << config.report_root_path / SummaryFile;
+    std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+    return retval;
+}
+
+
+void MemoryLayout::runInLayout(Engine &engine,
+                               const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                               const std::vector<BenchmarkRequest> &benchmarks_to_run,
+                               const ProgramConfig &config)
+{
+    if (benchmarks_to_run.size() != 1 || benchmarks_to_run.front().sets_w_params.size() != 1)
+        throw std::runtime_error("Memory layout child requires a configuration with exactly one benchmark.");
+
+    std::vector<std::string> failed_benchmarks;
+    runWithStackOffset(
+        fromChildArgument(config.layout_child),
+        [&]() {
+            BenchmarkRunner::run(engine, bench_config, benchmarks_to_run, config, config.report_root_path, failed_benchmarks);
+        });
+    if (!failed_benchmarks.empty())
+        throw std::runtime_error("Benchmark failed: " + failed_benchmarks.front());
+}
+
+} // namespace TestHarness
+} // namespace hebench
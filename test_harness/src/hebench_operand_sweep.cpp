@@ -0,0 +1,481 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "include/hebench_benchmark_runner.h"
+#include "include/hebench_live_metrics.h"
+#include "include/hebench_operand_sweep.h"
+
+namespace hebench {
+namespace TestHarness {
+
+OperandSweep::OperandSweep(const std::string &name,
+                           const IBenchmarkDescription::Description &description,
+                           const OperandSweepRequest &request) :
+    m_name(name),
+    m_flexible_operands(description.flexible_sample_params)
+{
+    if (m_flexible_operands.empty())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Operand sweep requires an Offline benchmark with operands of flexible sample size: " + name));
+    if (request.sample_sizes.empty())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("No sample sizes requested for operand sweep: " + name));
+    if (std::find(request.sample_sizes.begin(), request.sample_sizes.end(), 0) != request.sample_sizes.end())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Sample sizes for operand sweep must be positive: " + name));
+
+    const std::vector<std::uint64_t> &base = description.sample_sizes;
+    m_point_sample_sizes.push_back(base);
+    for (std::size_t operand_i : m_flexible_operands)
+    {
+        for (std::uint64_t sample_size : request.sample_sizes)
+        {
+            std::vector<std::uint64_t> sample_sizes = base;
+            sample_sizes[operand_i]                 = sample_size;
+            if (std::find(m_point_sample_sizes.begin(), m_point_sample_sizes.end(), sample_sizes) == m_point_sample_sizes.end())
+                m_point_sample_sizes.push_back(sample_sizes);
+        } // end for
+    } // end for
+
+    // all flexible operands varied together separate the fixed cost from the cost per result
+    if (m_flexible_operands.size() > 1)
+    {
+        std::vector<std::uint64_t> sample_sizes = base;
+        std::uint64_t min_sample_size           = *std::min_element(request.sample_sizes.begin(), request.sample_sizes.end());
+        for (std::size_t operand_i : m_flexible_operands)
+            sample_sizes[operand_i] = min_sample_size;
+        if (std::find(m_point_sample_sizes.begin(), m_point_sample_sizes.end(), sample_sizes) == m_point_sample_sizes.end())
+            m_point_sample_sizes.push_back(sample_sizes);
+    } // end if
+}
+
+void OperandSweep::addPoint(const hebench::TestHarness::Report::cpp::TimingReport &report)
+{
+    if (isDone())
+        throw std::logic_error(IL_LOG_MSG_CLASS("All points of the operand sweep have been added."));
+
+    Point point        = {};
+    point.sample_sizes = m_point_sample_sizes[m_points.size()];
+
+    // offline operations time the whole batch in a single event
+    std::vector<double> times_ms;
+    std::uint32_t main_event_type = report.getMainEventType();
+    const hebench::TestHarness::Report::TimingReportEventC *p_events = report.getEventsData();
+    for (std::uint64_t event_i = 0; event_i < report.getEventCount(); ++event_i)
+    {
+        const hebench::TestHarness::Report::TimingReportEventC &event = p_events[event_i];
+        if (event.event_type_id == main_event_type && event.time_interval_ratio_den != 0)
+        {
+            times_ms.push_back((event.wall_time_end - event.wall_time_start) * 1000.0
+                               * event.time_interval_ratio_num / event.time_interval_ratio_den);
+            point.result_count = event.iterations;
+        } // end if
+    } // end for
+
+    point.event_count = times_ms.size();
+    point.b_succeeded = !times_ms.empty();
+    if (!point.b_succeeded)
+        point.message = "No events in report.";
+    else
+    {
+        for (double value : times_ms)
+            point.mean_ms += value;
+        point.mean_ms /= times_ms.size();
+        for (double value : times_ms)
+            point.stddev_ms += (value - point.mean_ms) * (value - point.mean_ms);
+        if (times_ms.size() > 1)
+            point.stddev_ms /= times_ms.size() - 1;
+        point.stddev_ms = std::sqrt(point.stddev_ms);
+    } // end else
+    m_points.push_back(point);
+}
+
+void OperandSweep::addFailedPoint(const std::string &message)
+{
+    if (isDone())
+        throw std::logic_error(IL_LOG_MSG_CLASS("All points of the operand sweep have been added."));
+
+    Point point        = {};
+    point.sample_sizes = m_point_sample_sizes[m_points.size()];
+    point.b_succeeded  = false;
+    point.message      = message;
+    m_points.push_back(point);
+}
+
+bool OperandSweep::solveLeastSquares(std::vector<double> &coeffs,
+                                     const std::vector<std::vector<double>> &x,
+                                     const std::vector<double> &y)
+{
+    std::size_t col_count = x.empty() ? 0 : x.front().size();
+    if (x.size() < col_count || col_count <= 0)
+        return false;
+
+    // scale columns to the same magnitude to condition the normal equations
+    std::vector<double> scale(col_count, 0.0);
+    for (const std::vector<double> &row : x)
+        for (std::size_t col_i = 0; col_i < col_count; ++col_i)
+            scale[col_i] = std::max(scale[col_i], std::abs(row[col_i]));
+    for (double &value : scale)
+        if (value <= 0.0)
+            return false;
+
+    // normal equations: (x^T x) coeffs = x^T y, augmented with the right hand side
+    std::vector<std::vector<double>> a(col_count, std::vector<double>(col_count + 1, 0.0));
+    for (std::size_t row_i = 0; row_i < x.size(); ++row_i)
+    {
+        for (std::size_t i = 0; i < col_count; ++i)
+        {
+            double x_i = x[row_i][i] / scale[i];
+            for (std::size_t j = 0; j < col_count; ++j)
+                a[i][j] += x_i * x[row_i][j] / scale[j];
+            a[i][col_count] += x_i * y[row_i];
+        } // end for
+    } // end for
+
+    // Gaussian elimination with partial pivoting
+    constexpr double Tolerance = 1e-9;
+    for (std::size_t col_i = 0; col_i < col_count; ++col_i)
+    {
+        std::size_t pivot_i = col_i;
+        for (std::size_t row_i = col_i + 1; row_i < col_count; ++row_i)
+            if (std::abs(a[row_i][col_i]) > std::abs(a[pivot_i][col_i]))
+                pivot_i = row_i;
+        if (std::abs(a[pivot_i][col_i]) < Tolerance * x.size())
+            return false; // linearly dependent columns
+        std::swap(a[col_i], a[pivot_i]);
+        for (std::size_t row_i = 0; row_i < col_count; ++row_i)
+        {
+            if (row_i == col_i)
+                continue;
+            double factor = a[row_i][col_i] / a[col_i][col_i];
+            for (std::size_t j = col_i; j <= col_count; ++j)
+                a[row_i][j] -= factor * a[col_i][j];
+        } // end for
+    } // end for
+
+    coeffs.resize(col_count);
+    for (std::size_t col_i = 0; col_i < col_count; ++col_i)
+        coeffs[col_i] = a[col_i][col_count] / a[col_i][col_i] / scale[col_i];
+    return true;
+}
+
+OperandSweep::CostModel OperandSweep::fit() const
+{
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    std::size_t operand_count = m_point_sample_sizes.front().size();
+    CostModel retval          = {};
+    retval.fixed_ms           = NaN;
+    retval.per_result_ms      = NaN;
+    retval.residual_rms_ms    = NaN;
+    retval.per_sample_ms.assign(operand_count, NaN);
+    retval.marginal_ms.assign(operand_count, NaN);
+
+    std::vector<const Point *> points;
+    for (const Point &point : m_points)
+        if (point.b_succeeded)
+            points.push_back(&point);
+
+    // measured slope of each operand: simple linear regression over the base
+    // point and the points that only vary that operand
+    const std::vector<std::uint64_t> &base = m_point_sample_sizes.front();
+    for (std::size_t operand_i : m_flexible_operands)
+    {
+        std::vector<std::pair<double, double>> samples;
+        for (const Point *p_point : points)
+        {
+            bool b_on_axis = true;
+            for (std::size_t j = 0; b_on_axis && j < operand_count; ++j)
+                b_on_axis = j == operand_i || p_point->sample_sizes[j] == base[j];
+            if (b_on_axis)
+                samples.emplace_back(static_cast<double>(p_point->sample_sizes[operand_i]), p_point->mean_ms);
+        } // end for
+        if (samples.size() < 2)
+            continue;
+        double mean_x = 0.0;
+        double mean_y = 0.0;
+        for (const auto &sample : samples)
+        {
+            mean_x += sample.first;
+            mean_y += sample.second;
+        } // end for
+        mean_x /= samples.size();
+        mean_y /= samples.size();
+        double sxx = 0.0;
+        double sxy = 0.0;
+        for (const auto &sample : samples)
+        {
+            sxx += (sample.first - mean_x) * (sample.first - mean_x);
+            sxy += (sample.first - mean_x) * (sample.second - mean_y);
+        } // end for
+        if (sxx > 0.0)
+            retval.marginal_ms[operand_i] = sxy / sxx;
+    } // end for
+
+    // columns: fixed, samples of each flexible operand, results
+    std::vector<std::vector<double>> x;
+    std::vector<double> y;
+    for (const Point *p_point : points)
+    {
+        std::vector<double> row;
+        row.push_back(1.0);
+        for (std::size_t operand_i : m_flexible_operands)
+            row.push_back(static_cast<double>(p_point->sample_sizes[operand_i]));
+        row.push_back(static_cast<double>(p_point->result_count));
+        x.push_back(row);
+        y.push_back(p_point->mean_ms);
+    } // end for
+
+    std::vector<double> coeffs;
+    retval.b_per_result = solveLeastSquares(coeffs, x, y);
+    if (!retval.b_per_result)
+    {
+        // results proportional to samples: leave cost per result out
+        for (std::vector<double> &row : x)
+            row.pop_back();
+        retval.b_valid = solveLeastSquares(coeffs, x, y);
+    } // end if
+    else
+        retval.b_valid = true;
+
+    if (retval.b_valid)
+    {
+        retval.fixed_ms = coeffs[0];
+        for (std::size_t i = 0; i < m_flexible_operands.size(); ++i)
+            retval.per_sample_ms[m_flexible_operands[i]] = coeffs[i + 1];
+        if (retval.b_per_result)
+            retval.per_result_ms = coeffs.back();
+
+        double sum_sq = 0.0;
+        for (std::size_t row_i = 0; row_i < x.size(); ++row_i)
+        {
+            double predicted = 0.0;
+            for (std::size_t col_i = 0; col_i < coeffs.size(); ++col_i)
+                predicted += coeffs[col_i] * x[row_i][col_i];
+            sum_sq += (y[row_i] - predicted) * (y[row_i] - predicted);
+        } // end for
+        retval.residual_rms_ms = std::sqrt(sum_sq / x.size());
+    } // end if
+
+    return retval;
+}
+
+std::string OperandSweep::toString(const std::vector<std::uint64_t> &sample_sizes)
+{
+    std::stringstream ss;
+    for (std::size_t operand_i = 0; operand_i < sample_sizes.size(); ++operand_i)
+    {
+        if (operand_i > 0)
+            ss << "x";
+        ss << sample_sizes[operand_i];
+    } // end for
+    return ss.str();
+}
+
+void OperandSweep::save2CSV(const std::filesystem::path &summary_filename,
+                            const std::filesystem::path &points_filename,
+                            const std::vector<OperandSweep> &sweeps)
+{
+    std::ofstream fnum(points_filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + points_filename.string()));
+    fnum << "Benchmark,Point,Samples,Results,Status,Operations,Mean (ms),Std dev (ms),Message" << std::endl;
+    fnum << std::setprecision(17);
+    for (const OperandSweep &sweep : sweeps)
+    {
+        for (std::size_t point_i = 0; point_i < sweep.m_points.size(); ++point_i)
+        {
+            const Point &point = sweep.m_points[point_i];
+            fnum << "\"" << sweep.getName() << "\"," << point_i << ",\"" << toString(point.sample_sizes) << "\",";
+            if (point.b_succeeded)
+                fnum << point.result_count << ",OK," << point.event_count << ","
+                     << point.mean_ms << "," << point.stddev_ms;
+            else
+                fnum << ",Failed,,,";
+            fnum << ",\"" << point.message << "\"" << std::endl;
+        } // end for
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing operand sweep points: " + points_filename.string()));
+    fnum.close();
+
+    fnum.open(summary_filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + summary_filename.string()));
+    fnum << "Benchmark,Term,Base samples,Cost (ms),Marginal cost at base (ms)" << std::endl;
+    fnum << std::setprecision(17);
+    for (const OperandSweep &sweep : sweeps)
+    {
+        CostModel model                        = sweep.fit();
+        const std::vector<std::uint64_t> &base = sweep.m_point_sample_sizes.front();
+        std::string name                       = "\"" + sweep.getName() + "\"";
+        if (!model.b_valid)
+        {
+            fnum << name << ",Not enough points,,," << std::endl;
+            continue;
+        } // end if
+        fnum << name << ",Fixed,," << model.fixed_ms << "," << std::endl;
+        for (std::size_t operand_i : sweep.m_flexible_operands)
+        {
+            fnum << name << ",Operand " << operand_i << "," << base[operand_i] << ","
+                 << model.per_sample_ms[operand_i] << ",";
+            if (!std::isnan(model.marginal_ms[operand_i]))
+                fnum << model.marginal_ms[operand_i];
+            fnum << std::endl;
+        } // end for
+        fnum << name << ",Result,,";
+        if (model.b_per_result)
+            fnum << model.per_result_ms;
+        fnum << "," << std::endl
+             << name << ",Residual RMS,," << model.residual_rms_ms << "," << std::endl;
+    } // end for
+    if (!fnum)
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Error writing operand sweep summary: " + summary_filename.string()));
+}
+
+std::ostream &OperandSweep::show(std::ostream &os, const std::vector<OperandSweep> &sweeps)
+{
+    for (std::size_t sweep_i = 0; sweep_i < sweeps.size(); ++sweep_i)
+    {
+        const OperandSweep &sweep = sweeps[sweep_i];
+        CostModel model           = sweep.fit();
+        if (sweep_i > 0)
+            os << std::endl;
+        os << sweep_i + 1 << ". " << sweep.getName() << std::endl;
+        if (!model.b_valid)
+        {
+            os << "   Not enough points succeeded to fit the cost model." << std::endl;
+            continue;
+        } // end if
+        os << std::setprecision(6)
+           << "   Fixed (ms): " << model.fixed_ms << std::endl;
+        for (std::size_t operand_i : sweep.m_flexible_operands)
+        {
+            os << "   Operand " << operand_i << " per sample (ms): " << model.per_sample_ms[operand_i];
+            if (!std::isnan(model.marginal_ms[operand_i]))
+                os << " (marginal at base: " << model.marginal_ms[operand_i] << ")";
+            os << std::endl;
+        } // end for
+        if (model.b_per_result)
+            os << "   Per result (ms): " << model.per_result_ms << std::endl;
+        else
+            os << "   Per result: included in per sample cost" << std::endl;
+        os << std::defaultfloat;
+    } // end for
+    return os;
+}
+
+std::vector<BenchmarkRequest> OperandSweep::extract(std::vector<BenchmarkRequest> &benchmarks_to_run)
+{
+    std::vector<BenchmarkRequest> retval;
+    auto it = std::stable_partition(benchmarks_to_run.begin(), benchmarks_to_run.end(),
+                                    [](const BenchmarkRequest &bench_request) {
+                                        return bench_request.operand_sweep.sample_sizes.empty();
+                                    });
+    retval.assign(it, benchmarks_to_run.end());
+    benchmarks_to_run.erase(it, benchmarks_to_run.end());
+    return retval;
+}
+
+std::vector<std::string> OperandSweep::run(Engine &engine,
+                                           const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                           const std::vector<BenchmarkRequest> &operand_sweeps,
+                                           const ProgramConfig &config)
+{
+    std::vector<std::string> retval;
+    std::stringstream ss;
+
+    // every point of every sweep has its own reports and summary
+    std::filesystem::path sweeps_root_path = config.report_root_path / PointsDirName;
+    std::vector<OperandSweep> sweeps;
+    for (const BenchmarkRequest &operand_sweep : operand_sweeps)
+    {
+        for (const std::vector<hebench::APIBridge::WorkloadParam> &w_params : operand_sweep.sets_w_params)
+        {
+            BenchmarkFactory::BenchmarkToken::Ptr bench_token =
+                engine.describeBenchmark(bench_config, operand_sweep.benchmark_index, w_params);
+            sweeps.emplace_back(bench_token->description.path, bench_token->description, operand_sweep.operand_sweep);
+            OperandSweep &sweep                   = sweeps.back();
+            std::filesystem::path sweep_root_path = sweeps_root_path / ("sweep_" + std::to_string(sweeps.size() - 1));
+
+            BenchmarkRequest point_request;
+            point_request.benchmark_index = operand_sweep.benchmark_index;
+            point_request.sets_w_params.push_back(w_params);
+            while (!sweep.isDone())
+            {
+                std::size_t point_i = sweep.getPoints().size();
+                IBenchmarkDescription::BenchmarkConfig point_bench_config = bench_config;
+                point_bench_config.operand_sample_sizes                   = sweep.getPointSampleSizes()[point_i];
+
+                ss = std::stringstream();
+                ss << "Operand sweep point " << point_i << ": " << sweep.getName() << std::endl
+                   << "Samples per operand:";
+                for (std::uint64_t sample_size : point_bench_config.operand_sample_sizes)
+                    ss << " " << sample_size;
+                std::cout << std::endl
+                          << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+                // sample sizes not supported by the backend fail the point
+                std::string bench_path;
+                try
+                {
+                    bench_path = engine.describeBenchmark(point_bench_config, point_request.benchmark_index, w_params)
+                                     ->description.path;
+                }
+                catch (std::exception &ex)
+                {
+                    sweep.addFailedPoint(ex.what());
+                    continue;
+                }
+
+                std::filesystem::path point_root_path = sweep_root_path / ("point_" + std::to_string(point_i));
+                std::vector<std::string> run_failed;
+                BenchmarkRunner::run(engine, point_bench_config, { point_request }, config, point_root_path, run_failed);
+                if (!run_failed.empty())
+                {
+                    sweep.addFailedPoint("Benchmark failed.");
+                    continue;
+                } // end if
+                LiveMetrics::setPhase("Summary");
+                BenchmarkRunner::generateSummary(engine, point_bench_config, { point_request }, point_root_path, false);
+
+                sweep.addPoint(Report::cpp::TimingReport::loadReportFromCSVFile(
+                    BenchmarkRunner::getReportFilename(point_root_path, bench_path)));
+            } // end while
+
+            // a sweep that cannot fit its cost model failed
+            if (!sweep.fit().b_valid)
+                retval.push_back(sweep.getName());
+        } // end for
+    } // end for
+
+    save2CSV(config.report_root_path / SummaryFile,
+             config.report_root_path / PointsFile,
+             sweeps);
+    if (config.b_show_run_overview)
+    {
+        ss = std::stringstream();
+        ss << "Operand sweep cost models:" << std::endl
+           << std::endl;
+        show(ss, sweeps);
+        std::cout << std::endl
+                  << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    } // end if
+    ss = std::stringstream();
+    ss << "Operand sweep saved to: " << std::endl
+       << config.report_root_path / SummaryFile;
+    std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+    return retval;
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -0,0 +1,217 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../include/hebench_overhead.h"
+
+namespace hebench {
+namespace TestHarness {
+
+namespace {
+
+struct PhaseTime
+{
+    std::string phase_name;
+    double wall_time_s;
+};
+
+struct BenchmarkTimes
+{
+    std::string bench_path; // empty for the run outside of benchmarks
+    std::vector<PhaseTime> phases; // in order of first appearance
+};
+
+struct OverheadState
+{
+    std::mutex mtx;
+    std::vector<BenchmarkTimes> benchmarks            = std::vector<BenchmarkTimes>(1); // first is the run outside of benchmarks
+    std::size_t current_bench                         = 0;
+    std::string current_phase                         = HarnessOverhead::OtherPhaseName;
+    std::chrono::steady_clock::time_point last_change = std::chrono::steady_clock::now();
+};
+
+OverheadState &getState()
+{
+    static OverheadState state;
+    return state;
+}
+
+void addPhaseTime(std::vector<PhaseTime> &phases, const std::string &phase_name, double wall_time_s)
+{
+    auto it = std::find_if(phases.begin(), phases.end(),
+                           [&phase_name](const PhaseTime &phase) { return phase.phase_name == phase_name; });
+    if (it == phases.end())
+        phases.push_back(PhaseTime{ phase_name, wall_time_s });
+    else
+        it->wall_time_s += wall_time_s;
+}
+
+/**
+ * @brief Credits the wall time elapsed since the last phase change to the
+ * current phase.
+ * @details State must be locked by caller.
+ */
+void creditElapsed(OverheadState &state)
+{
+    auto now = std::chrono::steady_clock::now();
+    addPhaseTime(state.benchmarks[state.current_bench].phases, state.current_phase,
+                 std::chrono::duration<double>(now - state.last_change).count());
+    state.last_change = now;
+}
+
+std::vector<PhaseTime> getTotals(const std::vector<BenchmarkTimes> &benchmarks)
+{
+    std::vector<PhaseTime> retval;
+    for (const BenchmarkTimes &bench_times : benchmarks)
+        for (const PhaseTime &phase : bench_times.phases)
+            addPhaseTime(retval, phase.phase_name, phase.wall_time_s);
+    return retval;
+}
+
+double getTotalTime(const std::vector<PhaseTime> &phases)
+{
+    double retval = 0.0;
+    for (const PhaseTime &phase : phases)
+        retval += phase.wall_time_s;
+    return retval;
+}
+
+} // namespace
+
+//-------------------------------
+// class HarnessOverhead::Scope
+//-------------------------------
+
+HarnessOverhead::Scope::Scope(const std::string &phase_name) :
+    m_previous_phase_name(HarnessOverhead::getPhase())
+{
+    HarnessOverhead::setPhase(phase_name);
+}
+
+HarnessOverhead::Scope::~Scope()
+{
+    HarnessOverhead::setPhase(m_previous_phase_name);
+}
+
+//-----------------------
+// class HarnessOverhead
+//-----------------------
+
+void HarnessOverhead::setPhase(const std::string &phase_name)
+{
+    OverheadState &state = getState();
+    std::lock_guard<std::mutex> lock(state.mtx);
+    if (phase_name != state.current_phase)
+    {
+        creditElapsed(state);
+        state.current_phase = phase_name;
+    } // end if
+}
+
+std::string HarnessOverhead::getPhase()
+{
+    OverheadState &state = getState();
+    std::lock_guard<std::mutex> lock(state.mtx);
+    return state.current_phase;
+}
+
+void HarnessOverhead::beginBenchmark(const std::string &bench_path)
+{
+    OverheadState &state = getState();
+    std::lock_guard<std::mutex> lock(state.mtx);
+    creditElapsed(state);
+    state.benchmarks.emplace_back();
+    state.benchmarks.back().bench_path = bench_path;
+    state.current_bench                = state.benchmarks.size() - 1;
+    state.current_phase                = OtherPhaseName;
+}
+
+void HarnessOverhead::endBenchmark()
+{
+    OverheadState &state = getState();
+    std::lock_guard<std::mutex> lock(state.mtx);
+    creditElapsed(state);
+    state.current_bench = 0;
+    state.current_phase = OtherPhaseName;
+}
+
+void HarnessOverhead::reset()
+{
+    OverheadState &state = getState();
+    std::lock_guard<std::mutex> lock(state.mtx);
+    state.benchmarks.assign(1, BenchmarkTimes());
+    state.current_bench = 0;
+    state.current_phase = OtherPhaseName;
+    state.last_change   = std::chrono::steady_clock::now();
+}
+
+void HarnessOverhead::save2CSV(const std::filesystem::path &filename)
+{
+    OverheadState &state = getState();
+    std::lock_guard<std::mutex> lock(state.mtx);
+    creditElapsed(state);
+
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + filename.string()));
+
+    fnum << std::setprecision(9)
+         << "Benchmark,Phase,Wall time (s),Share of benchmark (%)" << std::endl;
+    for (const BenchmarkTimes &bench_times : state.benchmarks)
+    {
+        double bench_time_s = getTotalTime(bench_times.phases);
+        for (const PhaseTime &phase : bench_times.phases)
+            fnum << "\"" << (bench_times.bench_path.empty() ? "(outside benchmarks)" : bench_times.bench_path) << "\","
+                 << phase.phase_name << "," << phase.wall_time_s << ","
+                 << (bench_time_s > 0.0 ? phase.wall_time_s * 100.0 / bench_time_s : 0.0) << std::endl;
+    } // end for
+
+    std::vector<PhaseTime> totals = getTotals(state.benchmarks);
+    double run_time_s             = getTotalTime(totals);
+    fnum << std::endl
+         << "Total,Phase,Wall time (s),Share of run (%)" << std::endl;
+    for (const PhaseTime &phase : totals)
+        fnum << "Total," << phase.phase_name << "," << phase.wall_time_s << ","
+             << (run_time_s > 0.0 ? phase.wall_time_s * 100.0 / run_time_s : 0.0) << std::endl;
+    fnum << "Total,Run," << run_time_s << ",100" << std::endl;
+}
+
+std::ostream &HarnessOverhead::show(std::ostream &os)
+{
+    constexpr int PhaseColSize = 30;
+
+    std::vector<PhaseTime> totals;
+    {
+        OverheadState &state = getState();
+        std::lock_guard<std::mutex> lock(state.mtx);
+        creditElapsed(state);
+        totals = getTotals(state.benchmarks);
+    }
+    std::stable_sort(totals.begin(), totals.end(),
+                     [](const PhaseTime &lhs, const PhaseTime &rhs) { return lhs.wall_time_s > rhs.wall_time_s; });
+    double run_time_s = getTotalTime(totals);
+
+    os << std::setfill(' ') << std::left << std::setw(PhaseColSize) << "Phase"
+       << std::right << std::setw(16) << "Wall time (s)" << std::setw(10) << "Share" << std::endl;
+    for (const PhaseTime &phase : totals)
+        os << std::left << std::setw(PhaseColSize) << phase.phase_name.substr(0, PhaseColSize - 1)
+           << std::right << std::fixed << std::setprecision(3) << std::setw(16) << phase.wall_time_s
+           << std::setprecision(1) << std::setw(9) << (run_time_s > 0.0 ? phase.wall_time_s * 100.0 / run_time_s : 0.0) << "%"
+           << std::defaultfloat << std::endl;
+    os << std::left << std::setw(PhaseColSize) << "Run"
+       << std::right << std::fixed << std::setprecision(3) << std::setw(16) << run_time_s
+       << std::defaultfloat << std::setprecision(6) << std::endl;
+    return os;
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -0,0 +1,307 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "include/hebench_distributed.h"
+#include "include/hebench_fingerprint.h"
+#include "include/hebench_memory_layout.h"
+#include "include/hebench_program_config.h"
+#include "include/hebench_version.h"
+
+namespace hebench {
+namespace TestHarness {
+
+void ProgramConfig::validateBackendLibPath(const std::filesystem::path &lib_path)
+{
+    if (!std::filesystem::is_regular_file(lib_path) || !std::filesystem::exists(lib_path))
+        throw std::runtime_error("Specified backend lib does not exists or is not accessible: " + lib_path.string());
+    if (std::filesystem::is_symlink(lib_path))
+        throw std::runtime_error("Backend library error: symbolic links are not allowed as input arguments: " + lib_path.string());
+    if ((std::filesystem::canonical(lib_path).string()).substr(0, 5) == std::string("/tmp/"))
+        throw std::runtime_error("Backend library error: Cannot use files in /tmp/ as arguments: " + lib_path.string());
+}
+
+std::string ProgramConfig::readToken(const std::filesystem::path &token_file)
+{
+    std::ifstream fnum(token_file);
+    if (!fnum.is_open())
+        throw std::runtime_error("Specified token file does not exists or is not accessible: " + token_file.string());
+    std::string retval;
+    std::getline(fnum, retval);
+    retval.erase(retval.find_last_not_of(" \t\r\n") + 1);
+    if (retval.empty())
+        throw std::runtime_error("Token file is empty: " + token_file.string());
+    return retval;
+}
+
+std::vector<std::string> ProgramConfig::splitList(const std::string &s)
+{
+    std::vector<std::string> retval;
+    for (std::size_t pos = 0; pos < s.size();)
+    {
+        std::size_t comma_pos = s.find(',', pos);
+        if (comma_pos == std::string::npos)
+            comma_pos = s.size();
+        if (comma_pos > pos)
+            retval.push_back(s.substr(pos, comma_pos - pos));
+        pos = comma_pos + 1;
+    } // end for
+    return retval;
+}
+
+void ProgramConfig::initializeConfig(const hebench::ArgsParser &parser)
+{
+    std::string s_tmp;
+
+    if (parser.hasArgument("--version"))
+    {
+        showVersion(std::cout);
+        throw hebench::ArgsParser::HelpShown("Version shown.");
+    } // end if
+
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--benchmark_config_file", DefaultConfigFile);
+    config_file = s_tmp;
+
+    b_dump_config = parser.hasArgument("--dump_config");
+    if (b_dump_config && config_file.empty())
+        throw std::runtime_error("Dump default benchmark configuration file requested, but no filename given with \"--benchmark_config_file\" parameter.");
+    if (b_dump_config)
+        run_modes.enable(RunModes::Mode::DumpConfig);
+
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--backend_lib_path");
+    backend_lib_path = s_tmp;
+
+    parser.getValue<decltype(b_validate_results)>(b_validate_results, "--enable_validation", true);
+    parser.getValue<decltype(b_plaintext_baseline)>(b_plaintext_baseline, "--plaintext_baseline", false);
+    parser.getValue<decltype(probabilistic_validation_rounds)>(probabilistic_validation_rounds, "--probabilistic_validation", 0);
+
+    parser.getValue<decltype(random_seed)>(random_seed, "--random_seed", std::chrono::system_clock::now().time_since_epoch().count());
+
+    parser.getValue<decltype(report_delay_ms)>(report_delay_ms, "--report_delay", DefaultReportDelay);
+
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--report_root_path", DefaultRootPath);
+    report_root_path = s_tmp;
+    if (!std::filesystem::is_directory(report_root_path) || !std::filesystem::exists(report_root_path))
+        throw std::runtime_error("Specified directory for report output does not exists or is not accessible: " + report_root_path.string());
+    validateBackendLibPath(backend_lib_path);
+
+    if (!b_dump_config && !config_file.empty())
+    {
+        // reading configuration file
+        if (!std::filesystem::is_regular_file(config_file) || !std::filesystem::exists(config_file))
+            throw std::runtime_error("Specified benchmark configuration file does not exists or is not accessible: " + config_file.string());
+        if (std::filesystem::is_symlink(config_file))
+            throw std::runtime_error("Config file path error: symbolic links are not allowed as input arguments: " + config_file.string());
+        if (std::filesystem::canonical(config_file).string().substr(0, 5) == std::string("/tmp/"))
+            throw std::runtime_error("Config file error: Cannot use files in /tmp/ as arguments: " + config_file.string());
+    }
+
+    parser.getValue<decltype(b_show_run_overview)>(b_show_run_overview, "--run_overview", true);
+    parser.getValue<decltype(b_cipher_mask_summary)>(b_cipher_mask_summary, "--cipher_mask_summary", false);
+    parser.getValue<decltype(b_logreg_degree_summary)>(b_logreg_degree_summary, "--logreg_degree_summary", false);
+
+    parser.getValue<decltype(metrics_file)>(metrics_file, "--metrics_file", "");
+    parser.getValue<decltype(metrics_socket)>(metrics_socket, "--metrics_socket", "");
+    parser.getValue<decltype(metrics_interval_ms)>(metrics_interval_ms, "--metrics_interval", DefaultMetricsInterval);
+    if (metrics_interval_ms <= 0)
+        throw std::runtime_error("Live metrics interval must be greater than 0 ms.");
+    parser.getValue<decltype(progress_interval_ms)>(progress_interval_ms, "--progress_interval", DefaultProgressInterval);
+
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--coordinator_workers", "");
+    coordinator_workers = splitList(s_tmp);
+    if (!coordinator_workers.empty())
+        run_modes.enable(RunModes::Mode::Coordinator);
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--job_history_file", "");
+    job_history_file = s_tmp.empty() ? report_root_path / DefaultJobHistoryFile : std::filesystem::path(s_tmp);
+    parser.getValue<decltype(worker_port)>(worker_port, "--worker_port", 0);
+    if (worker_port > 0)
+        run_modes.enable(RunModes::Mode::Worker);
+    parser.getValue<decltype(worker_bind_address)>(worker_bind_address, "--worker_bind_address",
+                                                   DistributedWorker::DefaultBindAddress);
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--distributed_token_file", "");
+    distributed_token.clear();
+    if (worker_port > 0 || !coordinator_workers.empty())
+    {
+        if (s_tmp.empty())
+            throw std::runtime_error("Coordinator and worker modes require a shared token file specified with \"--distributed_token_file\".");
+        distributed_token = readToken(s_tmp);
+    } // end if
+    parser.getValue<decltype(daemon_socket)>(daemon_socket, "--daemon_socket", "");
+    if (!daemon_socket.empty())
+        run_modes.enable(RunModes::Mode::Daemon);
+
+    parser.getValue<decltype(b_record_api_calls)>(b_record_api_calls, "--record_api_calls", false);
+
+    parser.getValue<decltype(cold_start_samples)>(cold_start_samples, "--cold_start_samples", 0);
+    parser.getValue<decltype(b_cold_start_drop_cache)>(b_cold_start_drop_cache, "--cold_start_drop_cache", false);
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--cold_start_child", "");
+    cold_start_child_file = s_tmp;
+    if (cold_start_samples > 0)
+        run_modes.enable(RunModes::Mode::ColdStart);
+    if (!cold_start_child_file.empty())
+    {
+        run_modes.enable(RunModes::Mode::ColdStartChild);
+        if (config_file.empty())
+            throw std::runtime_error("Cold-start child requires a benchmark configuration file.");
+    } // end if
+
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--compare_backend_lib_paths", "");
+    compare_backend_lib_paths.clear();
+    for (const std::string &lib_path : splitList(s_tmp))
+    {
+        validateBackendLibPath(lib_path);
+        compare_backend_lib_paths.push_back(lib_path);
+    } // end for
+    parser.getValue<decltype(ab_rounds)>(ab_rounds, "--ab_rounds", DefaultABRounds);
+    if (!compare_backend_lib_paths.empty())
+    {
+        run_modes.enable(RunModes::Mode::ABComparison);
+        if (ab_rounds <= 0)
+            throw std::runtime_error("A/B comparison requires at least 1 round.");
+    } // end if
+
+    parser.getValue<decltype(layout_samples)>(layout_samples, "--layout_samples", 0);
+    parser.getValue<decltype(layout_child)>(layout_child, "--layout_child", "");
+    if (layout_samples > 0)
+        run_modes.enable(RunModes::Mode::LayoutRandomization);
+    if (!layout_child.empty())
+    {
+        run_modes.enable(RunModes::Mode::LayoutChild);
+        if (config_file.empty())
+            throw std::runtime_error("Memory layout child requires a benchmark configuration file.");
+        MemoryLayout::fromChildArgument(layout_child); // validate
+    } // end if
+
+    parser.getValue<decltype(env_sweep_child)>(env_sweep_child, "--env_sweep_child", "");
+    if (!env_sweep_child.empty())
+    {
+        run_modes.enable(RunModes::Mode::EnvSweepChild);
+        if (config_file.empty())
+            throw std::runtime_error("Environment sweep child requires a benchmark configuration file.");
+    } // end if
+
+    parser.getValue<decltype(backend_lib_hash)>(backend_lib_hash, "--backend_lib_hash", "");
+    if (!backend_lib_hash.empty() && cold_start_child_file.empty() && layout_child.empty() && env_sweep_child.empty())
+        throw std::runtime_error("Backend library hash is only used by child processes.");
+}
+
+std::vector<std::string> ProgramConfig::getChildArgs(const std::filesystem::path &child_config_file,
+                                                     const std::filesystem::path &child_report_root_path,
+                                                     std::uint64_t child_random_seed) const
+{
+    // children reuse the hash of the backend library to keep file reads out of their timed phases
+    return { "--backend_lib_path", backend_lib_path.string(),
+             "--benchmark_config_file", child_config_file.string(),
+             "--report_root_path", child_report_root_path.string(),
+             "--random_seed", std::to_string(child_random_seed),
+             "--enable_validation", b_validate_results ? "1" : "0",
+             "--report_delay", "0",
+             "--run_overview", "0",
+             "--progress_interval", "0",
+             "--backend_lib_hash", fingerprint.get(Report::cpp::Fingerprint::GroupBackend,
+                                                   FingerprintCollector::LibraryHashKey) };
+}
+
+std::ostream &ProgramConfig::showBenchmarkDefaults(std::ostream &os, const IBenchmarkDescription::BenchmarkConfig &bench_config)
+{
+    os << "Benchmark defaults:" << std::endl
+       << "    Random seed: " << bench_config.random_seed << std::endl
+       << "    Default minimum test time: " << bench_config.default_min_test_time_ms << " ms" << std::endl
+       << "    Default sample size: " << bench_config.default_sample_size << std::endl
+       << "    Probabilistic validation rounds: " << bench_config.probabilistic_validation_rounds << std::endl;
+    return os;
+}
+
+std::ostream &ProgramConfig::showConfig(std::ostream &os) const
+{
+    os << "Global Configuration:" << std::endl;
+    if (b_dump_config)
+    {
+        os << "    Dumping configuration file!" << std::endl;
+    } // end of
+    else
+    {
+        os
+            //<< "    Random seed: " << random_seed << std::endl
+            << "    Validate results: " << (b_validate_results ? "Yes" : "No") << std::endl
+            << "    Plaintext baseline: " << (b_plaintext_baseline ? "Yes" : "No") << std::endl
+            << "    Report delay (ms): " << report_delay_ms << std::endl
+            << "    Report Root Path: " << report_root_path << std::endl
+            << "    Show run overview: " << (b_show_run_overview ? "Yes" : "No") << std::endl
+            << "    Cipher mask summary: " << (b_cipher_mask_summary ? "Yes" : "No") << std::endl
+            << "    LogReg degree summary: " << (b_logreg_degree_summary ? "Yes" : "No") << std::endl
+            << "    Live metrics file: " << (metrics_file.empty() ? "(none)" : metrics_file) << std::endl
+            << "    Live metrics socket: " << (metrics_socket.empty() ? "(none)" : metrics_socket) << std::endl
+            << "    Progress interval (ms): " << progress_interval_ms << std::endl
+            << "    Record API calls: " << (b_record_api_calls ? "Yes" : "No") << std::endl
+            //           << "    Benchmark defaults:" << std::endl
+            //           << "        Default minimum test time: " << min_test_time_ms << " ms" << std::endl
+            //           << "        Default sample size: " << default_sample_size << std::endl
+            ;
+        if (worker_port > 0)
+            os << "    Distributed: worker on " << worker_bind_address << ":" << worker_port << std::endl;
+        else if (!daemon_socket.empty())
+            os << "    Daemon: listening on " << daemon_socket << std::endl;
+        else if (!coordinator_workers.empty())
+        {
+            os << "    Distributed: coordinator" << std::endl
+               << "        Job history file: " << job_history_file << std::endl
+               << "        Workers:" << std::endl;
+            for (const std::string &worker : coordinator_workers)
+                os << "            " << worker << std::endl;
+        } // end else if
+        if (cold_start_samples > 0)
+            os << "    Cold start: " << cold_start_samples << " samples per benchmark" << std::endl
+               << "        Drop library page cache: " << (b_cold_start_drop_cache ? "Yes" : "No") << std::endl;
+        else if (!cold_start_child_file.empty())
+            os << "    Cold start: child sample" << std::endl;
+        if (!compare_backend_lib_paths.empty())
+        {
+            os << "    A/B comparison: " << ab_rounds << " rounds" << std::endl
+               << "        Compared backend libraries:" << std::endl;
+            for (const std::filesystem::path &lib_path : compare_backend_lib_paths)
+                os << "            " << lib_path << std::endl;
+        } // end if
+        if (layout_samples > 0)
+            os << "    Memory layout randomization: " << layout_samples << " layouts per benchmark" << std::endl;
+        else if (!layout_child.empty())
+            os << "    Memory layout randomization: child with layout " << layout_child << std::endl;
+        if (!env_sweep_child.empty())
+            os << "    Environment sweep: child with knobs " << env_sweep_child << std::endl;
+    } // end if
+    os << "    Run configuration file: ";
+    if (config_file.empty())
+        os << "(none)" << std::endl;
+    else
+        os << config_file << std::endl;
+    os << "    Backend library: " << backend_lib_path << std::endl;
+    return os;
+}
+
+std::ostream &ProgramConfig::showVersion(std::ostream &os)
+{
+    os << HEBENCH_TEST_HARNESS_APP_NAME << " v"
+       << HEBENCH_TEST_HARNESS_VERSION_MAJOR << "."
+       << HEBENCH_TEST_HARNESS_VERSION_MINOR << "."
+       << HEBENCH_TEST_HARNESS_VERSION_REVISION << "-"
+       << HEBENCH_TEST_HARNESS_VERSION_BUILD << std::endl
+       << std::endl
+       << "API Bridge version:" << std::endl
+       << "  Required: " << HEBENCH_TEST_HARNESS_API_REQUIRED_VERSION_MAJOR << "."
+       << HEBENCH_TEST_HARNESS_API_REQUIRED_VERSION_MINOR << "."
+       << HEBENCH_TEST_HARNESS_API_MIN_REQUIRED_VERSION_REVISION << std::endl
+       << "  Current:  "
+       << HEBENCH_API_VERSION_MAJOR << "."
+       << HEBENCH_API_VERSION_MINOR << "."
+       << HEBENCH_API_VERSION_REVISION << "-"
+       << HEBENCH_API_VERSION_BUILD << std::endl;
+    return os;
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -0,0 +1,217 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <unistd.h>
+
+#include "../include/hebench_progress.h"
+#include "../include/hebench_types_harness.h"
+
+namespace hebench {
+namespace TestHarness {
+
+namespace {
+
+std::string formatDuration(double seconds)
+{
+    std::stringstream ss;
+    if (seconds < 60.0)
+        ss << std::fixed << std::setprecision(1) << seconds << "s";
+    else
+    {
+        std::uint64_t total_s = static_cast<std::uint64_t>(seconds);
+        std::uint64_t h       = total_s / 3600;
+        std::uint64_t m       = (total_s / 60) % 60;
+        std::uint64_t s       = total_s % 60;
+        if (h > 0)
+            ss << h << "h " << std::setw(2) << std::setfill('0') << m << "m ";
+        else
+            ss << m << "m ";
+        ss << std::setw(2) << std::setfill('0') << s << "s";
+    } // end else
+    return ss.str();
+}
+
+} // namespace
+
+class Progress::Renderer
+{
+public:
+    Renderer(std::size_t interval_ms);
+    ~Renderer();
+
+    void beginPhase(const std::string &phase, std::uint64_t total);
+    void endPhase();
+
+    std::atomic<std::uint64_t> done;
+
+private:
+    bool m_b_tty;
+    std::chrono::milliseconds m_interval;
+    std::mutex m_mtx; // protects phase state and console output from renderer
+    std::condition_variable m_cv;
+    bool m_b_stop;
+    bool m_b_active;
+    std::string m_phase;
+    std::uint64_t m_total;
+    std::chrono::steady_clock::time_point m_phase_start;
+    std::size_t m_last_line_size;
+    std::thread m_thread;
+
+    bool isPeriodic() const { return m_b_tty || m_interval.count() > 0; }
+    void rendererLoop();
+    // must be called with m_mtx locked
+    void draw(bool b_final);
+};
+
+std::shared_ptr<Progress::Renderer> Progress::m_p_renderer;
+
+Progress::Renderer::Renderer(std::size_t interval_ms) :
+    done(0),
+    m_b_tty(::isatty(STDOUT_FILENO) != 0),
+    m_interval(m_b_tty ? TerminalRefreshMs : interval_ms),
+    m_b_stop(false),
+    m_b_active(false),
+    m_total(0),
+    m_last_line_size(0)
+{
+    m_thread = std::thread(&Renderer::rendererLoop, this);
+}
+
+Progress::Renderer::~Renderer()
+{
+    endPhase();
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_b_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void Progress::Renderer::beginPhase(const std::string &phase, std::uint64_t total)
+{
+    endPhase();
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        done.store(0, std::memory_order_relaxed);
+        m_phase          = phase;
+        m_total          = total;
+        m_phase_start    = std::chrono::steady_clock::now();
+        m_last_line_size = 0;
+        m_b_active       = true;
+    }
+    m_cv.notify_all();
+}
+
+void Progress::Renderer::endPhase()
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (m_b_active)
+    {
+        draw(true);
+        m_b_active = false;
+    } // end if
+}
+
+void Progress::Renderer::rendererLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mtx);
+    while (!m_b_stop)
+    {
+        if (m_b_active && isPeriodic())
+        {
+            // wake up early only to stop; phase changes are picked up on next tick
+            if (!m_cv.wait_for(lock, m_interval, [this]() { return m_b_stop; })
+                && m_b_active)
+                draw(false);
+        } // end if
+        else
+            m_cv.wait(lock, [this]() { return m_b_stop || (m_b_active && isPeriodic()); });
+    } // end while
+}
+
+void Progress::Renderer::draw(bool b_final)
+{
+    std::uint64_t current = done.load(std::memory_order_relaxed);
+    double elapsed_s      = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_phase_start).count();
+    double rate           = elapsed_s > 0.0 ? current / elapsed_s : 0.0;
+
+    std::stringstream ss;
+    ss << (b_final ? IOS_MSG_DONE : IOS_MSG_INFO) << m_phase << ": " << current;
+    if (m_total > 0)
+        ss << " / " << m_total
+           << " (" << std::fixed << std::setprecision(1) << (100.0 * current / m_total) << "%)";
+    ss << " | " << std::fixed << std::setprecision(1) << rate << " /s";
+    if (b_final)
+        ss << " | " << formatDuration(elapsed_s);
+    else if (m_total > 0 && rate > 0.0 && current < m_total)
+        ss << " | ETA " << formatDuration((m_total - current) / rate);
+    std::string s_line = ss.str();
+
+    if (m_b_tty)
+    {
+        std::size_t line_size = s_line.size();
+        // pad with spaces to erase leftovers from a longer previous line
+        if (line_size < m_last_line_size)
+            s_line.append(m_last_line_size - line_size, ' ');
+        m_last_line_size = line_size;
+        std::cout << '\r' << s_line;
+        if (b_final)
+            std::cout << '\n';
+        std::cout << std::flush;
+    } // end if
+    else
+        std::cout << s_line << std::endl;
+}
+
+void Progress::initialize(std::size_t interval_ms)
+{
+    terminate();
+    std::atomic_store(&m_p_renderer, std::make_shared<Renderer>(interval_ms));
+}
+
+void Progress::terminate()
+{
+    // renderer ends active phase and stops when last reference goes out of scope
+    std::atomic_exchange(&m_p_renderer, std::shared_ptr<Renderer>());
+}
+
+bool Progress::isInitialized()
+{
+    return static_cast<bool>(std::atomic_load(&m_p_renderer));
+}
+
+void Progress::beginPhase(const std::string &phase, std::uint64_t total)
+{
+    std::shared_ptr<Renderer> p_renderer = std::atomic_load(&m_p_renderer);
+    if (p_renderer)
+        p_renderer->beginPhase(phase, total);
+}
+
+void Progress::advance(std::uint64_t count)
+{
+    std::shared_ptr<Renderer> p_renderer = std::atomic_load(&m_p_renderer);
+    if (p_renderer)
+        p_renderer->done.fetch_add(count, std::memory_order_relaxed);
+}
+
+void Progress::endPhase()
+{
+    std::shared_ptr<Renderer> p_renderer = std::atomic_load(&m_p_renderer);
+    if (p_renderer)
+        p_renderer->endPhase();
+}
+
+} // namespace TestHarness
+} // namespace hebench
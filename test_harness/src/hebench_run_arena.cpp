@@ -0,0 +1,50 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../include/hebench_run_arena.h"
+
+namespace hebench {
+namespace TestHarness {
+
+//----------------
+// class RunArena
+//----------------
+
+RunArena::Ptr RunArena::create(std::size_t initial_size)
+{
+    return RunArena::Ptr(new RunArena(initial_size));
+}
+
+RunArena::RunArena(std::size_t initial_size) :
+    m_monotonic(initial_size > 0 ? initial_size : DefaultInitialSize, &m_upstream),
+    m_pool(&m_monotonic)
+{
+}
+
+RunArena::~RunArena()
+{
+    // pool returns its chunks to the monotonic buffer, which releases
+    // everything to the system at once
+}
+
+void *RunArena::CountingResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    void *retval = std::pmr::get_default_resource()->allocate(bytes, alignment);
+    bytes_reserved += bytes;
+    return retval;
+}
+
+void RunArena::CountingResource::do_deallocate(void *p, std::size_t bytes, std::size_t alignment)
+{
+    std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+    bytes_reserved -= bytes;
+}
+
+bool RunArena::CountingResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -0,0 +1,122 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cctype>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include "../include/hebench_run_modes.h"
+
+namespace hebench {
+namespace TestHarness {
+
+namespace {
+
+constexpr std::uint32_t modeBit(RunModes::Mode mode)
+{
+    return std::uint32_t(1) << static_cast<std::uint32_t>(mode);
+}
+
+struct ModeEntry
+{
+    RunModes::Mode mode;
+    const char *name; // lower case, as in the middle of a sentence
+    std::uint32_t compatible; // bits of the modes this one can be combined with
+};
+
+// every mode, in declaration order
+constexpr ModeEntry ModeTable[] = {
+    { RunModes::Mode::DumpConfig, "dumping configuration (\"--dump_config\")", 0 },
+    { RunModes::Mode::Worker, "worker mode (\"--worker_port\")", 0 },
+    { RunModes::Mode::Coordinator, "coordinator mode (\"--coordinator_workers\")", 0 },
+    { RunModes::Mode::Daemon, "daemon mode (\"--daemon_socket\")", 0 },
+    { RunModes::Mode::ColdStart, "cold-start mode (\"--cold_start_samples\")", 0 },
+    { RunModes::Mode::ColdStartChild, "cold-start child (\"--cold_start_child\")", 0 },
+    { RunModes::Mode::ABComparison, "A/B comparison (\"--compare_backend_lib_paths\")", 0 },
+    { RunModes::Mode::LayoutRandomization, "memory layout randomization (\"--layout_samples\")", 0 },
+    { RunModes::Mode::LayoutChild, "memory layout child (\"--layout_child\")", 0 },
+    { RunModes::Mode::EnvSweep, "environment sweep", 0 },
+    { RunModes::Mode::EnvSweepChild, "environment sweep child (\"--env_sweep_child\")", 0 },
+    { RunModes::Mode::SLOSearch, "SLO capacity search", modeBit(RunModes::Mode::OperandSweep) },
+    { RunModes::Mode::OperandSweep, "operand sweep", modeBit(RunModes::Mode::SLOSearch) }
+};
+
+constexpr std::size_t ModeCount = static_cast<std::size_t>(RunModes::Mode::Count);
+
+constexpr bool isModeTableValid()
+{
+    if (sizeof(ModeTable) / sizeof(ModeTable[0]) != ModeCount)
+        return false;
+    for (std::size_t i = 0; i < ModeCount; ++i)
+    {
+        std::uint32_t bit_i = modeBit(ModeTable[i].mode);
+        if (static_cast<std::size_t>(ModeTable[i].mode) != i
+            || (ModeTable[i].compatible & bit_i) != 0
+            || (ModeTable[i].compatible >> ModeCount) != 0)
+            return false;
+        for (std::size_t j = 0; j < ModeCount; ++j)
+            if (((ModeTable[i].compatible & modeBit(ModeTable[j].mode)) != 0)
+                != ((ModeTable[j].compatible & bit_i) != 0))
+                return false;
+    } // end for
+    return true;
+}
+
+static_assert(ModeCount <= 32, "Run modes do not fit in a 32 bits mask.");
+static_assert(isModeTableValid(), "Run mode table must list every mode in order with symmetric compatibility.");
+
+} // namespace
+
+//----------------
+// class RunModes
+//----------------
+
+const char *RunModes::getName(Mode mode)
+{
+    if (static_cast<std::size_t>(mode) >= ModeCount)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid run mode."));
+    return ModeTable[static_cast<std::size_t>(mode)].name;
+}
+
+bool RunModes::isEnabled(Mode mode) const
+{
+    return (m_enabled & modeBit(mode)) != 0;
+}
+
+void RunModes::enable(Mode mode)
+{
+    if (static_cast<std::size_t>(mode) >= ModeCount)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid run mode."));
+    const ModeEntry &entry = ModeTable[static_cast<std::size_t>(mode)];
+    for (const ModeEntry &other : ModeTable)
+    {
+        if (other.mode != mode && isEnabled(other.mode) && (entry.compatible & modeBit(other.mode)) == 0)
+        {
+            std::string s_name(entry.name);
+            s_name.front() = static_cast<char>(std::toupper(static_cast<unsigned char>(s_name.front())));
+            throw std::runtime_error(s_name + " cannot be combined with " + other.name + ".");
+        } // end if
+    } // end for
+    m_enabled |= modeBit(mode);
+}
+
+void RunModes::dispatch(const std::vector<std::pair<Mode, Handler>> &handlers,
+                        const Handler &default_handler) const
+{
+    const Handler *p_handler = &default_handler;
+    for (const auto &mode_handler : handlers)
+    {
+        if (isEnabled(mode_handler.first))
+        {
+            if (p_handler != &default_handler)
+                throw std::logic_error(IL_LOG_MSG_CLASS("More than one run mode to dispatch is enabled."));
+            p_handler = &mode_handler.second;
+        } // end if
+    } // end for
+    if (*p_handler)
+        (*p_handler)();
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -0,0 +1,436 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "include/hebench_benchmark_runner.h"
+#include "include/hebench_live_metrics.h"
+#include "include/hebench_slo_search.h"
+
+namespace hebench {
+namespace TestHarness {
+
+namespace {
+
+std::string toCSVValue(double x)
+{
+    std::stringstream ss;
+    if (std::isfinite(x))
+        ss << std::setprecision(9) << x;
+    else
+        ss << "inf";
+    return ss.str();
+}
+
+} // namespace
+
+SLOCapacitySearch::SLOCapacitySearch(const std::string &name,
+                                     const std::vector<hebench::APIBridge::WorkloadParam> &w_params,
+                                     const SLOSearchRequest &request) :
+    m_name(name),
+    m_w_params(w_params),
+    m_request(request),
+    m_next_step_count(0),
+    m_feasible_step_count(0),
+    m_infeasible_step_count(0),
+    m_b_feasible_found(false),
+    m_b_infeasible_found(false),
+    m_b_done(false)
+{
+    if (m_request.param_index >= m_w_params.size())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Searched parameter index is out of range."));
+    if (m_w_params[m_request.param_index].data_type != hebench::APIBridge::WorkloadParamType::UInt64
+        && m_w_params[m_request.param_index].data_type != hebench::APIBridge::WorkloadParamType::Int64)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Searched parameter must be an integer parameter."));
+    if (m_request.step <= 0)
+        m_request.step = 1;
+}
+
+std::uint64_t SLOCapacitySearch::computeMinSamples(double quantile, double confidence)
+{
+    // the largest sample bounds the quantile with confidence 1 - quantile^n
+    std::uint64_t retval = static_cast<std::uint64_t>(std::ceil(std::log(1.0 - confidence) / std::log(quantile)));
+    if (retval <= 0)
+        retval = 1;
+    while (1.0 - std::pow(quantile, static_cast<double>(retval)) < confidence)
+        ++retval;
+    while (retval > 1 && 1.0 - std::pow(quantile, static_cast<double>(retval - 1)) >= confidence)
+        --retval;
+    return retval;
+}
+
+SLOCapacitySearch::LatencyStats SLOCapacitySearch::computeLatencyStats(std::vector<double> latencies_ms,
+                                                                       double quantile, double confidence)
+{
+    LatencyStats retval;
+    retval.samples        = latencies_ms.size();
+    retval.quantile_ms    = std::numeric_limits<double>::infinity();
+    retval.upper_bound_ms = std::numeric_limits<double>::infinity();
+    if (latencies_ms.empty())
+        return retval;
+
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    double n = static_cast<double>(latencies_ms.size());
+
+    // nearest rank estimate
+    std::size_t rank = static_cast<std::size_t>(std::ceil(quantile * n));
+    rank             = std::clamp<std::size_t>(rank, 1, latencies_ms.size());
+    retval.quantile_ms = latencies_ms[rank - 1];
+
+    // the j-th smallest sample (0-based) is an upper bound of the quantile
+    // with confidence P(Binomial(n, quantile) <= j)
+    double log_q   = std::log(quantile);
+    double log_1_q = std::log(1.0 - quantile);
+    double cdf     = 0.0;
+    for (std::size_t j = 0; j < latencies_ms.size(); ++j)
+    {
+        double k = static_cast<double>(j);
+        cdf += std::exp(std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0)
+                        + k * log_q + (n - k) * log_1_q);
+        if (cdf >= confidence)
+        {
+            retval.upper_bound_ms = latencies_ms[j];
+            break;
+        } // end if
+    } // end for
+
+    return retval;
+}
+
+std::vector<double> SLOCapacitySearch::getLatencies(const hebench::TestHarness::Report::cpp::TimingReport &report)
+{
+    std::vector<double> retval;
+    std::uint32_t main_event_type = report.getMainEventType();
+    const hebench::TestHarness::Report::TimingReportEventC *p_events = report.getEventsData();
+    for (std::uint64_t event_i = 0; event_i < report.getEventCount(); ++event_i)
+    {
+        const hebench::TestHarness::Report::TimingReportEventC &event = p_events[event_i];
+        if (event.event_type_id == main_event_type && event.iterations > 0 && event.time_interval_ratio_den != 0)
+            retval.push_back((event.wall_time_end - event.wall_time_start) * 1000.0
+                             * event.time_interval_ratio_num / event.time_interval_ratio_den
+                             / event.iterations);
+    } // end for
+    return retval;
+}
+
+bool SLOCapacitySearch::isLatencyBenchmark(const IBenchmarkDescription::Description &description)
+{
+    // category is stated in the benchmark header
+    std::istringstream is(description.header);
+    std::string line;
+    while (std::getline(is, line))
+        if (line.rfind(", Category, Latency", 0) == 0)
+            return true;
+    return false;
+}
+
+std::uint64_t SLOCapacitySearch::getSamplesPerProbe() const
+{
+    return std::max(m_request.min_samples, computeMinSamples(m_request.quantile, m_request.confidence));
+}
+
+std::string SLOCapacitySearch::getValue(std::uint64_t step_count) const
+{
+    const hebench::APIBridge::WorkloadParam &w_param = m_w_params[m_request.param_index];
+    return w_param.data_type == hebench::APIBridge::WorkloadParamType::UInt64 ?
+               std::to_string(w_param.u_param + step_count * m_request.step) :
+               std::to_string(w_param.i_param + static_cast<std::int64_t>(step_count * m_request.step));
+}
+
+std::vector<hebench::APIBridge::WorkloadParam> SLOCapacitySearch::getNextParams() const
+{
+    if (m_b_done)
+        throw std::logic_error(IL_LOG_MSG_CLASS("Search is already done."));
+
+    std::vector<hebench::APIBridge::WorkloadParam> retval = m_w_params;
+    hebench::APIBridge::WorkloadParam &w_param            = retval[m_request.param_index];
+    if (w_param.data_type == hebench::APIBridge::WorkloadParamType::UInt64)
+        w_param.u_param += m_next_step_count * m_request.step;
+    else
+        w_param.i_param += static_cast<std::int64_t>(m_next_step_count * m_request.step);
+    return retval;
+}
+
+void SLOCapacitySearch::addProbe(const LatencyStats &stats)
+{
+    if (m_b_done)
+        throw std::logic_error(IL_LOG_MSG_CLASS("Search is already done."));
+
+    Probe probe;
+    probe.stats      = stats;
+    probe.b_feasible = stats.upper_bound_ms <= m_request.max_latency_ms;
+    completeProbe(probe);
+}
+
+void SLOCapacitySearch::addFailedProbe(const std::string &message)
+{
+    if (m_b_done)
+        throw std::logic_error(IL_LOG_MSG_CLASS("Search is already done."));
+
+    Probe probe;
+    probe.stats      = computeLatencyStats(std::vector<double>(), m_request.quantile, m_request.confidence);
+    probe.b_feasible = false;
+    probe.message    = message;
+    completeProbe(probe);
+}
+
+void SLOCapacitySearch::completeProbe(Probe &probe)
+{
+    probe.step_count = m_next_step_count;
+    probe.value      = getValue(m_next_step_count);
+    if (probe.b_feasible)
+    {
+        m_feasible_step_count = m_next_step_count;
+        m_b_feasible_found    = true;
+    } // end if
+    else
+    {
+        m_infeasible_step_count = m_next_step_count;
+        m_b_infeasible_found    = true;
+    } // end else
+    m_probes.push_back(probe);
+
+    if (!m_b_feasible_found)
+        m_b_done = true; // initial value is infeasible
+    else if (!m_b_infeasible_found)
+    {
+        // exponential phase: double the increments until infeasible or at the largest value
+        if (m_feasible_step_count >= m_request.max_steps)
+            m_b_done = true;
+        else if (m_feasible_step_count == 0)
+            m_next_step_count = 1;
+        else
+            m_next_step_count = m_feasible_step_count > m_request.max_steps / 2 ?
+                                    m_request.max_steps :
+                                    m_feasible_step_count * 2;
+    } // end else if
+    else
+    {
+        // binary phase
+        if (m_infeasible_step_count - m_feasible_step_count <= 1)
+            m_b_done = true;
+        else
+            m_next_step_count = m_feasible_step_count + (m_infeasible_step_count - m_feasible_step_count) / 2;
+    } // end else
+}
+
+const SLOCapacitySearch::Probe *SLOCapacitySearch::getMaxFeasible() const
+{
+    if (!m_b_feasible_found)
+        return nullptr;
+    auto it = std::find_if(m_probes.begin(), m_probes.end(),
+                           [this](const Probe &probe) { return probe.step_count == m_feasible_step_count; });
+    return it == m_probes.end() ? nullptr : &(*it);
+}
+
+const SLOCapacitySearch::Probe *SLOCapacitySearch::getMinInfeasible() const
+{
+    if (!m_b_infeasible_found)
+        return nullptr;
+    auto it = std::find_if(m_probes.begin(), m_probes.end(),
+                           [this](const Probe &probe) { return probe.step_count == m_infeasible_step_count; });
+    return it == m_probes.end() ? nullptr : &(*it);
+}
+
+void SLOCapacitySearch::save2CSV(const std::filesystem::path &summary_filename,
+                                 const std::filesystem::path &probes_filename,
+                                 const std::vector<SLOCapacitySearch> &searches)
+{
+    std::ofstream fnum(summary_filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + summary_filename.string()));
+    fnum << "Search,Parameter,Quantile,Max latency (ms),Confidence,Samples per probe,Probes,"
+         << "Max feasible value,Quantile at max feasible (ms),Upper bound at max feasible (ms),Min infeasible value"
+         << std::endl;
+    for (const SLOCapacitySearch &search : searches)
+    {
+        const Probe *p_max_feasible   = search.getMaxFeasible();
+        const Probe *p_min_infeasible = search.getMinInfeasible();
+        fnum << "\"" << search.m_name << "\"," << search.m_w_params[search.m_request.param_index].name << ","
+             << toCSVValue(search.m_request.quantile) << "," << toCSVValue(search.m_request.max_latency_ms) << ","
+             << toCSVValue(search.m_request.confidence) << "," << search.getSamplesPerProbe() << ","
+             << search.m_probes.size() << ",";
+        if (p_max_feasible)
+            fnum << p_max_feasible->value << "," << toCSVValue(p_max_feasible->stats.quantile_ms) << ","
+                 << toCSVValue(p_max_feasible->stats.upper_bound_ms);
+        else
+            fnum << "None,,";
+        fnum << "," << (p_min_infeasible ? p_min_infeasible->value : std::string("None")) << std::endl;
+    } // end for
+
+    fnum.close();
+    fnum.open(probes_filename, std::ios_base::out | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Could not open file for writing: " + probes_filename.string()));
+    fnum << "Search,Probe,Value,Samples,Quantile (ms),Upper bound (ms),Feasible,Message" << std::endl;
+    for (const SLOCapacitySearch &search : searches)
+    {
+        for (std::size_t probe_i = 0; probe_i < search.m_probes.size(); ++probe_i)
+        {
+            const Probe &probe  = search.m_probes[probe_i];
+            std::string message = probe.message;
+            std::replace(message.begin(), message.end(), '\n', ' ');
+            std::replace(message.begin(), message.end(), '"', '\'');
+            fnum << "\"" << search.m_name << "\"," << probe_i << "," << probe.value << ","
+                 << probe.stats.samples << "," << toCSVValue(probe.stats.quantile_ms) << ","
+                 << toCSVValue(probe.stats.upper_bound_ms) << "," << (probe.b_feasible ? "Yes" : "No") << ",\""
+                 << message << "\"" << std::endl;
+        } // end for
+    } // end for
+}
+
+std::ostream &SLOCapacitySearch::show(std::ostream &os, const std::vector<SLOCapacitySearch> &searches)
+{
+    for (const SLOCapacitySearch &search : searches)
+    {
+        const Probe *p_max_feasible   = search.getMaxFeasible();
+        const Probe *p_min_infeasible = search.getMinInfeasible();
+        std::string param_name        = search.m_w_params[search.m_request.param_index].name;
+        os << search.m_name << std::endl
+           << "  SLO: quantile " << search.m_request.quantile << " <= " << search.m_request.max_latency_ms
+           << " ms with confidence " << search.m_request.confidence
+           << " (" << search.getSamplesPerProbe() << " samples per probe, "
+           << search.m_probes.size() << " probes)" << std::endl;
+        if (p_max_feasible)
+            os << "  Max feasible " << param_name << ": " << p_max_feasible->value
+               << " (quantile " << p_max_feasible->stats.quantile_ms << " ms, upper bound "
+               << p_max_feasible->stats.upper_bound_ms << " ms)" << std::endl;
+        else
+            os << "  Max feasible " << param_name << ": None" << std::endl;
+        if (p_min_infeasible)
+            os << "  Min infeasible " << param_name << ": " << p_min_infeasible->value
+               << (p_min_infeasible->message.empty() ? std::string() : " (failed to run)") << std::endl;
+        else if (p_max_feasible)
+            os << "  Largest value requested is feasible." << std::endl;
+    } // end for
+    return os;
+}
+
+std::vector<BenchmarkRequest> SLOCapacitySearch::extract(std::vector<BenchmarkRequest> &benchmarks_to_run)
+{
+    std::vector<BenchmarkRequest> retval;
+    auto it = std::stable_partition(benchmarks_to_run.begin(), benchmarks_to_run.end(),
+                                    [](const BenchmarkRequest &bench_request) {
+                                        return bench_request.slo_search.quantile <= 0.0;
+                                    });
+    retval.assign(it, benchmarks_to_run.end());
+    benchmarks_to_run.erase(it, benchmarks_to_run.end());
+    return retval;
+}
+
+std::vector<std::string> SLOCapacitySearch::run(Engine &engine,
+                                                const IBenchmarkDescription::BenchmarkConfig &bench_config,
+                                                const std::vector<BenchmarkRequest> &slo_searches,
+                                                const ProgramConfig &config)
+{
+    std::vector<std::string> retval;
+    std::stringstream ss;
+
+    // every probe has its own report under the probes root
+    std::filesystem::path probes_root_path = config.report_root_path / ProbesDirName;
+    std::vector<SLOCapacitySearch> searches;
+    std::vector<BenchmarkRequest> probes_ran;
+    IBenchmarkDescription::BenchmarkConfig probe_bench_config = bench_config;
+    for (const BenchmarkRequest &slo_search : slo_searches)
+    {
+        for (const std::vector<hebench::APIBridge::WorkloadParam> &w_params : slo_search.sets_w_params)
+        {
+            BenchmarkFactory::BenchmarkToken::Ptr bench_token =
+                engine.describeBenchmark(bench_config, slo_search.benchmark_index, w_params);
+            searches.emplace_back(bench_token->description.path, w_params, slo_search.slo_search);
+            SLOCapacitySearch &search = searches.back();
+            if (!isLatencyBenchmark(bench_token->description))
+                throw std::runtime_error("SLO capacity search requires a Latency benchmark: " + search.getName());
+
+            // enough operations per probe to bound the quantile
+            probe_bench_config.min_latency_iterations = search.getSamplesPerProbe();
+            while (!search.isDone())
+            {
+                BenchmarkRequest probe_request;
+                probe_request.benchmark_index = slo_search.benchmark_index;
+                probe_request.sets_w_params.push_back(search.getNextParams());
+
+                ss = std::stringstream();
+                ss << "SLO search probe " << search.getProbes().size() << ": " << search.getName() << std::endl
+                   << w_params[slo_search.slo_search.param_index].name << " = ";
+                const hebench::APIBridge::WorkloadParam &w_param = probe_request.sets_w_params.front()[slo_search.slo_search.param_index];
+                if (w_param.data_type == hebench::APIBridge::WorkloadParamType::UInt64)
+                    ss << w_param.u_param;
+                else
+                    ss << w_param.i_param;
+                std::cout << std::endl
+                          << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+                // values out of the range supported by the backend are infeasible
+                std::string bench_path;
+                try
+                {
+                    bench_path = engine.describeBenchmark(probe_bench_config, probe_request.benchmark_index,
+                                                          probe_request.sets_w_params.front())
+                                     ->description.path;
+                }
+                catch (std::exception &ex)
+                {
+                    search.addFailedProbe(ex.what());
+                    continue;
+                }
+
+                std::vector<std::string> run_failed;
+                BenchmarkRunner::run(engine, probe_bench_config, { probe_request }, config, probes_root_path, run_failed);
+                probes_ran.push_back(probe_request);
+                if (!run_failed.empty())
+                {
+                    search.addFailedProbe("Benchmark failed.");
+                    continue;
+                } // end if
+
+                Report::cpp::TimingReport report =
+                    Report::cpp::TimingReport::loadReportFromCSVFile(
+                        BenchmarkRunner::getReportFilename(probes_root_path, bench_path));
+                search.addProbe(computeLatencyStats(
+                    getLatencies(report),
+                    slo_search.slo_search.quantile, slo_search.slo_search.confidence));
+            } // end while
+
+            // a search where no probe ran at all failed
+            const std::vector<Probe> &probes = search.getProbes();
+            if (std::all_of(probes.begin(), probes.end(),
+                            [](const Probe &probe) { return !probe.message.empty(); }))
+                retval.push_back(search.getName());
+        } // end for
+    } // end for
+
+    // summaries for every probe
+    LiveMetrics::setPhase("Summary");
+    BenchmarkRunner::generateSummary(engine, probe_bench_config, probes_ran, probes_root_path, false);
+
+    save2CSV(config.report_root_path / SummaryFile,
+             config.report_root_path / ProbesFile,
+             searches);
+    if (config.b_show_run_overview)
+    {
+        ss = std::stringstream();
+        ss << "SLO capacity search:" << std::endl
+           << std::endl;
+        show(ss, searches);
+        std::cout << std::endl
+                  << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    } // end if
+    ss = std::stringstream();
+    ss << "SLO capacity search saved to: " << std::endl
+       << config.report_root_path / SummaryFile;
+    std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+    return retval;
+}
+
+} // namespace TestHarness
+} // namespace hebench
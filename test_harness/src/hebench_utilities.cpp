@@ -7,6 +7,8 @@
 #include <fstream>
 #include <sstream>
 
+#include <unistd.h>
+
 #include "include/hebench_utilities.h"
 
 namespace hebench {
@@ -94,6 +96,16 @@ void writeToFile(const std::string &filename,
         b_binary, b_append);
 }
 
+std::uint64_t getResidentMemoryBytes()
+{
+    std::uint64_t retval = 0;
+    std::ifstream fnum("/proc/self/statm");
+    std::uint64_t size_pages, resident_pages;
+    if (fnum >> size_pages >> resident_pages)
+        retval = resident_pages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+    return retval;
+}
+
 void printArraysAsColumns(std::ostream &os,
                           const hebench::APIBridge::NativeDataBuffer **p_buffers, std::size_t count,
                           hebench::APIBridge::DataType data_type,
@@ -18,8 +18,23 @@
 
 #include "dynamic_lib_load.h"
 
+#include "include/hebench_ab_compare.h"
+#include "include/hebench_benchmark_runner.h"
+#include "include/hebench_cold_start.h"
 #include "include/hebench_config.h"
+#include "include/hebench_daemon.h"
+#include "include/hebench_distributed.h"
 #include "include/hebench_engine.h"
+#include "include/hebench_env_sweep.h"
+#include "include/hebench_fingerprint.h"
+#include "include/hebench_live_metrics.h"
+#include "include/hebench_memory_layout.h"
+#include "include/hebench_operand_sweep.h"
+#include "include/hebench_overhead.h"
+#include "include/hebench_program_config.h"
+#include "include/hebench_progress.h"
+#include "include/hebench_run_modes.h"
+#include "include/hebench_slo_search.h"
 #include "include/hebench_types_harness.h"
 #include "include/hebench_utilities.h"
 #include "include/hebench_version.h"
@@ -30,138 +45,6 @@ static_assert(std::numeric_limits<double>::is_iec559, "Compiler type `double` do
 static_assert(sizeof(float) == 4, "Compiler type `float` is not 32 bits.");
 static_assert(sizeof(double) == 8, "Compiler type `double` is not 64 bits.");
 
-struct ProgramConfig
-{
-    std::filesystem::path backend_lib_path;
-    std::filesystem::path config_file;
-    bool b_dump_config;
-    bool b_validate_results;
-    std::uint64_t random_seed;
-    std::size_t report_delay_ms;
-    std::filesystem::path report_root_path;
-    bool b_show_run_overview;
-
-    static constexpr const char *DefaultConfigFile    = "";
-    static constexpr std::uint64_t DefaultMinTestTime = 0;
-    static constexpr std::uint64_t DefaultSampleSize  = 0;
-    static constexpr std::size_t DefaultReportDelay   = 1000;
-    static constexpr const char *DefaultRootPath      = ".";
-
-    void initializeConfig(const hebench::ArgsParser &parser);
-    static std::ostream &showBenchmarkDefaults(std::ostream &os, const hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig &bench_config);
-    std::ostream &showConfig(std::ostream &os) const;
-    static std::ostream &showVersion(std::ostream &os);
-};
-
-void ProgramConfig::initializeConfig(const hebench::ArgsParser &parser)
-{
-    std::string s_tmp;
-
-    if (parser.hasArgument("--version"))
-    {
-        showVersion(std::cout);
-        throw hebench::ArgsParser::HelpShown("Version shown.");
-    } // end if
-
-    parser.getValue<decltype(s_tmp)>(s_tmp, "--benchmark_config_file", DefaultConfigFile);
-    config_file = s_tmp;
-
-    b_dump_config = parser.hasArgument("--dump_config");
-    if (b_dump_config && config_file.empty())
-        throw std::runtime_error("Dump default benchmark configuration file requested, but no filename given with \"--benchmark_config_file\" parameter.");
-
-    parser.getValue<decltype(s_tmp)>(s_tmp, "--backend_lib_path");
-    backend_lib_path = s_tmp;
-
-    parser.getValue<decltype(b_validate_results)>(b_validate_results, "--enable_validation", true);
-
-    parser.getValue<decltype(random_seed)>(random_seed, "--random_seed", std::chrono::system_clock::now().time_since_epoch().count());
-
-    parser.getValue<decltype(report_delay_ms)>(report_delay_ms, "--report_delay", DefaultReportDelay);
-
-    parser.getValue<decltype(s_tmp)>(s_tmp, "--report_root_path", DefaultRootPath);
-    report_root_path = s_tmp;
-    if (!std::filesystem::is_directory(report_root_path) || !std::filesystem::exists(report_root_path))
-        throw std::runtime_error("Specified directory for report output does not exists or is not accessible: " + report_root_path.string());
-    if (!std::filesystem::is_regular_file(backend_lib_path) || !std::filesystem::exists(backend_lib_path))
-        throw std::runtime_error("Specified backend lib does not exists or is not accessible: " + backend_lib_path.string());
-    if (std::filesystem::is_symlink(backend_lib_path))
-        throw std::runtime_error("Backend library error: symbolic links are not allowed as input arguments: " + backend_lib_path.string());
-    if ((std::filesystem::canonical(backend_lib_path).string()).substr(0, 5) == std::string("/tmp/"))
-        throw std::runtime_error("Backend library error: Cannot use files in /tmp/ as arguments: " + backend_lib_path.string());
-
-    if (!b_dump_config && !config_file.empty())
-    {
-        // reading configuration file
-        if (!std::filesystem::is_regular_file(config_file) || !std::filesystem::exists(config_file))
-            throw std::runtime_error("Specified benchmark configuration file does not exists or is not accessible: " + config_file.string());
-        if (std::filesystem::is_symlink(config_file))
-            throw std::runtime_error("Config file path error: symbolic links are not allowed as input arguments: " + config_file.string());
-        if (std::filesystem::canonical(config_file).string().substr(0, 5) == std::string("/tmp/"))
-            throw std::runtime_error("Config file error: Cannot use files in /tmp/ as arguments: " + config_file.string());
-    }
-
-    parser.getValue<decltype(b_show_run_overview)>(b_show_run_overview, "--run_overview", true);
-}
-
-std::ostream &ProgramConfig::showBenchmarkDefaults(std::ostream &os, const hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig &bench_config)
-{
-    os << "Benchmark defaults:" << std::endl
-       << "    Random seed: " << bench_config.random_seed << std::endl
-       << "    Default minimum test time: " << bench_config.default_min_test_time_ms << " ms" << std::endl
-       << "    Default sample size: " << bench_config.default_sample_size << std::endl;
-    return os;
-}
-
-std::ostream &ProgramConfig::showConfig(std::ostream &os) const
-{
-    os << "Global Configuration:" << std::endl;
-    if (b_dump_config)
-    {
-        os << "    Dumping configuration file!" << std::endl;
-    } // end of
-    else
-    {
-        os
-            //<< "    Random seed: " << random_seed << std::endl
-            << "    Validate results: " << (b_validate_results ? "Yes" : "No") << std::endl
-            << "    Report delay (ms): " << report_delay_ms << std::endl
-            << "    Report Root Path: " << report_root_path << std::endl
-            << "    Show run overview: " << (b_show_run_overview ? "Yes" : "No") << std::endl
-            //           << "    Benchmark defaults:" << std::endl
-            //           << "        Default minimum test time: " << min_test_time_ms << " ms" << std::endl
-            //           << "        Default sample size: " << default_sample_size << std::endl
-            ;
-    } // end if
-    os << "    Run configuration file: ";
-    if (config_file.empty())
-        os << "(none)" << std::endl;
-    else
-        os << config_file << std::endl;
-    os << "    Backend library: " << backend_lib_path << std::endl;
-    return os;
-}
-
-std::ostream &ProgramConfig::showVersion(std::ostream &os)
-{
-    os << HEBENCH_TEST_HARNESS_APP_NAME << " v"
-       << HEBENCH_TEST_HARNESS_VERSION_MAJOR << "."
-       << HEBENCH_TEST_HARNESS_VERSION_MINOR << "."
-       << HEBENCH_TEST_HARNESS_VERSION_REVISION << "-"
-       << HEBENCH_TEST_HARNESS_VERSION_BUILD << std::endl
-       << std::endl
-       << "API Bridge version:" << std::endl
-       << "  Required: " << HEBENCH_TEST_HARNESS_API_REQUIRED_VERSION_MAJOR << "."
-       << HEBENCH_TEST_HARNESS_API_REQUIRED_VERSION_MINOR << "."
-       << HEBENCH_TEST_HARNESS_API_MIN_REQUIRED_VERSION_REVISION << std::endl
-       << "  Current:  "
-       << HEBENCH_API_VERSION_MAJOR << "."
-       << HEBENCH_API_VERSION_MINOR << "."
-       << HEBENCH_API_VERSION_REVISION << "-"
-       << HEBENCH_API_VERSION_BUILD << std::endl;
-    return os;
-}
-
 void initArgsParser(hebench::ArgsParser &parser, int argc, char **argv)
 {
     parser.addArgument("--backend_lib_path", "--backend", "-b", 1, "<path_to_shared_lib>",
@@ -180,10 +63,36 @@ void initArgsParser(hebench::ArgsParser &parser, int argc, char **argv)
     parser.addArgument("--enable_validation", "--validation", "-v", 1, "<bool: 0|false|1|true>",
                        "   [OPTIONAL] Specifies whether results from benchmarks ran will be validated\n"
                        "   against ground truth. Defaults to \"TRUE\".");
+    parser.addArgument("--probabilistic_validation", 1, "<rounds>",
+                       "   [OPTIONAL] Number of rounds of probabilistic validation for workloads\n"
+                       "   that support it (currently, Matrix Multiplication) when none is specified\n"
+                       "   by a benchmark configuration file. When positive, ground truth is not\n"
+                       "   computed nor stored, and each result is checked with Freivalds' algorithm\n"
+                       "   instead: an incorrect result passes with probability at most 2^-rounds.\n"
+                       "   Defaults to 0 (validate against ground truth).");
+    parser.addArgument("--plaintext_baseline", 1, "<bool: 0|false|1|true>",
+                       "   [OPTIONAL] Specifies whether each benchmark will also time its operation\n"
+                       "   on plaintext data using the ground truth implementation, and report the\n"
+                       "   slowdown factor of every phase of the benchmark with respect to it.\n"
+                       "   Defaults to \"FALSE\".");
     parser.addArgument("--run_overview", 1, "<bool: 0|false|1|true>",
                        "   [OPTIONAL] Specifies whether final summary overview of the benchmarks ran\n"
                        "   will be printed in standard output (TRUE) or not (FALSE). Results of the\n"
                        "   run will always be saved to storage regardless. Defaults to \"TRUE\".");
+    parser.addArgument("--cipher_mask_summary", 1, "<bool: 0|false|1|true>",
+                       "   [OPTIONAL] Specifies whether benchmarks ran that differ only in which\n"
+                       "   operation parameters are encrypted will be compared. Time and memory\n"
+                       "   differences per phase, and the cost of encrypting each individual\n"
+                       "   parameter, are saved in \"cipher_mask_summary.csv\" and\n"
+                       "   \"cipher_mask_operands.csv\" in the report root path. Defaults to \"FALSE\".");
+    parser.addArgument("--logreg_degree_summary", 1, "<bool: 0|false|1|true>",
+                       "   [OPTIONAL] Specifies whether Logistic Regression benchmarks ran that differ\n"
+                       "   only in the polynomial degree of the sigmoid will be compared. Every\n"
+                       "   benchmark generates its data from the same seed, and the error of the\n"
+                       "   results against the exact sigmoid is measured during validation. Time per\n"
+                       "   phase, cost growth with multiplicative depth and error of every degree are\n"
+                       "   saved in \"logreg_degree_summary.csv\" in the report root path. Defaults\n"
+                       "   to \"FALSE\".");
     parser.addArgument("--random_seed", "--seed", 1, "<uint64>",
                        "   [OPTIONAL] Specifies the random seed to use for pseudo-random number\n"
                        "   generation when none is specified by a benchmark configuration file. If\n"
@@ -196,155 +105,99 @@ void initArgsParser(hebench::ArgsParser &parser, int argc, char **argv)
                        "   [OPTIONAL] Directory where to store the report output files.\n"
                        "   Must exist and be accessible for writing. Any files with the same name will\n"
                        "   be overwritten. Defaults to current working directory \".\"");
+    parser.addArgument("--metrics_file", 1, "<path_to_file>",
+                       "   [OPTIONAL] If specified, Test Harness will periodically rewrite this file\n"
+                       "   with live metrics of the run in Prometheus text format (current benchmark,\n"
+                       "   phase, operations completed, rolling rate and latency quantiles, benchmarks\n"
+                       "   remaining and memory usage).");
+    parser.addArgument("--metrics_socket", 1, "<path_to_socket>",
+                       "   [OPTIONAL] If specified, Test Harness will serve live metrics of the run\n"
+                       "   in Prometheus text format on a Unix domain socket at this path.");
+    parser.addArgument("--metrics_interval", 1, "<interval_in_ms>",
+                       "   [OPTIONAL] Interval between rewrites of the live metrics file.\n"
+                       "   Defaults to 1000 ms.");
+    parser.addArgument("--progress_interval", 1, "<interval_in_ms>",
+                       "   [OPTIONAL] Interval between progress lines when standard output is not a\n"
+                       "   terminal. On a terminal, progress is redrawn in place at most every 100 ms.\n"
+                       "   Pass 0 to print only the final line of each phase. Defaults to 5000 ms.");
+    parser.addArgument("--coordinator_workers", 1, "<host:port,...>",
+                       "   [OPTIONAL] If specified, Test Harness runs as coordinator: benchmarks are\n"
+                       "   dispatched as independent jobs to the listed worker instances (started\n"
+                       "   with \"--worker_port\") and their reports are collected in the report root\n"
+                       "   path before generating the summary. Requires \"--distributed_token_file\".");
+    parser.addArgument("--job_history_file", 1, "<path_to_file>",
+                       "   [OPTIONAL] File with historical job run times used by the coordinator to\n"
+                       "   balance the load. Updated after every distributed run. Defaults to\n"
+                       "   \"hebench_job_history.csv\" in the report root path.");
+    parser.addArgument("--worker_port", 1, "<port>",
+                       "   [OPTIONAL] If specified, Test Harness runs as worker: it waits for a\n"
+                       "   coordinator on this TCP port and runs the benchmark jobs it receives\n"
+                       "   until terminated. Requires \"--distributed_token_file\".");
+    parser.addArgument("--worker_bind_address", 1, "<host>",
+                       "   [OPTIONAL] Address of the local interface where the worker listens for\n"
+                       "   coordinators. Defaults to \"127.0.0.1\" (local coordinators only).");
+    parser.addArgument("--distributed_token_file", 1, "<path_to_file>",
+                       "   [OPTIONAL] File whose first line is the secret token shared by coordinator\n"
+                       "   and workers. Workers drop connections that do not present it. Required by\n"
+                       "   \"--coordinator_workers\" and \"--worker_port\".");
+    parser.addArgument("--daemon_socket", 1, "<path_to_socket>",
+                       "   [OPTIONAL] If specified, Test Harness runs as daemon: it keeps the backend\n"
+                       "   loaded and waits for run requests on this Unix socket until a \"shutdown\"\n"
+                       "   request is received. The last benchmark initialized, with its dataset, is\n"
+                       "   kept alive, so that requests to run it again skip data generation and\n"
+                       "   backend initialization. Request \"run <benchmark_config_file>\" runs the\n"
+                       "   benchmarks in the file and saves their reports in the report root path.");
+    parser.addArgument("--record_api_calls", 1, "<bool: 0|false|1|true>",
+                       "   [OPTIONAL] Specifies whether the API Bridge calls issued on each benchmark\n"
+                       "   will be recorded, along with the plaintext inputs, in file \"api_calls.rec\"\n"
+                       "   next to the benchmark report. Recordings can be replayed against a backend\n"
+                       "   with tool \"api_replay\". Timings of benchmarks recorded should be\n"
+                       "   disregarded. Defaults to \"FALSE\".");
+    parser.addArgument("--cold_start_samples", 1, "<count>",
+                       "   [OPTIONAL] If specified, Test Harness measures the cold-start latency of\n"
+                       "   each benchmark instead of running it: every sample runs the benchmark once\n"
+                       "   in a fresh child process and times each phase from backend library load to\n"
+                       "   the first decoded result. The distribution of each phase is saved in file\n"
+                       "   \"cold_start.csv\" next to the benchmark report.");
+    parser.addArgument("--cold_start_drop_cache", 1, "<bool: 0|false|1|true>",
+                       "   [OPTIONAL] Specifies whether the page cache for the backend library file\n"
+                       "   will be dropped before each cold-start sample. Defaults to \"FALSE\".");
+    parser.addArgument("--cold_start_child", 1, "<path_to_file>",
+                       "   [INTERNAL] Used by Test Harness to start cold-start child processes.");
+    parser.addArgument("--compare_backend_lib_paths", 1, "<path_to_shared_lib,...>",
+                       "   [OPTIONAL] If specified, Test Harness loads these backend libraries\n"
+                       "   alongside \"--backend_lib_path\", which is the baseline, and runs every\n"
+                       "   benchmark on all of them interleaved in shuffled order for several rounds.\n"
+                       "   Each backend is compared against the baseline using per-round paired\n"
+                       "   differences and the result is saved in \"ab_summary.csv\" in the report\n"
+                       "   root path. Benchmarks not offered by every backend are skipped and\n"
+                       "   reported as failed.");
+    parser.addArgument("--ab_rounds", 1, "<count>",
+                       "   [OPTIONAL] Number of rounds for A/B comparison. Defaults to 3.");
+    parser.addArgument("--layout_samples", 1, "<count>",
+                       "   [OPTIONAL] If specified, Test Harness runs each benchmark once per memory\n"
+                       "   layout, every time in a fresh child process with randomized ASLR,\n"
+                       "   environment size, heap and memory mapping padding, and stack offset of the\n"
+                       "   benchmark thread. Variance induced by the layout is separated from the\n"
+                       "   variance within a layout and saved in \"layout_summary.csv\" in the report\n"
+                       "   root path.");
+    parser.addArgument("--layout_child", 1, "<heap,mapping,stack>",
+                       "   [INTERNAL] Used by Test Harness to start memory layout child processes.");
+    parser.addArgument("--env_sweep_child", 1, "<knob,...>",
+                       "   [INTERNAL] Used by Test Harness to start environment sweep child processes.");
+    parser.addArgument("--backend_lib_hash", 1, "<hash>",
+                       "   [INTERNAL] Used by Test Harness to pass the backend library hash to child\n"
+                       "   processes.");
     parser.addArgument("--version", 0, "",
                        "   [OPTIONAL] Outputs Test Harness version, required API Bridge version and\n"
                        "   currently linked API Bridge version. Application exists after this.");
     parser.parse(argc, argv);
 }
 
-std::string toDoubleVariableFrac(double x, int up_to_digits_after_dot)
-{
-    // Prints a floating point value with up to a number of digits after decimal point
-    // with no trailing zeroes.
-    std::string retval;
-    std::stringstream ss;
-    if (up_to_digits_after_dot < 0)
-        up_to_digits_after_dot = 0;
-    ss << std::fixed << std::setprecision(up_to_digits_after_dot) << x;
-    retval = ss.str();
-    retval.erase(retval.find_last_not_of(".0") + 1);
-    return retval;
-}
-
-void generateSummary(const hebench::TestHarness::Engine &engine,
-                     const hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig bench_config,
-                     const std::vector<hebench::TestHarness::BenchmarkRequest> &benchmarks_ran,
-                     const std::string &input_root_path, const std::string &output_root_path,
-                     bool do_stdout_summary = true)
-{
-    constexpr int ScreenColSize  = 80;
-    constexpr int AveWallColSize = ScreenColSize / 8;
-    constexpr int AveCPUColSize  = ScreenColSize / 8;
-    //constexpr int BenchNameColSize = ScreenColSize * 9 / 16;
-    constexpr int BenchNameColSize = ScreenColSize - AveWallColSize - AveCPUColSize - 15;
-
-    std::stringstream ss;
-
-    if (do_stdout_summary)
-    {
-        std::cout << " " << std::setfill(' ') << std::setw(BenchNameColSize) << std::left << std::string("Benchmark").substr(0, BenchNameColSize) << " | "
-                  << std::setw(AveWallColSize + 3) << std::right << std::string("Ave Wall time").substr(0, AveWallColSize + 3) << " | "
-                  << std::setw(AveWallColSize + 3) << std::right << std::string("Ave CPU time").substr(0, AveCPUColSize + 3) << std::endl;
-        std::cout << std::setfill('=') << std::setw(ScreenColSize) << std::left << "=" << std::endl;
-    } // end if
-
-    std::size_t bench_total = 0;
-    for (std::size_t bench_i = 0; bench_i < benchmarks_ran.size(); ++bench_i)
-    {
-        for (std::size_t params_i = 0; params_i < benchmarks_ran[bench_i].sets_w_params.size(); ++params_i)
-        {
-            hebench::TestHarness::BenchmarkFactory::BenchmarkToken::Ptr description_token =
-                engine.describeBenchmark(bench_config,
-                                         benchmarks_ran[bench_i].benchmark_index,
-                                         benchmarks_ran[bench_i].sets_w_params[params_i]);
-
-            // retrieve the correct input and output paths
-            std::filesystem::path report_filename = description_token->description.path;
-            std::filesystem::path report_path;
-            std::filesystem::path output_path;
-
-            if (report_filename.is_absolute())
-            {
-                report_path = report_filename;
-                output_path = report_filename;
-            } // end if
-            else
-            {
-                report_path = input_root_path / report_filename;
-                output_path = output_root_path / report_filename;
-            } // end else
-
-            // generate output directory if it doesn't exits
-            std::filesystem::create_directories(output_path);
-
-            // complete the paths to the input and output files
-            report_path /= hebench::TestHarness::FileNameNoExtReport;
-            report_path += ".csv";
-            output_path /= hebench::TestHarness::FileNameNoExtSummary;
-            output_path += ".csv";
-
-            if (do_stdout_summary)
-            {
-                ss = std::stringstream();
-                ss << (bench_total + 1) << ". " << report_filename.generic_string();
-                std::cout << " " << std::setfill(' ') << std::setw(BenchNameColSize) << std::left << ss.str().substr(0, BenchNameColSize) << " | ";
-            } // end if
-
-            try
-            {
-                // load input report
-                hebench::TestHarness::Report::cpp::TimingReport report =
-                    hebench::TestHarness::Report::cpp::TimingReport::loadReportFromCSVFile(report_path);
-                // generate summary
-                if (report.getEventCount() > 0)
-                {
-                    // output summary to file
-                    hebench::TestHarness::Report::TimingReportEventC tre;
-                    std::string csv_report = report.generateSummaryCSV(tre);
-                    hebench::Utilities::writeToFile(output_path, csv_report.c_str(), csv_report.size(), false, false);
-
-                    // output overview of summary to stdout
-                    if (do_stdout_summary)
-                    {
-                        hebench::TestHarness::Report::TimingPrefixedSeconds timing_prefix;
-                        double elapsed_time_secs;
-
-                        elapsed_time_secs = (tre.wall_time_end - tre.wall_time_start) * tre.time_interval_ratio_num / tre.time_interval_ratio_den;
-                        hebench::TestHarness::Report::cpp::TimingReport::computeTimingPrefix(timing_prefix, elapsed_time_secs);
-                        ss = std::stringstream();
-                        ss << timing_prefix.symbol << "s";
-                        std::cout << std::setw(AveWallColSize) << std::right
-                                  << toDoubleVariableFrac(timing_prefix.value, 2).substr(0, AveWallColSize)
-                                  << std::setfill(' ') << std::setw(3) << std::right << ss.str() << " | ";
-
-                        elapsed_time_secs = (tre.cpu_time_end - tre.cpu_time_start) * tre.time_interval_ratio_num / tre.time_interval_ratio_den;
-                        hebench::TestHarness::Report::cpp::TimingReport::computeTimingPrefix(timing_prefix, elapsed_time_secs);
-                        ss = std::stringstream();
-                        ss << timing_prefix.symbol << "s";
-                        std::cout << std::setw(AveCPUColSize) << std::right
-                                  << toDoubleVariableFrac(timing_prefix.value, 2).substr(0, AveCPUColSize)
-                                  << std::setfill(' ') << std::setw(3) << std::right << ss.str() << std::endl;
-                    } // end if
-                } // end if
-                else if (do_stdout_summary)
-                    std::cout << "Validation Failed" << std::endl;
-            }
-            catch (...)
-            {
-                if (do_stdout_summary)
-                    std::cout << "Load Failed" << std::endl;
-            }
-            if (do_stdout_summary)
-                std::cout << std::setfill('-') << std::setw(ScreenColSize) << std::left << "-" << std::endl;
-
-            ++bench_total; // count the benchmark
-        } // end for
-    } // end for
-}
-
-void generateSummary(const hebench::TestHarness::Engine &engine,
-                     const hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig bench_config,
-                     const std::vector<hebench::TestHarness::BenchmarkRequest> &benchmarks_ran,
-                     const std::string &input_root_path,
-                     bool do_stdout_summary = true)
-{
-    generateSummary(engine, bench_config, benchmarks_ran, input_root_path, input_root_path, do_stdout_summary);
-}
-
 int main(int argc, char **argv)
 {
     int retval = 0;
-    ProgramConfig config;
+    hebench::TestHarness::ProgramConfig config;
     std::stringstream ss;
 
     std::cout << std::endl
@@ -375,16 +228,51 @@ int main(int argc, char **argv)
         config.showConfig(ss);
         std::cout << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
 
+        if (!config.metrics_file.empty() || !config.metrics_socket.empty())
+            hebench::TestHarness::LiveMetrics::initialize(config.metrics_file,
+                                                          config.metrics_socket,
+                                                          config.metrics_interval_ms);
+        hebench::TestHarness::Progress::initialize(config.progress_interval_ms);
+        hebench::TestHarness::HarnessOverhead::reset(); // account for harness wall time from here on
+
         ss = std::stringstream();
         ss << "Initializing Backend from shared library:" << std::endl
            << config.backend_lib_path;
         std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
-        hebench::APIBridge::DynamicLibLoad::loadLibrary(config.backend_lib_path);
+        if (!config.layout_child.empty())
+        {
+            // layout requested by a parent Test Harness: padding shifts the library
+            hebench::TestHarness::MemoryLayout::applyPadding(
+                hebench::TestHarness::MemoryLayout::fromChildArgument(config.layout_child));
+        } // end if
+        hebench::TestHarness::ColdStart::Sample cold_start_sample; // timed only for cold-start children
+        auto time_start = std::chrono::steady_clock::now();
+        hebench::APIBridge::DynamicLib *p_backend_lib = hebench::APIBridge::DynamicLibLoad::loadLibrary(config.backend_lib_path);
+        auto time_end = std::chrono::steady_clock::now();
+        cold_start_sample.push_back({ hebench::TestHarness::ColdStart::PhaseLibraryLoad,
+                                      std::chrono::duration<double, std::milli>(time_end - time_start).count(),
+                                      true });
         std::cout << IOS_MSG_OK << std::endl;
 
+        // machine, build and backend fingerprint recorded in every report header
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Collecting machine fingerprint...") << std::endl;
+        hebench::TestHarness::Report::cpp::Fingerprint machine_fingerprint = hebench::TestHarness::FingerprintCollector::collect();
+        config.fingerprint                                                 = machine_fingerprint;
+        // children reuse the hash of their parent to keep file reads out of their timed phases
+        hebench::TestHarness::FingerprintCollector::addBackend(config.fingerprint, config.backend_lib_path, config.backend_lib_hash);
+        if (!config.env_sweep_child.empty())
+            hebench::TestHarness::EnvSweep::addToFingerprint(config.fingerprint, config.env_sweep_child);
+        std::cout << hebench::Logging::GlobalLogger::log(config.fingerprint.toHeader());
+        std::cout << IOS_MSG_DONE << std::endl;
+
         // create engine and register all benchmarks
         std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Initializing Backend engine...") << std::endl;
+        time_start                                 = std::chrono::steady_clock::now();
         hebench::TestHarness::Engine::Ptr p_engine = hebench::TestHarness::Engine::create();
+        time_end                                   = std::chrono::steady_clock::now();
+        cold_start_sample.push_back({ hebench::TestHarness::ColdStart::PhaseEngineInit,
+                                      std::chrono::duration<double, std::milli>(time_end - time_start).count(),
+                                      true });
         std::cout << IOS_MSG_OK << std::endl;
 
         std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Retrieving default benchmark configuration from Backend...") << std::endl;
@@ -394,12 +282,15 @@ int main(int argc, char **argv)
 
         // default configuration for benchmarks
         hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig bench_config;
-        bench_config.default_sample_size      = ProgramConfig::DefaultSampleSize; //config.default_sample_size;
-        bench_config.default_min_test_time_ms = ProgramConfig::DefaultMinTestTime; //config.min_test_time_ms;
-        bench_config.random_seed              = config.random_seed;
+        bench_config.default_sample_size             = hebench::TestHarness::ProgramConfig::DefaultSampleSize; //config.default_sample_size;
+        bench_config.default_min_test_time_ms        = hebench::TestHarness::ProgramConfig::DefaultMinTestTime; //config.min_test_time_ms;
+        bench_config.random_seed                     = config.random_seed;
+        bench_config.probabilistic_validation_rounds = config.probabilistic_validation_rounds;
 
-        if (config.b_dump_config)
-        {
+        // run modes requested are mutually exclusive (see RunModes)
+        using RunMode = hebench::TestHarness::RunModes::Mode;
+
+        auto dump_config = [&]() {
             ss = std::stringstream();
             ss << "Saving default benchmark configuration to storage:" << std::endl
                << config.config_file;
@@ -410,182 +301,182 @@ int main(int argc, char **argv)
             std::cout << IOS_MSG_OK << std::endl;
 
             // default config dumped; program completed
-        } // end if
-        else
-        {
+        };
+        auto load_job = [&](const std::filesystem::path &job_config_file,
+                            hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig &job_bench_config) {
+            // jobs received by a worker or daemon run as requested, in the current mode
+            std::vector<hebench::TestHarness::BenchmarkRequest> job_benchmarks =
+                hebench::TestHarness::BenchmarkRunner::loadConfiguration(*p_bench_config, job_config_file, job_bench_config);
+            hebench::TestHarness::RunModes job_modes = config.run_modes;
+            if (!hebench::TestHarness::SLOCapacitySearch::extract(job_benchmarks).empty())
+                job_modes.enable(RunMode::SLOSearch);
+            if (!hebench::TestHarness::OperandSweep::extract(job_benchmarks).empty())
+                job_modes.enable(RunMode::OperandSweep);
+            return job_benchmarks;
+        };
+        auto serve_worker = [&]() {
+            // run jobs from coordinators until terminated
+            hebench::TestHarness::DistributedWorker::serve(
+                config.worker_bind_address, config.worker_port, config.distributed_token,
+                config.report_root_path / hebench::TestHarness::ProgramConfig::WorkerDirName,
+                [&](const std::filesystem::path &job_config_file, const std::filesystem::path &job_report_root) -> bool {
+                    hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig job_bench_config = bench_config;
+                    std::vector<hebench::TestHarness::BenchmarkRequest> job_benchmarks = load_job(job_config_file, job_bench_config);
+
+                    std::vector<std::string> job_failed_benchmarks;
+                    hebench::TestHarness::BenchmarkRunner::run(*p_engine, job_bench_config, job_benchmarks, config, job_report_root, job_failed_benchmarks);
+                    return job_failed_benchmarks.empty();
+                });
+        };
+        auto serve_daemon = [&]() {
+            // keep engine and last benchmark warm between requests until shut down
+            hebench::TestHarness::HarnessDaemon::serve(
+                config.daemon_socket,
+                [&](const std::filesystem::path &request_config_file,
+                    hebench::TestHarness::BenchmarkCache &bench_cache) -> std::vector<std::string> {
+                    hebench::TestHarness::HarnessOverhead::reset(); // one overhead report per request
+                    hebench::TestHarness::IBenchmarkDescription::BenchmarkConfig request_bench_config = bench_config;
+                    std::vector<hebench::TestHarness::BenchmarkRequest> request_benchmarks = load_job(request_config_file, request_bench_config);
+                    hebench::TestHarness::LiveMetrics::setTotalBenchmarks(
+                        hebench::Utilities::BenchmarkConfiguration::countBenchmarks2Run(request_benchmarks));
+
+                    std::vector<std::string> request_failed_benchmarks;
+                    hebench::TestHarness::BenchmarkRunner::run(*p_engine, request_bench_config, request_benchmarks, config,
+                                                               config.report_root_path, request_failed_benchmarks, &bench_cache);
+
+                    hebench::TestHarness::LiveMetrics::setPhase("Summary");
+                    hebench::TestHarness::BenchmarkRunner::generateSummary(*p_engine, request_bench_config, request_benchmarks,
+                                                                           config.report_root_path, config.b_show_run_overview);
+                    hebench::TestHarness::HarnessOverhead::save2CSV(config.report_root_path / hebench::TestHarness::HarnessOverhead::ReportFile);
+                    return request_failed_benchmarks;
+                });
+        };
+        auto run_cold_start_child = [&]() {
+            // single cold-start sample requested by a parent Test Harness
+            benchmarks_to_run = hebench::TestHarness::BenchmarkRunner::loadConfiguration(*p_bench_config, config.config_file, bench_config);
+            hebench::TestHarness::ColdStart::takeSample(*p_engine, bench_config, benchmarks_to_run, config, cold_start_sample);
+        };
+        auto run_layout_child = [&]() {
+            // single memory layout requested by a parent Test Harness
+            benchmarks_to_run = hebench::TestHarness::BenchmarkRunner::loadConfiguration(*p_bench_config, config.config_file, bench_config);
+            hebench::TestHarness::MemoryLayout::runInLayout(*p_engine, bench_config, benchmarks_to_run, config);
+        };
+        auto run_requested = [&]() {
             // initialize benchmarks requested to run
 
             if (config.config_file.empty())
-            {
                 std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Loading default benchmark configuration...") << std::endl;
-                benchmarks_to_run = p_bench_config->getDefaultConfiguration();
-            } // end if
             else
             {
                 ss = std::stringstream();
                 ss << "Loading benchmark configuration file:" << std::endl
                    << config.config_file;
                 std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
-                benchmarks_to_run = p_bench_config->loadConfiguration(config.config_file, bench_config);
             } // end else
+            benchmarks_to_run = hebench::TestHarness::BenchmarkRunner::loadConfiguration(*p_bench_config, config.config_file, bench_config);
 
             ss = std::stringstream();
             config.showBenchmarkDefaults(ss, bench_config);
             std::cout << std::endl
                       << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
 
-            hebench::Utilities::RandomGenerator::setRandomSeed(bench_config.random_seed);
+            // capacity searches run their own probes after the benchmarks requested
+            std::vector<hebench::TestHarness::BenchmarkRequest> slo_searches = hebench::TestHarness::SLOCapacitySearch::extract(benchmarks_to_run);
+            if (!slo_searches.empty())
+                config.run_modes.enable(RunMode::SLOSearch);
+            // operand sweeps run their own points after the benchmarks requested
+            std::vector<hebench::TestHarness::BenchmarkRequest> operand_sweeps = hebench::TestHarness::OperandSweep::extract(benchmarks_to_run);
+            if (!operand_sweeps.empty())
+                config.run_modes.enable(RunMode::OperandSweep);
+
+            // knob combinations declared in the configuration file run in child processes
+            std::vector<hebench::TestHarness::EnvKnob> env_knobs;
+            if (!config.config_file.empty() && config.env_sweep_child.empty())
+                env_knobs = hebench::Utilities::BenchmarkConfiguration::loadEnvSweep(config.config_file);
+            if (!env_knobs.empty())
+                config.run_modes.enable(RunMode::EnvSweep);
+
+            // backends to compare against the baseline, each with its own engine
+            std::vector<hebench::TestHarness::ABComparison::Backend> ab_backends;
+            if (!config.compare_backend_lib_paths.empty())
+                ab_backends = hebench::TestHarness::ABComparison::loadBackends(config, p_backend_lib, p_engine, machine_fingerprint);
 
             total_runs = hebench::Utilities::BenchmarkConfiguration::countBenchmarks2Run(benchmarks_to_run);
+            if (!ab_backends.empty())
+                total_runs *= config.ab_rounds * ab_backends.size();
+            total_runs += hebench::Utilities::BenchmarkConfiguration::countBenchmarks2Run(slo_searches);
+            total_runs += hebench::Utilities::BenchmarkConfiguration::countBenchmarks2Run(operand_sweeps);
             ss         = std::stringstream();
             ss << "Benchmarks to run: " << total_runs;
             std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
-
-            // iterate through the registered benchmarks and execute them
-            std::size_t run_i = 0;
-            for (std::size_t bench_i = 0; bench_i < benchmarks_to_run.size(); ++bench_i)
-            {
-                for (std::size_t params_i = 0; params_i < benchmarks_to_run[bench_i].sets_w_params.size(); ++params_i)
+            hebench::TestHarness::LiveMetrics::setTotalBenchmarks(total_runs);
+
+            auto run_cold_start = [&]() {
+                // cold-start reports replace the benchmark reports and summary
+                failed_benchmarks = hebench::TestHarness::ColdStart::run(p_engine, p_bench_config, bench_config, benchmarks_to_run, config);
+            };
+            auto run_ab_comparison = [&]() {
+                // every backend and round has its own reports and summary under the report root
+                failed_benchmarks = hebench::TestHarness::ABComparison::run(ab_backends, bench_config, benchmarks_to_run, config);
+            };
+            auto run_env_sweep = [&]() {
+                // every combination has its own reports and summary under the report root
+                failed_benchmarks = hebench::TestHarness::EnvSweep::run(*p_engine, bench_config, benchmarks_to_run, env_knobs, config);
+            };
+            auto run_layout_randomization = [&]() {
+                // every layout has its own reports under its benchmark report path
+                failed_benchmarks = hebench::TestHarness::MemoryLayout::run(*p_engine, *p_bench_config, bench_config, benchmarks_to_run, config);
+            };
+            auto run_benchmarks = [&]() {
+                if (!benchmarks_to_run.empty() || (slo_searches.empty() && operand_sweeps.empty()))
                 {
-                    bool b_non_critical_error = false;
-                    std::string bench_path;
-                    hebench::Utilities::TimingReportEx report;
-                    try
-                    {
-                        ss = std::stringstream();
-                        ss << "(" << bench_i << ", " << params_i << ")";
-                        bench_path = ss.str();
-
-                        ss = std::stringstream();
-                        ss << " Progress: " << (run_i * 100 / total_runs) << "%" << std::endl
-                           << "           " << run_i << "/" << total_runs;
-                        std::cout << std::endl
-                                  << "==================" << std::endl
-                                  << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl
-                                  << "==================" << std::endl;
-
-                        if (config.report_delay_ms > 0)
-                            std::this_thread::sleep_for(std::chrono::milliseconds(config.report_delay_ms));
-
-                        // obtain the text description of the benchmark to print out
-                        hebench::TestHarness::BenchmarkFactory::BenchmarkToken::Ptr bench_token =
-                            p_engine->describeBenchmark(bench_config, benchmarks_to_run[bench_i].benchmark_index, benchmarks_to_run[bench_i].sets_w_params[params_i]);
-
-                        bench_path = bench_token->description.path;
-
-                        // print header
-
-                        // prints
-                        // ===========================
-                        //  Workload: <workload name>
-                        // ===========================
-                        std::string s_workload_name = "Workload: " + bench_token->description.workload_name;
-                        std::size_t fill_size       = s_workload_name.length() + 2;
-                        if (fill_size > 79)
-                            fill_size = 79;
-                        std::cout << std::endl
-                                  << std::setfill('=') << std::setw(fill_size) << "=" << std::endl
-                                  << " " << hebench::Logging::GlobalLogger::log(s_workload_name) << std::endl
-                                  << std::setw(fill_size) << "=" << std::setfill(' ') << std::endl;
-
-                        std::cout << std::endl
-                                  << bench_token->description.header << std::endl;
-
-                        // create the benchmark
-                        report.setHeader(bench_token->description.header);
-                        hebench::TestHarness::IBenchmark::Ptr p_bench = p_engine->createBenchmark(bench_token, report);
-
-                        hebench::TestHarness::IBenchmark::RunConfig run_config;
-                        run_config.b_validate_results = config.b_validate_results;
-
-                        // run the workload
-                        bool b_succeeded = p_bench->run(report, run_config);
-
-                        if (!b_succeeded)
-                        {
-                            std::cout << IOS_MSG_FAILED << hebench::Logging::GlobalLogger::log(bench_token->description.workload_name) << std::endl;
-                            failed_benchmarks.push_back(bench_path);
-                            report.clear(); // report event data is no longer valid for a failed run
-                        } // end if
-                    }
-                    catch (hebench::Common::ErrorException &err_num)
-                    {
-                        if (err_num.getErrorCode() == HEBENCH_ECODE_CRITICAL_ERROR)
-                            throw; // critical failure
-                        else
-                        {
-                            // no critical error: report and move on to the next benchmark
-
-                            b_non_critical_error = true;
-
-                            failed_benchmarks.push_back(bench_path);
-                            report.clear(); // report event data is no longer valid for a failed run
-
-                            ss = std::stringstream();
-                            ss << "Workload backend failed with message: " << std::endl
-                               << err_num.what();
-                            std::cout << std::endl
-                                      << IOS_MSG_ERROR << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
-                        } // end else
-                    }
-
-                    // create the path to output report
-                    std::filesystem::path report_filename = bench_path;
-                    std::filesystem::path report_path     = (report_filename.is_absolute() ?
-                                                             report_filename :
-                                                             config.report_root_path / report_filename);
-
-                    ss = std::stringstream();
-                    ss << "Saving report to: " << std::endl
-                       << report_path;
-                    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
-
-                    // output CSV report
-                    report_filename = report_path;
-                    report_filename /= hebench::TestHarness::FileNameNoExtReport;
-                    report_filename += ".csv";
-
-                    if (b_non_critical_error)
-                    {
-                        // delete any previous report in this location to signal failure
-                        if (std::filesystem::exists(report_filename)
-                            && std::filesystem::is_regular_file(report_filename))
-                            std::filesystem::remove(report_filename);
-                    } // end if
+                    if (!config.run_modes.isEnabled(RunMode::Coordinator))
+                        hebench::TestHarness::BenchmarkRunner::run(*p_engine, bench_config, benchmarks_to_run, config, config.report_root_path, failed_benchmarks);
                     else
-                    {
-                        std::filesystem::create_directories(report_path);
-                        report.save2CSV(report_filename);
-                    } // end else
-
-                    std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log("Report saved.") << std::endl;
-
-                    ++run_i;
-                } // end for
-
-                // benchmark cleaned up here automatically
-            } // end for
+                        failed_benchmarks = hebench::TestHarness::BenchmarkRunner::runDistributed(*p_engine, *p_bench_config, bench_config, benchmarks_to_run, config);
+
+                    // benchmark summary
+
+                    std::cout << std::endl
+                              << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Generating summary...") << std::endl
+                              << std::endl;
+                    hebench::TestHarness::LiveMetrics::setPhase("Summary");
+                    hebench::TestHarness::BenchmarkRunner::generateSummary(*p_engine, bench_config, benchmarks_to_run,
+                                                                           config.report_root_path, config.b_show_run_overview);
+                    if (config.b_cipher_mask_summary)
+                        hebench::TestHarness::BenchmarkRunner::generateCipherMaskSummary(*p_engine, bench_config, benchmarks_to_run, config);
+                    if (config.b_logreg_degree_summary)
+                        hebench::TestHarness::BenchmarkRunner::generateLogRegDegreeSummary(*p_engine, bench_config, benchmarks_to_run, config);
+                } // end if
 
-            ss = std::stringstream();
-            ss << " Progress: 100%" << std::endl
-               << "           " << total_runs << "/" << total_runs;
-            std::cout << std::endl
-                      << "==================" << std::endl
-                      << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl
-                      << "==================" << std::endl;
+                if (!slo_searches.empty())
+                {
+                    std::vector<std::string> search_failed = hebench::TestHarness::SLOCapacitySearch::run(*p_engine, bench_config, slo_searches, config);
+                    failed_benchmarks.insert(failed_benchmarks.end(), search_failed.begin(), search_failed.end());
+                } // end if
 
-            // benchmark summary
+                if (!operand_sweeps.empty())
+                {
+                    std::vector<std::string> sweep_failed = hebench::TestHarness::OperandSweep::run(*p_engine, bench_config, operand_sweeps, config);
+                    failed_benchmarks.insert(failed_benchmarks.end(), sweep_failed.begin(), sweep_failed.end());
+                } // end if
+            };
 
-            std::cout << std::endl
-                      << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Generating summary...") << std::endl
-                      << std::endl;
-            generateSummary(*p_engine, bench_config, benchmarks_to_run,
-                            config.report_root_path, config.b_show_run_overview);
+            config.run_modes.dispatch({ { RunMode::ColdStart, run_cold_start },
+                                        { RunMode::ABComparison, run_ab_comparison },
+                                        { RunMode::EnvSweep, run_env_sweep },
+                                        { RunMode::LayoutRandomization, run_layout_randomization } },
+                                      run_benchmarks);
 
             // clean-up engine before final report (engine can clean up
             // automatically, but better to release when no longer needed)
+            ab_backends.clear();
             p_engine.reset();
 
+            // wall time spent by Test Harness in each of its phases
+            std::filesystem::path overhead_filename = config.report_root_path / hebench::TestHarness::HarnessOverhead::ReportFile;
+            hebench::TestHarness::HarnessOverhead::save2CSV(overhead_filename);
+
             // benchmark overall summary
 
             if (config.b_show_run_overview && !failed_benchmarks.empty())
@@ -617,7 +508,28 @@ int main(int argc, char **argv)
             ss = std::stringstream();
             ss << "Failed: " << failed_benchmarks.size();
             std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
-        } // end else
+
+            if (config.b_show_run_overview)
+            {
+                ss = std::stringstream();
+                ss << "Harness wall time by phase:" << std::endl
+                   << std::endl;
+                hebench::TestHarness::HarnessOverhead::show(ss);
+                std::cout << std::endl
+                          << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+            } // end if
+            ss = std::stringstream();
+            ss << "Harness overhead report saved to: " << std::endl
+               << overhead_filename;
+            std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+        };
+
+        config.run_modes.dispatch({ { RunMode::DumpConfig, dump_config },
+                                    { RunMode::Worker, serve_worker },
+                                    { RunMode::Daemon, serve_daemon },
+                                    { RunMode::ColdStartChild, run_cold_start_child },
+                                    { RunMode::LayoutChild, run_layout_child } },
+                                  run_requested);
     }
     catch (hebench::ArgsParser::HelpShown &)
     {
@@ -625,6 +537,7 @@ int main(int argc, char **argv)
     }
     catch (std::exception &ex)
     {
+        hebench::TestHarness::Progress::endPhase();
         ss = std::stringstream();
         ss << "An error occurred with message: " << std::endl
            << ex.what();
@@ -637,6 +550,8 @@ int main(int argc, char **argv)
         retval = -1;
     }
 
+    hebench::TestHarness::Progress::terminate();
+    hebench::TestHarness::LiveMetrics::terminate();
     hebench::APIBridge::DynamicLibLoad::unloadLibrary();
 
     if (retval == 0)
@@ -0,0 +1,180 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "include/hebench_idata_loader.h"
+#include "modules/testing/include/testing.h"
+
+using hebench::TestHarness::PartialDataLoader;
+using hebench::TestHarness::RunArena;
+
+namespace {
+
+constexpr std::size_t ParameterCount     = 2;
+constexpr std::size_t ResultCount        = 2;
+constexpr std::uint64_t InputBufferSize  = 16;
+constexpr std::uint64_t OutputBufferSize = 32;
+
+/**
+ * @brief Loader that counts the calls to computeResultUnchecked() instead of
+ * computing results.
+ */
+class CountingDataLoader : public PartialDataLoader
+{
+public:
+    CountingDataLoader(bool can_compute_result) :
+        PartialDataLoader(RunArena::Ptr()),
+        m_can_compute_result(can_compute_result),
+        m_unchecked_calls(0)
+    {
+        const std::size_t input_counts[ParameterCount]         = { 2, 3 };
+        const std::uint64_t input_buffer_sizes[ParameterCount] = { InputBufferSize, InputBufferSize };
+        const std::uint64_t output_buffer_sizes[ResultCount]   = { OutputBufferSize, OutputBufferSize };
+        init(ParameterCount, input_counts, ResultCount);
+        allocate(input_buffer_sizes, ParameterCount, output_buffer_sizes, ResultCount);
+    }
+
+    bool canComputeResult() const override { return m_can_compute_result; }
+    void computeResultUnchecked(const std::vector<hebench::APIBridge::NativeDataBuffer *> &results,
+                                const std::uint64_t *param_data_pack_indices) override
+    {
+        if (!m_can_compute_result)
+            PartialDataLoader::computeResultUnchecked(results, param_data_pack_indices);
+        ++m_unchecked_calls;
+    }
+
+    std::uint64_t getUncheckedCalls() const { return m_unchecked_calls; }
+
+private:
+    bool m_can_compute_result;
+    std::uint64_t m_unchecked_calls;
+};
+
+/**
+ * @brief Result buffers large enough for the ground truth of CountingDataLoader.
+ */
+struct ResultBuffers
+{
+    ResultBuffers() :
+        raw(ResultCount, std::vector<std::uint8_t>(OutputBufferSize)),
+        buffers(ResultCount)
+    {
+        for (std::size_t result_i = 0; result_i < ResultCount; ++result_i)
+        {
+            buffers[result_i].p    = raw[result_i].data();
+            buffers[result_i].size = raw[result_i].size();
+            buffers[result_i].tag  = 0;
+        } // end for
+    }
+
+    std::vector<hebench::APIBridge::NativeDataBuffer *> getPointers()
+    {
+        std::vector<hebench::APIBridge::NativeDataBuffer *> retval;
+        for (hebench::APIBridge::NativeDataBuffer &buffer : buffers)
+            retval.push_back(&buffer);
+        return retval;
+    }
+
+    std::vector<std::vector<std::uint8_t>> raw;
+    std::vector<hebench::APIBridge::NativeDataBuffer> buffers;
+};
+
+void testValidArguments()
+{
+    CountingDataLoader loader(true);
+    ResultBuffers results;
+    // last sample of each parameter is in range
+    const std::uint64_t indices[ParameterCount] = { 1, 2 };
+    loader.computeResult(results.getPointers(), indices);
+    HEBENCH_CHECK(loader.getUncheckedCalls() == 1);
+}
+
+void testNullIndices()
+{
+    CountingDataLoader loader(true);
+    ResultBuffers results;
+    HEBENCH_CHECK_THROWS(loader.computeResult(results.getPointers(), nullptr), std::invalid_argument);
+    HEBENCH_CHECK(loader.getUncheckedCalls() == 0);
+}
+
+void testIndexOutOfRange()
+{
+    CountingDataLoader loader(true);
+    ResultBuffers results;
+    const std::uint64_t indices_0[ParameterCount] = { 2, 0 };
+    HEBENCH_CHECK_THROWS(loader.computeResult(results.getPointers(), indices_0), std::out_of_range);
+    const std::uint64_t indices_1[ParameterCount] = { 0, 3 };
+    HEBENCH_CHECK_THROWS(loader.computeResult(results.getPointers(), indices_1), std::out_of_range);
+    HEBENCH_CHECK(loader.getUncheckedCalls() == 0);
+}
+
+void testInsufficientResultBuffers()
+{
+    CountingDataLoader loader(true);
+    ResultBuffers results;
+    std::vector<hebench::APIBridge::NativeDataBuffer *> result_pointers = results.getPointers();
+    result_pointers.pop_back();
+    const std::uint64_t indices[ParameterCount] = { 0, 0 };
+    HEBENCH_CHECK_THROWS(loader.computeResult(result_pointers, indices), std::invalid_argument);
+    HEBENCH_CHECK(loader.getUncheckedCalls() == 0);
+}
+
+void testInvalidResultBuffer()
+{
+    CountingDataLoader loader(true);
+    const std::uint64_t indices[ParameterCount] = { 0, 0 };
+    {
+        ResultBuffers results;
+        std::vector<hebench::APIBridge::NativeDataBuffer *> result_pointers = results.getPointers();
+        result_pointers.back() = nullptr;
+        HEBENCH_CHECK_THROWS(loader.computeResult(result_pointers, indices), std::invalid_argument);
+    }
+    {
+        ResultBuffers results;
+        results.buffers.back().p = nullptr;
+        HEBENCH_CHECK_THROWS(loader.computeResult(results.getPointers(), indices), std::invalid_argument);
+    }
+    {
+        // smaller than the ground truth
+        ResultBuffers results;
+        results.buffers.front().size = OutputBufferSize - 1;
+        HEBENCH_CHECK_THROWS(loader.computeResult(results.getPointers(), indices), std::invalid_argument);
+    }
+    HEBENCH_CHECK(loader.getUncheckedCalls() == 0);
+}
+
+void testUncheckedSkipsValidation()
+{
+    // timed baseline relies on the unchecked call not validating again
+    CountingDataLoader loader(true);
+    ResultBuffers results;
+    loader.computeResultUnchecked(results.getPointers(), nullptr);
+    HEBENCH_CHECK(loader.getUncheckedCalls() == 1);
+}
+
+void testCannotComputeResult()
+{
+    CountingDataLoader loader(false);
+    ResultBuffers results;
+    const std::uint64_t indices[ParameterCount] = { 0, 0 };
+    HEBENCH_CHECK_THROWS(loader.computeResult(results.getPointers(), indices), std::logic_error);
+    HEBENCH_CHECK_THROWS(loader.computeResultUnchecked(results.getPointers(), indices), std::logic_error);
+    HEBENCH_CHECK(loader.getUncheckedCalls() == 0);
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::Testing::runTests({ { "ValidArguments", &testValidArguments },
+                                        { "NullIndices", &testNullIndices },
+                                        { "IndexOutOfRange", &testIndexOutOfRange },
+                                        { "InsufficientResultBuffers", &testInsufficientResultBuffers },
+                                        { "InvalidResultBuffer", &testInvalidResultBuffer },
+                                        { "UncheckedSkipsValidation", &testUncheckedSkipsValidation },
+                                        { "CannotComputeResult", &testCannotComputeResult } });
+}
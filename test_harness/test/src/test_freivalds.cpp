@@ -0,0 +1,189 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "include/hebench_math_utils.h"
+#include "modules/testing/include/testing.h"
+
+using hebench::Utilities::Math::freivalds;
+
+namespace {
+
+constexpr std::uint64_t RowsA     = 5;
+constexpr std::uint64_t ColsA     = 7;
+constexpr std::uint64_t ColsB     = 6;
+constexpr double Tolerance        = 0.05;
+constexpr std::uint64_t ProbeSeed = 1234;
+
+/**
+ * @brief Matrix product in the precision of T. Integer products wrap around
+ * in the width of T.
+ */
+template <class T>
+std::vector<T> matMul(const std::vector<T> &mat_a, const std::vector<T> &mat_b)
+{
+    std::vector<T> retval(RowsA * ColsB);
+    for (std::uint64_t row_a = 0; row_a < RowsA; ++row_a)
+        for (std::uint64_t col_b = 0; col_b < ColsB; ++col_b)
+        {
+            if constexpr (std::is_integral<T>::value)
+            {
+                using U  = typename std::make_unsigned<T>::type;
+                U result = 0;
+                for (std::uint64_t col_a = 0; col_a < ColsA; ++col_a)
+                    result += static_cast<U>(mat_a[row_a * ColsA + col_a]) * static_cast<U>(mat_b[col_a * ColsB + col_b]);
+                retval[row_a * ColsB + col_b] = static_cast<T>(result);
+            } // end if
+            else
+            {
+                T result = 0;
+                for (std::uint64_t col_a = 0; col_a < ColsA; ++col_a)
+                    result += mat_a[row_a * ColsA + col_a] * mat_b[col_a * ColsB + col_b];
+                retval[row_a * ColsB + col_b] = result;
+            } // end else
+        } // end for
+    return retval;
+}
+
+template <class T>
+std::vector<T> generateMatrix(std::uint64_t count, T min_value, T max_value, std::mt19937_64 &rand_gen)
+{
+    std::vector<T> retval(count);
+    if constexpr (std::is_integral<T>::value)
+    {
+        std::uniform_int_distribution<T> distribution(min_value, max_value);
+        std::generate(retval.begin(), retval.end(), [&]() { return distribution(rand_gen); });
+    } // end if
+    else
+    {
+        std::uniform_real_distribution<T> distribution(min_value, max_value);
+        std::generate(retval.begin(), retval.end(), [&]() { return distribution(rand_gen); });
+    } // end else
+    return retval;
+}
+
+std::vector<double> generateProjection(std::mt19937_64 &rand_gen)
+{
+    std::vector<double> retval(ColsB);
+    std::bernoulli_distribution distribution;
+    std::generate(retval.begin(), retval.end(), [&]() { return distribution(rand_gen) ? 1.0 : -1.0; });
+    return retval;
+}
+
+template <class T>
+std::vector<std::uint64_t> check(const std::vector<T> &mat_result, const std::vector<T> &mat_a, const std::vector<T> &mat_b,
+                                 const std::vector<double> &projection)
+{
+    return freivalds<T>(mat_result.data(), mat_a.data(), mat_b.data(),
+                        RowsA, ColsA, ColsB, projection, Tolerance);
+}
+
+template <class T>
+void checkIntegerExact(T min_value, T max_value)
+{
+    std::mt19937_64 rand_gen(ProbeSeed);
+    std::vector<T> mat_a      = generateMatrix<T>(RowsA * ColsA, min_value, max_value, rand_gen);
+    std::vector<T> mat_b      = generateMatrix<T>(ColsA * ColsB, min_value, max_value, rand_gen);
+    std::vector<T> mat_result = matMul(mat_a, mat_b);
+    for (int round_i = 0; round_i < 8; ++round_i)
+    {
+        std::vector<double> projection = generateProjection(rand_gen);
+        HEBENCH_CHECK(check(mat_result, mat_a, mat_b, projection).empty());
+
+        // off by one in any element changes the projection of its row by 1,
+        // which no tolerance hides
+        for (std::uint64_t row_a = 0; row_a < RowsA; ++row_a)
+        {
+            using U                  = typename std::make_unsigned<T>::type;
+            std::vector<T> mat_wrong = mat_result;
+            T &value                 = mat_wrong[row_a * ColsB + round_i % ColsB];
+            value                    = static_cast<T>(static_cast<U>(value) + static_cast<U>(1));
+            HEBENCH_CHECK((check(mat_wrong, mat_a, mat_b, projection) == std::vector<std::uint64_t>{ row_a }));
+        } // end for
+    } // end for
+}
+
+template <class T>
+void checkFloatTolerance()
+{
+    std::mt19937_64 rand_gen(ProbeSeed);
+    std::vector<T> mat_a      = generateMatrix<T>(RowsA * ColsA, -10, 10, rand_gen);
+    std::vector<T> mat_b      = generateMatrix<T>(ColsA * ColsB, -10, 10, rand_gen);
+    std::vector<T> mat_result = matMul(mat_a, mat_b);
+    for (int round_i = 0; round_i < 8; ++round_i)
+    {
+        std::vector<double> projection = generateProjection(rand_gen);
+        HEBENCH_CHECK(check(mat_result, mat_a, mat_b, projection).empty());
+
+        // every element off by 90% of its tolerance, all in the direction of
+        // the projection: the largest error that must still pass
+        std::vector<T> mat_within = mat_result;
+        for (std::uint64_t row_a = 0; row_a < RowsA; ++row_a)
+            for (std::uint64_t col_b = 0; col_b < ColsB; ++col_b)
+            {
+                T &value = mat_within[row_a * ColsB + col_b];
+                value += static_cast<T>(projection[col_b] * 0.9 * Tolerance * std::max(std::abs(static_cast<double>(value)), 1.0));
+            } // end for
+        HEBENCH_CHECK(check(mat_within, mat_a, mat_b, projection).empty());
+
+        // one element off by more than the summed tolerance of its row
+        std::uint64_t row_a = round_i % RowsA;
+        double row_bound    = 0.0;
+        for (std::uint64_t col_b = 0; col_b < ColsB; ++col_b)
+            row_bound += Tolerance * std::max(std::abs(static_cast<double>(mat_result[row_a * ColsB + col_b])), 1.0);
+        std::vector<T> mat_wrong = mat_result;
+        mat_wrong[row_a * ColsB] += static_cast<T>(3.0 * row_bound);
+        HEBENCH_CHECK((check(mat_wrong, mat_a, mat_b, projection) == std::vector<std::uint64_t>{ row_a }));
+    } // end for
+}
+
+void testInt32Exact()
+{
+    checkIntegerExact<std::int32_t>(-100, 100);
+}
+
+void testInt64Exact()
+{
+    checkIntegerExact<std::int64_t>(-100000, 100000);
+}
+
+void testInt32Wraparound()
+{
+    // products overflow: ground truth wraps around in 32 bits
+    checkIntegerExact<std::int32_t>(std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max());
+}
+
+void testInt64Wraparound()
+{
+    checkIntegerExact<std::int64_t>(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max());
+}
+
+void testFloat32Tolerance()
+{
+    checkFloatTolerance<float>();
+}
+
+void testFloat64Tolerance()
+{
+    checkFloatTolerance<double>();
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::Testing::runTests({ { "Int32Exact", &testInt32Exact },
+                                        { "Int64Exact", &testInt64Exact },
+                                        { "Int32Wraparound", &testInt32Wraparound },
+                                        { "Int64Wraparound", &testInt64Wraparound },
+                                        { "Float32Tolerance", &testFloat32Tolerance },
+                                        { "Float64Tolerance", &testFloat64Tolerance } });
+}
@@ -0,0 +1,154 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "include/hebench_run_modes.h"
+#include "modules/testing/include/testing.h"
+
+using hebench::TestHarness::RunModes;
+using Mode = hebench::TestHarness::RunModes::Mode;
+
+namespace {
+
+constexpr std::uint32_t ModeCount = static_cast<std::uint32_t>(Mode::Count);
+
+Mode getMode(std::uint32_t mode_i)
+{
+    return static_cast<Mode>(mode_i);
+}
+
+bool isCompatiblePair(Mode a, Mode b)
+{
+    return (a == Mode::SLOSearch && b == Mode::OperandSweep)
+           || (a == Mode::OperandSweep && b == Mode::SLOSearch);
+}
+
+void testNoModeEnabled()
+{
+    RunModes run_modes;
+    for (std::uint32_t mode_i = 0; mode_i < ModeCount; ++mode_i)
+        HEBENCH_CHECK(!run_modes.isEnabled(getMode(mode_i)));
+}
+
+void testEnableEachMode()
+{
+    for (std::uint32_t mode_i = 0; mode_i < ModeCount; ++mode_i)
+    {
+        RunModes run_modes;
+        run_modes.enable(getMode(mode_i));
+        // enabling a mode twice has no effect
+        run_modes.enable(getMode(mode_i));
+        for (std::uint32_t other_i = 0; other_i < ModeCount; ++other_i)
+            HEBENCH_CHECK(run_modes.isEnabled(getMode(other_i)) == (other_i == mode_i));
+    } // end for
+}
+
+void testCompatibility()
+{
+    // every pair is mutually exclusive, except SLO search and operand sweep
+    for (std::uint32_t mode_i = 0; mode_i < ModeCount; ++mode_i)
+        for (std::uint32_t other_i = 0; other_i < ModeCount; ++other_i)
+        {
+            if (other_i == mode_i)
+                continue;
+            RunModes run_modes;
+            run_modes.enable(getMode(mode_i));
+            if (isCompatiblePair(getMode(mode_i), getMode(other_i)))
+            {
+                run_modes.enable(getMode(other_i));
+                HEBENCH_CHECK(run_modes.isEnabled(getMode(mode_i)) && run_modes.isEnabled(getMode(other_i)));
+            } // end if
+            else
+            {
+                HEBENCH_CHECK_THROWS(run_modes.enable(getMode(other_i)), std::runtime_error);
+                // failed request leaves enabled modes unchanged
+                HEBENCH_CHECK(run_modes.isEnabled(getMode(mode_i)) && !run_modes.isEnabled(getMode(other_i)));
+            } // end else
+        } // end for
+}
+
+void testIncompatibleMessage()
+{
+    RunModes run_modes;
+    run_modes.enable(Mode::ColdStart);
+    std::string s_error;
+    try
+    {
+        run_modes.enable(Mode::Worker);
+    }
+    catch (std::runtime_error &ex)
+    {
+        s_error = ex.what();
+    }
+    // names both modes, starting with the one requested
+    HEBENCH_CHECK(s_error.rfind("Worker mode", 0) == 0);
+    HEBENCH_CHECK(s_error.find(RunModes::getName(Mode::ColdStart)) != std::string::npos);
+}
+
+void testInvalidMode()
+{
+    RunModes run_modes;
+    HEBENCH_CHECK_THROWS(run_modes.enable(Mode::Count), std::invalid_argument);
+    HEBENCH_CHECK_THROWS(RunModes::getName(Mode::Count), std::invalid_argument);
+    for (std::uint32_t mode_i = 0; mode_i < ModeCount; ++mode_i)
+        HEBENCH_CHECK(!std::string(RunModes::getName(getMode(mode_i))).empty());
+}
+
+void testDispatchEnabled()
+{
+    RunModes run_modes;
+    run_modes.enable(Mode::EnvSweep);
+    std::vector<std::string> called;
+    run_modes.dispatch({ { Mode::ColdStart, [&]() { called.push_back("cold start"); } },
+                         { Mode::EnvSweep, [&]() { called.push_back("env sweep"); } } },
+                       [&]() { called.push_back("default"); });
+    HEBENCH_CHECK((called == std::vector<std::string>{ "env sweep" }));
+}
+
+void testDispatchDefault()
+{
+    RunModes run_modes;
+    // modes without a handler in this dispatch do not select one
+    run_modes.enable(Mode::SLOSearch);
+    std::vector<std::string> called;
+    run_modes.dispatch({ { Mode::ColdStart, [&]() { called.push_back("cold start"); } } },
+                       [&]() { called.push_back("default"); });
+    HEBENCH_CHECK((called == std::vector<std::string>{ "default" }));
+
+    // empty default handler is not called
+    run_modes.dispatch({ { Mode::ColdStart, [&]() { called.push_back("cold start"); } } },
+                       RunModes::Handler());
+    HEBENCH_CHECK(called.size() == 1);
+}
+
+void testDispatchAmbiguous()
+{
+    RunModes run_modes;
+    run_modes.enable(Mode::SLOSearch);
+    run_modes.enable(Mode::OperandSweep);
+    bool b_called = false;
+    HEBENCH_CHECK_THROWS((run_modes.dispatch({ { Mode::SLOSearch, [&]() { b_called = true; } },
+                                               { Mode::OperandSweep, [&]() { b_called = true; } } },
+                                             [&]() { b_called = true; })),
+                         std::logic_error);
+    HEBENCH_CHECK(!b_called);
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::Testing::runTests({ { "NoModeEnabled", &testNoModeEnabled },
+                                        { "EnableEachMode", &testEnableEachMode },
+                                        { "Compatibility", &testCompatibility },
+                                        { "IncompatibleMessage", &testIncompatibleMessage },
+                                        { "InvalidMode", &testInvalidMode },
+                                        { "DispatchEnabled", &testDispatchEnabled },
+                                        { "DispatchDefault", &testDispatchDefault },
+                                        { "DispatchAmbiguous", &testDispatchAmbiguous } });
+}